@@ -76,6 +76,13 @@ macro(draco_set_build_definitions)
 
   endif()
 
+  if(DRACO_THREADING AND NOT EMSCRIPTEN)
+    # Sets CMAKE_THREAD_LIBS_INIT, which is also consumed by executable targets
+    # and by draco.pc.
+    find_package(Threads REQUIRED)
+    list(APPEND draco_lib_deps ${CMAKE_THREAD_LIBS_INIT})
+  endif()
+
 
   list(APPEND draco_defines "DRACO_CMAKE=1"
               "DRACO_FLAGS_SRCDIR=\"${draco_root}\""
@@ -123,6 +123,10 @@ macro(draco_set_default_options)
     NAME DRACO_MAYA_PLUGIN
     HELPSTRING "Build plugin library for Maya."
     VALUE OFF)
+  draco_option(
+    NAME DRACO_PYTHON_MODULE
+    HELPSTRING "Build the draco Python extension module."
+    VALUE OFF)
   draco_option(
     NAME DRACO_TRANSCODER_SUPPORTED
     HELPSTRING "Enable the Draco transcoder."
@@ -139,6 +143,14 @@ macro(draco_set_default_options)
     NAME DRACO_BUILD_EXECUTABLES
     HELPSTRING "Enable executables build."
     VALUE ON)
+  draco_option(
+    NAME DRACO_THREADING
+    HELPSTRING "Enable multithreaded code paths (ignored for Emscripten)."
+    VALUE ON)
+  draco_option(
+    NAME DRACO_INSTRUMENTATION
+    HELPSTRING "Enable collection of per-stage encoding and decoding stats."
+    VALUE OFF)
   draco_check_deprecated_options()
 endmacro()
 
@@ -240,10 +252,23 @@ macro(draco_set_optional_features)
     set(CMAKE_POSITION_INDEPENDENT_CODE ON)
   endif()
 
+  if(DRACO_PYTHON_MODULE)
+    draco_enable_feature(FEATURE "DRACO_PYTHON_MODULE")
+    set(CMAKE_POSITION_INDEPENDENT_CODE ON)
+  endif()
+
   if(DRACO_TRANSCODER_SUPPORTED)
     draco_enable_feature(FEATURE "DRACO_TRANSCODER_SUPPORTED")
   endif()
 
+  if(DRACO_THREADING AND NOT EMSCRIPTEN)
+    draco_enable_feature(FEATURE "DRACO_THREADING_SUPPORTED")
+  endif()
+
+  if(DRACO_INSTRUMENTATION)
+    draco_enable_feature(FEATURE "DRACO_INSTRUMENTATION_SUPPORTED")
+  endif()
+
 
 endmacro()
 
@@ -24,6 +24,16 @@ set(draco_factory_test_sources
     "${draco_src_root}/io/file_reader_factory_test.cc"
     "${draco_src_root}/io/file_writer_factory_test.cc")
 
+# Benchmarks are built into a separate target so that they do not slow down
+# the unit tests. They print their timings to stdout.
+set(draco_benchmark_sources
+    "${draco_src_root}/compression/attributes/prediction_schemes/mesh_prediction_scheme_geometric_normal_benchmark.cc"
+    "${draco_src_root}/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_benchmark.cc"
+    "${draco_src_root}/compression/batch_decoder_benchmark.cc"
+    "${draco_src_root}/compression/entropy/symbol_coding_benchmark.cc"
+    "${draco_src_root}/compression/mesh/mesh_edgebreaker_decoder_benchmark.cc"
+    "${draco_src_root}/mesh/corner_table_benchmark.cc")
+
 list(
   APPEND draco_test_common_sources
          "${draco_src_root}/core/draco_test_base.h"
@@ -41,6 +51,7 @@ list(
     "${draco_src_root}/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_canonicalized_transform_test.cc"
     "${draco_src_root}/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_transform_test.cc"
     "${draco_src_root}/compression/attributes/sequential_integer_attribute_encoding_test.cc"
+    "${draco_src_root}/compression/batch_decoder_test.cc"
     "${draco_src_root}/compression/bit_coders/rans_coding_test.cc"
     "${draco_src_root}/compression/decode_test.cc"
     "${draco_src_root}/compression/encode_test.cc"
@@ -51,9 +62,11 @@ list(
     "${draco_src_root}/compression/point_cloud/point_cloud_kd_tree_encoding_test.cc"
     "${draco_src_root}/compression/point_cloud/point_cloud_sequential_encoding_test.cc"
     "${draco_src_root}/core/buffer_bit_coding_test.cc"
+    "${draco_src_root}/core/hash_utils_test.cc"
     "${draco_src_root}/core/math_utils_test.cc"
     "${draco_src_root}/core/quantization_utils_test.cc"
     "${draco_src_root}/core/status_test.cc"
+    "${draco_src_root}/core/thread_pool_test.cc"
     "${draco_src_root}/core/vector_d_test.cc"
     "${draco_src_root}/io/file_reader_test_common.h"
     "${draco_src_root}/io/file_utils_test.cc"
@@ -67,9 +80,12 @@ list(
     "${draco_src_root}/io/stl_decoder_test.cc"
     "${draco_src_root}/io/stl_encoder_test.cc"
     "${draco_src_root}/io/point_cloud_io_test.cc"
+    "${draco_src_root}/mesh/compact_corner_table_test.cc"
     "${draco_src_root}/mesh/corner_table_test.cc"
     "${draco_src_root}/mesh/mesh_are_equivalent_test.cc"
     "${draco_src_root}/mesh/mesh_cleanup_test.cc"
+    "${draco_src_root}/mesh/mesh_reorderer_test.cc"
+    "${draco_src_root}/mesh/mesh_stripifier_test.cc"
     "${draco_src_root}/mesh/triangle_soup_mesh_builder_test.cc"
     "${draco_src_root}/metadata/metadata_encoder_test.cc"
     "${draco_src_root}/metadata/metadata_test.cc"
@@ -80,6 +96,7 @@ if(DRACO_TRANSCODER_SUPPORTED)
   list(
     APPEND draco_test_sources
            "${draco_src_root}/animation/animation_test.cc"
+           "${draco_src_root}/io/draco_mesh_cache_test.cc"
            "${draco_src_root}/io/gltf_decoder_test.cc"
            "${draco_src_root}/io/gltf_encoder_test.cc"
            "${draco_src_root}/io/gltf_utils_test.cc"
@@ -102,8 +119,22 @@ if(DRACO_TRANSCODER_SUPPORTED)
            "${draco_src_root}/scene/trs_matrix_test.cc"
            "${draco_src_root}/texture/texture_library_test.cc"
            "${draco_src_root}/texture/texture_map_test.cc"
-           "${draco_src_root}/texture/texture_transform_test.cc")
+           "${draco_src_root}/texture/texture_transform_test.cc"
+           "${draco_src_root}/tools/draco_transcoder_c_api.cc"
+           "${draco_src_root}/tools/draco_transcoder_c_api.h"
+           "${draco_src_root}/tools/draco_transcoder_c_api_test.cc"
+           "${draco_src_root}/tools/draco_transcoder_lib.cc"
+           "${draco_src_root}/tools/draco_transcoder_lib.h"
+           "${draco_src_root}/tools/draco_transcoder_lib_test.cc")
+
+endif()
 
+if(DRACO_UNITY_PLUGIN)
+  list(
+    APPEND draco_test_sources
+           "${draco_src_root}/unity/draco_unity_plugin.cc"
+           "${draco_src_root}/unity/draco_unity_plugin.h"
+           "${draco_src_root}/unity/draco_unity_plugin_test.cc")
 endif()
 
 macro(draco_setup_test_targets)
@@ -168,6 +199,14 @@ macro(draco_setup_test_targets)
       LIB_DEPS ${draco_dependency} draco_gtest draco_gtest_main
                draco_test_common)
 
-
+    draco_add_executable(
+      TEST
+      NAME draco_benchmarks
+      SOURCES ${draco_benchmark_sources}
+      DEFINES ${draco_defines} ${draco_test_defines}
+      INCLUDES ${draco_test_include_paths}
+      OBJLIB_DEPS draco_io
+      LIB_DEPS ${draco_dependency} draco_gtest draco_gtest_main
+               draco_test_common)
   endif()
 endmacro()
@@ -9,6 +9,7 @@ import ctypes
 import io
 import os
 import platform
+from collections import namedtuple
 from ctypes import Structure, c_char_p, c_int
 
 
@@ -27,6 +28,32 @@ class DracoOptions(Structure):
     ]
 
 
+class DracoBatchItem(Structure):
+    """C-compatible struct for a single batch transcoding input."""
+
+    _fields_ = [
+        ("input_filename", c_char_p),
+        ("input_data", ctypes.c_void_p),
+        ("input_size", ctypes.c_size_t),
+        ("output_filename", c_char_p),
+    ]
+
+
+class DracoBatchResult(Structure):
+    """C-compatible struct for a single batch transcoding result."""
+
+    _fields_ = [
+        ("status", c_int),
+        ("output_data", ctypes.c_void_p),
+        ("output_size", ctypes.c_size_t),
+    ]
+
+
+# Result of a single compress_gltf_batch() input. |data| is an io.BytesIO with
+# the compressed glTF, or None when |status| is non-zero.
+BatchResult = namedtuple("BatchResult", ["data", "status"])
+
+
 def _load_library():
     """Load the Draco transcoder shared library."""
     system = platform.system().lower()
@@ -39,9 +66,10 @@ def _load_library():
     else:  # Linux and others
         lib_path = f"lib{lib_name}.so"
 
-    # Try to load from current directory first
+    # Try to load from current directory first. The path must not be a bare
+    # file name, which the dynamic loader looks up only in the system paths.
     if os.path.exists(lib_path):
-        return ctypes.CDLL(lib_path)
+        return ctypes.CDLL(os.path.abspath(lib_path))
 
     # Try to load from build directory (common locations)
     build_dirs = [
@@ -82,10 +110,52 @@ _lib.draco_decompress_gltf_to_buffer.argtypes = [
 ]
 _lib.draco_decompress_gltf_to_buffer.restype = ctypes.c_void_p
 
+_lib.draco_transcode_gltf_to_output.argtypes = [
+    ctypes.c_void_p,
+    ctypes.c_size_t,
+    ctypes.POINTER(DracoOptions),
+]
+_lib.draco_transcode_gltf_to_output.restype = ctypes.c_void_p
+
+_lib.draco_decompress_gltf_to_output.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+_lib.draco_decompress_gltf_to_output.restype = ctypes.c_void_p
+
+_lib.draco_output_buffer_data.argtypes = [ctypes.c_void_p]
+_lib.draco_output_buffer_data.restype = ctypes.c_void_p
+
+_lib.draco_output_buffer_size.argtypes = [ctypes.c_void_p]
+_lib.draco_output_buffer_size.restype = ctypes.c_size_t
+
+_lib.draco_free_output_buffer.argtypes = [ctypes.c_void_p]
+_lib.draco_free_output_buffer.restype = None
+
+_lib.draco_transcode_gltf_batch.argtypes = [
+    ctypes.POINTER(DracoBatchItem),
+    ctypes.c_size_t,
+    ctypes.POINTER(DracoOptions),
+    c_int,
+    ctypes.POINTER(DracoBatchResult),
+]
+_lib.draco_transcode_gltf_batch.restype = c_int
+
 _lib.draco_free_buffer.argtypes = [ctypes.c_void_p]
 _lib.draco_free_buffer.restype = None
 
 
+def _make_options(qp, qt, qn, qc, qtg, qw, qg, cl):
+    """Create the C options struct from the compression arguments."""
+    options = DracoOptions()
+    options.quantization_position = qp
+    options.quantization_tex_coord = qt
+    options.quantization_normal = qn
+    options.quantization_color = qc
+    options.quantization_tangent = qtg
+    options.quantization_weight = qw
+    options.quantization_generic = qg
+    options.compression_level = cl
+    return options
+
+
 def compress_gltf(input_data, qp=11, qt=10, qn=8, qc=8, qtg=8, qw=8, qg=8, cl=7):
     """
     Compress glTF data using Draco compression.
@@ -120,15 +190,7 @@ def compress_gltf(input_data, qp=11, qt=10, qn=8, qc=8, qtg=8, qw=8, qg=8, cl=7)
         raise RuntimeError("input_data must be a file path (str) or BytesIO object")
 
     # Create options struct
-    options = DracoOptions()
-    options.quantization_position = qp
-    options.quantization_tex_coord = qt
-    options.quantization_normal = qn
-    options.quantization_color = qc
-    options.quantization_tangent = qtg
-    options.quantization_weight = qw
-    options.quantization_generic = qg
-    options.compression_level = cl
+    options = _make_options(qp, qt, qn, qc, qtg, qw, qg, cl)
 
     # Get input data
     input_bytes = input_buffer.getvalue()
@@ -152,6 +214,168 @@ def compress_gltf(input_data, qp=11, qt=10, qn=8, qc=8, qtg=8, qw=8, qg=8, cl=7)
         _lib.draco_free_buffer(result)
 
 
+class _OutputBuffer:
+    """Owns a native DracoOutputBuffer and frees it when collected."""
+
+    def __init__(self, handle):
+        self._handle = handle
+
+    def __del__(self):
+        _lib.draco_free_output_buffer(self._handle)
+
+
+def _input_view(input_data):
+    """
+    Return (keep_alive, pointer, size) for glTF input data without copying it.
+
+    File paths are read into memory. BytesIO objects, bytes, bytearrays and
+    memoryviews are referenced directly.
+    """
+    if isinstance(input_data, str):
+        if not os.path.exists(input_data):
+            raise RuntimeError(f"Input file does not exist: {input_data}")
+        with open(input_data, "rb") as f:
+            input_data = f.read()
+    elif isinstance(input_data, io.BytesIO):
+        input_data = input_data.getbuffer()
+    if isinstance(input_data, bytes):
+        return input_data, ctypes.cast(c_char_p(input_data), ctypes.c_void_p), len(
+            input_data
+        )
+    if isinstance(input_data, (bytearray, memoryview)):
+        view = memoryview(input_data).cast("B")
+        if view.readonly:
+            data = view.tobytes()
+            return data, ctypes.cast(c_char_p(data), ctypes.c_void_p), len(data)
+        array = (ctypes.c_char * len(view)).from_buffer(view)
+        return array, ctypes.cast(array, ctypes.c_void_p), len(view)
+    raise RuntimeError(
+        "input_data must be a file path (str), BytesIO or bytes-like object"
+    )
+
+
+def _output_view(handle):
+    """Wrap a native DracoOutputBuffer into a memoryview without copying."""
+    if not handle:
+        return None
+    owner = _OutputBuffer(handle)
+    size = _lib.draco_output_buffer_size(handle)
+    array = (ctypes.c_char * size).from_address(_lib.draco_output_buffer_data(handle))
+    # The array keeps the native buffer alive as long as any view exists.
+    array._owner = owner
+    return memoryview(array).cast("B")
+
+
+def compress_gltf_view(input_data, qp=11, qt=10, qn=8, qc=8, qtg=8, qw=8, qg=8, cl=7):
+    """
+    Compress glTF data using Draco compression without copying the output.
+
+    Same as compress_gltf() but the input can also be bytes, bytearray or
+    memoryview, and the result is a read-write memoryview of the buffer
+    written by the native encoder. The native buffer is freed once the
+    memoryview and all views derived from it are released.
+
+    Returns:
+        memoryview: Compressed glTF data
+
+    Raises:
+        RuntimeError: If input data is invalid or compression fails
+    """
+    keep_alive, input_ptr, input_size = _input_view(input_data)
+    options = _make_options(qp, qt, qn, qc, qtg, qw, qg, cl)
+    handle = _lib.draco_transcode_gltf_to_output(
+        input_ptr, input_size, ctypes.byref(options)
+    )
+    del keep_alive
+    if not handle:
+        raise RuntimeError("Draco transcoding failed")
+    return _output_view(handle)
+
+
+def decompress_gltf_view(input_data):
+    """
+    Decompress Draco-compressed glTF data without copying the output.
+
+    Same as decompress_gltf() but the input can also be bytes, bytearray or
+    memoryview, and the result is a memoryview of the buffer written by the
+    native encoder.
+
+    Returns:
+        memoryview: Decompressed glTF data
+
+    Raises:
+        RuntimeError: If input data is invalid or decompression fails
+    """
+    keep_alive, input_ptr, input_size = _input_view(input_data)
+    handle = _lib.draco_decompress_gltf_to_output(input_ptr, input_size)
+    del keep_alive
+    if not handle:
+        raise RuntimeError("Draco decompression failed")
+    return _output_view(handle)
+
+
+def compress_gltf_batch(
+    inputs, num_threads=-1, qp=11, qt=10, qn=8, qc=8, qtg=8, qw=8, qg=8, cl=7
+):
+    """
+    Compress multiple glTF inputs concurrently using Draco compression.
+
+    All inputs are transcoded by a single native call that distributes them
+    over an internal thread pool, so the GIL is released for the whole batch
+    and no Python threads are needed.
+
+    Args:
+        inputs (list of str or io.BytesIO): Input glTF data - file paths (str)
+            or BytesIO objects
+        num_threads (int): Number of extra worker threads, negative values use
+            all hardware threads (default: -1)
+        qp, qt, qn, qc, qtg, qw, qg, cl: Same as in compress_gltf()
+
+    Returns:
+        list of BatchResult: Compressed glTF data and status of each input, in
+        the order of |inputs|
+
+    Raises:
+        RuntimeError: If an input has an invalid type
+    """
+    num_items = len(inputs)
+    items = (DracoBatchItem * num_items)()
+    # Keeps the input bytes alive during the native call.
+    input_bytes = []
+    for i, input_data in enumerate(inputs):
+        if isinstance(input_data, str):
+            items[i].input_filename = os.fsencode(input_data)
+        elif isinstance(input_data, io.BytesIO):
+            data = input_data.getvalue()
+            input_bytes.append(data)
+            items[i].input_data = ctypes.cast(c_char_p(data), ctypes.c_void_p)
+            items[i].input_size = len(data)
+        else:
+            raise RuntimeError(
+                "inputs must contain file paths (str) or BytesIO objects"
+            )
+
+    options = _make_options(qp, qt, qn, qc, qtg, qw, qg, cl)
+    results = (DracoBatchResult * num_items)()
+    if _lib.draco_transcode_gltf_batch(
+        items, num_items, ctypes.byref(options), num_threads, results
+    ) < 0:
+        raise RuntimeError("Draco batch transcoding failed")
+
+    batch_results = []
+    for result in results:
+        data = None
+        if result.output_data:
+            try:
+                data = io.BytesIO(
+                    ctypes.string_at(result.output_data, result.output_size)
+                )
+            finally:
+                _lib.draco_free_buffer(result.output_data)
+        batch_results.append(BatchResult(data, result.status))
+    return batch_results
+
+
 def decompress_gltf(input_data):
     """
     Decompress Draco-compressed glTF data to uncompressed glTF.
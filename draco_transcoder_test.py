@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+#
+# Copyright 2026 The Draco Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Tests the draco_transcoder.py ctypes wrapper.
+
+Run through ctest, or directly with:
+
+  python3 draco_transcoder_test.py --library_dir <draco build dir> \
+      --testdata_dir <draco root>/testdata
+"""
+
+import argparse
+import gc
+import io
+import os
+import sys
+import unittest
+
+# Directory of the draco test files, set in main().
+TESTDATA_DIR = None
+
+# Imported in main() from the directory of the shared library.
+draco_transcoder = None
+
+BOX = os.path.join("Box", "glTF_Binary", "Box.glb")
+DUCK = os.path.join("KhronosSampleModels", "Duck", "glTF_Binary", "Duck.glb")
+
+
+def test_file_path(name):
+    return os.path.join(TESTDATA_DIR, name)
+
+
+def read_test_file(name):
+    with open(test_file_path(name), "rb") as f:
+        return f.read()
+
+
+class DracoTranscoderTest(unittest.TestCase):
+    def test_compress_gltf(self):
+        expected = draco_transcoder.compress_gltf(
+            io.BytesIO(read_test_file(BOX))
+        ).getvalue()
+        self.assertGreater(len(expected), 0)
+        self.assertEqual(
+            draco_transcoder.compress_gltf(test_file_path(BOX)).getvalue(),
+            expected,
+        )
+
+    def test_compress_gltf_invalid_input(self):
+        with self.assertRaises(RuntimeError):
+            draco_transcoder.compress_gltf(io.BytesIO(b"not a glTF file"))
+        with self.assertRaises(RuntimeError):
+            draco_transcoder.compress_gltf(test_file_path("does_not_exist.glb"))
+        with self.assertRaises(RuntimeError):
+            draco_transcoder.compress_gltf(read_test_file(BOX))
+        with self.assertRaises(RuntimeError):
+            draco_transcoder.compress_gltf(test_file_path(BOX), cl=11)
+
+    def test_compress_gltf_view(self):
+        data = read_test_file(DUCK)
+        expected = draco_transcoder.compress_gltf(io.BytesIO(data)).getvalue()
+        inputs = [
+            test_file_path(DUCK),
+            io.BytesIO(data),
+            data,
+            bytearray(data),
+            memoryview(data),
+        ]
+        for input_data in inputs:
+            with self.subTest(input_type=type(input_data).__name__):
+                view = draco_transcoder.compress_gltf_view(input_data)
+                self.assertIsInstance(view, memoryview)
+                self.assertEqual(view.tobytes(), expected)
+
+    def test_compress_gltf_view_outlives_handle(self):
+        view = draco_transcoder.compress_gltf_view(read_test_file(BOX))
+        expected = view.tobytes()
+        # A slice of the view keeps the native buffer alive on its own.
+        view = view[4:]
+        gc.collect()
+        for _ in range(5):
+            draco_transcoder.compress_gltf_view(read_test_file(DUCK))
+        self.assertEqual(view.tobytes(), expected[4:])
+
+    def test_compress_gltf_view_invalid_input(self):
+        with self.assertRaises(RuntimeError):
+            draco_transcoder.compress_gltf_view(b"not a glTF file")
+        with self.assertRaises(RuntimeError):
+            draco_transcoder.compress_gltf_view(12)
+        with self.assertRaises(RuntimeError):
+            draco_transcoder.compress_gltf_view(read_test_file(BOX), qp=31)
+
+    def test_decompress_gltf(self):
+        compressed = draco_transcoder.compress_gltf(test_file_path(BOX))
+        expected = draco_transcoder.decompress_gltf(compressed).getvalue()
+        self.assertGreater(len(expected), 0)
+        view = draco_transcoder.decompress_gltf_view(compressed)
+        self.assertEqual(view.tobytes(), expected)
+        view = draco_transcoder.decompress_gltf_view(compressed.getvalue())
+        self.assertEqual(view.tobytes(), expected)
+        with self.assertRaises(RuntimeError):
+            draco_transcoder.decompress_gltf_view(b"not a glTF file")
+
+    def test_compress_gltf_batch(self):
+        box_data = read_test_file(BOX)
+        duck_data = read_test_file(DUCK)
+        expected_box = draco_transcoder.compress_gltf(
+            io.BytesIO(box_data)
+        ).getvalue()
+        expected_duck = draco_transcoder.compress_gltf(
+            io.BytesIO(duck_data)
+        ).getvalue()
+        inputs = [
+            io.BytesIO(box_data),
+            test_file_path(DUCK),
+            io.BytesIO(b"not a glTF file"),
+            test_file_path("does_not_exist.glb"),
+            io.BytesIO(duck_data),
+        ]
+        for num_threads in [0, 2, -1]:
+            with self.subTest(num_threads=num_threads):
+                results = draco_transcoder.compress_gltf_batch(
+                    inputs, num_threads=num_threads
+                )
+                self.assertEqual(
+                    [result.status for result in results], [0, 0, -4, -4, 0]
+                )
+                self.assertEqual(results[0].data.getvalue(), expected_box)
+                self.assertGreater(len(results[1].data.getvalue()), 0)
+                self.assertIsNone(results[2].data)
+                self.assertIsNone(results[3].data)
+                self.assertEqual(results[4].data.getvalue(), expected_duck)
+
+    def test_compress_gltf_batch_invalid_input(self):
+        self.assertEqual(draco_transcoder.compress_gltf_batch([]), [])
+        results = draco_transcoder.compress_gltf_batch(
+            [test_file_path(BOX), test_file_path(DUCK)], cl=11
+        )
+        self.assertEqual([result.status for result in results], [-2, -2])
+        with self.assertRaises(RuntimeError):
+            draco_transcoder.compress_gltf_batch([read_test_file(BOX)])
+
+
+def main():
+    global TESTDATA_DIR, draco_transcoder
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--library_dir",
+        required=True,
+        help="Directory of the built draco_transcoder_shared library.",
+    )
+    parser.add_argument(
+        "--testdata_dir", required=True, help="Directory of the draco test files."
+    )
+    args, unittest_args = parser.parse_known_args()
+    TESTDATA_DIR = os.path.abspath(args.testdata_dir)
+    # The wrapper loads the shared library from the current directory.
+    os.chdir(args.library_dir)
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    import draco_transcoder as draco_transcoder_module  # pylint: disable=g-import-not-at-top
+
+    draco_transcoder = draco_transcoder_module
+    unittest.main(argv=[sys.argv[0]] + unittest_args)
+
+
+if __name__ == "__main__":
+    main()
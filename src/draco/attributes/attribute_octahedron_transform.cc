@@ -15,8 +15,12 @@
 
 #include "draco/attributes/attribute_octahedron_transform.h"
 
+#include <atomic>
+
 #include "draco/attributes/attribute_transform_type.h"
 #include "draco/compression/attributes/normal_compression_utils.h"
+#include "draco/core/quantization_utils.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
@@ -47,33 +51,73 @@ bool AttributeOctahedronTransform::TransformAttribute(
 
 bool AttributeOctahedronTransform::InverseTransformAttribute(
     const PointAttribute &attribute, PointAttribute *target_attribute) {
-  if (target_attribute->data_type() != DT_FLOAT32) {
+  return InverseTransformAttribute(attribute, target_attribute, nullptr);
+}
+
+bool AttributeOctahedronTransform::InverseTransformAttribute(
+    const PointAttribute &attribute, PointAttribute *target_attribute,
+    ThreadPool *pool) {
+  const DataType data_type = target_attribute->data_type();
+  if (!IsFloatStorageDataTypeSupported(data_type)) {
+    return false;
+  }
+  // Both unit vectors and octahedral coordinates have components in [-1, 1],
+  // which can't be stored in unsigned normalized integers.
+  if (!IsFloatRangeStorable(data_type, -1.f, 1.f)) {
     return false;
   }
 
   const int num_points = target_attribute->size();
   const int num_components = target_attribute->num_components();
-  if (num_components != 3) {
+  if (num_components != 3 && num_components != 2) {
     return false;
   }
-  constexpr int kEntrySize = sizeof(float) * 3;
+  if (pool == nullptr) {
+    return InverseTransformValues(attribute, 0, num_points, target_attribute);
+  }
+  std::atomic<bool> success(true);
+  pool->ParallelFor(num_points, kMinInverseTransformValuesPerRange,
+                    [&](int begin, int end) {
+                      if (!InverseTransformValues(attribute, begin, end,
+                                                  target_attribute)) {
+                        success = false;
+                      }
+                    });
+  return success;
+}
+
+bool AttributeOctahedronTransform::InverseTransformValues(
+    const PointAttribute &attribute, int begin, int end,
+    PointAttribute *target_attribute) const {
+  const int num_components = target_attribute->num_components();
+  const DataType data_type = target_attribute->data_type();
+  const int entry_size = DataTypeLength(data_type) * num_components;
   float att_val[3];
-  const int32_t *source_attribute_data = reinterpret_cast<const int32_t *>(
-      attribute.GetAddress(AttributeValueIndex(0)));
+  float octahedral_coords[2];
+  const int32_t *source_attribute_data =
+      reinterpret_cast<const int32_t *>(
+          attribute.GetAddress(AttributeValueIndex(0))) +
+      2 * begin;
   uint8_t *target_address =
-      target_attribute->GetAddress(AttributeValueIndex(0));
+      target_attribute->GetAddress(AttributeValueIndex(0)) +
+      begin * entry_size;
   OctahedronToolBox octahedron_tool_box;
   if (!octahedron_tool_box.SetQuantizationBits(quantization_bits_)) {
     return false;
   }
-  for (uint32_t i = 0; i < num_points; ++i) {
+  for (int i = begin; i < end; ++i) {
     const int32_t s = *source_attribute_data++;
     const int32_t t = *source_attribute_data++;
     octahedron_tool_box.QuantizedOctahedralCoordsToUnitVector(s, t, att_val);
 
-    // Store the decoded floating point values into the attribute buffer.
-    std::memcpy(target_address, att_val, kEntrySize);
-    target_address += kEntrySize;
+    // Store the decoded values into the attribute buffer in the target format.
+    if (num_components == 2) {
+      UnitVectorToZUpOctahedralCoords(att_val, octahedral_coords);
+      StoreFloatValues(octahedral_coords, 2, data_type, target_address);
+    } else {
+      StoreFloatValues(att_val, 3, data_type, target_address);
+    }
+    target_address += entry_size;
   }
   return true;
 }
@@ -22,6 +22,8 @@
 
 namespace draco {
 
+class ThreadPool;
+
 // Attribute transform for attributes transformed to octahedral coordinates.
 class AttributeOctahedronTransform : public AttributeTransform {
  public:
@@ -41,9 +43,20 @@ class AttributeOctahedronTransform : public AttributeTransform {
                           const std::vector<PointIndex> &point_ids,
                           PointAttribute *target_attribute) override;
 
+  // Converts the octahedral coordinates of |attribute| into
+  // |target_attribute|. Targets with three components receive unit vectors,
+  // targets with two components receive z-up octahedral coordinates in range
+  // [-1, 1] (see UnitVectorToZUpOctahedralCoords()). The target attribute can
+  // use any data type supported by StoreFloatValues().
   bool InverseTransformAttribute(const PointAttribute &attribute,
                                  PointAttribute *target_attribute) override;
 
+  // Same as above, but the values are split into ranges that are transformed
+  // in parallel on the |pool|. |pool| can be null.
+  bool InverseTransformAttribute(const PointAttribute &attribute,
+                                 PointAttribute *target_attribute,
+                                 ThreadPool *pool);
+
   // Set number of quantization bits.
   void SetParameters(int quantization_bits);
 
@@ -73,6 +86,11 @@ class AttributeOctahedronTransform : public AttributeTransform {
                                  PointAttribute *target_attribute) const;
 
  private:
+  // Converts octahedral coordinates of values [|begin|, |end|) of |attribute|
+  // into unit vectors stored in |target_attribute|.
+  bool InverseTransformValues(const PointAttribute &attribute, int begin,
+                              int end, PointAttribute *target_attribute) const;
+
   int32_t quantization_bits_;
 };
 
@@ -14,6 +14,7 @@
 //
 #include "draco/attributes/attribute_quantization_transform.h"
 
+#include <atomic>
 #include <cmath>
 #include <cstring>
 #include <memory>
@@ -21,6 +22,7 @@
 
 #include "draco/attributes/attribute_transform_type.h"
 #include "draco/core/quantization_utils.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
@@ -70,18 +72,53 @@ bool AttributeQuantizationTransform::TransformAttribute(
 
 bool AttributeQuantizationTransform::InverseTransformAttribute(
     const PointAttribute &attribute, PointAttribute *target_attribute) {
-  if (target_attribute->data_type() != DT_FLOAT32) {
+  return InverseTransformAttribute(attribute, target_attribute, nullptr);
+}
+
+bool AttributeQuantizationTransform::InverseTransformAttribute(
+    const PointAttribute &attribute, PointAttribute *target_attribute,
+    ThreadPool *pool) {
+  const DataType data_type = target_attribute->data_type();
+  if (!IsFloatStorageDataTypeSupported(data_type)) {
     return false;
   }
+  // Normalized integers can't represent values outside of their normalized
+  // range. Such attributes are rejected instead of being clamped.
+  for (const float min_value : min_values_) {
+    if (!IsFloatRangeStorable(data_type, min_value, min_value + range_)) {
+      return false;
+    }
+  }
+  const int num_values = target_attribute->size();
+  if (pool == nullptr) {
+    return InverseTransformValues(attribute, 0, num_values, target_attribute);
+  }
+  // Each range writes to a disjoint part of the target buffer.
+  std::atomic<bool> success(true);
+  pool->ParallelFor(num_values, kMinInverseTransformValuesPerRange,
+                    [&](int begin, int end) {
+                      if (!InverseTransformValues(attribute, begin, end,
+                                                  target_attribute)) {
+                        success = false;
+                      }
+                    });
+  return success;
+}
 
+bool AttributeQuantizationTransform::InverseTransformValues(
+    const PointAttribute &attribute, int begin, int end,
+    PointAttribute *target_attribute) const {
   // Convert all quantized values back to floats.
   const int32_t max_quantized_value =
       (1u << static_cast<uint32_t>(quantization_bits_)) - 1;
   const int num_components = target_attribute->num_components();
-  const int entry_size = sizeof(float) * num_components;
+  const DataType data_type = target_attribute->data_type();
+  const int entry_size = DataTypeLength(data_type) * num_components;
   const std::unique_ptr<float[]> att_val(new float[num_components]);
-  int quant_val_id = 0;
-  int out_byte_pos = 0;
+  int quant_val_id = begin * num_components;
+  uint8_t *out_address =
+      target_attribute->GetAddress(AttributeValueIndex(0)) +
+      begin * entry_size;
   Dequantizer dequantizer;
   if (!dequantizer.Init(range_, max_quantized_value)) {
     return false;
@@ -90,18 +127,16 @@ bool AttributeQuantizationTransform::InverseTransformAttribute(
       reinterpret_cast<const int32_t *>(
           attribute.GetAddress(AttributeValueIndex(0)));
 
-  const int num_values = target_attribute->size();
-
-  for (uint32_t i = 0; i < num_values; ++i) {
+  for (int i = begin; i < end; ++i) {
     for (int c = 0; c < num_components; ++c) {
       float value =
           dequantizer.DequantizeFloat(source_attribute_data[quant_val_id++]);
       value = value + min_values_[c];
       att_val[c] = value;
     }
-    // Store the floating point value into the attribute buffer.
-    target_attribute->buffer()->Write(out_byte_pos, att_val.get(), entry_size);
-    out_byte_pos += entry_size;
+    // Store the value into the attribute buffer in the target data type.
+    StoreFloatValues(att_val.get(), num_components, data_type, out_address);
+    out_address += entry_size;
   }
   return true;
 }
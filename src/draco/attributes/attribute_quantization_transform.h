@@ -23,6 +23,8 @@
 
 namespace draco {
 
+class ThreadPool;
+
 // Attribute transform for quantized attributes.
 class AttributeQuantizationTransform : public AttributeTransform {
  public:
@@ -41,9 +43,18 @@ class AttributeQuantizationTransform : public AttributeTransform {
                           const std::vector<PointIndex> &point_ids,
                           PointAttribute *target_attribute) override;
 
+  // Dequantizes |attribute| into |target_attribute|. The target attribute can
+  // use any data type supported by StoreFloatValues(), such as DT_FLOAT16 or
+  // the normalized integer types.
   bool InverseTransformAttribute(const PointAttribute &attribute,
                                  PointAttribute *target_attribute) override;
 
+  // Same as above, but the values are split into ranges that are transformed
+  // in parallel on the |pool|. |pool| can be null.
+  bool InverseTransformAttribute(const PointAttribute &attribute,
+                                 PointAttribute *target_attribute,
+                                 ThreadPool *pool);
+
   bool SetParameters(int quantization_bits, const float *min_values,
                      int num_components, float range);
 
@@ -88,6 +99,10 @@ class AttributeQuantizationTransform : public AttributeTransform {
   static bool IsQuantizationValid(int quantization_bits);
 
  private:
+  // Dequantizes values [|begin|, |end|) of |attribute| into |target_attribute|.
+  bool InverseTransformValues(const PointAttribute &attribute, int begin,
+                              int end, PointAttribute *target_attribute) const;
+
   int32_t quantization_bits_;
 
   // Minimal dequantized value for each component of the attribute.
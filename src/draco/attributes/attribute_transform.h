@@ -26,6 +26,10 @@ namespace draco {
 // interface where possible.
 class AttributeTransform {
  public:
+  // Minimum number of attribute values processed by a single task when an
+  // inverse transform runs on a thread pool.
+  static constexpr int kMinInverseTransformValuesPerRange = 1 << 14;
+
   virtual ~AttributeTransform() = default;
 
   // Return attribute transform type.
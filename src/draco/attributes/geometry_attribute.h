@@ -23,6 +23,7 @@
 #include "draco/attributes/geometry_indices.h"
 #include "draco/core/data_buffer.h"
 #include "draco/core/hash_utils.h"
+#include "draco/core/quantization_utils.h"
 #include "draco/draco_features.h"
 #ifdef DRACO_TRANSCODER_SUPPORTED
 #include "draco/core/status.h"
@@ -214,6 +215,8 @@ class GeometryAttribute {
       case DT_BOOL:
         return ConvertTypedValue<bool, OutT>(att_id, out_num_components,
                                              out_val);
+      case DT_FLOAT16:
+        return ConvertFloat16Value<OutT>(att_id, out_num_components, out_val);
       default:
         // Wrong attribute type.
         return false;
@@ -325,6 +328,30 @@ class GeometryAttribute {
     return true;
   }
 
+  // Same as ConvertTypedValue() for attributes that store half precision
+  // floating point values.
+  template <typename OutT>
+  bool ConvertFloat16Value(AttributeValueIndex att_id,
+                           uint8_t out_num_components, OutT *out_value) const {
+    const uint8_t *src_address = GetAddress(att_id);
+    for (int i = 0; i < std::min(num_components_, out_num_components); ++i) {
+      if (!IsAddressValid(src_address)) {
+        return false;
+      }
+      const float in_value =
+          Float16ToFloat(*reinterpret_cast<const uint16_t *>(src_address));
+      if (!ConvertComponentValue<float, OutT>(in_value, normalized_,
+                                              out_value + i)) {
+        return false;
+      }
+      src_address += sizeof(uint16_t);
+    }
+    for (int i = num_components_; i < out_num_components; ++i) {
+      out_value[i] = static_cast<OutT>(0);
+    }
+    return true;
+  }
+
 #ifdef DRACO_TRANSCODER_SUPPORTED
   // Function that converts input |value| from type T to the internal attribute
   // representation defined by OutT and |num_components_|.
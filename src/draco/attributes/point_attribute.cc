@@ -104,6 +104,7 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
       unique_vals = DeduplicateTypedValues<uint8_t>(in_att, in_att_offset);
       break;
     case DT_UINT16:
+    case DT_FLOAT16:
       unique_vals = DeduplicateTypedValues<uint16_t>(in_att, in_att_offset);
       break;
     case DT_INT16:
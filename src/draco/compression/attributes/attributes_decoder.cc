@@ -75,7 +75,10 @@ bool AttributesDecoder::DecodeAttributesDecoderData(DecoderBuffer *in_buffer) {
     if (att_type >= GeometryAttribute::NAMED_ATTRIBUTES_COUNT) {
       return false;
     }
-    if (data_type == DT_INVALID || data_type >= DT_TYPES_COUNT) {
+    // DT_FLOAT16 is only an output data type of the decoder and it is never
+    // stored in the bitstream.
+    if (data_type == DT_INVALID || data_type >= DT_TYPES_COUNT ||
+        data_type == DT_FLOAT16) {
       return false;
     }
 
@@ -59,6 +59,11 @@ class AttributesDecoder : public AttributesDecoderInterface {
     if (!DecodeDataNeededByPortableTransforms(in_buffer)) {
       return false;
     }
+    if (point_cloud_decoder_->thread_pool() != nullptr) {
+      // Transforms of all attributes are reverted later in the post-decode
+      // stage of the PointCloudDecoder.
+      return true;
+    }
     if (!TransformAttributesToOriginalFormat()) {
       return false;
     }
@@ -78,7 +83,6 @@ class AttributesDecoder : public AttributesDecoderInterface {
   virtual bool DecodeDataNeededByPortableTransforms(DecoderBuffer *in_buffer) {
     return true;
   }
-  virtual bool TransformAttributesToOriginalFormat() { return true; }
 
  private:
   // List of attribute ids that need to be decoded with this decoder.
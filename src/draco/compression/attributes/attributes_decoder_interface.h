@@ -44,6 +44,12 @@ class AttributesDecoderInterface {
   // the derived classes.
   virtual bool DecodeAttributes(DecoderBuffer *in_buffer) = 0;
 
+  // Reverts the attribute transforms (e.g. dequantization) of all attributes
+  // decoded by DecodeAttributes(). The PointCloudDecoder calls this method
+  // only when the transforms are deferred to a separate post-decode stage
+  // (see PointCloudDecoder::thread_pool()).
+  virtual bool TransformAttributesToOriginalFormat() { return true; }
+
   virtual int32_t GetAttributeId(int i) const = 0;
   virtual int32_t GetNumAttributes() const = 0;
   virtual PointCloudDecoder *GetDecoder() const = 0;
@@ -367,6 +367,32 @@ class OctahedronToolBox {
   float dequantization_scale_;
   int32_t center_value_;
 };
+
+// Converts a |unit_vector| into octahedral coordinates in range [-1, 1] using
+// the z-up octahedral mapping that is commonly used by GPU shaders (note that
+// OctahedronToolBox uses the x axis instead). The vector can be recovered as
+// normalize(s, t, 1 - |s| - |t|), where (s, t) is first reflected as
+// ((1 - |t|) * sign(s), (1 - |s|) * sign(t)) when the z component is negative.
+inline void UnitVectorToZUpOctahedralCoords(const float *unit_vector,
+                                            float *out_coords) {
+  const float abs_sum = std::abs(unit_vector[0]) + std::abs(unit_vector[1]) +
+                        std::abs(unit_vector[2]);
+  if (abs_sum == 0.f) {
+    out_coords[0] = 0.f;
+    out_coords[1] = 0.f;
+    return;
+  }
+  float s = unit_vector[0] / abs_sum;
+  float t = unit_vector[1] / abs_sum;
+  if (unit_vector[2] < 0.f) {
+    const float reflected_s = (1.f - std::abs(t)) * (s >= 0.f ? 1.f : -1.f);
+    t = (1.f - std::abs(s)) * (t >= 0.f ? 1.f : -1.f);
+    s = reflected_s;
+  }
+  out_coords[0] = s;
+  out_coords[1] = t;
+}
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_ATTRIBUTES_NORMAL_COMPRESSION_UTILS_H_
@@ -0,0 +1,152 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmark of the area-weighted geometric normal predictor. The predictor is
+// run on quantized positions of each model, once computing the triangle
+// normals separately for each vertex and once using the precomputed face
+// normals (see ComputeFaceNormals()).
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_data.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_geometric_normal_predictor_area.h"
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_canonicalized_decoding_transform.h"
+#include "draco/core/cycle_timer.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+namespace draco {
+
+namespace {
+
+typedef MeshPredictionSchemeData<CornerTable> MeshData;
+typedef PredictionSchemeNormalOctahedronCanonicalizedDecodingTransform<int32_t>
+    Transform;
+typedef MeshPredictionSchemeGeometricNormalPredictorArea<int32_t, Transform,
+                                                         MeshData>
+    Predictor;
+
+// Minimum number of predicted normals for each measurement. Small models are
+// processed multiple times to reduce the timing noise.
+constexpr int kMinNumPredictedValues = 5000000;
+
+// Computes predictions for all entries of |mesh_data| and returns the time
+// in milliseconds.
+int64_t PredictAllNormals(Predictor *predictor, const MeshData &mesh_data,
+                          bool precompute_face_normals, int num_repetitions,
+                          std::vector<int32_t> *out_predictions) {
+  const std::vector<CornerIndex> &data_to_corner_map =
+      *mesh_data.data_to_corner_map();
+  out_predictions->resize(3 * data_to_corner_map.size());
+  CycleTimer timer;
+  timer.Start();
+  for (int r = 0; r < num_repetitions; ++r) {
+    if (precompute_face_normals) {
+      predictor->ComputeFaceNormals();
+    }
+    for (size_t i = 0; i < data_to_corner_map.size(); ++i) {
+      predictor->ComputePredictedValue(data_to_corner_map[i],
+                                       &(*out_predictions)[3 * i]);
+    }
+  }
+  timer.Stop();
+  return timer.GetInMs();
+}
+
+void BenchmarkMesh(const std::string &name, const Mesh &mesh) {
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  ASSERT_NE(pos_att, nullptr);
+  const std::unique_ptr<CornerTable> table =
+      CreateCornerTableFromPositionAttribute(&mesh);
+  ASSERT_NE(table, nullptr);
+  const int num_vertices = table->num_vertices();
+
+  // Entries are assigned to vertices in order. Each entry is mapped to a
+  // quantized position stored in a separate attribute with one value per
+  // vertex.
+  std::vector<CornerIndex> data_to_corner_map(num_vertices);
+  std::vector<int32_t> vertex_to_data_map(num_vertices);
+  std::vector<PointIndex> entry_to_point_id_map(num_vertices);
+  PointAttribute quantized_pos;
+  quantized_pos.Init(GeometryAttribute::POSITION, 3, DT_INT32, false,
+                     num_vertices);
+  const BoundingBox bbox = mesh.ComputeBoundingBox();
+  const Vector3f size = bbox.Size();
+  const float range = std::max(size[0], std::max(size[1], size[2]));
+  const float scale = range > 0.f ? 2047.f / range : 1.f;
+  for (int v = 0; v < num_vertices; ++v) {
+    const CornerIndex corner = table->LeftMostCorner(VertexIndex(v));
+    data_to_corner_map[v] = corner;
+    vertex_to_data_map[v] = v;
+    entry_to_point_id_map[v] = PointIndex(v);
+    Vector3f pos(0.f, 0.f, 0.f);
+    if (corner != kInvalidCornerIndex) {
+      const FaceIndex face = table->Face(corner);
+      const PointIndex point = mesh.face(face)[table->LocalIndex(corner)];
+      pos_att->GetMappedValue(point, &pos[0]);
+    }
+    int32_t value[3];
+    for (int c = 0; c < 3; ++c) {
+      value[c] = static_cast<int32_t>(
+          std::floor((pos[c] - bbox.GetMinPoint()[c]) * scale + 0.5f));
+    }
+    quantized_pos.SetAttributeValue(AttributeValueIndex(v), value);
+  }
+  // Isolated vertices are not predicted.
+  data_to_corner_map.erase(
+      std::remove(data_to_corner_map.begin(), data_to_corner_map.end(),
+                  kInvalidCornerIndex),
+      data_to_corner_map.end());
+  MeshData mesh_data;
+  mesh_data.Set(&mesh, table.get(), &data_to_corner_map, &vertex_to_data_map);
+
+  Predictor predictor(mesh_data);
+  predictor.SetPositionAttribute(quantized_pos);
+  predictor.SetEntryToPointIdMap(entry_to_point_id_map.data());
+
+  const int num_repetitions = std::max(
+      1, kMinNumPredictedValues / static_cast<int>(data_to_corner_map.size()));
+  std::vector<int32_t> per_vertex_predictions;
+  const int64_t per_vertex_ms = PredictAllNormals(
+      &predictor, mesh_data, false, num_repetitions, &per_vertex_predictions);
+  std::vector<int32_t> precomputed_predictions;
+  const int64_t precomputed_ms = PredictAllNormals(
+      &predictor, mesh_data, true, num_repetitions, &precomputed_predictions);
+  ASSERT_EQ(per_vertex_predictions, precomputed_predictions);
+  printf("  %-18s %8" PRId64 " ms %8" PRId64 " ms %6.2fx\n", name.c_str(),
+         per_vertex_ms, precomputed_ms,
+         precomputed_ms > 0
+             ? static_cast<double>(per_vertex_ms) / precomputed_ms
+             : 0.0);
+}
+
+}  // namespace
+
+TEST(MeshPredictionSchemeGeometricNormalBenchmark, Predict) {
+  printf("Geometric normal prediction (per-vertex vs. precomputed faces)\n");
+  for (const std::string file_name :
+       {"bun_zipper.ply", "bunny_norm.obj", "test_nm.obj"}) {
+    const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    BenchmarkMesh(file_name, *mesh);
+  }
+}
+
+}  // namespace draco
@@ -101,6 +101,7 @@ bool MeshPredictionSchemeGeometricNormalEncoder<DataTypeT, TransformT,
   this->SetQuantizationBits(this->transform().quantization_bits());
   predictor_.SetEntryToPointIdMap(entry_to_point_id_map);
   DRACO_DCHECK(this->IsInitialized());
+  predictor_.ComputeFaceNormals();
   // Expecting in_data in octahedral coordinates, i.e., portable attribute.
   DRACO_DCHECK_EQ(num_components, 2);
 
@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_GEOMETRIC_NORMAL_PREDICTOR_AREA_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_GEOMETRIC_NORMAL_PREDICTOR_AREA_H_
 
+#include <vector>
+
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_geometric_normal_predictor_base.h"
 
 namespace draco {
@@ -36,6 +38,64 @@ class MeshPredictionSchemeGeometricNormalPredictorArea
   };
   virtual ~MeshPredictionSchemeGeometricNormalPredictorArea() {}
 
+  // Computes normals of all faces of the corner table in a single pass. The
+  // normals are then reused by ComputePredictedValue() for all vertices of the
+  // faces, which results in the same predictions as computing the normals
+  // separately for each vertex. Must be called after the position attribute
+  // and the entry to point id map are set. The normals are used only in the
+  // TRIANGLE_AREA mode.
+  void ComputeFaceNormals() {
+    DRACO_DCHECK(this->IsInitialized());
+    if (this->normal_prediction_mode_ != TRIANGLE_AREA) {
+      face_normals_.clear();
+      return;
+    }
+    typedef typename MeshDataT::CornerTable CornerTable;
+    const CornerTable *const corner_table = this->mesh_data_.corner_table();
+    const std::vector<int32_t> &vertex_to_data_map =
+        *this->mesh_data_.vertex_to_data_map();
+
+    // Gather positions of all vertices first so that the face normals can be
+    // computed in a simple loop over the faces.
+    const int num_vertices = static_cast<int>(vertex_to_data_map.size());
+    std::vector<uint64_t> positions(3 * num_vertices, 0);
+    for (int v = 0; v < num_vertices; ++v) {
+      const int data_id = vertex_to_data_map[v];
+      if (data_id < 0) {
+        continue;
+      }
+      const VectorD<int64_t, 3> pos = this->GetPositionForDataId(data_id);
+      positions[3 * v] = static_cast<uint64_t>(pos[0]);
+      positions[3 * v + 1] = static_cast<uint64_t>(pos[1]);
+      positions[3 * v + 2] = static_cast<uint64_t>(pos[2]);
+    }
+
+    // The cross product of the two edges of a triangle is the same for all
+    // three corners of the triangle. The math is done as unsigned to prevent
+    // signed integer overflows.
+    const int num_faces = corner_table->num_faces();
+    face_normals_.assign(3 * num_faces, 0);
+    for (int f = 0; f < num_faces; ++f) {
+      const CornerIndex c(3 * f);
+      const VertexIndex v0 = corner_table->Vertex(c);
+      const VertexIndex v1 = corner_table->Vertex(c + 1);
+      const VertexIndex v2 = corner_table->Vertex(c + 2);
+      if (v0 == kInvalidVertexIndex || v1 == kInvalidVertexIndex ||
+          v2 == kInvalidVertexIndex) {
+        continue;
+      }
+      const uint64_t *const p0 = &positions[3 * v0.value()];
+      const uint64_t *const p1 = &positions[3 * v1.value()];
+      const uint64_t *const p2 = &positions[3 * v2.value()];
+      const uint64_t d1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      const uint64_t d2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      uint64_t *const normal = &face_normals_[3 * f];
+      normal[0] = d1[1] * d2[2] - d1[2] * d2[1];
+      normal[1] = d1[2] * d2[0] - d1[0] * d2[2];
+      normal[2] = d1[0] * d2[1] - d1[1] * d2[0];
+    }
+  }
+
   // Computes predicted octahedral coordinates on a given corner.
   void ComputePredictedValue(CornerIndex corner_id,
                              DataTypeT *prediction) override {
@@ -45,11 +105,27 @@ class MeshPredictionSchemeGeometricNormalPredictorArea
     // Going to compute the predicted normal from the surrounding triangles
     // according to the connectivity of the given corner table.
     VertexCornersIterator<CornerTable> cit(corner_table, corner_id);
+
+    VectorD<int64_t, 3> normal;
+    if (this->normal_prediction_mode_ == TRIANGLE_AREA &&
+        !face_normals_.empty()) {
+      // Adding up the precomputed normals of the surrounding triangles.
+      auto normal_data = reinterpret_cast<uint64_t *>(normal.data());
+      while (!cit.End()) {
+        const uint64_t *const face_normal =
+            &face_normals_[3 * corner_table->Face(cit.Corner()).value()];
+        normal_data[0] += face_normal[0];
+        normal_data[1] += face_normal[1];
+        normal_data[2] += face_normal[2];
+        cit.Next();
+      }
+      ConvertNormalToPrediction(&normal, prediction);
+      return;
+    }
+
     // Position of central vertex does not change in loop.
     const VectorD<int64_t, 3> pos_cent = this->GetPositionForCorner(corner_id);
     // Computing normals for triangles and adding them up.
-
-    VectorD<int64_t, 3> normal;
     CornerIndex c_next, c_prev;
     while (!cit.End()) {
       // Getting corners.
@@ -79,7 +155,24 @@ class MeshPredictionSchemeGeometricNormalPredictorArea
 
       cit.Next();
     }
+    ConvertNormalToPrediction(&normal, prediction);
+  }
+  bool SetNormalPredictionMode(NormalPredictionMode mode) override {
+    if (mode == ONE_TRIANGLE) {
+      this->normal_prediction_mode_ = mode;
+      return true;
+    } else if (mode == TRIANGLE_AREA) {
+      this->normal_prediction_mode_ = mode;
+      return true;
+    }
+    return false;
+  }
 
+ private:
+  // Converts the summed up |normal| to the predicted value.
+  void ConvertNormalToPrediction(VectorD<int64_t, 3> *normal_ptr,
+                                 DataTypeT *prediction) const {
+    VectorD<int64_t, 3> &normal = *normal_ptr;
     // Convert to int32_t, make sure entries are not too large.
     constexpr int64_t upper_bound = 1 << 29;
     if (this->normal_prediction_mode_ == ONE_TRIANGLE) {
@@ -100,16 +193,10 @@ class MeshPredictionSchemeGeometricNormalPredictorArea
     prediction[1] = static_cast<int32_t>(normal[1]);
     prediction[2] = static_cast<int32_t>(normal[2]);
   }
-  bool SetNormalPredictionMode(NormalPredictionMode mode) override {
-    if (mode == ONE_TRIANGLE) {
-      this->normal_prediction_mode_ = mode;
-      return true;
-    } else if (mode == TRIANGLE_AREA) {
-      this->normal_prediction_mode_ = mode;
-      return true;
-    }
-    return false;
-  }
+
+  // Normals of all faces computed by ComputeFaceNormals(), stored as unsigned
+  // values (see ComputePredictedValue()).
+  std::vector<uint64_t> face_normals_;
 };
 
 }  // namespace draco
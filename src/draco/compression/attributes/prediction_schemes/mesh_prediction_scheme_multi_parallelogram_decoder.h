@@ -63,37 +63,31 @@ bool MeshPredictionSchemeMultiParallelogramDecoder<DataTypeT, TransformT,
                           const PointIndex * /* entry_to_point_id_map */) {
   this->transform().Init(num_components);
 
-  // For storage of prediction values (already initialized to zero).
-  std::unique_ptr<DataTypeT[]> pred_vals(new DataTypeT[num_components]());
-  std::unique_ptr<DataTypeT[]> parallelogram_pred_vals(
-      new DataTypeT[num_components]());
-
-  this->transform().ComputeOriginalValue(pred_vals.get(), in_corr, out_data);
-
   const CornerTable *const table = this->mesh_data().corner_table();
   const std::vector<int32_t> *const vertex_to_data_map =
       this->mesh_data().vertex_to_data_map();
-
-  const int corner_map_size =
-      static_cast<int>(this->mesh_data().data_to_corner_map()->size());
+  const std::vector<CornerIndex> &data_to_corner_map =
+      *this->mesh_data().data_to_corner_map();
+  const int corner_map_size = static_cast<int>(data_to_corner_map.size());
+
+  // Gather the entries of all valid parallelograms around each vertex before
+  // any value is decoded. The parallelograms of entry |p| are stored in
+  // |src_entries| as triplets starting at index 3 * |first_src[p]|.
+  std::vector<int> first_src(corner_map_size + 1, 0);
+  std::vector<int> src_entries;
+  src_entries.reserve(3 * corner_map_size);
   for (int p = 1; p < corner_map_size; ++p) {
-    const CornerIndex start_corner_id =
-        this->mesh_data().data_to_corner_map()->at(p);
-
+    first_src[p] = static_cast<int>(src_entries.size() / 3);
+    const CornerIndex start_corner_id = data_to_corner_map[p];
     CornerIndex corner_id(start_corner_id);
-    int num_parallelograms = 0;
-    for (int i = 0; i < num_components; ++i) {
-      pred_vals[i] = static_cast<DataTypeT>(0);
-    }
     while (corner_id != kInvalidCornerIndex) {
-      if (ComputeParallelogramPrediction(
-              p, corner_id, table, *vertex_to_data_map, out_data,
-              num_components, parallelogram_pred_vals.get())) {
-        for (int c = 0; c < num_components; ++c) {
-          pred_vals[c] =
-              AddAsUnsigned(pred_vals[c], parallelogram_pred_vals[c]);
-        }
-        ++num_parallelograms;
+      int opp_entry, next_entry, prev_entry;
+      if (GetParallelogramPredictionEntries(p, corner_id, table,
+                                            *vertex_to_data_map, &opp_entry,
+                                            &next_entry, &prev_entry)) {
+        src_entries.push_back(opp_entry);
+        src_entries.push_back(next_entry);
+        src_entries.push_back(prev_entry);
       }
 
       // Proceed to the next corner attached to the vertex.
@@ -102,22 +96,48 @@ bool MeshPredictionSchemeMultiParallelogramDecoder<DataTypeT, TransformT,
         corner_id = kInvalidCornerIndex;
       }
     }
+  }
+  first_src[corner_map_size] = static_cast<int>(src_entries.size() / 3);
 
+  // For storage of prediction values (already initialized to zero).
+  std::unique_ptr<DataTypeT[]> pred_vals(new DataTypeT[num_components]());
+  std::unique_ptr<DataTypeT[]> parallelogram_pred_vals(
+      new DataTypeT[num_components]());
+
+  this->transform().ComputeOriginalValue(pred_vals.get(), in_corr, out_data);
+
+  for (int p = 1; p < corner_map_size; ++p) {
+    const int num_parallelograms = first_src[p + 1] - first_src[p];
     const int dst_offset = p * num_components;
     if (num_parallelograms == 0) {
       // No parallelogram was valid.
       // We use the last decoded point as a reference.
       const int src_offset = (p - 1) * num_components;
-      this->transform().ComputeOriginalValue(
-          out_data + src_offset, in_corr + dst_offset, out_data + dst_offset);
-    } else {
-      // Compute the correction from the predicted value.
+      this->transform().ComputeOriginalValue(out_data + src_offset,
+                                             in_corr + dst_offset,
+                                             out_data + dst_offset);
+      continue;
+    }
+    for (int i = 0; i < num_components; ++i) {
+      pred_vals[i] = static_cast<DataTypeT>(0);
+    }
+    for (int i = first_src[p]; i < first_src[p + 1]; ++i) {
+      const int *const src = &src_entries[3 * i];
+      ComputeParallelogramPrediction(out_data, src[0] * num_components,
+                                     src[1] * num_components,
+                                     src[2] * num_components, num_components,
+                                     parallelogram_pred_vals.get());
       for (int c = 0; c < num_components; ++c) {
-        pred_vals[c] /= num_parallelograms;
+        pred_vals[c] = AddAsUnsigned(pred_vals[c], parallelogram_pred_vals[c]);
       }
-      this->transform().ComputeOriginalValue(
-          pred_vals.get(), in_corr + dst_offset, out_data + dst_offset);
     }
+
+    // Compute the correction from the predicted value.
+    for (int c = 0; c < num_components; ++c) {
+      pred_vals[c] /= num_parallelograms;
+    }
+    this->transform().ComputeOriginalValue(
+        pred_vals.get(), in_corr + dst_offset, out_data + dst_offset);
   }
   return true;
 }
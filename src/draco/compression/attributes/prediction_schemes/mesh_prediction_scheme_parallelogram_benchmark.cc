@@ -0,0 +1,210 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmarks of the parallelogram prediction decoders on position-heavy
+// meshes. The prediction schemes are run directly on quantized positions
+// ordered by a depth-first traversal, so the timings do not include the
+// entropy decoding of the corrections.
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_data.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_multi_parallelogram_decoder.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_multi_parallelogram_encoder.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_decoder.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_encoder.h"
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_decoding_transform.h"
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_encoding_transform.h"
+#include "draco/compression/mesh/traverser/depth_first_traverser.h"
+#include "draco/core/cycle_timer.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/draco_features.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+namespace draco {
+
+namespace {
+
+typedef MeshPredictionSchemeData<CornerTable> MeshData;
+typedef PredictionSchemeWrapEncodingTransform<int32_t> EncodingTransform;
+typedef PredictionSchemeWrapDecodingTransform<int32_t> DecodingTransform;
+
+// Minimum number of decoded values for each benchmark. Small models are
+// decoded multiple times to reduce the timing noise.
+constexpr int kMinNumDecodedValues = 20000000;
+
+// Traversal observer that assigns attribute entries to vertices in the order
+// in which they are visited, like the mesh attribute encoders do.
+class EntryOrderObserver {
+ public:
+  EntryOrderObserver() : data_to_corner_map_(nullptr), vertex_to_data_map_() {}
+  EntryOrderObserver(std::vector<CornerIndex> *data_to_corner_map,
+                     std::vector<int32_t> *vertex_to_data_map)
+      : data_to_corner_map_(data_to_corner_map),
+        vertex_to_data_map_(vertex_to_data_map) {}
+  void OnNewFaceVisited(FaceIndex /* face */) {}
+  void OnNewVertexVisited(VertexIndex vert, CornerIndex corner) {
+    (*vertex_to_data_map_)[vert.value()] =
+        static_cast<int32_t>(data_to_corner_map_->size());
+    data_to_corner_map_->push_back(corner);
+  }
+
+ private:
+  std::vector<CornerIndex> *data_to_corner_map_;
+  std::vector<int32_t> *vertex_to_data_map_;
+};
+
+// Creates a height field mesh on a regular grid of |grid_size| x |grid_size|
+// vertices.
+std::unique_ptr<Mesh> CreateHeightFieldMesh(int grid_size) {
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  const int num_points = grid_size * grid_size;
+  mesh->set_num_points(num_points);
+  GeometryAttribute pos;
+  pos.Init(GeometryAttribute::POSITION, nullptr, 3, DT_FLOAT32, false,
+           sizeof(float) * 3, 0);
+  PointAttribute *const pos_att =
+      mesh->attribute(mesh->AddAttribute(pos, true, num_points));
+  for (int y = 0; y < grid_size; ++y) {
+    for (int x = 0; x < grid_size; ++x) {
+      const float height = std::sin(0.05f * x) * std::cos(0.07f * y);
+      const Vector3f value(static_cast<float>(x), static_cast<float>(y),
+                           10.f * height);
+      pos_att->SetAttributeValue(AttributeValueIndex(y * grid_size + x),
+                                 &value[0]);
+    }
+  }
+  for (int y = 0; y < grid_size - 1; ++y) {
+    for (int x = 0; x < grid_size - 1; ++x) {
+      const PointIndex p00(y * grid_size + x);
+      const PointIndex p10(y * grid_size + x + 1);
+      const PointIndex p01((y + 1) * grid_size + x);
+      const PointIndex p11((y + 1) * grid_size + x + 1);
+      mesh->AddFace({{p00, p10, p11}});
+      mesh->AddFace({{p00, p11, p01}});
+    }
+  }
+  return mesh;
+}
+
+template <class EncoderT, class DecoderT>
+void BenchmarkPredictionScheme(const std::string &name, const Mesh &mesh,
+                               const char *scheme_name) {
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  ASSERT_NE(pos_att, nullptr);
+  const std::unique_ptr<CornerTable> table =
+      CreateCornerTableFromPositionAttribute(&mesh);
+  ASSERT_NE(table, nullptr);
+
+  // Order the attribute entries by a depth-first traversal.
+  std::vector<CornerIndex> data_to_corner_map;
+  std::vector<int32_t> vertex_to_data_map(table->num_vertices(), -1);
+  DepthFirstTraverser<CornerTable, EntryOrderObserver> traverser;
+  traverser.Init(table.get(),
+                 EntryOrderObserver(&data_to_corner_map, &vertex_to_data_map));
+  traverser.OnTraversalStart();
+  for (FaceIndex f(0); f < table->num_faces(); ++f) {
+    traverser.TraverseFromCorner(table->FirstCorner(f));
+  }
+  traverser.OnTraversalEnd();
+  MeshData mesh_data;
+  mesh_data.Set(&mesh, table.get(), &data_to_corner_map, &vertex_to_data_map);
+
+  // Quantize the positions to 11 bits.
+  const int num_entries = static_cast<int>(data_to_corner_map.size());
+  const BoundingBox bbox = mesh.ComputeBoundingBox();
+  const Vector3f size = bbox.Size();
+  const float range = std::max(size[0], std::max(size[1], size[2]));
+  const float scale = range > 0.f ? 2047.f / range : 1.f;
+  std::vector<int32_t> values(3 * num_entries);
+  for (int i = 0; i < num_entries; ++i) {
+    const VertexIndex vert = table->Vertex(data_to_corner_map[i]);
+    const PointIndex point(table->VertexParent(vert).value());
+    Vector3f pos;
+    pos_att->GetMappedValue(point, &pos[0]);
+    for (int c = 0; c < 3; ++c) {
+      values[3 * i + c] = static_cast<int32_t>(
+          std::floor((pos[c] - bbox.GetMinPoint()[c]) * scale + 0.5f));
+    }
+  }
+
+  EncoderT encoder(pos_att, EncodingTransform(), mesh_data);
+  std::vector<int32_t> corrections(values.size());
+  ASSERT_TRUE(encoder.ComputeCorrectionValues(
+      values.data(), corrections.data(), static_cast<int>(values.size()), 3,
+      nullptr));
+  EncoderBuffer buffer;
+  ASSERT_TRUE(encoder.EncodePredictionData(&buffer));
+
+  DecoderT decoder(pos_att, DecodingTransform(), mesh_data);
+  DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(buffer.data(), buffer.size());
+  ASSERT_TRUE(decoder.DecodePredictionData(&decoder_buffer));
+
+  const int num_repetitions = std::max(
+      1, kMinNumDecodedValues / static_cast<int>(values.size()));
+  std::vector<int32_t> decoded_values(values.size());
+  CycleTimer timer;
+  timer.Start();
+  for (int i = 0; i < num_repetitions; ++i) {
+    ASSERT_TRUE(decoder.ComputeOriginalValues(
+        corrections.data(), decoded_values.data(),
+        static_cast<int>(values.size()), 3, nullptr));
+  }
+  timer.Stop();
+  ASSERT_EQ(decoded_values, values);
+  const int64_t time_ms = timer.GetInMs();
+  const double num_values = static_cast<double>(num_entries) * num_repetitions;
+  printf("  %-18s %-22s %6" PRId64 " ms (%.2f Mvalues/s)\n", name.c_str(),
+         scheme_name, time_ms,
+         time_ms > 0 ? num_values / (1000.0 * time_ms) : 0.0);
+}
+
+void BenchmarkMesh(const std::string &name, const Mesh &mesh) {
+  BenchmarkPredictionScheme<
+      MeshPredictionSchemeParallelogramEncoder<int32_t, EncodingTransform,
+                                               MeshData>,
+      MeshPredictionSchemeParallelogramDecoder<int32_t, DecodingTransform,
+                                               MeshData>>(name, mesh,
+                                                          "parallelogram");
+#ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
+  BenchmarkPredictionScheme<
+      MeshPredictionSchemeMultiParallelogramEncoder<int32_t, EncodingTransform,
+                                                    MeshData>,
+      MeshPredictionSchemeMultiParallelogramDecoder<int32_t, DecodingTransform,
+                                                    MeshData>>(
+      name, mesh, "multi-parallelogram");
+#endif
+}
+
+}  // namespace
+
+TEST(MeshPredictionSchemeParallelogramBenchmark, Decode) {
+  printf("Parallelogram prediction decoding throughput\n");
+  for (const std::string file_name : {"bun_zipper.ply", "bunny_norm.obj"}) {
+    const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    BenchmarkMesh(file_name, *mesh);
+  }
+  const std::unique_ptr<Mesh> grid = CreateHeightFieldMesh(1000);
+  BenchmarkMesh("height field 1000", *grid);
+}
+
+}  // namespace draco
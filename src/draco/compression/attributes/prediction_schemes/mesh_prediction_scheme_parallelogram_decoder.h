@@ -63,6 +63,23 @@ bool MeshPredictionSchemeParallelogramDecoder<DataTypeT, TransformT,
   const CornerTable *const table = this->mesh_data().corner_table();
   const std::vector<int32_t> *const vertex_to_data_map =
       this->mesh_data().vertex_to_data_map();
+  const std::vector<CornerIndex> &data_to_corner_map =
+      *this->mesh_data().data_to_corner_map();
+  const int corner_map_size = static_cast<int>(data_to_corner_map.size());
+
+  // The entries used by each prediction depend only on the connectivity, so
+  // they are gathered before any value is decoded. Entries that cannot be
+  // predicted by a parallelogram use the previous entry for all three
+  // sources, which is equal to the delta coding: (a + a) - a = a.
+  std::vector<int> src_entries(3 * corner_map_size);
+  for (int p = 1; p < corner_map_size; ++p) {
+    int *const src = &src_entries[3 * p];
+    if (!GetParallelogramPredictionEntries(p, data_to_corner_map[p], table,
+                                           *vertex_to_data_map, &src[0],
+                                           &src[1], &src[2])) {
+      src[0] = src[1] = src[2] = p - 1;
+    }
+  }
 
   // For storage of prediction values (already initialized to zero).
   std::unique_ptr<DataTypeT[]> pred_vals(new DataTypeT[num_components]());
@@ -70,25 +87,15 @@ bool MeshPredictionSchemeParallelogramDecoder<DataTypeT, TransformT,
   // Restore the first value.
   this->transform().ComputeOriginalValue(pred_vals.get(), in_corr, out_data);
 
-  const int corner_map_size =
-      static_cast<int>(this->mesh_data().data_to_corner_map()->size());
   for (int p = 1; p < corner_map_size; ++p) {
-    const CornerIndex corner_id = this->mesh_data().data_to_corner_map()->at(p);
+    const int *const src = &src_entries[3 * p];
+    ComputeParallelogramPrediction(out_data, src[0] * num_components,
+                                   src[1] * num_components,
+                                   src[2] * num_components, num_components,
+                                   pred_vals.get());
     const int dst_offset = p * num_components;
-    if (!ComputeParallelogramPrediction(p, corner_id, table,
-                                        *vertex_to_data_map, out_data,
-                                        num_components, pred_vals.get())) {
-      // Parallelogram could not be computed, Possible because some of the
-      // vertices are not valid (not encoded yet).
-      // We use the last encoded point as a reference (delta coding).
-      const int src_offset = (p - 1) * num_components;
-      this->transform().ComputeOriginalValue(
-          out_data + src_offset, in_corr + dst_offset, out_data + dst_offset);
-    } else {
-      // Apply the parallelogram prediction.
-      this->transform().ComputeOriginalValue(
-          pred_vals.get(), in_corr + dst_offset, out_data + dst_offset);
-    }
+    this->transform().ComputeOriginalValue(
+        pred_vals.get(), in_corr + dst_offset, out_data + dst_offset);
   }
   return true;
 }
@@ -37,6 +37,44 @@ inline void GetParallelogramEntries(
   *prev_entry = vertex_to_data_map[table->Vertex(table->Previous(ci)).value()];
 }
 
+// Gets the data entries of the parallelogram that can be used to predict the
+// value at corner |ci| with data entry id |data_entry_id|. Returns false when
+// the parallelogram doesn't exist or when not all of its entries precede
+// |data_entry_id|. The result depends only on the connectivity, so it can be
+// computed before any attribute value is decoded.
+template <class CornerTableT>
+inline bool GetParallelogramPredictionEntries(
+    int data_entry_id, const CornerIndex ci, const CornerTableT *table,
+    const std::vector<int32_t> &vertex_to_data_map, int *opp_entry,
+    int *next_entry, int *prev_entry) {
+  const CornerIndex oci = table->Opposite(ci);
+  if (oci == kInvalidCornerIndex) {
+    return false;
+  }
+  GetParallelogramEntries<CornerTableT>(oci, table, vertex_to_data_map,
+                                        opp_entry, next_entry, prev_entry);
+  return *opp_entry < data_entry_id && *next_entry < data_entry_id &&
+         *prev_entry < data_entry_id;
+}
+
+// Computes the parallelogram prediction from the values stored at offsets
+// |opp_off|, |next_off| and |prev_off| of |in_data|.
+template <typename DataTypeT>
+inline void ComputeParallelogramPrediction(const DataTypeT *in_data,
+                                           int opp_off, int next_off,
+                                           int prev_off, int num_components,
+                                           DataTypeT *out_prediction) {
+  for (int c = 0; c < num_components; ++c) {
+    const int64_t in_data_next_off = in_data[next_off + c];
+    const int64_t in_data_prev_off = in_data[prev_off + c];
+    const int64_t in_data_opp_off = in_data[opp_off + c];
+    const int64_t result =
+        (in_data_next_off + in_data_prev_off) - in_data_opp_off;
+
+    out_prediction[c] = static_cast<DataTypeT>(result);
+  }
+}
+
 // Computes parallelogram prediction for a given corner and data entry id.
 // The prediction is stored in |out_prediction|.
 // Function returns false when the prediction couldn't be computed, e.g. because
@@ -46,28 +84,16 @@ inline bool ComputeParallelogramPrediction(
     int data_entry_id, const CornerIndex ci, const CornerTableT *table,
     const std::vector<int32_t> &vertex_to_data_map, const DataTypeT *in_data,
     int num_components, DataTypeT *out_prediction) {
-  const CornerIndex oci = table->Opposite(ci);
-  if (oci == kInvalidCornerIndex) {
-    return false;
-  }
   int vert_opp, vert_next, vert_prev;
-  GetParallelogramEntries<CornerTableT>(oci, table, vertex_to_data_map,
-                                        &vert_opp, &vert_next, &vert_prev);
-  if (vert_opp < data_entry_id && vert_next < data_entry_id &&
-      vert_prev < data_entry_id) {
+  if (GetParallelogramPredictionEntries<CornerTableT>(
+          data_entry_id, ci, table, vertex_to_data_map, &vert_opp, &vert_next,
+          &vert_prev)) {
     // Apply the parallelogram prediction.
     const int v_opp_off = vert_opp * num_components;
     const int v_next_off = vert_next * num_components;
     const int v_prev_off = vert_prev * num_components;
-    for (int c = 0; c < num_components; ++c) {
-      const int64_t in_data_next_off = in_data[v_next_off + c];
-      const int64_t in_data_prev_off = in_data[v_prev_off + c];
-      const int64_t in_data_opp_off = in_data[v_opp_off + c];
-      const int64_t result =
-          (in_data_next_off + in_data_prev_off) - in_data_opp_off;
-
-      out_prediction[c] = static_cast<DataTypeT>(result);
-    }
+    ComputeParallelogramPrediction(in_data, v_opp_off, v_next_off, v_prev_off,
+                                   num_components, out_prediction);
     return true;
   }
   return false;  // Not all data is available for prediction
@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_WRAP_DECODING_TRANSFORM_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_PREDICTION_SCHEME_WRAP_DECODING_TRANSFORM_H_
 
+#include <algorithm>
+
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_transform_base.h"
 #include "draco/core/decoder_buffer.h"
 
@@ -33,6 +35,8 @@ class PredictionSchemeWrapDecodingTransform
 
   // Computes the original value from the input predicted value and the decoded
   // corrections. Values out of the bounds of the input values are unwrapped.
+  // The predicted values are clamped and wrapped without branches so that the
+  // loop can be vectorized by the compiler.
   inline void ComputeOriginalValue(const DataTypeT *predicted_vals,
                                    const CorrTypeT *corr_vals,
                                    DataTypeT *out_original_vals) const {
@@ -44,22 +48,22 @@ class PredictionSchemeWrapDecodingTransform
     static_assert(std::is_same<DataTypeT, int32_t>::value,
                   "Only int32_t is supported for predicted values.");
 
-    predicted_vals = this->ClampPredictedValue(predicted_vals);
-
-    // Perform the wrapping using unsigned coordinates to avoid potential signed
-    // integer overflows caused by malformed input.
-    const uint32_t *const uint_predicted_vals =
-        reinterpret_cast<const uint32_t *>(predicted_vals);
-    const uint32_t *const uint_corr_vals =
-        reinterpret_cast<const uint32_t *>(corr_vals);
+    const DataTypeT min_value = this->min_value();
+    const DataTypeT max_value = this->max_value();
+    const uint32_t max_dif = static_cast<uint32_t>(this->max_dif());
     for (int i = 0; i < this->num_components(); ++i) {
-      out_original_vals[i] =
-          static_cast<DataTypeT>(uint_predicted_vals[i] + uint_corr_vals[i]);
-      if (out_original_vals[i] > this->max_value()) {
-        out_original_vals[i] -= this->max_dif();
-      } else if (out_original_vals[i] < this->min_value()) {
-        out_original_vals[i] += this->max_dif();
-      }
+      const DataTypeT clamped_val =
+          std::min(std::max(predicted_vals[i], min_value), max_value);
+      // Perform the wrapping using unsigned coordinates to avoid potential
+      // signed integer overflows caused by malformed input.
+      const uint32_t val = static_cast<uint32_t>(clamped_val) +
+                           static_cast<uint32_t>(corr_vals[i]);
+      const DataTypeT signed_val = static_cast<DataTypeT>(val);
+      const uint32_t wrapped_val =
+          signed_val > max_value
+              ? val - max_dif
+              : (signed_val < min_value ? val + max_dif : val);
+      out_original_vals[i] = static_cast<DataTypeT>(wrapped_val);
     }
   }
 
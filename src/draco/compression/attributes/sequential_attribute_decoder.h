@@ -72,6 +72,12 @@ class SequentialAttributeDecoder {
 
   PointAttribute *portable_attribute() { return portable_attribute_.get(); }
 
+  // Returns the pool that can be used to revert the attribute transform in
+  // parallel, or nullptr when the transform runs on the calling thread.
+  ThreadPool *thread_pool() const {
+    return decoder_ ? decoder_->thread_pool() : nullptr;
+  }
+
  private:
   PointCloudDecoder *decoder_;
   PointAttribute *attribute_;
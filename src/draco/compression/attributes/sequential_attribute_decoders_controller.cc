@@ -13,11 +13,15 @@
 // limitations under the License.
 //
 #include "draco/compression/attributes/sequential_attribute_decoders_controller.h"
+
+#include <algorithm>
+
 #ifdef DRACO_NORMAL_ENCODING_SUPPORTED
 #include "draco/compression/attributes/sequential_normal_attribute_decoder.h"
 #endif
 #include "draco/compression/attributes/sequential_quantization_attribute_decoder.h"
 #include "draco/compression/config/compression_shared.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
@@ -83,6 +87,10 @@ bool SequentialAttributeDecodersController::
     DecodeDataNeededByPortableTransforms(DecoderBuffer *in_buffer) {
   const int32_t num_attributes = GetNumAttributes();
   for (int i = 0; i < num_attributes; ++i) {
+    AttributeCodingStats *const att_stats =
+        GetDecoder()->attribute_stats(GetAttributeId(i));
+    ScopedStageStats transform_stats(
+        att_stats ? &att_stats->transform : nullptr, in_buffer);
     if (!sequential_decoders_[i]->DecodeDataNeededByPortableTransform(
             point_ids_, in_buffer)) {
       return false;
@@ -94,33 +102,53 @@ bool SequentialAttributeDecodersController::
 bool SequentialAttributeDecodersController::
     TransformAttributesToOriginalFormat() {
   const int32_t num_attributes = GetNumAttributes();
-  for (int i = 0; i < num_attributes; ++i) {
-    // Check whether the attribute transform should be skipped.
-    if (GetDecoder()->options()) {
-      const PointAttribute *const attribute =
-          sequential_decoders_[i]->attribute();
-      const PointAttribute *const portable_attribute =
-          sequential_decoders_[i]->GetPortableAttribute();
-      if (portable_attribute &&
-          GetDecoder()->options()->GetAttributeBool(
-              attribute->attribute_type(), "skip_attribute_transform", false)) {
-        // Attribute transform should not be performed. In this case, we replace
-        // the output geometry attribute with the portable attribute.
-        // TODO(ostava): We can potentially avoid this copy by introducing a new
-        // mechanism that would allow to use the final attributes as portable
-        // attributes for predictors that may need them.
-        sequential_decoders_[i]->attribute()->CopyFrom(*portable_attribute);
-        continue;
+  ThreadPool *const pool = GetDecoder()->thread_pool();
+  if (pool != nullptr) {
+    // The transforms of individual attributes are independent of each other.
+    std::vector<uint8_t> success(num_attributes, 0);
+    pool->ParallelFor(num_attributes, 1, [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        success[i] = TransformAttributeToOriginalFormat(i);
       }
-    }
-    if (!sequential_decoders_[i]->TransformAttributeToOriginalFormat(
-            point_ids_)) {
+    });
+    return std::find(success.begin(), success.end(), 0) == success.end();
+  }
+  for (int i = 0; i < num_attributes; ++i) {
+    if (!TransformAttributeToOriginalFormat(i)) {
       return false;
     }
   }
   return true;
 }
 
+bool SequentialAttributeDecodersController::TransformAttributeToOriginalFormat(
+    int i) {
+  AttributeCodingStats *const att_stats =
+      GetDecoder()->attribute_stats(GetAttributeId(i));
+  ScopedStageStats transform_stats(att_stats ? &att_stats->transform
+                                             : nullptr);
+  // Check whether the attribute transform should be skipped.
+  if (GetDecoder()->options()) {
+    const PointAttribute *const attribute =
+        sequential_decoders_[i]->attribute();
+    const PointAttribute *const portable_attribute =
+        sequential_decoders_[i]->GetPortableAttribute();
+    if (portable_attribute &&
+        GetDecoder()->options()->GetAttributeBool(
+            attribute->attribute_type(), "skip_attribute_transform", false)) {
+      // Attribute transform should not be performed. In this case, we replace
+      // the output geometry attribute with the portable attribute.
+      // TODO(ostava): We can potentially avoid this copy by introducing a new
+      // mechanism that would allow to use the final attributes as portable
+      // attributes for predictors that may need them.
+      sequential_decoders_[i]->attribute()->CopyFrom(*portable_attribute);
+      return true;
+    }
+  }
+  return sequential_decoders_[i]->TransformAttributeToOriginalFormat(
+      point_ids_);
+}
+
 std::unique_ptr<SequentialAttributeDecoder>
 SequentialAttributeDecodersController::CreateSequentialDecoder(
     uint8_t decoder_type) {
@@ -27,6 +27,10 @@ namespace draco {
 // AttributeIndexedValuesDecoder for each of the decoded attribute, where the
 // type of the values decoder is determined by the unique identifier that was
 // encoded by the encoder.
+//
+// When the "num_attribute_decoding_threads" decoder option is set, the
+// attribute transforms are reverted after all attribute data is decoded, in
+// parallel across the attributes (see PointCloudDecoder::thread_pool()).
 class SequentialAttributeDecodersController : public AttributesDecoder {
  public:
   explicit SequentialAttributeDecodersController(
@@ -51,6 +55,9 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
       uint8_t decoder_type);
 
  private:
+  // Reverts the transform of the |i|-th attribute.
+  bool TransformAttributeToOriginalFormat(int i);
+
   std::vector<std::unique_ptr<SequentialAttributeDecoder>> sequential_decoders_;
   std::vector<PointIndex> point_ids_;
   std::unique_ptr<PointsSequencer> sequencer_;
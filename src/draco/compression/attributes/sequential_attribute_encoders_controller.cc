@@ -13,21 +13,27 @@
 // limitations under the License.
 //
 #include "draco/compression/attributes/sequential_attribute_encoders_controller.h"
+
+#include <algorithm>
+
 #ifdef DRACO_NORMAL_ENCODING_SUPPORTED
 #include "draco/compression/attributes/sequential_normal_attribute_encoder.h"
 #endif
 #include "draco/compression/attributes/sequential_quantization_attribute_encoder.h"
 #include "draco/compression/point_cloud/point_cloud_encoder.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
 SequentialAttributeEncodersController::SequentialAttributeEncodersController(
     std::unique_ptr<PointsSequencer> sequencer)
-    : sequencer_(std::move(sequencer)) {}
+    : sequencer_(std::move(sequencer)), thread_pool_(nullptr) {}
 
 SequentialAttributeEncodersController::SequentialAttributeEncodersController(
     std::unique_ptr<PointsSequencer> sequencer, int point_attrib_id)
-    : AttributesEncoder(point_attrib_id), sequencer_(std::move(sequencer)) {}
+    : AttributesEncoder(point_attrib_id),
+      sequencer_(std::move(sequencer)),
+      thread_pool_(nullptr) {}
 
 bool SequentialAttributeEncodersController::Init(PointCloudEncoder *encoder,
                                                  const PointCloud *pc) {
@@ -64,27 +70,97 @@ bool SequentialAttributeEncodersController::EncodeAttributes(
   if (!sequencer_ || !sequencer_->GenerateSequence(&point_ids_)) {
     return false;
   }
-  return AttributesEncoder::EncodeAttributes(buffer);
+  const int num_threads = GetNumEncodingThreads();
+  if (num_threads == 0) {
+    return AttributesEncoder::EncodeAttributes(buffer);
+  }
+  // The calling thread takes part in the work as well.
+  ThreadPool pool(num_threads);
+  thread_pool_ = &pool;
+  const bool success = AttributesEncoder::EncodeAttributes(buffer);
+  thread_pool_ = nullptr;
+  return success;
+}
+
+int SequentialAttributeEncodersController::GetNumEncodingThreads() const {
+  const int num_encoders = static_cast<int>(sequential_encoders_.size());
+  if (encoder() == nullptr || num_encoders < 2) {
+    return 0;
+  }
+  int num_threads = encoder()->options()->GetGlobalInt(
+      "num_attribute_encoding_threads", 0);
+  if (num_threads < 0) {
+    num_threads = ThreadPool::HardwareConcurrency() - 1;
+  }
+  return std::min(num_threads, num_encoders - 1);
 }
 
 bool SequentialAttributeEncodersController::
     TransformAttributesToPortableFormat() {
+  if (thread_pool_ != nullptr) {
+    // The transforms of individual attributes are independent of each other.
+    const int num_encoders = static_cast<int>(sequential_encoders_.size());
+    std::vector<uint8_t> success(num_encoders, 0);
+    thread_pool_->ParallelFor(num_encoders, 1, [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        success[i] = TransformAttributeToPortableFormat(i);
+      }
+    });
+    return std::find(success.begin(), success.end(), 0) == success.end();
+  }
   for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
-    if (!sequential_encoders_[i]->TransformAttributeToPortableFormat(
-            point_ids_)) {
+    if (!TransformAttributeToPortableFormat(i)) {
       return false;
     }
   }
   return true;
 }
 
+bool SequentialAttributeEncodersController::TransformAttributeToPortableFormat(
+    int i) {
+  AttributeCodingStats *const att_stats =
+      encoder()->attribute_stats(GetAttributeId(i));
+  ScopedStageStats transform_stats(att_stats ? &att_stats->transform
+                                             : nullptr);
+  return sequential_encoders_[i]->TransformAttributeToPortableFormat(
+      point_ids_);
+}
+
 bool SequentialAttributeEncodersController::EncodePortableAttributes(
     EncoderBuffer *out_buffer) {
+  if (thread_pool_ != nullptr) {
+    // All portable attributes (including the parent attributes used by the
+    // prediction schemes) are ready at this point, so the attributes can be
+    // encoded independently into separate buffers.
+    const int num_encoders = static_cast<int>(sequential_encoders_.size());
+    std::vector<EncoderBuffer> buffers(num_encoders);
+    std::vector<uint8_t> success(num_encoders, 0);
+    thread_pool_->ParallelFor(num_encoders, 1, [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        success[i] = sequential_encoders_[i]->EncodePortableAttribute(
+            point_ids_, &buffers[i]);
+      }
+    });
+    for (int i = 0; i < num_encoders; ++i) {
+      if (!success[i]) {
+        return false;
+      }
+      out_buffer->Encode(buffers[i].data(), buffers[i].size());
+      if (!out_buffer->Flush()) {
+        return false;
+      }
+    }
+    return true;
+  }
   for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
     if (!sequential_encoders_[i]->EncodePortableAttribute(point_ids_,
                                                           out_buffer)) {
       return false;
     }
+    // The encoded attribute is complete and it can be passed to the output.
+    if (!out_buffer->Flush()) {
+      return false;
+    }
   }
   return true;
 }
@@ -92,6 +168,10 @@ bool SequentialAttributeEncodersController::EncodePortableAttributes(
 bool SequentialAttributeEncodersController::
     EncodeDataNeededByPortableTransforms(EncoderBuffer *out_buffer) {
   for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
+    AttributeCodingStats *const att_stats =
+        encoder()->attribute_stats(GetAttributeId(i));
+    ScopedStageStats transform_stats(
+        att_stats ? &att_stats->transform : nullptr, out_buffer);
     if (!sequential_encoders_[i]->EncodeDataNeededByPortableTransform(
             out_buffer)) {
       return false;
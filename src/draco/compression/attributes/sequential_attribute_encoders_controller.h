@@ -21,6 +21,8 @@
 
 namespace draco {
 
+class ThreadPool;
+
 // A basic implementation of an attribute encoder that can be used to encode
 // an arbitrary set of attributes. The encoder creates a sequential attribute
 // encoder for each encoded attribute (see sequential_attribute_encoder.h) and
@@ -28,6 +30,11 @@ namespace draco {
 // generated in the GeneratePointSequence() method. The default implementation
 // generates a linear sequence of all points, but derived classes can generate
 // any custom sequence.
+//
+// When the "num_attribute_encoding_threads" encoder option is set, the
+// attributes are transformed and encoded in parallel, each into a separate
+// buffer. The buffers are then concatenated in the order of the attributes so
+// the output is identical to the serial encoding.
 class SequentialAttributeEncodersController : public AttributesEncoder {
  public:
   explicit SequentialAttributeEncodersController(
@@ -101,6 +108,12 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
       int i);
 
  private:
+  // Returns the number of worker threads used for encoding of the attributes.
+  int GetNumEncodingThreads() const;
+
+  // Transforms the i-th attribute to its portable format.
+  bool TransformAttributeToPortableFormat(int i);
+
   std::vector<std::unique_ptr<SequentialAttributeEncoder>> sequential_encoders_;
 
   // Flag for each sequential attribute encoder indicating whether it was marked
@@ -108,6 +121,10 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
   std::vector<bool> sequential_encoder_marked_as_parent_;
   std::vector<PointIndex> point_ids_;
   std::unique_ptr<PointsSequencer> sequencer_;
+
+  // Pool used for parallel encoding of the attributes. Set only during
+  // EncodeAttributes() and only when multiple threads are used.
+  ThreadPool *thread_pool_;
 };
 
 }  // namespace draco
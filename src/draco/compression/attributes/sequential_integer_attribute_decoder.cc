@@ -17,6 +17,7 @@
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_decoder_factory.h"
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_decoding_transform.h"
 #include "draco/compression/entropy/symbol_decoding.h"
+#include "draco/core/quantization_utils.h"
 
 namespace draco {
 
@@ -116,6 +117,10 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
   if (portable_attribute_data == nullptr) {
     return false;
   }
+  AttributeCodingStats *const att_stats =
+      decoder() ? decoder()->attribute_stats(attribute_id()) : nullptr;
+  ScopedStageStats entropy_stats(att_stats ? &att_stats->entropy : nullptr,
+                                 in_buffer);
   uint8_t compressed;
   if (!in_buffer->Decode(&compressed)) {
     return false;
@@ -167,9 +172,12 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
         reinterpret_cast<const uint32_t *>(portable_attribute_data),
         static_cast<int>(num_values), portable_attribute_data);
   }
+  entropy_stats.Stop();
 
   // If the data was encoded with a prediction scheme, we must revert it.
   if (prediction_scheme_) {
+    ScopedStageStats prediction_stats(
+        att_stats ? &att_stats->prediction : nullptr, in_buffer);
     if (!prediction_scheme_->DecodePredictionData(in_buffer)) {
       return false;
     }
@@ -185,6 +193,27 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
   return true;
 }
 
+DataType SequentialIntegerAttributeDecoder::GetOutputDataType() const {
+  if (decoder() == nullptr || decoder()->options() == nullptr) {
+    return DT_FLOAT32;
+  }
+  return static_cast<DataType>(decoder()->options()->GetAttributeInt(
+      attribute()->attribute_type(), "output_data_type", DT_FLOAT32));
+}
+
+bool SequentialIntegerAttributeDecoder::SetOutputFormat(DataType data_type,
+                                                        int num_components) {
+  if (!IsFloatStorageDataTypeSupported(data_type)) {
+    return false;
+  }
+  PointAttribute *const att = attribute();
+  const size_t num_values = att->size();
+  att->GeometryAttribute::Init(att->attribute_type(), nullptr, num_components,
+                               data_type, IsDataTypeIntegral(data_type),
+                               DataTypeLength(data_type) * num_components, 0);
+  return att->Reset(num_values);
+}
+
 bool SequentialIntegerAttributeDecoder::StoreValues(uint32_t num_values) {
   switch (attribute()->data_type()) {
     case DT_UINT8:
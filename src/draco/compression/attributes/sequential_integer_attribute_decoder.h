@@ -54,6 +54,16 @@ class SequentialIntegerAttributeDecoder : public SequentialAttributeDecoder {
 
   void PreparePortableAttribute(int num_entries, int num_components);
 
+  // Returns the data type of the decoded floating point attribute values set
+  // by the "output_data_type" decoder option. Default: DT_FLOAT32.
+  DataType GetOutputDataType() const;
+
+  // Changes the data type and the number of components of the decoded
+  // attribute. Must be called before the decoded values are stored. Integer
+  // data types are marked as normalized. Returns false when the |data_type|
+  // cannot be used to store floating point values.
+  bool SetOutputFormat(DataType data_type, int num_components);
+
   int32_t *GetPortableAttributeData() {
     if (portable_attribute()->size() == 0) {
       return nullptr;
@@ -135,9 +135,14 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
   // process all encoded data in a separate array.
   std::vector<int32_t> encoded_data(num_values);
 
+  AttributeCodingStats *const att_stats =
+      encoder() ? encoder()->attribute_stats(attribute_id()) : nullptr;
+
   // All integer values are initialized. Process them using the prediction
   // scheme if we have one.
   if (prediction_scheme_) {
+    ScopedStageStats prediction_stats(
+        att_stats ? &att_stats->prediction : nullptr, out_buffer);
     if (!prediction_scheme_->ComputeCorrectionValues(
             portable_attribute_data, &encoded_data[0], num_values,
             num_components, point_ids.data())) {
@@ -145,6 +150,8 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     }
   }
 
+  ScopedStageStats entropy_stats(att_stats ? &att_stats->entropy : nullptr,
+                                 out_buffer);
   if (prediction_scheme_ == nullptr ||
       !prediction_scheme_->AreCorrectionsPositive()) {
     const int32_t *const input =
@@ -158,14 +165,35 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     out_buffer->Encode(static_cast<uint8_t>(1));
     Options symbol_encoding_options;
     if (encoder() != nullptr) {
-      SetSymbolEncodingCompressionLevel(&symbol_encoding_options,
-                                        10 - encoder()->options()->GetSpeed());
+      // The compression level can be overridden for each attribute, otherwise
+      // it is derived from the encoding speed.
+      SetSymbolEncodingCompressionLevel(
+          &symbol_encoding_options,
+          encoder()->options()->GetAttributeInt(
+              attribute_id(), "symbol_encoding_compression_level",
+              10 - encoder()->options()->GetSpeed()));
+      SetSymbolEncodingContextModeling(
+          &symbol_encoding_options,
+          encoder()->options()->GetAttributeBool(
+              attribute_id(), "symbol_encoding_context_modeling", false));
+      SetSymbolEncodingEntropySampling(
+          &symbol_encoding_options,
+          encoder()->options()->GetAttributeBool(
+              attribute_id(), "symbol_encoding_entropy_sampling", false));
     }
+    const size_t symbol_coding_method_offset = out_buffer->size();
     if (!EncodeSymbols(reinterpret_cast<uint32_t *>(encoded_data.data()),
                        static_cast<int>(point_ids.size()) * num_components,
                        num_components, &symbol_encoding_options, out_buffer)) {
       return false;
     }
+    // The encoded symbols start with the selected coding method.
+    if (encoder() != nullptr &&
+        out_buffer->size() > symbol_coding_method_offset &&
+        out_buffer->data()[symbol_coding_method_offset] ==
+            SYMBOL_CODING_CONTEXT) {
+      encoder()->SetUsesContextSymbolCoding();
+    }
   } else {
     // No compression. Just store the raw integer values, using the number of
     // bytes as needed.
@@ -193,7 +221,10 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
       }
     }
   }
+  entropy_stats.Stop();
   if (prediction_scheme_) {
+    ScopedStageStats prediction_stats(
+        att_stats ? &att_stats->prediction : nullptr, out_buffer);
     prediction_scheme_->EncodePredictionData(out_buffer);
   }
   return true;
@@ -68,9 +68,19 @@ bool SequentialNormalAttributeDecoder::DecodeDataNeededByPortableTransform(
 }
 
 bool SequentialNormalAttributeDecoder::StoreValues(uint32_t num_points) {
-  // Convert all quantized values back to floats.
+  const DataType output_data_type = GetOutputDataType();
+  const bool octahedral_output =
+      decoder() != nullptr && decoder()->options() != nullptr &&
+      decoder()->options()->GetAttributeBool(attribute()->attribute_type(),
+                                             "octahedral_output", false);
+  if (output_data_type != DT_FLOAT32 || octahedral_output) {
+    if (!SetOutputFormat(output_data_type, octahedral_output ? 2 : 3)) {
+      return false;
+    }
+  }
+  // Convert all quantized values back to floats (or the requested format).
   return octahedral_transform_.InverseTransformAttribute(
-      *GetPortableAttribute(), attribute());
+      *GetPortableAttribute(), attribute(), thread_pool());
 }
 
 }  // namespace draco
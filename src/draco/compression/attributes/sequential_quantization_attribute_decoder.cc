@@ -80,9 +80,14 @@ bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo() {
 
 bool SequentialQuantizationAttributeDecoder::DequantizeValues(
     uint32_t num_values) {
-  // Convert all quantized values back to floats.
+  const DataType output_data_type = GetOutputDataType();
+  if (output_data_type != DT_FLOAT32 &&
+      !SetOutputFormat(output_data_type, attribute()->num_components())) {
+    return false;
+  }
+  // Convert all quantized values back to floats (or the requested format).
   return quantization_transform_.InverseTransformAttribute(
-      *GetPortableAttribute(), attribute());
+      *GetPortableAttribute(), attribute(), thread_pool());
 }
 
 }  // namespace draco
@@ -0,0 +1,105 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/batch_decoder.h"
+
+#include <utility>
+
+namespace draco {
+
+namespace {
+
+// Returns the number of worker threads used for |num_threads| requested by
+// the user.
+int GetNumWorkerThreads(int num_threads) {
+  if (num_threads < 0) {
+    return ThreadPool::HardwareConcurrency() - 1;
+  }
+  return num_threads;
+}
+
+// Builds the output of a batch from decoded geometries and statuses.
+template <typename GeometryT>
+std::vector<StatusOr<std::unique_ptr<GeometryT>>> BuildBatchResults(
+    std::vector<std::unique_ptr<GeometryT>> *geometries,
+    const std::vector<Status> &statuses) {
+  std::vector<StatusOr<std::unique_ptr<GeometryT>>> results;
+  results.reserve(geometries->size());
+  for (size_t i = 0; i < geometries->size(); ++i) {
+    if (statuses[i].ok()) {
+      results.emplace_back(std::move((*geometries)[i]));
+    } else {
+      results.emplace_back(statuses[i]);
+    }
+  }
+  return results;
+}
+
+}  // namespace
+
+BatchDecoder::BatchDecoder(int num_threads)
+    : pool_(GetNumWorkerThreads(num_threads)),
+      decoders_(pool_.num_threads() + 1) {
+  for (Decoder &decoder : decoders_) {
+    decoder.SetReuseDecoderState(true);
+  }
+}
+
+template <typename DecodeFunctionT>
+void BatchDecoder::DecodeBatch(const std::vector<DecoderBuffer> &buffers,
+                               const DecodeFunctionT &decode_function) {
+  for (Decoder &decoder : decoders_) {
+    *decoder.options() = options_;
+  }
+  const int num_buffers = static_cast<int>(buffers.size());
+  pool_.ParallelFor(num_buffers, 1, [&](int begin, int end) {
+    // No other thread uses this decoder until the chunk is done.
+    Decoder *const decoder = &decoders_[pool_.CurrentThreadIndex()];
+    for (int i = begin; i < end; ++i) {
+      // Decoding modifies the position of the buffer so we use a copy. Note
+      // that no data is copied in this step.
+      DecoderBuffer buffer(buffers[i]);
+      decode_function(decoder, &buffer, i);
+    }
+  });
+}
+
+std::vector<StatusOr<std::unique_ptr<Mesh>>> BatchDecoder::DecodeMeshes(
+    const std::vector<DecoderBuffer> &buffers) {
+  std::vector<std::unique_ptr<Mesh>> meshes(buffers.size());
+  std::vector<Status> statuses(buffers.size());
+  DecodeBatch(buffers, [&](Decoder *decoder, DecoderBuffer *buffer, int i) {
+    std::unique_ptr<Mesh> mesh(new Mesh());
+    statuses[i] = decoder->DecodeBufferToGeometry(buffer, mesh.get());
+    meshes[i] = std::move(mesh);
+  });
+  return BuildBatchResults(&meshes, statuses);
+}
+
+std::vector<StatusOr<std::unique_ptr<PointCloud>>>
+BatchDecoder::DecodePointClouds(const std::vector<DecoderBuffer> &buffers) {
+  std::vector<std::unique_ptr<PointCloud>> point_clouds(buffers.size());
+  std::vector<Status> statuses(buffers.size());
+  DecodeBatch(buffers, [&](Decoder *decoder, DecoderBuffer *buffer, int i) {
+    StatusOr<std::unique_ptr<PointCloud>> statusor =
+        decoder->DecodePointCloudFromBuffer(buffer);
+    statuses[i] = statusor.status();
+    if (statusor.ok()) {
+      point_clouds[i] = std::move(statusor).value();
+    }
+  });
+  return BuildBatchResults(&point_clouds, statuses);
+}
+
+}  // namespace draco
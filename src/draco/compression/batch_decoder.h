@@ -0,0 +1,87 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_BATCH_DECODER_H_
+#define DRACO_COMPRESSION_BATCH_DECODER_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/config/decoder_options.h"
+#include "draco/compression/decode.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status_or.h"
+#include "draco/core/thread_pool.h"
+#include "draco/draco_features.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Class for decoding large batches of independent Draco buffers in parallel.
+// The buffers are distributed among the threads of a work-stealing ThreadPool
+// that is owned by the batch decoder and reused for all batches. Buffers are
+// claimed by the threads using an atomic counter and each decoded geometry is
+// written to its own slot of the output, so no locks are taken while
+// decoding. Each buffer is decoded independently with the same options, as
+// if it was decoded with Decoder on its own.
+//
+// Every thread of the pool owns one Decoder for the life of the batch decoder
+// (see Decoder::SetReuseDecoderState()). The internal geometry decoders and
+// their buffers, such as the corner table, the traversal data and the
+// attribute encoding data of Edgebreaker meshes, are reset between buffers
+// instead of being allocated for each of them. For this reason a batch
+// decoder must not be used by multiple threads at the same time.
+class BatchDecoder {
+ public:
+  // Creates a batch decoder that uses |num_threads| worker threads in
+  // addition to the calling thread. When |num_threads| is negative, the number
+  // of threads is derived from the hardware concurrency.
+  explicit BatchDecoder(int num_threads);
+
+  // Decodes all meshes stored in |buffers|. The i-th entry of the returned
+  // vector corresponds to the i-th input buffer and contains either the
+  // decoded mesh or the status describing the decoding error. The data
+  // referenced by |buffers| must remain valid during the call.
+  std::vector<StatusOr<std::unique_ptr<Mesh>>> DecodeMeshes(
+      const std::vector<DecoderBuffer> &buffers);
+
+  // Same as above but for point clouds. Buffers containing meshes are decoded
+  // as meshes and can be down-casted to Mesh.
+  std::vector<StatusOr<std::unique_ptr<PointCloud>>> DecodePointClouds(
+      const std::vector<DecoderBuffer> &buffers);
+
+  // Returns the options that are used for decoding all buffers. The options
+  // must not be modified while a batch is being decoded.
+  DecoderOptions *options() { return &options_; }
+
+  int num_threads() const { return pool_.num_threads(); }
+
+ private:
+  // Decodes all |buffers| using |decode_function| that is called with a
+  // decoder, the input buffer and the index of the buffer.
+  template <typename DecodeFunctionT>
+  void DecodeBatch(const std::vector<DecoderBuffer> &buffers,
+                   const DecodeFunctionT &decode_function);
+
+  DecoderOptions options_;
+  ThreadPool pool_;
+
+  // Decoder of each thread of |pool_| indexed by
+  // ThreadPool::CurrentThreadIndex().
+  std::vector<Decoder> decoders_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_BATCH_DECODER_H_
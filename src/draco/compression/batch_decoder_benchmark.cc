@@ -0,0 +1,95 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmarks of decoding many small Draco buffers using the BatchDecoder and
+// a simple loop over the regular Decoder.
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "draco/compression/batch_decoder.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/cycle_timer.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/thread_pool.h"
+
+namespace draco {
+
+namespace {
+
+// Number of buffers decoded by each benchmark.
+constexpr int kNumBuffers = 20000;
+
+void PrintThroughput(const std::string &name, int64_t time_ms) {
+  printf("  %-28s %6" PRId64 " ms (%.0f buffers/s)\n", name.c_str(), time_ms,
+         time_ms > 0 ? 1000.0 * kNumBuffers / time_ms : 0.0);
+}
+
+}  // namespace
+
+TEST(BatchDecoderBenchmark, SmallMeshes) {
+  std::vector<std::vector<char>> encoded_data;
+  for (const std::string file_name :
+       {"cube_att.obj", "test_nm.obj", "octagon.obj"}) {
+    std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    Encoder encoder;
+    EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+    encoded_data.push_back(
+        std::vector<char>(buffer.data(), buffer.data() + buffer.size()));
+  }
+  std::vector<DecoderBuffer> buffers(kNumBuffers);
+  for (int i = 0; i < kNumBuffers; ++i) {
+    const std::vector<char> &data = encoded_data[i % encoded_data.size()];
+    buffers[i].Init(data.data(), data.size());
+  }
+  printf("Decoding %d small meshes\n", kNumBuffers);
+
+  // Both benchmarks keep all decoded meshes alive until the batch is done.
+  CycleTimer timer;
+  timer.Start();
+  std::vector<std::unique_ptr<Mesh>> meshes(kNumBuffers);
+  for (int i = 0; i < kNumBuffers; ++i) {
+    DecoderBuffer buffer(buffers[i]);
+    Decoder decoder;
+    StatusOr<std::unique_ptr<Mesh>> statusor =
+        decoder.DecodeMeshFromBuffer(&buffer);
+    ASSERT_TRUE(statusor.ok());
+    meshes[i] = std::move(statusor).value();
+  }
+  timer.Stop();
+  meshes.clear();
+  PrintThroughput("Decoder loop", timer.GetInMs());
+
+  const int max_num_threads = ThreadPool::HardwareConcurrency() - 1;
+  for (int num_threads = 0; num_threads <= max_num_threads;
+       num_threads = num_threads == 0 ? 1 : 2 * num_threads) {
+    BatchDecoder batch_decoder(num_threads);
+    timer.Start();
+    const std::vector<StatusOr<std::unique_ptr<Mesh>>> results =
+        batch_decoder.DecodeMeshes(buffers);
+    timer.Stop();
+    ASSERT_EQ(results.size(), buffers.size());
+    PrintThroughput(
+        "BatchDecoder " + std::to_string(num_threads) + " worker threads",
+        timer.GetInMs());
+  }
+}
+
+}  // namespace draco
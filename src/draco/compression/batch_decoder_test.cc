@@ -0,0 +1,129 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/batch_decoder.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/mesh/mesh_are_equivalent.h"
+
+namespace draco {
+
+class BatchDecoderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Encode a few meshes with different encoding methods.
+    const std::vector<std::string> file_names = {"cube_att.obj", "test_nm.obj",
+                                                 "bun_zipper.ply"};
+    for (const std::string &file_name : file_names) {
+      std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+      ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+      for (const int speed : {0, 10}) {
+        Encoder encoder;
+        encoder.SetSpeedOptions(speed, speed);
+        encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 11);
+        EncoderBuffer buffer;
+        DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+        encoded_data_.push_back(std::vector<char>(
+            buffer.data(), buffer.data() + buffer.size()));
+      }
+    }
+  }
+
+  // Returns |num_buffers| decoder buffers cycling through the encoded data.
+  std::vector<DecoderBuffer> CreateBuffers(int num_buffers) const {
+    std::vector<DecoderBuffer> buffers(num_buffers);
+    for (int i = 0; i < num_buffers; ++i) {
+      const std::vector<char> &data = encoded_data_[i % encoded_data_.size()];
+      buffers[i].Init(data.data(), data.size());
+    }
+    return buffers;
+  }
+
+  // Decodes |buffer| using the regular decoder.
+  static std::unique_ptr<Mesh> DecodeMesh(DecoderBuffer buffer) {
+    Decoder decoder;
+    return decoder.DecodeMeshFromBuffer(&buffer).value();
+  }
+
+  std::vector<std::vector<char>> encoded_data_;
+};
+
+TEST_F(BatchDecoderTest, TestDecodeMeshes) {
+  // Tests that the batch decoder returns the same meshes as the regular
+  // decoder in the order of the input buffers.
+  const std::vector<DecoderBuffer> buffers = CreateBuffers(24);
+  for (const int num_threads : {0, 1, 4}) {
+    BatchDecoder batch_decoder(num_threads);
+    std::vector<StatusOr<std::unique_ptr<Mesh>>> results =
+        batch_decoder.DecodeMeshes(buffers);
+    ASSERT_EQ(results.size(), buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      DRACO_ASSERT_OK(results[i].status());
+      const std::unique_ptr<Mesh> expected_mesh = DecodeMesh(buffers[i]);
+      ASSERT_NE(expected_mesh, nullptr);
+      MeshAreEquivalent equiv;
+      ASSERT_TRUE(equiv(*expected_mesh, *results[i].value()))
+          << "Mismatch at buffer " << i << " with " << num_threads
+          << " threads.";
+    }
+  }
+}
+
+TEST_F(BatchDecoderTest, TestInvalidBuffers) {
+  // Tests that errors are reported for individual buffers without affecting
+  // the rest of the batch.
+  std::vector<DecoderBuffer> buffers = CreateBuffers(10);
+  const char invalid_data[] = "DRACO invalid data";
+  buffers[3].Init(invalid_data, sizeof(invalid_data));
+  buffers[7].Init(invalid_data, 2);
+  BatchDecoder batch_decoder(2);
+  std::vector<StatusOr<std::unique_ptr<Mesh>>> results =
+      batch_decoder.DecodeMeshes(buffers);
+  ASSERT_EQ(results.size(), buffers.size());
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    if (i == 3 || i == 7) {
+      ASSERT_FALSE(results[i].ok());
+    } else {
+      DRACO_ASSERT_OK(results[i].status());
+      ASSERT_NE(results[i].value(), nullptr);
+    }
+  }
+}
+
+TEST_F(BatchDecoderTest, TestDecoderOptions) {
+  // Tests that the options of the batch decoder are used for all buffers.
+  const std::vector<DecoderBuffer> buffers = CreateBuffers(6);
+  BatchDecoder batch_decoder(2);
+  batch_decoder.options()->SetAttributeBool(GeometryAttribute::POSITION,
+                                            "skip_attribute_transform", true);
+  std::vector<StatusOr<std::unique_ptr<PointCloud>>> results =
+      batch_decoder.DecodePointClouds(buffers);
+  ASSERT_EQ(results.size(), buffers.size());
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    DRACO_ASSERT_OK(results[i].status());
+    const PointAttribute *const pos_att =
+        results[i].value()->GetNamedAttribute(GeometryAttribute::POSITION);
+    ASSERT_NE(pos_att, nullptr);
+    ASSERT_EQ(pos_att->data_type(), DT_INT32);
+  }
+}
+
+}  // namespace draco
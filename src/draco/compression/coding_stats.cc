@@ -0,0 +1,74 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/coding_stats.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+namespace draco {
+
+namespace {
+
+// Appends a single row of the stats table to |out|.
+void AppendStageRow(const char *name, const CodingStageStats &stage,
+                    std::string *out) {
+  char row[128];
+  snprintf(row, sizeof(row), "%-24s %12.3f %14" PRId64 "\n", name,
+           stage.time_ns / 1e6, stage.num_bytes);
+  out->append(row);
+}
+
+}  // namespace
+
+void CodingStats::Clear() {
+  header = CodingStageStats();
+  metadata = CodingStageStats();
+  connectivity = CodingStageStats();
+  attribute_data = CodingStageStats();
+  total = CodingStageStats();
+  attributes.clear();
+}
+
+void CodingStats::InitAttributes(const PointCloud &pc) {
+  attributes.assign(pc.num_attributes(), AttributeCodingStats());
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    attributes[i].attribute_id = i;
+    attributes[i].attribute_type = pc.attribute(i)->attribute_type();
+  }
+}
+
+std::string CodingStats::ToString() const {
+  std::string out;
+  char row[128];
+  snprintf(row, sizeof(row), "%-24s %12s %14s\n", "Stage", "Time (ms)",
+           "Bytes");
+  out.append(row);
+  AppendStageRow("header", header, &out);
+  AppendStageRow("metadata", metadata, &out);
+  AppendStageRow("connectivity", connectivity, &out);
+  AppendStageRow("attributes", attribute_data, &out);
+  for (const AttributeCodingStats &att : attributes) {
+    snprintf(row, sizeof(row), "  attribute %d (%s)\n", att.attribute_id,
+             GeometryAttribute::TypeToString(att.attribute_type).c_str());
+    out.append(row);
+    AppendStageRow("    transform", att.transform, &out);
+    AppendStageRow("    prediction", att.prediction, &out);
+    AppendStageRow("    entropy", att.entropy, &out);
+  }
+  AppendStageRow("total", total, &out);
+  return out;
+}
+
+}  // namespace draco
@@ -0,0 +1,182 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_CODING_STATS_H_
+#define DRACO_COMPRESSION_CODING_STATS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "draco/attributes/geometry_attribute.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/draco_features.h"
+#include "draco/point_cloud/point_cloud.h"
+
+#ifdef DRACO_INSTRUMENTATION_SUPPORTED
+#include <chrono>
+#endif
+
+namespace draco {
+
+// Time and data size of a single encoding or decoding stage.
+struct CodingStageStats {
+  CodingStageStats() : time_ns(0), num_bytes(0) {}
+
+  // Time spent in the stage in nanoseconds.
+  int64_t time_ns;
+  // Number of bytes written by the encoder or read by the decoder.
+  int64_t num_bytes;
+};
+
+// Stats of the stages of a single encoded attribute. Available only for
+// attributes encoded with the sequential attribute encoders.
+struct AttributeCodingStats {
+  AttributeCodingStats()
+      : attribute_id(-1), attribute_type(GeometryAttribute::INVALID) {}
+
+  int attribute_id;
+  GeometryAttribute::Type attribute_type;
+
+  // Attribute transform such as quantization, including the transform data.
+  CodingStageStats transform;
+  // Prediction scheme, including the prediction data.
+  CodingStageStats prediction;
+  // Entropy coding of the attribute values (or raw values without compression).
+  CodingStageStats entropy;
+};
+
+// Time and data size of the stages of the last encoding or decoding
+// operation, see Decoder::stats() and EncoderBase::stats(). The stats are
+// collected only when Draco is built with the DRACO_INSTRUMENTATION CMake
+// option. Otherwise, all the instrumentation compiles to no-ops and the stats
+// stay empty.
+struct CodingStats {
+  // Returns true when the stats are collected by the library.
+  static constexpr bool IsSupported() {
+#ifdef DRACO_INSTRUMENTATION_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void Clear();
+
+  // Creates the stats for all attributes of |pc|. Must be called before any
+  // attribute is processed, the stats of individual attributes can then be
+  // updated from multiple threads.
+  void InitAttributes(const PointCloud &pc);
+
+  // Returns stats of attribute |att_id| or nullptr if the id is not valid.
+  AttributeCodingStats *attribute(int att_id) {
+    if (att_id < 0 || att_id >= static_cast<int>(attributes.size())) {
+      return nullptr;
+    }
+    return &attributes[att_id];
+  }
+
+  // Returns a human readable table with all stats.
+  std::string ToString() const;
+
+  CodingStageStats header;
+  CodingStageStats metadata;
+  // Connectivity of meshes or any other geometry data such as the number of
+  // points of point clouds.
+  CodingStageStats connectivity;
+  // All attribute data including the data of the attribute coders.
+  CodingStageStats attribute_data;
+  CodingStageStats total;
+  std::vector<AttributeCodingStats> attributes;
+};
+
+// Adds the time spent in the scope of the instance to |stage|, and when
+// a buffer is provided also the number of bytes encoded into or decoded from
+// the buffer. Does nothing when |stage| is nullptr.
+#ifdef DRACO_INSTRUMENTATION_SUPPORTED
+class ScopedStageStats {
+ public:
+  explicit ScopedStageStats(CodingStageStats *stage)
+      : ScopedStageStats(stage, nullptr, nullptr) {}
+  ScopedStageStats(CodingStageStats *stage, const DecoderBuffer *buffer)
+      : ScopedStageStats(stage, buffer, nullptr) {}
+  ScopedStageStats(CodingStageStats *stage, const EncoderBuffer *buffer)
+      : ScopedStageStats(stage, nullptr, buffer) {}
+
+  ~ScopedStageStats() { Stop(); }
+
+  // Records the stats before the end of the scope. Any subsequent calls have
+  // no effect.
+  void Stop() {
+    if (stage_ == nullptr) {
+      return;
+    }
+    stage_->time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start_time_)
+                           .count();
+    stage_->num_bytes += GetBufferPosition() - start_position_;
+    stage_ = nullptr;
+  }
+
+ private:
+  ScopedStageStats(CodingStageStats *stage, const DecoderBuffer *dec_buffer,
+                   const EncoderBuffer *enc_buffer)
+      : stage_(stage),
+        dec_buffer_(dec_buffer),
+        enc_buffer_(enc_buffer),
+        start_position_(0) {
+    if (stage_ != nullptr) {
+      start_position_ = GetBufferPosition();
+      start_time_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  // Returns the position of the buffer. Decoder buffers are measured by their
+  // data head rather than by DecoderBuffer::decoded_size() because decoders
+  // may re-initialize the buffer to a later part of the same data (e.g., the
+  // edgebreaker decoder after it reads the traversal data).
+  int64_t GetBufferPosition() const {
+    if (dec_buffer_ != nullptr) {
+      return static_cast<int64_t>(
+          reinterpret_cast<uintptr_t>(dec_buffer_->data_head()));
+    }
+    if (enc_buffer_ != nullptr) {
+      return static_cast<int64_t>(enc_buffer_->num_flushed_bytes() +
+                                  enc_buffer_->size());
+    }
+    return 0;
+  }
+
+  CodingStageStats *stage_;
+  const DecoderBuffer *const dec_buffer_;
+  const EncoderBuffer *const enc_buffer_;
+  int64_t start_position_;
+  std::chrono::steady_clock::time_point start_time_;
+};
+#else
+class ScopedStageStats {
+ public:
+  explicit ScopedStageStats(CodingStageStats * /* stage */) {}
+  ScopedStageStats(CodingStageStats * /* stage */,
+                   const DecoderBuffer * /* buffer */) {}
+  ScopedStageStats(CodingStageStats * /* stage */,
+                   const EncoderBuffer * /* buffer */) {}
+  void Stop() {}
+};
+#endif  // DRACO_INSTRUMENTATION_SUPPORTED
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_CODING_STATS_H_
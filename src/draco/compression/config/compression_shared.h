@@ -24,9 +24,9 @@ namespace draco {
 
 // Latest Draco bit-stream version.
 static constexpr uint8_t kDracoPointCloudBitstreamVersionMajor = 2;
-static constexpr uint8_t kDracoPointCloudBitstreamVersionMinor = 3;
+static constexpr uint8_t kDracoPointCloudBitstreamVersionMinor = 4;
 static constexpr uint8_t kDracoMeshBitstreamVersionMajor = 2;
-static constexpr uint8_t kDracoMeshBitstreamVersionMinor = 2;
+static constexpr uint8_t kDracoMeshBitstreamVersionMinor = 3;
 
 // Concatenated latest bit-stream version.
 static constexpr uint16_t kDracoPointCloudBitstreamVersion =
@@ -36,6 +36,12 @@ static constexpr uint16_t kDracoPointCloudBitstreamVersion =
 static constexpr uint16_t kDracoMeshBitstreamVersion = DRACO_BITSTREAM_VERSION(
     kDracoMeshBitstreamVersionMajor, kDracoMeshBitstreamVersionMinor);
 
+// Minor bit-stream versions written by the encoder unless the encoded data
+// uses a feature of the latest version (currently only SYMBOL_CODING_CONTEXT).
+// This keeps the output of the default settings decodable by older decoders.
+static constexpr uint8_t kDracoPointCloudDefaultBitstreamVersionMinor = 3;
+static constexpr uint8_t kDracoMeshDefaultBitstreamVersionMinor = 2;
+
 // Currently, we support point cloud and triangular mesh encoding.
 // TODO(draco-eng) Convert enum to enum class (safety, not performance).
 enum EncodedGeometryType {
@@ -144,6 +150,12 @@ enum NormalPredictionMode {
 enum SymbolCodingMethod {
   SYMBOL_CODING_TAGGED = 0,
   SYMBOL_CODING_RAW = 1,
+  // Raw symbols coded with separate probability tables for different contexts
+  // (see symbol_coding_contexts.h). Introduced in mesh bitstream version 2.3
+  // and point cloud bitstream version 2.4. It is used only when requested by
+  // the encoder options, and only encoded data that uses it is written with
+  // these versions.
+  SYMBOL_CODING_CONTEXT = 2,
   NUM_SYMBOL_CODING_METHODS,
 };
 
@@ -15,10 +15,12 @@
 #include "draco/compression/decode.h"
 
 #include "draco/compression/config/compression_shared.h"
+#include "draco/compression/mesh/mesh_decoder.h"
 
 #ifdef DRACO_MESH_COMPRESSION_SUPPORTED
 #include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
 #include "draco/compression/mesh/mesh_sequential_decoder.h"
+#include "draco/mesh/mesh_reorderer.h"
 #endif
 
 #ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
@@ -52,6 +54,28 @@ StatusOr<std::unique_ptr<MeshDecoder>> CreateMeshDecoder(uint8_t method) {
 }
 #endif
 
+Decoder::Decoder() {}
+
+Decoder::~Decoder() {}
+
+Decoder::Decoder(const Decoder &other)
+    : options_(other.options_),
+      stats_(other.stats_),
+      thread_pool_(other.thread_pool_),
+      reuse_decoder_state_(other.reuse_decoder_state_) {}
+
+Decoder &Decoder::operator=(const Decoder &other) {
+  if (this != &other) {
+    options_ = other.options_;
+    stats_ = other.stats_;
+    thread_pool_ = other.thread_pool_;
+    reuse_decoder_state_ = other.reuse_decoder_state_;
+    point_cloud_decoders_.clear();
+    mesh_decoders_.clear();
+  }
+  return *this;
+}
+
 StatusOr<EncodedGeometryType> Decoder::GetEncodedGeometryType(
     DecoderBuffer *in_buffer) {
   DecoderBuffer temp_buffer(*in_buffer);
@@ -99,10 +123,25 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
   if (header.encoder_type != POINT_CLOUD) {
     return Status(Status::DRACO_ERROR, "Input is not a point cloud.");
   }
-  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloudDecoder> decoder,
-                         CreatePointCloudDecoder(header.encoder_method))
+  const uint8_t method = header.encoder_method;
+  std::unique_ptr<PointCloudDecoder> decoder;
+  if (reuse_decoder_state_ && method < point_cloud_decoders_.size()) {
+    decoder = std::move(point_cloud_decoders_[method]);
+  }
+  if (decoder == nullptr) {
+    DRACO_ASSIGN_OR_RETURN(decoder, CreatePointCloudDecoder(method))
+  }
 
+  stats_.Clear();
+  decoder->set_stats(&stats_);
+  decoder->set_attribute_decoding_thread_pool(thread_pool_);
   DRACO_RETURN_IF_ERROR(decoder->Decode(options_, in_buffer, out_geometry))
+  if (reuse_decoder_state_) {
+    if (method >= point_cloud_decoders_.size()) {
+      point_cloud_decoders_.resize(method + 1);
+    }
+    point_cloud_decoders_[method] = std::move(decoder);
+  }
   return OkStatus();
 #else
   return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
@@ -118,10 +157,29 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
   if (header.encoder_type != TRIANGULAR_MESH) {
     return Status(Status::DRACO_ERROR, "Input is not a mesh.");
   }
-  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<MeshDecoder> decoder,
-                         CreateMeshDecoder(header.encoder_method))
+  const uint8_t method = header.encoder_method;
+  std::unique_ptr<MeshDecoder> decoder;
+  if (reuse_decoder_state_ && method < mesh_decoders_.size()) {
+    decoder = std::move(mesh_decoders_[method]);
+  }
+  if (decoder == nullptr) {
+    DRACO_ASSIGN_OR_RETURN(decoder, CreateMeshDecoder(method))
+  }
 
+  stats_.Clear();
+  decoder->set_stats(&stats_);
+  decoder->set_attribute_decoding_thread_pool(thread_pool_);
   DRACO_RETURN_IF_ERROR(decoder->Decode(options_, in_buffer, out_geometry))
+  if (reuse_decoder_state_) {
+    if (method >= mesh_decoders_.size()) {
+      mesh_decoders_.resize(method + 1);
+    }
+    mesh_decoders_[method] = std::move(decoder);
+  }
+  if (options_.GetGlobalBool("optimize_vertex_cache", false)) {
+    DRACO_RETURN_IF_ERROR(
+        MeshReorderer::Reorder(out_geometry, MeshReordererOptions()))
+  }
   return OkStatus();
 #else
   return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
@@ -132,4 +190,33 @@ void Decoder::SetSkipAttributeTransform(GeometryAttribute::Type att_type) {
   options_.SetAttributeBool(att_type, "skip_attribute_transform", true);
 }
 
+void Decoder::SetAttributeOutputDataType(GeometryAttribute::Type att_type,
+                                         DataType data_type) {
+  options_.SetAttributeInt(att_type, "output_data_type", data_type);
+}
+
+void Decoder::SetOctahedralOutput(GeometryAttribute::Type att_type) {
+  options_.SetAttributeBool(att_type, "octahedral_output", true);
+}
+
+void Decoder::SetOptimizeVertexCache(bool enabled) {
+  options_.SetGlobalBool("optimize_vertex_cache", enabled);
+}
+
+void Decoder::SetNumAttributeDecodingThreads(int num_threads) {
+  options_.SetGlobalInt("num_attribute_decoding_threads", num_threads);
+}
+
+void Decoder::SetAttributeDecodingThreadPool(ThreadPool *pool) {
+  thread_pool_ = pool;
+}
+
+void Decoder::SetReuseDecoderState(bool enabled) {
+  reuse_decoder_state_ = enabled;
+  if (!enabled) {
+    point_cloud_decoders_.clear();
+    mesh_decoders_.clear();
+  }
+}
+
 }  // namespace draco
@@ -15,6 +15,10 @@
 #ifndef DRACO_COMPRESSION_DECODE_H_
 #define DRACO_COMPRESSION_DECODE_H_
 
+#include <memory>
+#include <vector>
+
+#include "draco/compression/coding_stats.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
 #include "draco/core/decoder_buffer.h"
@@ -24,10 +28,22 @@
 
 namespace draco {
 
+class MeshDecoder;
+class PointCloudDecoder;
+class ThreadPool;
+
 // Class responsible for decoding of meshes and point clouds that were
 // compressed by a Draco encoder.
 class Decoder {
  public:
+  Decoder();
+  ~Decoder();
+
+  // Copies the settings of |other|. Decoder state kept for reuse (see
+  // SetReuseDecoderState()) is not copied.
+  Decoder(const Decoder &other);
+  Decoder &operator=(const Decoder &other);
+
   // Returns the geometry type encoded in the input |in_buffer|.
   // The return value is one of POINT_CLOUD, MESH or INVALID_GEOMETRY in case
   // the input data is invalid.
@@ -67,12 +83,72 @@ class Decoder {
   // transform manually.
   void SetSkipAttributeTransform(GeometryAttribute::Type att_type);
 
+  // Sets the data type of decoded quantized attributes (including normals
+  // encoded with the octahedral transform) of a given attribute type. Instead
+  // of 32-bit floats, the values can be dequantized directly into DT_FLOAT16
+  // or into normalized integers DT_INT8, DT_INT16 (SNORM) or DT_UINT8,
+  // DT_UINT16 (UNORM). Decoding fails when the quantized values of an
+  // attribute are not within the normalized range of the integer type
+  // ([-1, 1] for SNORM, [0, 1] for UNORM), e.g. for positions outside of a
+  // unit cube or normals decoded into UNORM types.
+  // Attributes that are not quantized keep their original data type. Note that
+  // geometry with DT_FLOAT16 attributes can't be encoded again.
+  void SetAttributeOutputDataType(GeometryAttribute::Type att_type,
+                                  DataType data_type);
+
+  // When set, normals of a given attribute type that were encoded with the
+  // octahedral transform are decoded into two z-up octahedral coordinates in
+  // range [-1, 1] (see UnitVectorToZUpOctahedralCoords()) instead of three
+  // component unit vectors. The coordinates use the data type set by
+  // SetAttributeOutputDataType(), e.g. DT_INT16 for SNORM16 octahedral normals.
+  void SetOctahedralOutput(GeometryAttribute::Type att_type);
+
+  // When enabled, faces and points of decoded meshes are reordered for better
+  // GPU vertex cache utilization using the MeshReorderer. This changes the
+  // order of faces and points produced by the decoder. Disabled by default.
+  void SetOptimizeVertexCache(bool enabled);
+
+  // Sets the number of worker threads used to revert attribute transforms
+  // such as dequantization after the attribute data is decoded. The
+  // transforms run in parallel across attributes and across ranges of
+  // attribute values. The decoded geometry is identical to the
+  // single-threaded decoding. Negative values use all available hardware
+  // threads. Default: [0] (no worker threads).
+  void SetNumAttributeDecodingThreads(int num_threads);
+
+  // Sets a caller-owned |pool| that is used to revert the attribute transforms
+  // instead of creating worker threads for each decoded geometry. When set,
+  // the number of threads set by SetNumAttributeDecodingThreads() is ignored.
+  // In both cases geometry with few points is decoded on the calling thread
+  // only. The |pool| must outlive all decoding calls. Default: nullptr.
+  void SetAttributeDecodingThreadPool(ThreadPool *pool);
+
+  // When enabled, the internal decoders are kept after a successful decoding
+  // and reused for the next geometry encoded with the same method, together
+  // with their buffers such as the corner table of Edgebreaker meshes. This
+  // avoids most allocations when many small geometries are decoded one after
+  // another, at the cost of holding on to the memory needed by the largest
+  // decoded geometry. The state is dropped when decoding fails. Default: false.
+  void SetReuseDecoderState(bool enabled);
+
   // Returns the options instance used by the decoder that can be used by users
   // to control the decoding process.
   DecoderOptions *options() { return &options_; }
 
+  // Returns the time and data size of the individual stages of the last
+  // decoding operation. Collected only when Draco is built with the
+  // DRACO_INSTRUMENTATION CMake option, see CodingStats.
+  const CodingStats &stats() const { return stats_; }
+
  private:
   DecoderOptions options_;
+  CodingStats stats_;
+  ThreadPool *thread_pool_ = nullptr;
+  bool reuse_decoder_state_ = false;
+
+  // Decoders kept for reuse indexed by the encoding method.
+  std::vector<std::unique_ptr<PointCloudDecoder>> point_cloud_decoders_;
+  std::vector<std::unique_ptr<MeshDecoder>> mesh_decoders_;
 };
 
 }  // namespace draco
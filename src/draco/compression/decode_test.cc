@@ -14,12 +14,15 @@
 //
 #include "draco/compression/decode.h"
 
+#include <array>
 #include <cinttypes>
 #include <sstream>
 
 #include "draco/compression/encode.h"
+#include "draco/core/bounding_box.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
+#include "draco/core/thread_pool.h"
 #include "draco/io/file_utils.h"
 #include "draco/io/obj_encoder.h"
 
@@ -242,4 +245,353 @@ TEST_F(DecodeTest, TestSkipAttributeTransformUniqueId) {
             << std::endl;
 }
 
+// Returns the data of all attributes of |pc| concatenated in a single vector.
+std::vector<uint8_t> GetAllAttributeData(const draco::PointCloud &pc) {
+  std::vector<uint8_t> data;
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const draco::DataBuffer *const buffer = pc.attribute(i)->buffer();
+    data.insert(data.end(), buffer->data(),
+                buffer->data() + buffer->data_size());
+  }
+  return data;
+}
+
+TEST_F(DecodeTest, TestParallelAttributeDecoding) {
+  // Tests that reverting attribute transforms on multiple threads results in
+  // the same geometry as the single-threaded decoding.
+  const auto mesh = draco::ReadMeshFromTestFile("bunny_norm.obj");
+  ASSERT_NE(mesh, nullptr);
+  std::vector<std::vector<char>> encoded_files;
+  for (const int method :
+       {draco::MESH_SEQUENTIAL_ENCODING, draco::MESH_EDGEBREAKER_ENCODING}) {
+    draco::Encoder encoder;
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+    encoder.SetEncodingMethod(method);
+    draco::EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+    encoded_files.push_back(
+        std::vector<char>(buffer.data(), buffer.data() + buffer.size()));
+  }
+  for (const std::string file_name : {"car.drc", "pc_kd_color.drc"}) {
+    std::vector<char> data;
+    ASSERT_TRUE(
+        draco::ReadFileToBuffer(draco::GetTestFileFullPath(file_name), &data));
+    encoded_files.push_back(data);
+  }
+
+  for (const std::vector<char> &file : encoded_files) {
+    for (const bool skip_transform : {false, true}) {
+      std::vector<uint8_t> reference;
+      for (const int num_threads : {0, 2, -1}) {
+        draco::DecoderBuffer buffer;
+        buffer.Init(file.data(), file.size());
+        draco::Decoder decoder;
+        if (skip_transform) {
+          decoder.SetSkipAttributeTransform(draco::GeometryAttribute::NORMAL);
+        }
+        decoder.SetNumAttributeDecodingThreads(num_threads);
+        DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::PointCloud> pc,
+                               decoder.DecodePointCloudFromBuffer(&buffer));
+        const std::vector<uint8_t> data = GetAllAttributeData(*pc);
+        if (num_threads == 0) {
+          reference = data;
+        } else {
+          ASSERT_EQ(data, reference);
+        }
+      }
+
+      // Decode the same data on a caller-owned pool shared by the decoders.
+      draco::ThreadPool pool(2);
+      for (int i = 0; i < 2; ++i) {
+        draco::DecoderBuffer buffer;
+        buffer.Init(file.data(), file.size());
+        draco::Decoder decoder;
+        if (skip_transform) {
+          decoder.SetSkipAttributeTransform(draco::GeometryAttribute::NORMAL);
+        }
+        decoder.SetAttributeDecodingThreadPool(&pool);
+        DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::PointCloud> pc,
+                               decoder.DecodePointCloudFromBuffer(&buffer));
+        ASSERT_EQ(GetAllAttributeData(*pc), reference);
+      }
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestAttributeOutputDataTypes) {
+  // Tests that quantized attributes can be decoded directly into half floats
+  // and normalized integers, and normals into octahedral coordinates.
+  const auto mesh = draco::ReadMeshFromTestFile("bunny_norm.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 12);
+  draco::EncoderBuffer encoder_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer));
+
+  draco::DecoderBuffer buffer;
+  buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+  draco::Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> reference,
+                         decoder.DecodeMeshFromBuffer(&buffer));
+  const draco::PointAttribute *const ref_pos =
+      reference->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+  const draco::PointAttribute *const ref_norm =
+      reference->GetNamedAttribute(draco::GeometryAttribute::NORMAL);
+
+  struct OutputConfig {
+    draco::DataType normal_data_type;
+    bool octahedral;
+    float tolerance;
+  };
+  const OutputConfig configs[] = {{draco::DT_FLOAT16, false, 1e-3f},
+                                  {draco::DT_INT16, false, 1e-4f},
+                                  {draco::DT_INT8, false, 1e-2f},
+                                  {draco::DT_INT16, true, 1e-3f},
+                                  {draco::DT_FLOAT32, true, 1e-3f}};
+  for (const OutputConfig &config : configs) {
+    draco::Decoder output_decoder;
+    output_decoder.SetAttributeOutputDataType(
+        draco::GeometryAttribute::POSITION, draco::DT_FLOAT16);
+    output_decoder.SetAttributeOutputDataType(draco::GeometryAttribute::NORMAL,
+                                              config.normal_data_type);
+    if (config.octahedral) {
+      output_decoder.SetOctahedralOutput(draco::GeometryAttribute::NORMAL);
+    }
+    buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> decoded,
+                           output_decoder.DecodeMeshFromBuffer(&buffer));
+    ASSERT_EQ(decoded->num_points(), reference->num_points());
+    const draco::PointAttribute *const pos =
+        decoded->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+    const draco::PointAttribute *const norm =
+        decoded->GetNamedAttribute(draco::GeometryAttribute::NORMAL);
+    ASSERT_EQ(pos->data_type(), draco::DT_FLOAT16);
+    ASSERT_EQ(pos->unique_id(), ref_pos->unique_id());
+    ASSERT_EQ(norm->data_type(), config.normal_data_type);
+    ASSERT_EQ(norm->num_components(), config.octahedral ? 2 : 3);
+    ASSERT_EQ(norm->normalized(), draco::IsDataTypeIntegral(
+                                      config.normal_data_type));
+
+    for (draco::PointIndex pi(0); pi < decoded->num_points(); ++pi) {
+      std::array<float, 3> ref_value, value;
+      ASSERT_TRUE(ref_pos->ConvertValue(ref_pos->mapped_index(pi),
+                                        ref_value.data()));
+      ASSERT_TRUE(pos->ConvertValue(pos->mapped_index(pi), value.data()));
+      for (int c = 0; c < 3; ++c) {
+        // Half floats have 11 bits of precision (less for subnormals).
+        ASSERT_NEAR(value[c], ref_value[c],
+                    std::abs(ref_value[c]) * 1e-3f + 1e-7f);
+      }
+
+      ASSERT_TRUE(ref_norm->ConvertValue(ref_norm->mapped_index(pi),
+                                         ref_value.data()));
+      ASSERT_TRUE(norm->ConvertValue(norm->mapped_index(pi), 3, value.data()));
+      if (config.octahedral) {
+        // Reconstruct the unit vector from the octahedral coordinates.
+        float s = value[0];
+        float t = value[1];
+        const float z = 1.f - std::abs(s) - std::abs(t);
+        if (z < 0.f) {
+          const float reflected_s = (1.f - std::abs(t)) * (s >= 0 ? 1 : -1);
+          t = (1.f - std::abs(s)) * (t >= 0 ? 1 : -1);
+          s = reflected_s;
+        }
+        const float length = std::sqrt(s * s + t * t + z * z);
+        value = {{s / length, t / length, z / length}};
+      }
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_NEAR(value[c], ref_value[c], config.tolerance);
+      }
+    }
+  }
+
+  // Half floats are only an output format of the decoder and they can't be
+  // encoded.
+  draco::Decoder half_float_decoder;
+  half_float_decoder.SetAttributeOutputDataType(
+      draco::GeometryAttribute::POSITION, draco::DT_FLOAT16);
+  buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> half_float_mesh,
+                         half_float_decoder.DecodeMeshFromBuffer(&buffer));
+  draco::EncoderBuffer half_float_buffer;
+  ASSERT_EQ(
+      encoder.EncodeMeshToBuffer(*half_float_mesh, &half_float_buffer).code(),
+      draco::Status::UNSUPPORTED_FEATURE);
+}
+
+
+TEST_F(DecodeTest, TestNormalizedOutputRange) {
+  // Tests that attributes within the normalized range of integer output types
+  // round-trip and that attributes outside of the range fail to decode instead
+  // of being clamped.
+  auto mesh = draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 12);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+  draco::EncoderBuffer encoder_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer));
+
+  // Positions and texture coordinates of the cube are in range [0, 1].
+  draco::DecoderBuffer buffer;
+  buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+  draco::Decoder decoder;
+  decoder.SetAttributeOutputDataType(draco::GeometryAttribute::POSITION,
+                                     draco::DT_UINT16);
+  decoder.SetAttributeOutputDataType(draco::GeometryAttribute::TEX_COORD,
+                                     draco::DT_UINT8);
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> decoded,
+                         decoder.DecodeMeshFromBuffer(&buffer));
+  const draco::PointAttribute *const pos =
+      decoded->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+  ASSERT_EQ(pos->data_type(), draco::DT_UINT16);
+  ASSERT_EQ(decoded->num_points(), mesh->num_points());
+  const draco::BoundingBox ref_box = mesh->ComputeBoundingBox();
+  draco::BoundingBox box;
+  for (draco::AttributeValueIndex avi(0); avi < pos->size(); ++avi) {
+    std::array<float, 3> value;
+    ASSERT_TRUE(pos->ConvertValue(avi, value.data()));
+    box.Update(draco::Vector3f(value[0], value[1], value[2]));
+  }
+  for (int c = 0; c < 3; ++c) {
+    ASSERT_EQ(box.GetMinPoint()[c], ref_box.GetMinPoint()[c]);
+    ASSERT_EQ(box.GetMaxPoint()[c], ref_box.GetMaxPoint()[c]);
+  }
+
+  // Normals have negative components that can't be stored in UNORM types.
+  buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+  draco::Decoder normal_decoder;
+  normal_decoder.SetAttributeOutputDataType(draco::GeometryAttribute::NORMAL,
+                                            draco::DT_UINT16);
+  ASSERT_FALSE(normal_decoder.DecodeMeshFromBuffer(&buffer).ok());
+
+  // Positions outside of [-1, 1] can't be stored in SNORM types.
+  draco::PointAttribute *const mesh_pos = mesh->attribute(
+      mesh->GetNamedAttributeId(draco::GeometryAttribute::POSITION));
+  for (draco::AttributeValueIndex avi(0); avi < mesh_pos->size(); ++avi) {
+    std::array<float, 3> value;
+    mesh_pos->GetValue(avi, &value);
+    for (float &v : value) {
+      v = 2.f * v - 0.5f;
+    }
+    mesh_pos->SetAttributeValue(avi, value.data());
+  }
+  encoder_buffer.Clear();
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer));
+  buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+  draco::Decoder position_decoder;
+  position_decoder.SetAttributeOutputDataType(
+      draco::GeometryAttribute::POSITION, draco::DT_INT16);
+  ASSERT_FALSE(position_decoder.DecodeMeshFromBuffer(&buffer).ok());
+}
+
+TEST_F(DecodeTest, TestCodingStats) {
+  // Tests that the encoder and the decoder report consistent stats of the
+  // individual stages when the instrumentation is compiled in.
+  const auto mesh = draco::ReadMeshFromTestFile("bunny_norm.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+  draco::EncoderBuffer encoder_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer));
+
+  draco::DecoderBuffer buffer;
+  buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+  draco::Decoder decoder;
+  DRACO_ASSERT_OK(decoder.DecodeMeshFromBuffer(&buffer).status());
+
+  for (const draco::CodingStats *stats : {&encoder.stats(), &decoder.stats()}) {
+    if (!draco::CodingStats::IsSupported()) {
+      ASSERT_EQ(stats->total.num_bytes, 0);
+      ASSERT_TRUE(stats->attributes.empty());
+      continue;
+    }
+    ASSERT_EQ(stats->total.num_bytes,
+              static_cast<int64_t>(encoder_buffer.size()));
+    ASSERT_EQ(stats->header.num_bytes + stats->metadata.num_bytes +
+                  stats->connectivity.num_bytes +
+                  stats->attribute_data.num_bytes,
+              stats->total.num_bytes);
+    ASSERT_GT(stats->connectivity.num_bytes, 0);
+    ASSERT_EQ(stats->attributes.size(),
+              static_cast<size_t>(mesh->num_attributes()));
+    int64_t num_attribute_bytes = 0;
+    for (const draco::AttributeCodingStats &att : stats->attributes) {
+      ASSERT_GT(att.entropy.num_bytes, 0);
+      ASSERT_GT(att.transform.num_bytes, 0);
+      num_attribute_bytes += att.transform.num_bytes +
+                             att.prediction.num_bytes + att.entropy.num_bytes;
+    }
+    ASSERT_LE(num_attribute_bytes, stats->attribute_data.num_bytes);
+  }
+}
+
+#ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
+TEST_F(DecodeTest, TestReuseDecoderState) {
+  // Tests that a decoder reusing its state decodes a sequence of different
+  // geometries, including older bitstream versions and invalid data, exactly
+  // like a new decoder for each geometry.
+  const std::vector<std::string> file_names = {
+      "test_nm.obj.edgebreaker.cl10.2.2.drc",
+      "test_nm.obj.edgebreaker.0.9.1.drc",
+      "car.drc",
+      "cube_att.obj.edgebreaker.cl4.2.2.drc",
+      "pc_kd_color.drc",
+      "test_nm.obj.sequential.1.1.0.drc",
+      "",
+      "test_nm.obj.edgebreaker.1.0.0.drc",
+      "cube_att.obj.edgebreaker.cl10.2.2.drc",
+      "point_cloud_no_qp.drc",
+      "test_nm.obj.edgebreaker.cl4.2.2.drc"};
+  std::vector<std::vector<char>> encoded_files;
+  for (const std::string &file_name : file_names) {
+    std::vector<char> data;
+    if (file_name.empty()) {
+      // Truncated Edgebreaker data.
+      data = encoded_files[0];
+      data.resize(data.size() / 2);
+    } else {
+      ASSERT_TRUE(draco::ReadFileToBuffer(
+          draco::GetTestFileFullPath(file_name), &data));
+    }
+    encoded_files.push_back(data);
+  }
+
+  draco::Decoder reusing_decoder;
+  reusing_decoder.SetReuseDecoderState(true);
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const std::vector<char> &file : encoded_files) {
+      draco::DecoderBuffer buffer;
+      buffer.Init(file.data(), file.size());
+      draco::Decoder decoder;
+      auto expected_pc = decoder.DecodePointCloudFromBuffer(&buffer);
+      buffer.Init(file.data(), file.size());
+      auto pc = reusing_decoder.DecodePointCloudFromBuffer(&buffer);
+      ASSERT_EQ(pc.ok(), expected_pc.ok());
+      if (!pc.ok()) {
+        continue;
+      }
+      ASSERT_EQ(GetAllAttributeData(*pc.value()),
+                GetAllAttributeData(*expected_pc.value()));
+      const draco::Mesh *const mesh =
+          dynamic_cast<const draco::Mesh *>(pc.value().get());
+      const draco::Mesh *const expected_mesh =
+          dynamic_cast<const draco::Mesh *>(expected_pc.value().get());
+      ASSERT_EQ(mesh == nullptr, expected_mesh == nullptr);
+      if (mesh == nullptr) {
+        continue;
+      }
+      ASSERT_EQ(mesh->num_faces(), expected_mesh->num_faces());
+      for (draco::FaceIndex fi(0); fi < mesh->num_faces(); ++fi) {
+        ASSERT_EQ(mesh->face(fi), expected_mesh->face(fi));
+      }
+    }
+  }
+}
+#endif
+
 }  // namespace
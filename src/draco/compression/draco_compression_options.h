@@ -81,6 +81,22 @@ struct DracoCompressionOptions {
   int quantization_bits_weight = 8;
   bool find_non_degenerate_texture_quantization = false;
 
+  // Error-bounded quantization. When a bound is positive, the quantization bits
+  // of the corresponding attributes are not taken from the options above but
+  // computed as the lowest number of bits that keeps the quantization error
+  // within the bound. Texture coordinate quantization is then also increased
+  // when needed to avoid new degenerate faces.
+  //
+  // Maximum position error in the units of the model.
+  float max_position_error = 0.f;
+  // Maximum position error as a fraction of the bounding box diagonal. Used
+  // only when |max_position_error| is not set.
+  float max_position_error_fraction = 0.f;
+  // Maximum texture coordinate error in the UV units.
+  float max_tex_coord_error = 0.f;
+  // Maximum angle between the original and quantized normals in radians.
+  float max_normal_angle = 0.f;
+
   bool operator==(const DracoCompressionOptions &other) const {
     return compression_level == other.compression_level &&
            quantization_position == other.quantization_position &&
@@ -91,7 +107,11 @@ struct DracoCompressionOptions {
            quantization_bits_tangent == other.quantization_bits_tangent &&
            quantization_bits_weight == other.quantization_bits_weight &&
            find_non_degenerate_texture_quantization ==
-               other.find_non_degenerate_texture_quantization;
+               other.find_non_degenerate_texture_quantization &&
+           max_position_error == other.max_position_error &&
+           max_position_error_fraction == other.max_position_error_fraction &&
+           max_tex_coord_error == other.max_tex_coord_error &&
+           max_normal_angle == other.max_normal_angle;
   }
 
   bool operator!=(const DracoCompressionOptions &other) const {
@@ -122,6 +142,10 @@ struct DracoCompressionOptions {
         Validate("Tangent quantization", quantization_bits_tangent, 0, 30));
     DRACO_RETURN_IF_ERROR(
         Validate("Weights quantization", quantization_bits_weight, 0, 30));
+    if (max_position_error < 0.f || max_position_error_fraction < 0.f ||
+        max_tex_coord_error < 0.f || max_normal_angle < 0.f) {
+      return ErrorStatus("Maximum quantization error must not be negative.");
+    }
     return OkStatus();
   }
 
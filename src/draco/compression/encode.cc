@@ -24,13 +24,17 @@ Status Encoder::EncodePointCloudToBuffer(const PointCloud &pc,
                                          EncoderBuffer *out_buffer) {
   ExpertEncoder encoder(pc);
   encoder.Reset(CreateExpertEncoderOptions(pc));
-  return encoder.EncodeToBuffer(out_buffer);
+  const Status status = encoder.EncodeToBuffer(out_buffer);
+  set_stats(encoder.stats());
+  return status;
 }
 
 Status Encoder::EncodeMeshToBuffer(const Mesh &m, EncoderBuffer *out_buffer) {
   ExpertEncoder encoder(m);
   encoder.Reset(CreateExpertEncoderOptions(m));
-  DRACO_RETURN_IF_ERROR(encoder.EncodeToBuffer(out_buffer));
+  const Status status = encoder.EncodeToBuffer(out_buffer);
+  set_stats(encoder.stats());
+  DRACO_RETURN_IF_ERROR(status);
   set_num_encoded_points(encoder.num_encoded_points());
   set_num_encoded_faces(encoder.num_encoded_faces());
   return OkStatus();
@@ -82,6 +86,22 @@ void Encoder::SetEncodingMethod(int encoding_method) {
   Base::SetEncodingMethod(encoding_method);
 }
 
+void Encoder::SetSymbolEncodingContextModeling(bool enabled) {
+  options().SetGlobalBool("symbol_encoding_context_modeling", enabled);
+}
+
+void Encoder::SetSymbolEncodingEntropySampling(bool enabled) {
+  options().SetGlobalBool("symbol_encoding_entropy_sampling", enabled);
+}
+
+void Encoder::SetNumAttributeEncodingThreads(int num_threads) {
+  options().SetGlobalInt("num_attribute_encoding_threads", num_threads);
+}
+
+void Encoder::SetNumConnectivityEncodingThreads(int num_threads) {
+  options().SetGlobalInt("num_connectivity_encoding_threads", num_threads);
+}
+
 Status Encoder::SetAttributePredictionScheme(GeometryAttribute::Type type,
                                              int prediction_scheme_method) {
   Status status = CheckPredictionScheme(type, prediction_scheme_method);
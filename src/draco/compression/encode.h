@@ -129,6 +129,30 @@ class Encoder
   // call of EncodePointCloudToBuffer or EncodeMeshToBuffer is going to fail.
   void SetEncodingMethod(int encoding_method);
 
+  // Allows the encoder to use context modeling for the entropy coding of
+  // attribute values when it results in a smaller output. The size reduction
+  // is usually small (see SetSymbolEncodingContextModeling() in
+  // symbol_encoding.h). Default: [false].
+  void SetSymbolEncodingContextModeling(bool enabled);
+
+  // Allows the encoder to select the entropy coding of very large attributes
+  // from a subset of the attribute values, which speeds up the encoding at
+  // the cost of a possibly larger output (see
+  // SetSymbolEncodingEntropySampling() in symbol_encoding.h). Default: [false].
+  void SetSymbolEncodingEntropySampling(bool enabled);
+
+  // Sets the number of worker threads used to encode attributes that share
+  // the same point sequence, e.g. all attributes of the sequential encoding.
+  // The output is identical to the single-threaded encoding. Negative values
+  // use all available hardware threads. Default: [0] (no worker threads).
+  void SetNumAttributeEncodingThreads(int num_threads);
+
+  // Sets the number of worker threads used to construct the connectivity
+  // (corner table) of meshes encoded with the edgebreaker method. The output
+  // is identical to the single-threaded encoding. Negative values use all
+  // available hardware threads. Default: [0] (no worker threads).
+  void SetNumConnectivityEncodingThreads(int num_threads);
+
   // Creates encoder options for the expert encoder used during the actual
   // encoding.
   EncoderOptions CreateExpertEncoderOptions(const PointCloud &pc) const;
@@ -16,6 +16,7 @@
 #define DRACO_COMPRESSION_ENCODE_BASE_H_
 
 #include "draco/attributes/geometry_attribute.h"
+#include "draco/compression/coding_stats.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/core/status.h"
 
@@ -48,6 +49,11 @@ class EncoderBase {
   size_t num_encoded_points() const { return num_encoded_points_; }
   size_t num_encoded_faces() const { return num_encoded_faces_; }
 
+  // Returns the time and data size of the individual stages of the last
+  // encoding operation. Collected only when Draco is built with the
+  // DRACO_INSTRUMENTATION CMake option, see CodingStats.
+  const CodingStats &stats() const { return stats_; }
+
  protected:
   void Reset(const EncoderOptionsT &options) { options_ = options; }
 
@@ -112,12 +118,15 @@ class EncoderBase {
  protected:
   void set_num_encoded_points(size_t num) { num_encoded_points_ = num; }
   void set_num_encoded_faces(size_t num) { num_encoded_faces_ = num; }
+  void set_stats(const CodingStats &stats) { stats_ = stats; }
+  CodingStats *mutable_stats() { return &stats_; }
 
  private:
   EncoderOptionsT options_;
 
   size_t num_encoded_points_;
   size_t num_encoded_faces_;
+  CodingStats stats_;
 };
 
 template <class EncoderOptionsT>
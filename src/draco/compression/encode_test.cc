@@ -16,6 +16,7 @@
 #include "draco/compression/encode.h"
 
 #include <cinttypes>
+#include <cmath>
 #include <fstream>
 #include <sstream>
 
@@ -403,6 +404,267 @@ TEST_F(EncodeTest, TestNoPosQuantizationNormalCoding) {
   ASSERT_NE(decoded_mesh, nullptr);
 }
 
+TEST_F(EncodeTest, TestOptimizeAttributeEncoding) {
+  // Tests that the expert encoder can search for per-attribute settings that
+  // do not increase the encoded size and that the result can be decoded.
+  const auto mesh = draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+
+  draco::ExpertEncoder encoder(*mesh);
+  for (int i = 0; i < mesh->num_attributes(); ++i) {
+    encoder.SetAttributeQuantization(i, 10);
+  }
+  encoder.SetSpeedOptions(0, 0);
+  DRACO_ASSIGN_OR_ASSERT(const auto optimization,
+                         encoder.OptimizeAttributeEncoding(2));
+  ASSERT_EQ(optimization.attributes.size(), mesh->num_attributes());
+  ASSERT_LE(optimization.optimized_size, optimization.default_size);
+
+  // The selected settings must be used by the subsequent encoding.
+  draco::EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer));
+  ASSERT_EQ(buffer.size(), optimization.optimized_size);
+  for (int i = 0; i < mesh->num_attributes(); ++i) {
+    const int scheme = optimization.attributes[i].prediction_scheme;
+    if (scheme != -1) {
+      ASSERT_EQ(encoder.options().GetAttributeInt(i, "prediction_scheme", -1),
+                scheme);
+    }
+  }
+
+  draco::DecoderBuffer in_buffer;
+  in_buffer.Init(buffer.data(), buffer.size());
+  draco::Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(const auto decoded_mesh,
+                         decoder.DecodeMeshFromBuffer(&in_buffer));
+  ASSERT_EQ(decoded_mesh->num_faces(), mesh->num_faces());
+}
+
+TEST_F(EncodeTest, TestOptimizeAttributeEncodingRespectsOptions) {
+  // Tests that the search does not select prediction schemes that are too slow
+  // for the requested decoding speed and that it does not change explicitly
+  // set prediction schemes.
+  const auto mesh = draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  const int pos_att_id =
+      mesh->GetNamedAttributeId(draco::GeometryAttribute::POSITION);
+
+  draco::ExpertEncoder encoder(*mesh);
+  for (int i = 0; i < mesh->num_attributes(); ++i) {
+    encoder.SetAttributeQuantization(i, 10);
+  }
+  encoder.SetSpeedOptions(0, 5);
+  DRACO_ASSERT_OK(encoder.SetAttributePredictionScheme(
+      pos_att_id, draco::PREDICTION_DIFFERENCE));
+  DRACO_ASSIGN_OR_ASSERT(const auto optimization,
+                         encoder.OptimizeAttributeEncoding(0));
+  for (int i = 0; i < mesh->num_attributes(); ++i) {
+    const auto &config = optimization.attributes[i];
+    if (i == pos_att_id) {
+      ASSERT_EQ(config.prediction_scheme, -1);
+    }
+    ASSERT_NE(config.prediction_scheme,
+              draco::MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM);
+    ASSERT_NE(config.prediction_scheme,
+              draco::MESH_PREDICTION_TEX_COORDS_PORTABLE);
+    ASSERT_NE(config.prediction_scheme,
+              draco::MESH_PREDICTION_GEOMETRIC_NORMAL);
+    ASSERT_LE(config.symbol_encoding_compression_level, 5);
+  }
+  ASSERT_EQ(encoder.options().GetAttributeInt(pos_att_id, "prediction_scheme",
+                                              -1),
+            draco::PREDICTION_DIFFERENCE);
+}
+
+TEST_F(EncodeTest, TestParallelAttributeEncoding) {
+  // Tests that encoding of attributes on multiple threads results in the same
+  // output as the single-threaded encoding.
+  const auto mesh = draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  struct EncodingConfig {
+    int encoding_method;
+    bool split_mesh_on_seams;
+  };
+  const EncodingConfig configs[] = {
+      {draco::MESH_SEQUENTIAL_ENCODING, false},
+      {draco::MESH_EDGEBREAKER_ENCODING, false},
+      {draco::MESH_EDGEBREAKER_ENCODING, true}};
+  for (const EncodingConfig &config : configs) {
+    std::vector<char> reference;
+    for (const int num_threads : {0, 2, -1}) {
+      draco::ExpertEncoder encoder(*mesh);
+      for (int i = 0; i < mesh->num_attributes(); ++i) {
+        encoder.SetAttributeQuantization(i, 10);
+      }
+      encoder.SetEncodingMethod(config.encoding_method);
+      encoder.options().SetGlobalBool("split_mesh_on_seams",
+                                      config.split_mesh_on_seams);
+      encoder.SetNumAttributeEncodingThreads(num_threads);
+      draco::EncoderBuffer buffer;
+      DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer));
+      const std::vector<char> data(buffer.data(),
+                                   buffer.data() + buffer.size());
+      if (num_threads == 0) {
+        reference = data;
+      } else {
+        ASSERT_EQ(data, reference);
+      }
+    }
+  }
+}
+
+TEST_F(EncodeTest, TestMultithreadedConnectivityEncoding) {
+  // Tests that constructing the connectivity on multiple threads results in
+  // the same output as the single-threaded encoding.
+  const auto mesh = draco::ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  for (const bool split_mesh_on_seams : {false, true}) {
+    std::vector<char> reference;
+    for (const int num_threads : {0, 2, -1}) {
+      draco::ExpertEncoder encoder(*mesh);
+      encoder.SetAttributeQuantization(0, 10);
+      encoder.SetEncodingMethod(draco::MESH_EDGEBREAKER_ENCODING);
+      encoder.options().SetGlobalBool("split_mesh_on_seams",
+                                      split_mesh_on_seams);
+      encoder.SetNumConnectivityEncodingThreads(num_threads);
+      draco::EncoderBuffer buffer;
+      DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer));
+      const std::vector<char> data(buffer.data(),
+                                   buffer.data() + buffer.size());
+      if (num_threads == 0) {
+        reference = data;
+      } else {
+        ASSERT_EQ(data, reference);
+      }
+    }
+  }
+}
+
+TEST_F(EncodeTest, TestStreamingOutput) {
+  // Tests that the encoded data flushed to a callback during the encoding is
+  // the same as the data encoded into memory.
+  const auto mesh = draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  for (const int encoding_method :
+       {draco::MESH_SEQUENTIAL_ENCODING, draco::MESH_EDGEBREAKER_ENCODING}) {
+    draco::Encoder encoder;
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+    encoder.SetEncodingMethod(encoding_method);
+    draco::EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+
+    std::vector<char> streamed_data;
+    int num_flushes = 0;
+    draco::EncoderBuffer streamed_buffer;
+    streamed_buffer.SetFlushCallback([&](const char *data, size_t size) {
+      streamed_data.insert(streamed_data.end(), data, data + size);
+      ++num_flushes;
+      return true;
+    });
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &streamed_buffer));
+    // Header, connectivity and the attributes are flushed separately.
+    ASSERT_GT(num_flushes, 2);
+    ASSERT_EQ(streamed_buffer.size(), 0);
+    ASSERT_EQ(streamed_buffer.num_flushed_bytes(), buffer.size());
+    ASSERT_EQ(streamed_data,
+              std::vector<char>(buffer.data(), buffer.data() + buffer.size()));
+
+    // Errors of the callback must be reported as IO errors at any flush.
+    for (int failing_flush = 0; failing_flush < num_flushes; ++failing_flush) {
+      int flush_id = 0;
+      draco::EncoderBuffer failing_buffer;
+      failing_buffer.SetFlushCallback(
+          [&](const char * /* data */, size_t /* size */) {
+            return flush_id++ != failing_flush;
+          });
+      const draco::Status status =
+          encoder.EncodeMeshToBuffer(*mesh, &failing_buffer);
+      ASSERT_EQ(status.code(), draco::Status::IO_ERROR) << failing_flush;
+    }
+  }
+}
+
+TEST_F(EncodeTest, TestBitstreamVersion) {
+  // Tests that the latest bitstream version is written only when the encoded
+  // data uses context-modeling symbol coding.
+  const auto mesh = draco::ReadMeshFromTestFile("bunny_norm.obj");
+  ASSERT_NE(mesh, nullptr);
+
+  // Point cloud with a generic attribute whose values have correlated
+  // magnitudes, for which the context modeling is selected.
+  constexpr int kNumPoints = 20000;
+  draco::PointCloudBuilder builder;
+  builder.Start(kNumPoints);
+  const int att_id = builder.AddAttribute(draco::GeometryAttribute::GENERIC, 3,
+                                          draco::DT_INT32);
+  uint32_t seed = 1;
+  for (draco::PointIndex i(0); i < kNumPoints; ++i) {
+    const int32_t range = 1 << ((i.value() / 64) % 10);
+    int32_t values[3];
+    for (int c = 0; c < 3; ++c) {
+      seed = seed * 1103515245 + 12345;
+      const int32_t a = (seed >> 16) % range;
+      seed = seed * 1103515245 + 12345;
+      const int32_t b = (seed >> 16) % range;
+      values[c] = a * b / range;
+    }
+    builder.SetAttributeValueForPoint(att_id, i, values);
+  }
+  const std::unique_ptr<draco::PointCloud> pc = builder.Finalize(false);
+  ASSERT_NE(pc, nullptr);
+
+  // Offset of the minor version in the Draco header.
+  const int kVersionMinorOffset = 6;
+  for (const bool context_modeling : {false, true}) {
+    draco::Encoder encoder;
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+    encoder.SetAttributePredictionScheme(draco::GeometryAttribute::GENERIC,
+                                         draco::PREDICTION_NONE);
+    encoder.SetSymbolEncodingContextModeling(context_modeling);
+
+    draco::EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+    ASSERT_EQ(buffer.data()[kVersionMinorOffset],
+              context_modeling ? draco::kDracoMeshBitstreamVersionMinor
+                               : draco::kDracoMeshDefaultBitstreamVersionMinor);
+    draco::DecoderBuffer decoder_buffer;
+    decoder_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder decoder;
+    DRACO_ASSERT_OK(decoder.DecodeMeshFromBuffer(&decoder_buffer).status());
+
+    encoder.SetEncodingMethod(draco::POINT_CLOUD_SEQUENTIAL_ENCODING);
+    draco::EncoderBuffer point_cloud_buffer;
+    DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &point_cloud_buffer));
+    ASSERT_EQ(point_cloud_buffer.data()[kVersionMinorOffset],
+              context_modeling
+                  ? draco::kDracoPointCloudBitstreamVersionMinor
+                  : draco::kDracoPointCloudDefaultBitstreamVersionMinor);
+    decoder_buffer.Init(point_cloud_buffer.data(), point_cloud_buffer.size());
+    DRACO_ASSERT_OK(
+        decoder.DecodePointCloudFromBuffer(&decoder_buffer).status());
+  }
+
+  // Streamed data is written with the latest version whenever the context
+  // modeling is allowed, because the header is flushed before the attributes
+  // are encoded.
+  for (const bool context_modeling : {false, true}) {
+    draco::Encoder encoder;
+    encoder.SetSymbolEncodingContextModeling(context_modeling);
+    std::vector<char> streamed_data;
+    draco::EncoderBuffer streamed_buffer;
+    streamed_buffer.SetFlushCallback([&](const char *data, size_t size) {
+      streamed_data.insert(streamed_data.end(), data, data + size);
+      return true;
+    });
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &streamed_buffer));
+    ASSERT_GT(streamed_data.size(), kVersionMinorOffset);
+    ASSERT_EQ(streamed_data[kVersionMinorOffset],
+              context_modeling ? draco::kDracoMeshBitstreamVersionMinor
+                               : draco::kDracoMeshDefaultBitstreamVersionMinor);
+  }
+}
+
 #ifdef DRACO_TRANSCODER_SUPPORTED
 TEST_F(EncodeTest, TestDracoCompressionOptions) {
   // This test verifies that we can set the encoder's compression options via
@@ -477,6 +739,44 @@ TEST_F(EncodeTest, TestDracoCompressionOptionsManualOverride) {
   ASSERT_LT(buffer_with_override.size(), buffer_no_override.size());
 }
 
+TEST_F(EncodeTest, TestDracoCompressionOptionsErrorBoundedQuantization) {
+  // Test verifies that quantization bits can be derived from the maximum
+  // allowed quantization error.
+
+  // 1x1x1 cube.
+  const auto mesh = draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  mesh->SetCompressionEnabled(true);
+  draco::DracoCompressionOptions compression_options;
+  // Maximum position error of 0.01 requires a quantization step of at most
+  // 0.02, which needs 6 bits (step of 1/63).
+  compression_options.max_position_error_fraction = 0.01f / std::sqrt(3.f);
+  compression_options.max_tex_coord_error = 0.01f;
+  compression_options.max_normal_angle = 0.1f;
+  DRACO_ASSERT_OK(compression_options.Check());
+  mesh->SetCompressionOptions(compression_options);
+
+  draco::ExpertEncoder encoder(*mesh);
+  draco::EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer));
+
+  const int pos_att_id =
+      mesh->GetNamedAttributeId(draco::GeometryAttribute::POSITION);
+  ASSERT_EQ(
+      encoder.options().GetAttributeInt(pos_att_id, "quantization_bits", -1),
+      6);
+  for (const auto type : {draco::GeometryAttribute::TEX_COORD,
+                          draco::GeometryAttribute::NORMAL}) {
+    const int att_id = mesh->GetNamedAttributeId(type);
+    ASSERT_GT(
+        encoder.options().GetAttributeInt(att_id, "quantization_bits", -1), 0);
+  }
+
+  // Negative bounds are invalid.
+  compression_options.max_normal_angle = -1.f;
+  ASSERT_FALSE(compression_options.Check().ok());
+}
+
 TEST_F(EncodeTest, TestDracoCompressionOptionsGridQuantization) {
   // Test verifies that we can set position quantization via grid spacing.
 
@@ -7,24 +7,37 @@
 
 namespace draco {
 
+// Minimum number of symbols per histogram bin for which the frequencies are
+// counted using multiple interleaved histograms.
+constexpr int kMinNumSymbolsPerBinForInterleavedHistogram = 4;
+
 int64_t ComputeShannonEntropy(const uint32_t *symbols, int num_symbols,
                               int max_value, int *out_num_unique_symbols) {
   // First find frequency of all unique symbols in the input array.
-  int num_unique_symbols = 0;
-  std::vector<int> symbol_frequencies(max_value + 1, 0);
-  for (int i = 0; i < num_symbols; ++i) {
-    ++symbol_frequencies[symbols[i]];
+  std::vector<uint64_t> symbol_frequencies;
+  ComputeSymbolFrequencies(symbols, num_symbols, max_value,
+                           &symbol_frequencies);
+  return ComputeShannonEntropyFromFrequencies(
+      symbol_frequencies.data(), max_value + 1, out_num_unique_symbols);
+}
+
+int64_t ComputeShannonEntropyFromFrequencies(const uint64_t *frequencies,
+                                             int num_frequencies,
+                                             int *out_num_unique_symbols) {
+  uint64_t num_symbols = 0;
+  for (int i = 0; i < num_frequencies; ++i) {
+    num_symbols += frequencies[i];
   }
+  int num_unique_symbols = 0;
   double total_bits = 0;
-  double num_symbols_d = num_symbols;
-  for (int i = 0; i < max_value + 1; ++i) {
-    if (symbol_frequencies[i] > 0) {
+  const double num_symbols_d = static_cast<double>(num_symbols);
+  for (int i = 0; i < num_frequencies; ++i) {
+    if (frequencies[i] > 0) {
       ++num_unique_symbols;
       // Compute Shannon entropy for the symbol.
       // We don't want to use std::log2 here for Android build.
-      total_bits +=
-          symbol_frequencies[i] *
-          log2(static_cast<double>(symbol_frequencies[i]) / num_symbols_d);
+      total_bits += frequencies[i] *
+                    log2(static_cast<double>(frequencies[i]) / num_symbols_d);
     }
   }
   if (out_num_unique_symbols) {
@@ -34,6 +47,40 @@ int64_t ComputeShannonEntropy(const uint32_t *symbols, int num_symbols,
   return static_cast<int64_t>(-total_bits);
 }
 
+void ComputeSymbolFrequencies(const uint32_t *symbols, int num_symbols,
+                              uint32_t max_value,
+                              std::vector<uint64_t> *out_frequencies) {
+  const size_t num_bins = static_cast<size_t>(max_value) + 1;
+  out_frequencies->assign(num_bins, 0);
+  uint64_t *const frequencies = out_frequencies->data();
+  int i = 0;
+  if (static_cast<size_t>(num_symbols) >=
+      kMinNumSymbolsPerBinForInterleavedHistogram * num_bins) {
+    // Symbols of typical encoder inputs are heavily skewed, so consecutive
+    // symbols often update the same bin and each increment has to wait for
+    // the previous one. Counting four consecutive symbols into four separate
+    // histograms removes this dependency and the histograms are summed at the
+    // end.
+    std::vector<uint32_t> partial_frequencies(3 * num_bins, 0);
+    uint32_t *const frequencies_1 = partial_frequencies.data();
+    uint32_t *const frequencies_2 = frequencies_1 + num_bins;
+    uint32_t *const frequencies_3 = frequencies_2 + num_bins;
+    for (; i + 4 <= num_symbols; i += 4) {
+      ++frequencies[symbols[i]];
+      ++frequencies_1[symbols[i + 1]];
+      ++frequencies_2[symbols[i + 2]];
+      ++frequencies_3[symbols[i + 3]];
+    }
+    for (size_t j = 0; j < num_bins; ++j) {
+      frequencies[j] += static_cast<uint64_t>(frequencies_1[j]) +
+                        frequencies_2[j] + frequencies_3[j];
+    }
+  }
+  for (; i < num_symbols; ++i) {
+    ++frequencies[symbols[i]];
+  }
+}
+
 double ComputeBinaryShannonEntropy(uint32_t num_values,
                                    uint32_t num_true_values) {
   if (num_values == 0) {
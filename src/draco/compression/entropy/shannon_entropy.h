@@ -38,6 +38,19 @@ namespace draco {
 int64_t ComputeShannonEntropy(const uint32_t *symbols, int num_symbols,
                               int max_value, int *out_num_unique_symbols);
 
+// Same as ComputeShannonEntropy() but the entropy is computed from already
+// known |frequencies| of all symbols in range <0, num_frequencies - 1>.
+int64_t ComputeShannonEntropyFromFrequencies(const uint64_t *frequencies,
+                                             int num_frequencies,
+                                             int *out_num_unique_symbols);
+
+// Computes the number of occurrences of each symbol in the input array
+// |symbols|. All symbols must be in range <0, max_value>. The result is stored
+// in |out_frequencies| that is resized to |max_value| + 1 entries.
+void ComputeSymbolFrequencies(const uint32_t *symbols, int num_symbols,
+                              uint32_t max_value,
+                              std::vector<uint64_t> *out_frequencies);
+
 // Computes the Shannon entropy of |num_values| Boolean entries, where
 // |num_true_values| are set to true.
 // Returns entropy between 0-1.
@@ -1,5 +1,8 @@
 #include "draco/compression/entropy/shannon_entropy.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "draco/core/draco_test_base.h"
 
 namespace {
@@ -55,4 +58,38 @@ TEST(ShannonEntropyTest, TestStreamEntropy) {
   ASSERT_EQ(stream_2_entropy_bits, entropy_tracker_2.GetNumberOfDataBits());
 }
 
+TEST(ShannonEntropyTest, TestSymbolFrequencies) {
+  // Test verifies that the symbol frequencies are computed correctly for both
+  // small and large inputs and that the entropy computed from the frequencies
+  // matches the entropy computed directly from the symbols.
+  for (const int num_symbols : {7, 1000, 100003}) {
+    std::vector<uint32_t> symbols;
+    uint32_t seed = 1;
+    for (int i = 0; i < num_symbols; ++i) {
+      seed = seed * 1103515245 + 12345;
+      // Skewed distribution with long runs of the same symbol.
+      symbols.push_back(((seed >> 16) % 16) * ((seed >> 20) % 16) / 8);
+    }
+    const uint32_t max_value =
+        *std::max_element(symbols.begin(), symbols.end());
+    std::vector<uint64_t> expected_frequencies(max_value + 1, 0);
+    for (const uint32_t symbol : symbols) {
+      ++expected_frequencies[symbol];
+    }
+    std::vector<uint64_t> frequencies;
+    draco::ComputeSymbolFrequencies(symbols.data(), num_symbols, max_value,
+                                    &frequencies);
+    ASSERT_EQ(frequencies, expected_frequencies);
+
+    int num_unique_symbols = 0;
+    int num_unique_symbols_2 = 0;
+    ASSERT_EQ(draco::ComputeShannonEntropy(symbols.data(), num_symbols,
+                                           max_value, &num_unique_symbols),
+              draco::ComputeShannonEntropyFromFrequencies(
+                  frequencies.data(), static_cast<int>(frequencies.size()),
+                  &num_unique_symbols_2));
+    ASSERT_EQ(num_unique_symbols, num_unique_symbols_2);
+  }
+}
+
 }  // namespace
@@ -0,0 +1,174 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmarks of the context-modeling entropy coding of attribute values
+// (SYMBOL_CODING_CONTEXT) compared to the default rANS symbol coding. For
+// each model, the benchmark reports the encoded size and the decoding time of
+// the whole mesh. The encoding of large synthetic symbol streams is measured
+// with and without the entropy sampling.
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/entropy/shannon_entropy.h"
+#include "draco/compression/entropy/symbol_encoding.h"
+#include "draco/core/cycle_timer.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace draco {
+
+namespace {
+
+// Minimum number of decoded points for each measurement. Small models are
+// decoded multiple times to reduce the timing noise.
+constexpr int kMinNumDecodedPoints = 2000000;
+
+struct EncodingResult {
+  size_t size;
+  int64_t decode_time_ms;
+};
+
+EncodingResult EncodeAndDecode(const Mesh &mesh, int compression_level,
+                               bool context_modeling) {
+  Encoder encoder;
+  encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 11);
+  encoder.SetAttributeQuantization(GeometryAttribute::TEX_COORD, 10);
+  encoder.SetAttributeQuantization(GeometryAttribute::NORMAL, 8);
+  encoder.SetSpeedOptions(10 - compression_level, 10 - compression_level);
+  encoder.SetSymbolEncodingContextModeling(context_modeling);
+  EncoderBuffer buffer;
+  EncodingResult result = {0, 0};
+  const Status status = encoder.EncodeMeshToBuffer(mesh, &buffer);
+  EXPECT_TRUE(status.ok()) << status.error_msg_string();
+  if (!status.ok()) {
+    return result;
+  }
+  result.size = buffer.size();
+
+  const int num_repetitions =
+      std::max(1, kMinNumDecodedPoints / static_cast<int>(mesh.num_points()));
+  CycleTimer timer;
+  timer.Start();
+  for (int i = 0; i < num_repetitions; ++i) {
+    DecoderBuffer decoder_buffer;
+    decoder_buffer.Init(buffer.data(), buffer.size());
+    Decoder decoder;
+    StatusOr<std::unique_ptr<Mesh>> statusor =
+        decoder.DecodeMeshFromBuffer(&decoder_buffer);
+    EXPECT_TRUE(statusor.ok());
+  }
+  timer.Stop();
+  result.decode_time_ms = timer.GetInMs();
+  return result;
+}
+
+// Number of symbols of the synthetic streams.
+constexpr int kNumStreamSymbols = 10000000;
+
+// Generates a stream of |kNumStreamSymbols| symbols. When |max_bit_length| is
+// small, the symbols resemble prediction residuals of quantized attributes,
+// with small values being more likely. Otherwise, the values are spread over
+// a wide range.
+std::vector<uint32_t> GenerateSymbolStream(int max_bit_length) {
+  std::vector<uint32_t> symbols(kNumStreamSymbols);
+  uint32_t seed = 1;
+  for (int i = 0; i < kNumStreamSymbols; ++i) {
+    const uint32_t range = 1u << (1 + (i / 4096) % max_bit_length);
+    seed = seed * 1103515245 + 12345;
+    const uint32_t a = (seed >> 8) % range;
+    seed = seed * 1103515245 + 12345;
+    const uint32_t b = (seed >> 8) % range;
+    symbols[i] = static_cast<uint32_t>(static_cast<uint64_t>(a) * b / range);
+  }
+  return symbols;
+}
+
+struct StreamEncodingResult {
+  size_t size;
+  int64_t encode_time_ms;
+};
+
+StreamEncodingResult EncodeStream(const std::vector<uint32_t> &symbols,
+                                  bool entropy_sampling) {
+  Options options;
+  SetSymbolEncodingEntropySampling(&options, entropy_sampling);
+  EncoderBuffer buffer;
+  CycleTimer timer;
+  timer.Start();
+  EXPECT_TRUE(EncodeSymbols(symbols.data(), static_cast<int>(symbols.size()),
+                            3, &options, &buffer));
+  timer.Stop();
+  StreamEncodingResult result = {buffer.size(), timer.GetInMs()};
+  return result;
+}
+
+}  // namespace
+
+TEST(SymbolCodingBenchmark, EncodeLargeStreams) {
+  printf("Encoding of %d symbols\n", kNumStreamSymbols);
+  printf("  %-8s %10s %18s %18s\n", "bits", "entropy", "exact", "sampled");
+  for (const int max_bit_length : {4, 10, 16}) {
+    const std::vector<uint32_t> symbols = GenerateSymbolStream(max_bit_length);
+    const uint32_t max_value =
+        *std::max_element(symbols.begin(), symbols.end());
+    CycleTimer timer;
+    timer.Start();
+    const int64_t entropy_bits = ComputeShannonEntropy(
+        symbols.data(), static_cast<int>(symbols.size()),
+        static_cast<int>(max_value), nullptr);
+    timer.Stop();
+    ASSERT_GT(entropy_bits, 0);
+    const int64_t entropy_time_ms = timer.GetInMs();
+    const StreamEncodingResult exact_result = EncodeStream(symbols, false);
+    const StreamEncodingResult sampled_result = EncodeStream(symbols, true);
+    printf("  %-8d %7" PRId64 " ms %8zu B %5" PRId64 " ms %8zu B %5" PRId64
+           " ms\n",
+           max_bit_length, entropy_time_ms, exact_result.size,
+           exact_result.encode_time_ms, sampled_result.size,
+           sampled_result.encode_time_ms);
+  }
+}
+
+TEST(SymbolCodingBenchmark, ContextModeling) {
+  printf("Context modeling of attribute values vs. default symbol coding\n");
+  printf("  %-16s %3s %18s %18s %8s\n", "model", "cl", "default",
+         "context", "size");
+  for (const std::string file_name :
+       {"bun_zipper.ply", "bunny_norm.obj", "test_nm.obj"}) {
+    const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    for (const int compression_level : {5, 7, 10}) {
+      const EncodingResult default_result =
+          EncodeAndDecode(*mesh, compression_level, false);
+      const EncodingResult context_result =
+          EncodeAndDecode(*mesh, compression_level, true);
+      ASSERT_GT(default_result.size, 0);
+      printf("  %-16s %3d %8zu B %5" PRId64 " ms %8zu B %5" PRId64
+             " ms %+7.2f%%\n",
+             file_name.c_str(), compression_level, default_result.size,
+             default_result.decode_time_ms, context_result.size,
+             context_result.decode_time_ms,
+             100.0 * (static_cast<double>(context_result.size) /
+                          default_result.size -
+                      1.0));
+    }
+  }
+}
+
+}  // namespace draco
@@ -0,0 +1,81 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File providing shared functionality for the context-modeling symbol coding
+// (SYMBOL_CODING_CONTEXT) implemented in symbol_encoding.cc and
+// symbol_decoding.cc.
+#ifndef DRACO_COMPRESSION_ENTROPY_SYMBOL_CODING_CONTEXTS_H_
+#define DRACO_COMPRESSION_ENTROPY_SYMBOL_CODING_CONTEXTS_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include "draco/compression/entropy/rans_symbol_coding.h"
+#include "draco/core/bit_utils.h"
+
+namespace draco {
+
+// Maximum number of contexts used by the context-modeling symbol coding.
+constexpr int kMaxNumSymbolCodingContexts = 256;
+
+// Returns the maximum bit length of unique symbols that selects the rANS
+// precision of the contexts when coding |num_values| symbols. No context can
+// contain more than |num_values| unique symbols and the encoder adds at most
+// two bits for the highest compression levels.
+inline int GetMaxSymbolCodingContextBitLength(uint32_t num_values) {
+  return MostSignificantBit(std::max(1u, num_values)) + 3;
+}
+
+// Returns true when the decoder can allocate the rANS lookup tables of
+// |num_used_contexts| non-empty contexts coded with |unique_symbols_bit_length|
+// for |num_values| symbols. The tables may take up at most the size of a
+// single table of the highest precision plus 64 entries per coded value. This
+// bounds the memory that a malformed stream can make the decoder allocate.
+inline bool IsSymbolCodingContextTableSizeValid(int num_used_contexts,
+                                                int unique_symbols_bit_length,
+                                                uint32_t num_values) {
+  const uint64_t table_size =
+      uint64_t{1} << ComputeRAnsPrecisionFromUniqueSymbolsBitLength(
+          unique_symbols_bit_length);
+  // The highest precision of our rANS library is 20 bits.
+  const uint64_t max_total_table_size =
+      (uint64_t{1} << 20) + 64 * static_cast<uint64_t>(num_values);
+  return num_used_contexts * table_size <= max_total_table_size;
+}
+
+// Returns the coding context of the value at index |value_id| that belongs to
+// component |component| of an entry with |num_components| components. Every
+// component has |num_magnitude_contexts| contexts selected by the bit length
+// of the previously coded neighboring value, which is the previous component
+// of the same entry, or the same component of the previous entry for the
+// first component. Prediction residuals of neighboring values tend to have
+// similar magnitudes, so each context gets a more skewed probability table.
+inline int GetSymbolCodingContext(const uint32_t *values, int value_id,
+                                  int component, int num_components,
+                                  int num_magnitude_contexts) {
+  uint32_t neighbor = 0;
+  if (component > 0) {
+    neighbor = values[value_id - 1];
+  } else if (value_id >= num_components) {
+    neighbor = values[value_id - num_components];
+  }
+  const int magnitude =
+      neighbor == 0 ? 0 : MostSignificantBit(neighbor) + 1;
+  return component * num_magnitude_contexts +
+         std::min(magnitude, num_magnitude_contexts - 1);
+}
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ENTROPY_SYMBOL_CODING_CONTEXTS_H_
@@ -158,6 +158,111 @@ TEST_F(SymbolCodingTest, TestLargeNumberCondition) {
   }
 }
 
+TEST_F(SymbolCodingTest, TestContextModeling) {
+  // This test verifies that the context-modeling scheme is selected for
+  // multi-component data where the magnitudes of neighboring values are
+  // correlated, and that the data is successfully decoded.
+  constexpr int kNumComponents = 3;
+  std::vector<uint32_t> in;
+  uint32_t seed = 1;
+  for (int i = 0; i < 20000; ++i) {
+    // The range of values changes slowly across the entries and small values
+    // are more likely, similarly to prediction residuals.
+    const uint32_t range = 1u << ((i / 64) % 10);
+    for (int c = 0; c < kNumComponents; ++c) {
+      seed = seed * 1103515245 + 12345;
+      const uint32_t a = (seed >> 16) % range;
+      seed = seed * 1103515245 + 12345;
+      const uint32_t b = (seed >> 16) % range;
+      in.push_back(a * b / range);
+    }
+  }
+
+  EncoderBuffer default_eb;
+  ASSERT_TRUE(EncodeSymbols(in.data(), in.size(), kNumComponents, nullptr,
+                            &default_eb));
+
+  Options options;
+  SetSymbolEncodingContextModeling(&options, true);
+  EncoderBuffer eb;
+  ASSERT_TRUE(
+      EncodeSymbols(in.data(), in.size(), kNumComponents, &options, &eb));
+  ASSERT_EQ(eb.data()[0], SYMBOL_CODING_CONTEXT);
+  ASSERT_LT(eb.size(), default_eb.size());
+
+  std::vector<uint32_t> out(in.size());
+  DecoderBuffer db;
+  db.Init(eb.data(), eb.size());
+  db.set_bitstream_version(bitstream_version_);
+  ASSERT_TRUE(DecodeSymbols(in.size(), kNumComponents, &db, &out[0]));
+  ASSERT_EQ(in, out);
+
+  // Decoding must fail when the number of values doesn't match the encoded
+  // data.
+  out.resize(in.size() + kNumComponents);
+  db.Init(eb.data(), eb.size());
+  db.set_bitstream_version(bitstream_version_);
+  ASSERT_FALSE(DecodeSymbols(out.size(), kNumComponents, &db, &out[0]));
+
+  // The scheme is not supported by older bitstream versions.
+  db.Init(eb.data(), eb.size());
+  db.set_bitstream_version(DRACO_BITSTREAM_VERSION(2, 2));
+  ASSERT_FALSE(DecodeSymbols(in.size(), kNumComponents, &db, &out[0]));
+
+  // Decoding must fail before any rANS tables are allocated when the stream
+  // uses more contexts or a higher precision than needed for the number of
+  // values.
+  const uint8_t too_many_contexts[] = {SYMBOL_CODING_CONTEXT, 8, 1};
+  const uint8_t too_high_precision[] = {SYMBOL_CODING_CONTEXT, 1, 18};
+  for (const uint8_t *data : {too_many_contexts, too_high_precision}) {
+    db.Init(reinterpret_cast<const char *>(data), 3);
+    db.set_bitstream_version(bitstream_version_);
+    ASSERT_FALSE(DecodeSymbols(kNumComponents, kNumComponents, &db, &out[0]));
+  }
+}
+
+TEST_F(SymbolCodingTest, TestEntropySampling) {
+  // This test verifies that large inputs are encoded losslessly when the
+  // encoding method is selected from a subset of the symbols.
+  constexpr int kNumComponents = 3;
+  std::vector<uint32_t> in;
+  uint32_t seed = 1;
+  for (int i = 0; i < 3000000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const uint32_t range = 1u << ((i / 4096) % 12);
+    in.push_back((seed >> 16) % range);
+  }
+
+  EncoderBuffer default_eb;
+  ASSERT_TRUE(EncodeSymbols(in.data(), in.size(), kNumComponents, nullptr,
+                            &default_eb));
+
+  // Disabled sampling must not change the encoded data.
+  Options options;
+  SetSymbolEncodingEntropySampling(&options, false);
+  EncoderBuffer eb;
+  ASSERT_TRUE(
+      EncodeSymbols(in.data(), in.size(), kNumComponents, &options, &eb));
+  ASSERT_EQ(std::vector<char>(eb.data(), eb.data() + eb.size()),
+            std::vector<char>(default_eb.data(),
+                              default_eb.data() + default_eb.size()));
+
+  for (const bool context_modeling : {false, true}) {
+    SetSymbolEncodingEntropySampling(&options, true);
+    SetSymbolEncodingContextModeling(&options, context_modeling);
+    eb.Clear();
+    ASSERT_TRUE(
+        EncodeSymbols(in.data(), in.size(), kNumComponents, &options, &eb));
+
+    std::vector<uint32_t> out(in.size());
+    DecoderBuffer db;
+    db.Init(eb.data(), eb.size());
+    db.set_bitstream_version(bitstream_version_);
+    ASSERT_TRUE(DecodeSymbols(in.size(), kNumComponents, &db, &out[0]));
+    ASSERT_EQ(in, out);
+  }
+}
+
 TEST_F(SymbolCodingTest, TestConversionFullRange) {
   TestConvertToSymbolAndBack(static_cast<int8_t>(-128));
   TestConvertToSymbolAndBack(static_cast<int8_t>(-127));
@@ -18,6 +18,8 @@
 #include <cmath>
 
 #include "draco/compression/entropy/rans_symbol_decoder.h"
+#include "draco/compression/entropy/symbol_coding_contexts.h"
+#include "draco/core/varint_decoding.h"
 
 namespace draco {
 
@@ -29,6 +31,10 @@ template <template <int> class SymbolDecoderT>
 bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
                       uint32_t *out_values);
 
+template <template <int> class SymbolDecoderT>
+bool DecodeContextSymbols(uint32_t num_values, int num_components,
+                          DecoderBuffer *src_buffer, uint32_t *out_values);
+
 bool DecodeSymbols(uint32_t num_values, int num_components,
                    DecoderBuffer *src_buffer, uint32_t *out_values) {
   if (num_values == 0) {
@@ -45,6 +51,16 @@ bool DecodeSymbols(uint32_t num_values, int num_components,
   } else if (scheme == SYMBOL_CODING_RAW) {
     return DecodeRawSymbols<RAnsSymbolDecoder>(num_values, src_buffer,
                                                out_values);
+  } else if (scheme == SYMBOL_CODING_CONTEXT) {
+    // The context-modeling scheme was introduced in mesh bitstream version
+    // 2.3 and point cloud bitstream version 2.4. No point cloud of version 2.3
+    // could be encoded with the scheme, so checking the lower version is
+    // sufficient for both geometry types.
+    if (src_buffer->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 3)) {
+      return false;
+    }
+    return DecodeContextSymbols<RAnsSymbolDecoder>(num_values, num_components,
+                                                   src_buffer, out_values);
   }
   return false;
 }
@@ -178,4 +194,170 @@ bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
   }
 }
 
+template <class SymbolDecoderT>
+bool DecodeContextSymbolsInternal(uint32_t num_values, int num_components,
+                                  int num_magnitude_contexts,
+                                  int unique_symbols_bit_length,
+                                  DecoderBuffer *src_buffer,
+                                  uint32_t *out_values) {
+  // Prepare decoders for all contexts. Each context is stored as an
+  // independent stream of raw symbols.
+  const int num_contexts = num_components * num_magnitude_contexts;
+  std::vector<SymbolDecoderT> decoders(num_contexts);
+  std::vector<uint32_t> num_context_values(num_contexts, 0);
+  uint64_t total_num_values = 0;
+  int num_used_contexts = 0;
+  for (int i = 0; i < num_contexts; ++i) {
+    if (!DecodeVarint(&num_context_values[i], src_buffer)) {
+      return false;
+    }
+    if (num_context_values[i] == 0) {
+      continue;
+    }
+    // Check the sizes before the rANS decoder of the context is allocated.
+    total_num_values += num_context_values[i];
+    if (total_num_values > num_values) {
+      return false;
+    }
+    if (!IsSymbolCodingContextTableSizeValid(
+            ++num_used_contexts, unique_symbols_bit_length, num_values)) {
+      return false;
+    }
+    if (!decoders[i].Create(src_buffer)) {
+      return false;
+    }
+    if (decoders[i].num_symbols() == 0) {
+      return false;  // Wrong number of symbols.
+    }
+    if (!decoders[i].StartDecoding(src_buffer)) {
+      return false;
+    }
+  }
+  if (total_num_values != num_values) {
+    return false;
+  }
+
+  int component = 0;
+  for (uint32_t i = 0; i < num_values; ++i) {
+    const int context = GetSymbolCodingContext(out_values, i, component,
+                                               num_components,
+                                               num_magnitude_contexts);
+    if (num_context_values[context] == 0) {
+      return false;  // More values in the context than encoded.
+    }
+    --num_context_values[context];
+    out_values[i] = decoders[context].DecodeSymbol();
+    if (++component == num_components) {
+      component = 0;
+    }
+  }
+  for (int i = 0; i < num_contexts; ++i) {
+    if (decoders[i].num_symbols() > 0) {
+      decoders[i].EndDecoding();
+    }
+  }
+  return true;
+}
+
+template <template <int> class SymbolDecoderT>
+bool DecodeContextSymbols(uint32_t num_values, int num_components,
+                          DecoderBuffer *src_buffer, uint32_t *out_values) {
+  uint8_t num_magnitude_contexts;
+  if (!src_buffer->Decode(&num_magnitude_contexts)) {
+    return false;
+  }
+  if (num_components <= 0) {
+    num_components = 1;
+  }
+  const int num_contexts = num_components * num_magnitude_contexts;
+  if (num_magnitude_contexts == 0 ||
+      num_contexts > kMaxNumSymbolCodingContexts ||
+      static_cast<uint32_t>(num_contexts) > num_values) {
+    return false;
+  }
+  uint8_t max_bit_length;
+  if (!src_buffer->Decode(&max_bit_length)) {
+    return false;
+  }
+  if (max_bit_length > GetMaxSymbolCodingContextBitLength(num_values)) {
+    return false;
+  }
+  switch (max_bit_length) {
+    case 1:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<1>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 2:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<2>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 3:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<3>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 4:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<4>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 5:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<5>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 6:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<6>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 7:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<7>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 8:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<8>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 9:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<9>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 10:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<10>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 11:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<11>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 12:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<12>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 13:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<13>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 14:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<14>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 15:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<15>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 16:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<16>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 17:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<17>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    case 18:
+      return DecodeContextSymbolsInternal<SymbolDecoderT<18>>(
+          num_values, num_components, num_magnitude_contexts, max_bit_length,
+          src_buffer, out_values);
+    default:
+      return false;
+  }
+}
+
 }  // namespace draco
@@ -19,8 +19,10 @@
 
 #include "draco/compression/entropy/rans_symbol_encoder.h"
 #include "draco/compression/entropy/shannon_entropy.h"
+#include "draco/compression/entropy/symbol_coding_contexts.h"
 #include "draco/core/bit_utils.h"
 #include "draco/core/macros.h"
+#include "draco/core/varint_encoding.h"
 
 namespace draco {
 
@@ -28,6 +30,13 @@ constexpr int32_t kMaxTagSymbolBitLength = 32;
 constexpr int kMaxRawEncodingBitLength = 18;
 constexpr int kDefaultSymbolCodingCompressionLevel = 7;
 
+// When the entropy sampling is enabled, the sizes of the encoded data are
+// estimated from at most about |kMaxNumEntropySampledValues| values that are
+// taken in blocks of |kEntropySamplingBlockSize| values evenly distributed
+// over the input.
+constexpr int kMaxNumEntropySampledValues = 1 << 20;
+constexpr int kEntropySamplingBlockSize = 1 << 12;
+
 typedef uint64_t TaggedBitLengthFrequencies[kMaxTagSymbolBitLength];
 
 void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method) {
@@ -43,14 +52,27 @@ bool SetSymbolEncodingCompressionLevel(Options *options,
   return true;
 }
 
+void SetSymbolEncodingContextModeling(Options *options, bool enabled) {
+  options->SetBool("symbol_encoding_context_modeling", enabled);
+}
+
+void SetSymbolEncodingEntropySampling(Options *options, bool enabled) {
+  options->SetBool("symbol_encoding_entropy_sampling", enabled);
+}
+
 // Computes bit lengths of the input values. If num_components > 1, the values
 // are processed in "num_components" sized chunks and the bit length is always
-// computed for the largest value from the chunk.
-static void ComputeBitLengths(const uint32_t *symbols, int num_values,
-                              int num_components,
-                              std::vector<uint32_t> *out_bit_lengths,
-                              uint32_t *out_max_value) {
-  out_bit_lengths->reserve(num_values);
+// computed for the largest value from the chunk. The frequencies of all bit
+// lengths are computed in the same pass and stored in
+// |out_bit_length_frequencies|.
+static void ComputeBitLengths(
+    const uint32_t *symbols, int num_values, int num_components,
+    std::vector<uint32_t> *out_bit_lengths,
+    TaggedBitLengthFrequencies out_bit_length_frequencies,
+    uint32_t *out_max_value) {
+  out_bit_lengths->resize((num_values + num_components - 1) / num_components);
+  uint32_t *const bit_lengths = out_bit_lengths->data();
+  memset(out_bit_length_frequencies, 0, sizeof(TaggedBitLengthFrequencies));
   *out_max_value = 0;
   // Maximum integer value across all components.
   for (int i = 0; i < num_values; i += num_components) {
@@ -68,50 +90,245 @@ static void ComputeBitLengths(const uint32_t *symbols, int num_values,
     if (max_component_value > *out_max_value) {
       *out_max_value = max_component_value;
     }
-    out_bit_lengths->push_back(value_msb_pos + 1);
+    bit_lengths[i / num_components] = value_msb_pos + 1;
+    ++out_bit_length_frequencies[value_msb_pos + 1];
   }
 }
 
 static int64_t ApproximateTaggedSchemeBits(
-    const std::vector<uint32_t> bit_lengths, int num_components) {
+    const TaggedBitLengthFrequencies bit_length_frequencies,
+    int num_components) {
   // Compute the total bit length used by all values (the length of data encode
   // after tags).
   uint64_t total_bit_length = 0;
-  for (size_t i = 0; i < bit_lengths.size(); ++i) {
-    total_bit_length += bit_lengths[i];
+  for (int i = 0; i < kMaxTagSymbolBitLength; ++i) {
+    total_bit_length += bit_length_frequencies[i] * i;
   }
   // Compute the number of entropy bits for tags.
   int num_unique_symbols;
-  const int64_t tag_bits = ComputeShannonEntropy(
-      bit_lengths.data(), static_cast<int>(bit_lengths.size()), 32,
-      &num_unique_symbols);
+  const int64_t tag_bits = ComputeShannonEntropyFromFrequencies(
+      bit_length_frequencies, kMaxTagSymbolBitLength, &num_unique_symbols);
   const int64_t tag_table_bits =
       ApproximateRAnsFrequencyTableBits(num_unique_symbols, num_unique_symbols);
   return tag_bits + tag_table_bits + total_bit_length * num_components;
 }
 
-static int64_t ApproximateRawSchemeBits(const uint32_t *symbols,
-                                        int num_symbols, uint32_t max_value,
-                                        int *out_num_unique_symbols) {
+// Approximates the number of bits of the raw scheme from the |frequencies| of
+// all symbols in range <0, max_value>.
+static int64_t ApproximateRawSchemeBits(
+    const std::vector<uint64_t> &frequencies, uint32_t max_value,
+    int *out_num_unique_symbols) {
   int num_unique_symbols;
-  const int64_t data_bits = ComputeShannonEntropy(
-      symbols, num_symbols, max_value, &num_unique_symbols);
+  const int64_t data_bits = ComputeShannonEntropyFromFrequencies(
+      frequencies.data(), static_cast<int>(frequencies.size()),
+      &num_unique_symbols);
   const int64_t table_bits =
       ApproximateRAnsFrequencyTableBits(max_value, num_unique_symbols);
   *out_num_unique_symbols = num_unique_symbols;
   return table_bits + data_bits;
 }
 
+// Returns the number of symbols with a non-zero frequency.
+static int CountUniqueSymbols(const std::vector<uint64_t> &frequencies) {
+  int num_unique_symbols = 0;
+  for (const uint64_t frequency : frequencies) {
+    if (frequency > 0) {
+      ++num_unique_symbols;
+    }
+  }
+  return num_unique_symbols;
+}
+
+// Returns the distance between the starts of two consecutive blocks of values
+// that are used to estimate the sizes of the encoded data, or 0 when all
+// values are used. The distance is always a multiple of |num_components|.
+static int GetEntropySamplingPeriod(int num_values, int num_components,
+                                    const Options *options) {
+  if (options == nullptr ||
+      !options->GetBool("symbol_encoding_entropy_sampling", false) ||
+      num_values <= 2 * kMaxNumEntropySampledValues) {
+    return 0;
+  }
+  const int num_blocks =
+      kMaxNumEntropySampledValues / kEntropySamplingBlockSize;
+  const int period = num_values / num_blocks;
+  return period - period % num_components;
+}
+
+// Returns the number of values in each sampled block. The value is always a
+// multiple of |num_components|.
+static int GetEntropySamplingBlockSize(int num_components) {
+  return std::max(num_components, kEntropySamplingBlockSize -
+                                      kEntropySamplingBlockSize %
+                                          num_components);
+}
+
+// Splits the input symbols in range <begin, end) into the coding contexts of
+// the context-modeling scheme (see GetSymbolCodingContext()). The symbols are
+// appended to |out_context_symbols| that must already contain all contexts.
+// |begin| must be a multiple of |num_components|.
+static void SplitSymbolsIntoContexts(
+    const uint32_t *symbols, int begin, int end, int num_components,
+    int num_magnitude_contexts,
+    std::vector<std::vector<uint32_t>> *out_context_symbols) {
+  int component = 0;
+  for (int i = begin; i < end; ++i) {
+    const int context = GetSymbolCodingContext(symbols, i, component,
+                                               num_components,
+                                               num_magnitude_contexts);
+    (*out_context_symbols)[context].push_back(symbols[i]);
+    if (++component == num_components) {
+      component = 0;
+    }
+  }
+}
+
+// Computes the frequencies of symbols of all contexts. Returns the maximum
+// number of unique symbols in any context.
+static int ComputeContextFrequencies(
+    const std::vector<std::vector<uint32_t>> &context_symbols,
+    std::vector<std::vector<uint64_t>> *out_context_frequencies) {
+  out_context_frequencies->resize(context_symbols.size());
+  int max_num_unique_symbols = 0;
+  for (size_t i = 0; i < context_symbols.size(); ++i) {
+    const std::vector<uint32_t> &symbols = context_symbols[i];
+    std::vector<uint64_t> &frequencies = (*out_context_frequencies)[i];
+    if (symbols.empty()) {
+      frequencies.clear();
+      continue;
+    }
+    const uint32_t max_value =
+        *std::max_element(symbols.begin(), symbols.end());
+    ComputeSymbolFrequencies(symbols.data(), static_cast<int>(symbols.size()),
+                             max_value, &frequencies);
+    max_num_unique_symbols =
+        std::max(max_num_unique_symbols, CountUniqueSymbols(frequencies));
+  }
+  return max_num_unique_symbols;
+}
+
+static int64_t ApproximateContextSchemeBits(
+    const std::vector<std::vector<uint64_t>> &context_frequencies) {
+  int64_t total_bits = 0;
+  for (const std::vector<uint64_t> &frequencies : context_frequencies) {
+    // Number of symbols in the context.
+    total_bits += 8;
+    if (frequencies.empty()) {
+      continue;
+    }
+    int num_unique_symbols;
+    total_bits += ApproximateRawSchemeBits(
+        frequencies, static_cast<uint32_t>(frequencies.size() - 1),
+        &num_unique_symbols);
+  }
+  return total_bits;
+}
+
+// Selects the number of magnitude contexts per component that is expected to
+// result in the smallest output of the context-modeling scheme. More contexts
+// capture the data better, but each context needs its own frequency table.
+// When |sampling_period| is not 0, only blocks of values starting at
+// multiples of |sampling_period| are used for the estimate.
+// Returns the estimated number of bits or -1 when the scheme can't be used.
+static int64_t SelectNumMagnitudeContexts(const uint32_t *symbols,
+                                          int num_values, int num_components,
+                                          int sampling_period,
+                                          int *out_num_magnitude_contexts) {
+  int64_t best_bits = -1;
+  for (int num_magnitude_contexts = 1; num_magnitude_contexts <= 8;
+       num_magnitude_contexts *= 2) {
+    // The decoder doesn't accept more contexts than coded values.
+    if (num_components * num_magnitude_contexts >
+            kMaxNumSymbolCodingContexts ||
+        num_components * num_magnitude_contexts > num_values) {
+      break;
+    }
+    std::vector<std::vector<uint32_t>> context_symbols(
+        num_components * num_magnitude_contexts);
+    if (sampling_period == 0) {
+      SplitSymbolsIntoContexts(symbols, 0, num_values, num_components,
+                               num_magnitude_contexts, &context_symbols);
+    } else {
+      const int block_size = GetEntropySamplingBlockSize(num_components);
+      for (int i = 0; i < num_values; i += sampling_period) {
+        SplitSymbolsIntoContexts(symbols, i,
+                                 std::min(num_values, i + block_size),
+                                 num_components, num_magnitude_contexts,
+                                 &context_symbols);
+      }
+    }
+    std::vector<std::vector<uint64_t>> context_frequencies;
+    ComputeContextFrequencies(context_symbols, &context_frequencies);
+    const int64_t bits = ApproximateContextSchemeBits(context_frequencies);
+    if (best_bits < 0 || bits < best_bits) {
+      best_bits = bits;
+      *out_num_magnitude_contexts = num_magnitude_contexts;
+    }
+  }
+  return best_bits;
+}
+
+// Returns the bit length of the number of unique symbols that is used to
+// select the precision of the rANS coding of raw symbols. The value is
+// adjusted according to the compression level set in |options|. Returns -1
+// when there are too many unique symbols.
+static int ComputeRawSymbolsBitLength(int32_t num_unique_symbols,
+                                      const Options *options) {
+  int symbol_bits = 0;
+  if (num_unique_symbols > 0) {
+    symbol_bits = MostSignificantBit(num_unique_symbols);
+  }
+  int unique_symbols_bit_length = symbol_bits + 1;
+  // Currently, we don't support encoding of more than 2^18 unique symbols.
+  if (unique_symbols_bit_length > kMaxRawEncodingBitLength) {
+    return -1;
+  }
+  int compression_level = kDefaultSymbolCodingCompressionLevel;
+  if (options != nullptr &&
+      options->IsOptionSet("symbol_encoding_compression_level")) {
+    compression_level = options->GetInt("symbol_encoding_compression_level");
+  }
+
+  // Adjust the bit_length based on compression level. Lower compression levels
+  // will use fewer bits while higher compression levels use more bits. Note
+  // that this is going to work for all valid bit_lengths because the actual
+  // number of bits allocated for rANS encoding is hard coded as:
+  // std::max(12, 3 * bit_length / 2) , therefore there will be always a
+  // sufficient number of bits available for all symbols.
+  // See ComputeRAnsPrecisionFromUniqueSymbolsBitLength() for the formula.
+  // This hardcoded equation cannot be changed without changing the bitstream.
+  if (compression_level < 4) {
+    unique_symbols_bit_length -= 2;
+  } else if (compression_level < 6) {
+    unique_symbols_bit_length -= 1;
+  } else if (compression_level > 9) {
+    unique_symbols_bit_length += 2;
+  } else if (compression_level > 7) {
+    unique_symbols_bit_length += 1;
+  }
+  // Clamp the bit_length to a valid range.
+  return std::min(std::max(1, unique_symbols_bit_length),
+                  kMaxRawEncodingBitLength);
+}
+
 template <template <int> class SymbolEncoderT>
-bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
-                         int num_components,
-                         const std::vector<uint32_t> &bit_lengths,
-                         EncoderBuffer *target_buffer);
+bool EncodeTaggedSymbols(
+    const uint32_t *symbols, int num_values, int num_components,
+    const std::vector<uint32_t> &bit_lengths,
+    const TaggedBitLengthFrequencies bit_length_frequencies,
+    EncoderBuffer *target_buffer);
 
 template <template <int> class SymbolEncoderT>
 bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
-                      uint32_t max_entry_value, int32_t num_unique_symbols,
-                      const Options *options, EncoderBuffer *target_buffer);
+                      const std::vector<uint64_t> &frequencies,
+                      int32_t num_unique_symbols, const Options *options,
+                      EncoderBuffer *target_buffer);
+
+template <template <int> class SymbolEncoderT>
+bool EncodeContextSymbols(const uint32_t *symbols, int num_values,
+                          int num_components, int num_magnitude_contexts,
+                          const Options *options,
+                          EncoderBuffer *target_buffer);
 
 bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
                    const Options *options, EncoderBuffer *target_buffer) {
@@ -124,74 +341,153 @@ bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
   if (num_components <= 0) {
     num_components = 1;
   }
+  // Bit lengths of all entries and the frequencies of the bit lengths are
+  // computed in a single pass and they are used for both the estimate and the
+  // encoding of the tagged scheme.
   std::vector<uint32_t> bit_lengths;
+  TaggedBitLengthFrequencies bit_length_frequencies;
   uint32_t max_value;
   ComputeBitLengths(symbols, num_values, num_components, &bit_lengths,
-                    &max_value);
-
-  // Approximate number of bits needed for storing the symbols using the tagged
-  // scheme.
-  const int64_t tagged_scheme_total_bits =
-      ApproximateTaggedSchemeBits(bit_lengths, num_components);
-
-  // Approximate number of bits needed for storing the symbols using the raw
-  // scheme.
-  int num_unique_symbols = 0;
-  const int64_t raw_scheme_total_bits = ApproximateRawSchemeBits(
-      symbols, num_values, max_value, &num_unique_symbols);
+                    bit_length_frequencies, &max_value);
 
   // The maximum bit length of a single entry value that we can encode using
   // the raw scheme.
   const int max_value_bit_length =
       MostSignificantBit(std::max(1u, max_value)) + 1;
 
+  const int sampling_period =
+      GetEntropySamplingPeriod(num_values, num_components, options);
+
+  // Frequencies of all symbols. They are computed at most once and shared by
+  // the estimate and the encoding of the raw scheme.
+  std::vector<uint64_t> frequencies;
+  int num_unique_symbols = 0;
+
   int method = -1;
   if (options != nullptr && options->IsOptionSet("symbol_encoding_method")) {
     method = options->GetInt("symbol_encoding_method");
+  } else if (max_value_bit_length > kMaxRawEncodingBitLength) {
+    method = SYMBOL_CODING_TAGGED;
   } else {
-    if (tagged_scheme_total_bits < raw_scheme_total_bits ||
-        max_value_bit_length > kMaxRawEncodingBitLength) {
+    // Approximate number of bits needed for storing the symbols using the
+    // tagged scheme.
+    const int64_t tagged_scheme_total_bits =
+        ApproximateTaggedSchemeBits(bit_length_frequencies, num_components);
+
+    // Approximate number of bits needed for storing the symbols using the raw
+    // scheme.
+    int64_t raw_scheme_total_bits;
+    if (sampling_period == 0) {
+      ComputeSymbolFrequencies(symbols, num_values, max_value, &frequencies);
+      raw_scheme_total_bits = ApproximateRawSchemeBits(frequencies, max_value,
+                                                       &num_unique_symbols);
+    } else {
+      // Only a subset of symbols is used to estimate the entropy of the data.
+      // The exact frequencies are computed later if the raw scheme is used.
+      std::vector<uint32_t> sampled_symbols;
+      const int block_size = GetEntropySamplingBlockSize(num_components);
+      for (int i = 0; i < num_values; i += sampling_period) {
+        sampled_symbols.insert(sampled_symbols.end(), symbols + i,
+                               symbols + std::min(num_values, i + block_size));
+      }
+      std::vector<uint64_t> sampled_frequencies;
+      ComputeSymbolFrequencies(sampled_symbols.data(),
+                               static_cast<int>(sampled_symbols.size()),
+                               max_value, &sampled_frequencies);
+      int num_sampled_unique_symbols;
+      const int64_t sampled_data_bits = ComputeShannonEntropyFromFrequencies(
+          sampled_frequencies.data(),
+          static_cast<int>(sampled_frequencies.size()),
+          &num_sampled_unique_symbols);
+      raw_scheme_total_bits =
+          static_cast<int64_t>(static_cast<double>(sampled_data_bits) *
+                               num_values / sampled_symbols.size()) +
+          ApproximateRAnsFrequencyTableBits(max_value,
+                                            num_sampled_unique_symbols);
+    }
+
+    if (tagged_scheme_total_bits < raw_scheme_total_bits) {
       method = SYMBOL_CODING_TAGGED;
     } else {
       method = SYMBOL_CODING_RAW;
     }
   }
-  // Use the tagged scheme.
-  target_buffer->Encode(static_cast<uint8_t>(method));
-  if (method == SYMBOL_CODING_TAGGED) {
-    return EncodeTaggedSymbols<RAnsSymbolEncoder>(
-        symbols, num_values, num_components, bit_lengths, target_buffer);
+
+  // The context-modeling scheme is considered only when it was explicitly
+  // selected or allowed by the options.
+  int num_magnitude_contexts = 1;
+  bool allow_context_scheme =
+      options != nullptr && !options->IsOptionSet("symbol_encoding_method") &&
+      options->GetBool("symbol_encoding_context_modeling", false) &&
+      max_value_bit_length <= kMaxRawEncodingBitLength;
+  if (method == SYMBOL_CODING_CONTEXT || allow_context_scheme) {
+    if (SelectNumMagnitudeContexts(symbols, num_values, num_components,
+                                   sampling_period,
+                                   &num_magnitude_contexts) < 0) {
+      if (method == SYMBOL_CODING_CONTEXT) {
+        return false;
+      }
+      allow_context_scheme = false;
+    }
   }
-  if (method == SYMBOL_CODING_RAW) {
-    return EncodeRawSymbols<RAnsSymbolEncoder>(symbols, num_values, max_value,
-                                               num_unique_symbols, options,
-                                               target_buffer);
+
+  const auto encode_symbols = [&](int selected_method,
+                                  EncoderBuffer *buffer) -> bool {
+    buffer->Encode(static_cast<uint8_t>(selected_method));
+    if (selected_method == SYMBOL_CODING_TAGGED) {
+      return EncodeTaggedSymbols<RAnsSymbolEncoder>(
+          symbols, num_values, num_components, bit_lengths,
+          bit_length_frequencies, buffer);
+    }
+    if (selected_method == SYMBOL_CODING_RAW) {
+      if (frequencies.empty()) {
+        ComputeSymbolFrequencies(symbols, num_values, max_value, &frequencies);
+        num_unique_symbols = CountUniqueSymbols(frequencies);
+      }
+      return EncodeRawSymbols<RAnsSymbolEncoder>(
+          symbols, num_values, frequencies, num_unique_symbols, options,
+          buffer);
+    }
+    if (selected_method == SYMBOL_CODING_CONTEXT) {
+      return EncodeContextSymbols<RAnsSymbolEncoder>(
+          symbols, num_values, num_components, num_magnitude_contexts, options,
+          buffer);
+    }
+    // Unknown method selected.
+    return false;
+  };
+
+  if (allow_context_scheme) {
+    // The context-modeling scheme stores many frequency tables and its size
+    // estimate is not precise enough to be compared with the estimates of the
+    // other schemes. Therefore, the data is encoded with both the context
+    // scheme and the scheme selected above and the smaller output is used.
+    EncoderBuffer selected_buffer;
+    if (!encode_symbols(method, &selected_buffer)) {
+      return false;
+    }
+    EncoderBuffer context_buffer;
+    const EncoderBuffer *best_buffer = &selected_buffer;
+    if (encode_symbols(SYMBOL_CODING_CONTEXT, &context_buffer) &&
+        context_buffer.size() < selected_buffer.size()) {
+      best_buffer = &context_buffer;
+    }
+    return target_buffer->Encode(best_buffer->data(), best_buffer->size());
   }
-  // Unknown method selected.
-  return false;
+  return encode_symbols(method, target_buffer);
 }
 
 template <template <int> class SymbolEncoderT>
-bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
-                         int num_components,
-                         const std::vector<uint32_t> &bit_lengths,
-                         EncoderBuffer *target_buffer) {
-  // Create entries for entropy coding. Each entry corresponds to a different
-  // number of bits that are necessary to encode a given value. Every value
-  // has at most 32 bits. Therefore, we need 32 different entries (for
-  // bit_length [1-32]). For each entry we compute the frequency of a given
-  // bit-length in our data set.
-  TaggedBitLengthFrequencies frequencies;
-  // Set frequency for each entry to zero.
-  memset(frequencies, 0, sizeof(frequencies));
-
-  // Compute the frequencies from input data.
-  // Maximum integer value for the values across all components.
-  for (size_t i = 0; i < bit_lengths.size(); ++i) {
-    // Update the frequency of the associated entry id.
-    ++frequencies[bit_lengths[i]];
-  }
-
+bool EncodeTaggedSymbols(
+    const uint32_t *symbols, int num_values, int num_components,
+    const std::vector<uint32_t> &bit_lengths,
+    const TaggedBitLengthFrequencies bit_length_frequencies,
+    EncoderBuffer *target_buffer) {
+  // Entries for entropy coding. Each entry corresponds to a different number
+  // of bits that are necessary to encode a given value. Every value has at
+  // most 32 bits. Therefore, we need 32 different entries (for bit_length
+  // [1-32]). For each entry we have the frequency of a given bit-length in
+  // our data set.
   // Create one extra buffer to store raw value.
   EncoderBuffer value_buffer;
   // Number of expected bits we need to store the values (can be optimized if
@@ -201,7 +497,8 @@ bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
 
   // Create encoder for encoding the bit tags.
   SymbolEncoderT<5> tag_encoder;
-  tag_encoder.Create(frequencies, kMaxTagSymbolBitLength, target_buffer);
+  tag_encoder.Create(bit_length_frequencies, kMaxTagSymbolBitLength,
+                     target_buffer);
 
   // Start encoding bit tags.
   tag_encoder.StartEncoding(target_buffer);
@@ -244,14 +541,8 @@ bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
 
 template <class SymbolEncoderT>
 bool EncodeRawSymbolsInternal(const uint32_t *symbols, int num_values,
-                              uint32_t max_entry_value,
+                              const std::vector<uint64_t> &frequencies,
                               EncoderBuffer *target_buffer) {
-  // Count the frequency of each entry value.
-  std::vector<uint64_t> frequencies(max_entry_value + 1, 0);
-  for (int i = 0; i < num_values; ++i) {
-    ++frequencies[symbols[i]];
-  }
-
   SymbolEncoderT encoder;
   encoder.Create(frequencies.data(), static_cast<int>(frequencies.size()),
                  target_buffer);
@@ -272,43 +563,14 @@ bool EncodeRawSymbolsInternal(const uint32_t *symbols, int num_values,
 
 template <template <int> class SymbolEncoderT>
 bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
-                      uint32_t max_entry_value, int32_t num_unique_symbols,
-                      const Options *options, EncoderBuffer *target_buffer) {
-  int symbol_bits = 0;
-  if (num_unique_symbols > 0) {
-    symbol_bits = MostSignificantBit(num_unique_symbols);
-  }
-  int unique_symbols_bit_length = symbol_bits + 1;
-  // Currently, we don't support encoding of more than 2^18 unique symbols.
-  if (unique_symbols_bit_length > kMaxRawEncodingBitLength) {
+                      const std::vector<uint64_t> &frequencies,
+                      int32_t num_unique_symbols, const Options *options,
+                      EncoderBuffer *target_buffer) {
+  const int unique_symbols_bit_length =
+      ComputeRawSymbolsBitLength(num_unique_symbols, options);
+  if (unique_symbols_bit_length < 0) {
     return false;
   }
-  int compression_level = kDefaultSymbolCodingCompressionLevel;
-  if (options != nullptr &&
-      options->IsOptionSet("symbol_encoding_compression_level")) {
-    compression_level = options->GetInt("symbol_encoding_compression_level");
-  }
-
-  // Adjust the bit_length based on compression level. Lower compression levels
-  // will use fewer bits while higher compression levels use more bits. Note
-  // that this is going to work for all valid bit_lengths because the actual
-  // number of bits allocated for rANS encoding is hard coded as:
-  // std::max(12, 3 * bit_length / 2) , therefore there will be always a
-  // sufficient number of bits available for all symbols.
-  // See ComputeRAnsPrecisionFromUniqueSymbolsBitLength() for the formula.
-  // This hardcoded equation cannot be changed without changing the bitstream.
-  if (compression_level < 4) {
-    unique_symbols_bit_length -= 2;
-  } else if (compression_level < 6) {
-    unique_symbols_bit_length -= 1;
-  } else if (compression_level > 9) {
-    unique_symbols_bit_length += 2;
-  } else if (compression_level > 7) {
-    unique_symbols_bit_length += 1;
-  }
-  // Clamp the bit_length to a valid range.
-  unique_symbols_bit_length = std::min(std::max(1, unique_symbols_bit_length),
-                                       kMaxRawEncodingBitLength);
   target_buffer->Encode(static_cast<uint8_t>(unique_symbols_bit_length));
   // Use appropriate symbol encoder based on the maximum symbol bit length.
   switch (unique_symbols_bit_length) {
@@ -316,58 +578,177 @@ bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
       FALLTHROUGH_INTENDED;
     case 1:
       return EncodeRawSymbolsInternal<SymbolEncoderT<1>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 2:
       return EncodeRawSymbolsInternal<SymbolEncoderT<2>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 3:
       return EncodeRawSymbolsInternal<SymbolEncoderT<3>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 4:
       return EncodeRawSymbolsInternal<SymbolEncoderT<4>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 5:
       return EncodeRawSymbolsInternal<SymbolEncoderT<5>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 6:
       return EncodeRawSymbolsInternal<SymbolEncoderT<6>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 7:
       return EncodeRawSymbolsInternal<SymbolEncoderT<7>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 8:
       return EncodeRawSymbolsInternal<SymbolEncoderT<8>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 9:
       return EncodeRawSymbolsInternal<SymbolEncoderT<9>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 10:
       return EncodeRawSymbolsInternal<SymbolEncoderT<10>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 11:
       return EncodeRawSymbolsInternal<SymbolEncoderT<11>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 12:
       return EncodeRawSymbolsInternal<SymbolEncoderT<12>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 13:
       return EncodeRawSymbolsInternal<SymbolEncoderT<13>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 14:
       return EncodeRawSymbolsInternal<SymbolEncoderT<14>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 15:
       return EncodeRawSymbolsInternal<SymbolEncoderT<15>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 16:
       return EncodeRawSymbolsInternal<SymbolEncoderT<16>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 17:
       return EncodeRawSymbolsInternal<SymbolEncoderT<17>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
     case 18:
       return EncodeRawSymbolsInternal<SymbolEncoderT<18>>(
-          symbols, num_values, max_entry_value, target_buffer);
+          symbols, num_values, frequencies, target_buffer);
+    default:
+      return false;
+  }
+}
+
+template <class SymbolEncoderT>
+bool EncodeContextSymbolsInternal(
+    const std::vector<std::vector<uint32_t>> &context_symbols,
+    const std::vector<std::vector<uint64_t>> &context_frequencies,
+    EncoderBuffer *target_buffer) {
+  // Each context is encoded as an independent stream of raw symbols that is
+  // preceded by the number of symbols in the context.
+  for (size_t i = 0; i < context_symbols.size(); ++i) {
+    const std::vector<uint32_t> &symbols = context_symbols[i];
+    EncodeVarint(static_cast<uint32_t>(symbols.size()), target_buffer);
+    if (symbols.empty()) {
+      continue;
+    }
+    if (!EncodeRawSymbolsInternal<SymbolEncoderT>(
+            symbols.data(), static_cast<int>(symbols.size()),
+            context_frequencies[i], target_buffer)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <template <int> class SymbolEncoderT>
+bool EncodeContextSymbols(const uint32_t *symbols, int num_values,
+                          int num_components, int num_magnitude_contexts,
+                          const Options *options,
+                          EncoderBuffer *target_buffer) {
+  if (num_components * num_magnitude_contexts > kMaxNumSymbolCodingContexts ||
+      num_components * num_magnitude_contexts > num_values) {
+    return false;
+  }
+  std::vector<std::vector<uint32_t>> context_symbols(num_components *
+                                                     num_magnitude_contexts);
+  SplitSymbolsIntoContexts(symbols, 0, num_values, num_components,
+                           num_magnitude_contexts, &context_symbols);
+  std::vector<std::vector<uint64_t>> context_frequencies;
+  const int max_num_unique_symbols =
+      ComputeContextFrequencies(context_symbols, &context_frequencies);
+  // All contexts share the same precision of the rANS coding.
+  const int unique_symbols_bit_length =
+      ComputeRawSymbolsBitLength(max_num_unique_symbols, options);
+  if (unique_symbols_bit_length < 0) {
+    return false;
+  }
+  // The scheme can't be used when the decoder would have to allocate too many
+  // large rANS tables for the number of coded values.
+  int num_used_contexts = 0;
+  for (const std::vector<uint32_t> &symbols : context_symbols) {
+    if (!symbols.empty()) {
+      ++num_used_contexts;
+    }
+  }
+  if (!IsSymbolCodingContextTableSizeValid(num_used_contexts,
+                                           unique_symbols_bit_length,
+                                           num_values)) {
+    return false;
+  }
+  target_buffer->Encode(static_cast<uint8_t>(num_magnitude_contexts));
+  target_buffer->Encode(static_cast<uint8_t>(unique_symbols_bit_length));
+  switch (unique_symbols_bit_length) {
+    case 1:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<1>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 2:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<2>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 3:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<3>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 4:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<4>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 5:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<5>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 6:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<6>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 7:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<7>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 8:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<8>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 9:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<9>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 10:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<10>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 11:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<11>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 12:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<12>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 13:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<13>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 14:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<14>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 15:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<15>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 16:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<16>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 17:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<17>>(
+          context_symbols, context_frequencies, target_buffer);
+    case 18:
+      return EncodeContextSymbolsInternal<SymbolEncoderT<18>>(
+          context_symbols, context_frequencies, target_buffer);
     default:
       return false;
   }
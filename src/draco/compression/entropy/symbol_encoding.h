@@ -42,6 +42,20 @@ void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method);
 // Returns false if an invalid level has been set.
 bool SetSymbolEncodingCompressionLevel(Options *options, int compression_level);
 
+// Allows the symbol encoder to select the context-modeling method
+// (SYMBOL_CODING_CONTEXT) when it is expected to produce a smaller output than
+// the other methods. The method is disabled by default because its gains are
+// small: on the bunny test models the encoded files shrink only by about 1-5%,
+// well short of the 10-20% targeted by the method, while the decoding of the
+// attribute values is about 5-10% slower.
+void SetSymbolEncodingContextModeling(Options *options, bool enabled);
+
+// Allows the symbol encoder to estimate the sizes of the encoded data from a
+// subset of the input symbols when the input is very large. This speeds up
+// the selection of the encoding method at the cost of a possibly suboptimal
+// decision. The encoded data is always lossless.
+void SetSymbolEncodingEntropySampling(Options *options, bool enabled);
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_ENTROPY_SYMBOL_ENCODING_H_
@@ -14,14 +14,17 @@
 //
 #include "draco/compression/expert_encode.h"
 
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
 #include "draco/compression/mesh/mesh_sequential_encoder.h"
+#include "draco/core/thread_pool.h"
 #ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
 #include "draco/compression/point_cloud/point_cloud_kd_tree_encoder.h"
 #include "draco/compression/point_cloud/point_cloud_sequential_encoder.h"
@@ -29,9 +32,57 @@
 
 #ifdef DRACO_TRANSCODER_SUPPORTED
 #include "draco/core/bit_utils.h"
+#include "draco/mesh/mesh_utils.h"
 #endif
 namespace draco {
 
+namespace {
+
+// Symbol encoding compression levels that result in distinct bit lengths of
+// the rANS coder (see EncodeRawSymbols() in symbol_encoding.cc).
+constexpr int kCandidateCompressionLevels[] = {0, 4, 7, 8, 10};
+
+// Prediction schemes evaluated by ExpertEncoder::OptimizeAttributeEncoding().
+constexpr PredictionSchemeMethod kCandidatePredictionSchemes[] = {
+    PREDICTION_DIFFERENCE, MESH_PREDICTION_PARALLELOGRAM,
+    MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM,
+    MESH_PREDICTION_TEX_COORDS_PORTABLE, MESH_PREDICTION_GEOMETRIC_NORMAL};
+
+// Returns the fastest decoding speed for which SelectPredictionMethod() can
+// select the prediction scheme |method|.
+int GetMaxDecodingSpeed(PredictionSchemeMethod method) {
+  switch (method) {
+    case MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM:
+      return 1;
+    case MESH_PREDICTION_TEX_COORDS_PORTABLE:
+    case MESH_PREDICTION_GEOMETRIC_NORMAL:
+      return 3;
+    case MESH_PREDICTION_PARALLELOGRAM:
+      return 7;
+    default:
+      return 10;
+  }
+}
+
+// Candidate setting of a single attribute option evaluated by a trial
+// encoding.
+struct EncodingTrial {
+  int att_id;
+  bool is_prediction_scheme;  // Otherwise the symbol coding level is set.
+  int value;
+  int64_t encoded_size;
+};
+
+void ApplyEncodingTrial(const EncodingTrial &trial, EncoderOptions *options) {
+  options->SetAttributeInt(trial.att_id,
+                           trial.is_prediction_scheme
+                               ? "prediction_scheme"
+                               : "symbol_encoding_compression_level",
+                           trial.value);
+}
+
+}  // namespace
+
 ExpertEncoder::ExpertEncoder(const PointCloud &point_cloud)
     : point_cloud_(&point_cloud), mesh_(nullptr) {}
 
@@ -103,6 +154,8 @@ Status ExpertEncoder::EncodePointCloudToBuffer(const PointCloud &pc,
     encoder.reset(new PointCloudSequentialEncoder());
   }
   encoder->SetPointCloud(pc);
+  mutable_stats()->Clear();
+  encoder->set_stats(mutable_stats());
   DRACO_RETURN_IF_ERROR(encoder->Encode(options(), out_buffer));
 
   set_num_encoded_points(encoder->num_encoded_points());
@@ -137,6 +190,8 @@ Status ExpertEncoder::EncodeMeshToBuffer(const Mesh &m,
     encoder = std::unique_ptr<MeshEncoder>(new MeshSequentialEncoder());
   }
   encoder->SetMesh(m);
+  mutable_stats()->Clear();
+  encoder->set_stats(mutable_stats());
 
   DRACO_RETURN_IF_ERROR(encoder->Encode(options(), out_buffer));
 
@@ -177,6 +232,22 @@ void ExpertEncoder::SetUseBuiltInAttributeCompression(bool enabled) {
   options().SetGlobalBool("use_built_in_attribute_compression", enabled);
 }
 
+void ExpertEncoder::SetSymbolEncodingContextModeling(bool enabled) {
+  options().SetGlobalBool("symbol_encoding_context_modeling", enabled);
+}
+
+void ExpertEncoder::SetSymbolEncodingEntropySampling(bool enabled) {
+  options().SetGlobalBool("symbol_encoding_entropy_sampling", enabled);
+}
+
+void ExpertEncoder::SetNumAttributeEncodingThreads(int num_threads) {
+  options().SetGlobalInt("num_attribute_encoding_threads", num_threads);
+}
+
+void ExpertEncoder::SetNumConnectivityEncodingThreads(int num_threads) {
+  options().SetGlobalInt("num_connectivity_encoding_threads", num_threads);
+}
+
 void ExpertEncoder::SetEncodingMethod(int encoding_method) {
   Base::SetEncodingMethod(encoding_method);
 }
@@ -199,6 +270,148 @@ Status ExpertEncoder::SetAttributePredictionScheme(
   return status;
 }
 
+void ExpertEncoder::SetAttributeSymbolEncodingCompressionLevel(
+    int32_t attribute_id, int compression_level) {
+  options().SetAttributeInt(attribute_id, "symbol_encoding_compression_level",
+                            compression_level);
+}
+
+void ExpertEncoder::SetAttributeSymbolEncodingContextModeling(
+    int32_t attribute_id, bool enabled) {
+  options().SetAttributeBool(attribute_id, "symbol_encoding_context_modeling",
+                             enabled);
+}
+
+StatusOr<ExpertEncoder::AttributeEncodingOptimization>
+ExpertEncoder::OptimizeAttributeEncoding(int num_threads) {
+  if (point_cloud_ == nullptr) {
+    return Status(Status::DRACO_ERROR, "Invalid input geometry.");
+  }
+  const EncoderOptions initial_options = options();
+  AttributeEncodingOptimization result;
+  result.attributes.assign(point_cloud_->num_attributes(),
+                           AttributeEncodingConfig{-1, -1});
+  result.default_size = ComputeEncodedSize(initial_options);
+  if (result.default_size < 0) {
+    return Status(Status::DRACO_ERROR, "Failed to encode the input geometry.");
+  }
+  result.optimized_size = result.default_size;
+
+  // Gather all candidate settings that fit within the decoding speed budget.
+  const int decoding_speed = initial_options.GetDecodingSpeed();
+  std::vector<EncodingTrial> trials;
+  for (int att_id = 0; att_id < point_cloud_->num_attributes(); ++att_id) {
+    const GeometryAttribute::Type att_type =
+        point_cloud_->attribute(att_id)->attribute_type();
+    // Prediction schemes are used only by mesh encoders.
+    if (mesh_ != nullptr &&
+        !initial_options.IsAttributeOptionSet(att_id, "prediction_scheme")) {
+      for (const PredictionSchemeMethod method : kCandidatePredictionSchemes) {
+        if (GetMaxDecodingSpeed(method) < decoding_speed ||
+            !CheckPredictionScheme(att_type, method).ok()) {
+          continue;
+        }
+        trials.push_back({att_id, true, method, -1});
+      }
+    }
+    if (!initial_options.IsAttributeOptionSet(
+            att_id, "symbol_encoding_compression_level")) {
+      for (const int level : kCandidateCompressionLevels) {
+        if (level > 10 - decoding_speed) {
+          continue;
+        }
+        trials.push_back({att_id, false, level, -1});
+      }
+    }
+  }
+
+  // Evaluate each candidate setting separately, keeping all other options
+  // unchanged.
+  if (num_threads < 0) {
+    num_threads = ThreadPool::HardwareConcurrency() - 1;
+  }
+  const auto run_trials = [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      EncoderOptions trial_options = initial_options;
+      ApplyEncodingTrial(trials[i], &trial_options);
+      trials[i].encoded_size = ComputeEncodedSize(trial_options);
+    }
+  };
+  ThreadPool pool(num_threads);
+  pool.ParallelFor(static_cast<int>(trials.size()), 1, run_trials);
+
+  // For each attribute, find the best prediction scheme and compression level.
+  std::vector<int> best_scheme_trials(point_cloud_->num_attributes(), -1);
+  std::vector<int> best_level_trials(point_cloud_->num_attributes(), -1);
+  int best_trial = -1;
+  for (int i = 0; i < static_cast<int>(trials.size()); ++i) {
+    const EncodingTrial &trial = trials[i];
+    if (trial.encoded_size < 0 || trial.encoded_size >= result.default_size) {
+      continue;
+    }
+    int &best = trial.is_prediction_scheme ? best_scheme_trials[trial.att_id]
+                                           : best_level_trials[trial.att_id];
+    if (best == -1 || trial.encoded_size < trials[best].encoded_size) {
+      best = i;
+    }
+    if (best_trial == -1 ||
+        trial.encoded_size < trials[best_trial].encoded_size) {
+      best_trial = i;
+    }
+  }
+  if (best_trial == -1) {
+    return result;  // No candidate improved the initial options.
+  }
+
+  // Combine the best settings of all attributes. The settings are not fully
+  // independent so the combination is used only if it beats the best single
+  // setting.
+  std::vector<int> selected_trials;
+  EncoderOptions optimized_options = initial_options;
+  for (int att_id = 0; att_id < point_cloud_->num_attributes(); ++att_id) {
+    for (const int trial : {best_scheme_trials[att_id],
+                            best_level_trials[att_id]}) {
+      if (trial != -1) {
+        ApplyEncodingTrial(trials[trial], &optimized_options);
+        selected_trials.push_back(trial);
+      }
+    }
+  }
+  int64_t optimized_size = ComputeEncodedSize(optimized_options);
+  if (optimized_size < 0 ||
+      optimized_size > trials[best_trial].encoded_size) {
+    optimized_options = initial_options;
+    ApplyEncodingTrial(trials[best_trial], &optimized_options);
+    optimized_size = trials[best_trial].encoded_size;
+    selected_trials.assign(1, best_trial);
+  }
+
+  for (const int trial : selected_trials) {
+    AttributeEncodingConfig &config = result.attributes[trials[trial].att_id];
+    if (trials[trial].is_prediction_scheme) {
+      config.prediction_scheme = trials[trial].value;
+    } else {
+      config.symbol_encoding_compression_level = trials[trial].value;
+    }
+  }
+  result.optimized_size = optimized_size;
+  Reset(optimized_options);
+  return result;
+}
+
+int64_t ExpertEncoder::ComputeEncodedSize(
+    const EncoderOptions &options) const {
+  std::unique_ptr<ExpertEncoder> encoder(
+      mesh_ != nullptr ? new ExpertEncoder(*mesh_)
+                       : new ExpertEncoder(*point_cloud_));
+  encoder->Reset(options);
+  EncoderBuffer buffer;
+  if (!encoder->EncodeToBuffer(&buffer).ok()) {
+    return -1;
+  }
+  return static_cast<int64_t>(buffer.size());
+}
+
 #ifdef DRACO_TRANSCODER_SUPPORTED
 Status ExpertEncoder::ApplyCompressionOptions(const PointCloud &pc) {
   if (!pc.IsCompressionEnabled()) {
@@ -213,7 +426,30 @@ Status ExpertEncoder::ApplyCompressionOptions(const PointCloud &pc) {
                        10 - compression_options.compression_level);
   }
 
+  // Error bound for positions in the units of the model.
+  float max_position_error = compression_options.max_position_error;
+  if (max_position_error <= 0.f &&
+      compression_options.max_position_error_fraction > 0.f) {
+    const Vector3f size = pc.ComputeBoundingBox().Size();
+    max_position_error = compression_options.max_position_error_fraction *
+                         std::sqrt(size.SquaredNorm());
+  }
+
+  // Positions are processed first because the error-bounded quantization of
+  // texture coordinates depends on the position quantization.
+  std::vector<int> att_ids;
   for (int ai = 0; ai < pc.num_attributes(); ++ai) {
+    if (pc.attribute(ai)->attribute_type() == GeometryAttribute::POSITION) {
+      att_ids.push_back(ai);
+    }
+  }
+  for (int ai = 0; ai < pc.num_attributes(); ++ai) {
+    if (pc.attribute(ai)->attribute_type() != GeometryAttribute::POSITION) {
+      att_ids.push_back(ai);
+    }
+  }
+
+  for (const int ai : att_ids) {
     if (options().IsAttributeOptionSet(ai, "quantization_bits")) {
       continue;  // Don't override options that have been set.
     }
@@ -221,8 +457,11 @@ Status ExpertEncoder::ApplyCompressionOptions(const PointCloud &pc) {
     const auto type = pc.attribute(ai)->attribute_type();
     switch (type) {
       case GeometryAttribute::POSITION:
-        if (compression_options.quantization_position
-                .AreQuantizationBitsDefined()) {
+        if (max_position_error > 0.f) {
+          DRACO_RETURN_IF_ERROR(SetAttributeErrorBoundedQuantization(
+              pc, ai, max_position_error));
+        } else if (compression_options.quantization_position
+                       .AreQuantizationBitsDefined()) {
           quantization_bits =
               compression_options.quantization_position.quantization_bits();
         } else {
@@ -230,10 +469,20 @@ Status ExpertEncoder::ApplyCompressionOptions(const PointCloud &pc) {
         }
         break;
       case GeometryAttribute::TEX_COORD:
-        quantization_bits = compression_options.quantization_bits_tex_coord;
+        if (compression_options.max_tex_coord_error > 0.f) {
+          DRACO_RETURN_IF_ERROR(SetAttributeErrorBoundedQuantization(
+              pc, ai, compression_options.max_tex_coord_error));
+        } else {
+          quantization_bits = compression_options.quantization_bits_tex_coord;
+        }
         break;
       case GeometryAttribute::NORMAL:
-        quantization_bits = compression_options.quantization_bits_normal;
+        if (compression_options.max_normal_angle > 0.f) {
+          DRACO_RETURN_IF_ERROR(SetAttributeErrorBoundedQuantization(
+              pc, ai, compression_options.max_normal_angle));
+        } else {
+          quantization_bits = compression_options.quantization_bits_normal;
+        }
         break;
       case GeometryAttribute::COLOR:
         quantization_bits = compression_options.quantization_bits_color;
@@ -312,6 +561,43 @@ Status ExpertEncoder::SetAttributeGridQuantization(const PointCloud &pc,
                                    range);
   return OkStatus();
 }
+
+Status ExpertEncoder::SetAttributeErrorBoundedQuantization(
+    const PointCloud &pc, int attribute_index, float max_error) {
+  const PointAttribute &att = *pc.attribute(attribute_index);
+  if (att.attribute_type() == GeometryAttribute::NORMAL) {
+    DRACO_ASSIGN_OR_RETURN(
+        const int bits,
+        MeshUtils::FindLowestNormalQuantizationForMaxAngle(att, max_error));
+    SetAttributeQuantization(attribute_index, bits);
+    return OkStatus();
+  }
+  DRACO_ASSIGN_OR_RETURN(
+      int bits, MeshUtils::FindLowestQuantizationForMaxError(att, max_error));
+
+  // Texture coordinate quantization must not create new degenerate faces that
+  // are not degenerate in positions already.
+  const int pos_att_id = pc.GetNamedAttributeId(GeometryAttribute::POSITION);
+  const int pos_bits =
+      pos_att_id == -1
+          ? -1
+          : options().GetAttributeInt(pos_att_id, "quantization_bits", -1);
+  if (att.attribute_type() == GeometryAttribute::TEX_COORD &&
+      att.num_components() == 2 && mesh_ == &pc && pos_bits > 0 &&
+      bits < 30) {
+    DRACO_ASSIGN_OR_RETURN(const int non_degenerate_bits,
+                           MeshUtils::FindLowestTextureQuantization(
+                               *mesh_, *pc.attribute(pos_att_id), pos_bits,
+                               att, bits));
+    // Zero means that no quantization avoids new degenerate faces, in which
+    // case the error-bounded quantization is kept.
+    if (non_degenerate_bits > 0) {
+      bits = non_degenerate_bits;
+    }
+  }
+  SetAttributeQuantization(attribute_index, bits);
+  return OkStatus();
+}
 #endif  // DRACO_TRANSCODER_SUPPORTED
 
 }  // namespace draco
@@ -15,11 +15,14 @@
 #ifndef DRACO_COMPRESSION_EXPERT_ENCODE_H_
 #define DRACO_COMPRESSION_EXPERT_ENCODE_H_
 
+#include <vector>
+
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/encoder_options.h"
 #include "draco/compression/encode_base.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/core/status.h"
+#include "draco/core/status_or.h"
 #include "draco/mesh/mesh.h"
 
 namespace draco {
@@ -80,6 +83,30 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
   // compression is used on top of the Draco compression. Default: [true].
   void SetUseBuiltInAttributeCompression(bool enabled);
 
+  // Allows the encoder to use context modeling for the entropy coding of
+  // attribute values when it results in a smaller output. The size reduction
+  // is usually small (see SetSymbolEncodingContextModeling() in
+  // symbol_encoding.h). Default: [false].
+  void SetSymbolEncodingContextModeling(bool enabled);
+
+  // Allows the encoder to select the entropy coding of very large attributes
+  // from a subset of the attribute values, which speeds up the encoding at
+  // the cost of a possibly larger output (see
+  // SetSymbolEncodingEntropySampling() in symbol_encoding.h). Default: [false].
+  void SetSymbolEncodingEntropySampling(bool enabled);
+
+  // Sets the number of worker threads used to encode attributes that share
+  // the same point sequence, e.g. all attributes of the sequential encoding.
+  // The output is identical to the single-threaded encoding. Negative values
+  // use all available hardware threads. Default: [0] (no worker threads).
+  void SetNumAttributeEncodingThreads(int num_threads);
+
+  // Sets the number of worker threads used to construct the connectivity
+  // (corner table) of meshes encoded with the edgebreaker method. The output
+  // is identical to the single-threaded encoding. Negative values use all
+  // available hardware threads. Default: [0] (no worker threads).
+  void SetNumConnectivityEncodingThreads(int num_threads);
+
   // Sets the desired encoding method for a given geometry. By default, encoding
   // method is selected based on the properties of the input geometry and based
   // on the other options selected in the used EncoderOptions (such as desired
@@ -132,11 +159,75 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
   Status SetAttributePredictionScheme(int32_t attribute_id,
                                       int prediction_scheme_method);
 
+  // Sets the compression level of the entropy coding of the attribute values.
+  // |compression_level| must be in range [0, 10], where higher levels use
+  // more precise (but slower to decode) symbol coders. By default, the level
+  // is derived from the speed options.
+  void SetAttributeSymbolEncodingCompressionLevel(int32_t attribute_id,
+                                                  int compression_level);
+
+  // Same as SetSymbolEncodingContextModeling() but only for a single
+  // attribute.
+  void SetAttributeSymbolEncodingContextModeling(int32_t attribute_id,
+                                                 bool enabled);
+
+  // Encoding configuration of a single attribute selected by
+  // OptimizeAttributeEncoding().
+  struct AttributeEncodingConfig {
+    // Selected prediction scheme method (see SetAttributePredictionScheme()),
+    // or -1 when the default selection of the encoder was kept.
+    int prediction_scheme;
+    // Selected symbol encoding compression level, or -1 when the default
+    // level was kept.
+    int symbol_encoding_compression_level;
+  };
+
+  // Result of OptimizeAttributeEncoding().
+  struct AttributeEncodingOptimization {
+    // Selected configuration for each attribute, indexed by attribute id.
+    std::vector<AttributeEncodingConfig> attributes;
+    // Encoded size with the initial and with the selected options.
+    int64_t default_size;
+    int64_t optimized_size;
+  };
+
+  // Searches for the prediction schemes and the symbol encoding compression
+  // levels that minimize the encoded size of the geometry. Each candidate
+  // setting of each attribute is evaluated by a trial encoding of the whole
+  // geometry, because the size of an attribute depends also on the selected
+  // connectivity traversal. The trial encodings run in parallel using
+  // |num_threads| additional threads (negative value selects the number of
+  // threads automatically).
+  //
+  // The decoding speed set with SetSpeedOptions() is used as a budget: only
+  // prediction schemes that the encoder would consider for the given decoding
+  // speed and compression levels up to 10 - decoding_speed are evaluated.
+  // Settings that were explicitly set for an attribute are never changed.
+  //
+  // The selected settings are stored in the encoder options and used by all
+  // subsequent calls of EncodeToBuffer(). If no candidate improves on the
+  // initial options, the options are left unchanged.
+  StatusOr<AttributeEncodingOptimization> OptimizeAttributeEncoding(
+      int num_threads);
+
 #ifdef DRACO_TRANSCODER_SUPPORTED
   // Applies grid quantization to position attribute in point cloud |pc| at
   // |attribute_index| with a given grid |spacing|.
   Status SetAttributeGridQuantization(const PointCloud &pc, int attribute_index,
                                       float spacing);
+
+  // Sets the lowest quantization of the attribute in point cloud |pc| at
+  // |attribute_index| for which the quantization error does not exceed
+  // |max_error|. For normals, |max_error| is the maximum angle in radians
+  // between the original and the quantized normals. For other attributes, it
+  // is the maximum error of any component. When encoding a mesh with quantized
+  // positions, the quantization of texture coordinates is increased if needed
+  // to avoid new degenerate faces (see
+  // MeshUtils::FindLowestTextureQuantization()), so the position quantization
+  // should be set first.
+  Status SetAttributeErrorBoundedQuantization(const PointCloud &pc,
+                                              int attribute_index,
+                                              float max_error);
 #endif  // DRACO_TRANSCODER_SUPPORTED
 
  private:
@@ -145,6 +236,10 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
 
   Status EncodeMeshToBuffer(const Mesh &m, EncoderBuffer *out_buffer);
 
+  // Encodes the geometry with |options| and returns the encoded size, or -1
+  // when the geometry cannot be encoded with the given options.
+  int64_t ComputeEncodedSize(const EncoderOptions &options) const;
+
 #ifdef DRACO_TRANSCODER_SUPPORTED
   // Applies compression options stored in |pc|.
   Status ApplyCompressionOptions(const PointCloud &pc);
@@ -47,6 +47,8 @@ class MeshEdgebreakerDecoder : public MeshDecoder {
   bool OnAttributesDecoded() override;
 
   std::unique_ptr<MeshEdgebreakerDecoderImplInterface> impl_;
+  // Traversal decoder type of |impl_| or -1 when there is no implementation.
+  int impl_type_;
 };
 
 }  // namespace draco
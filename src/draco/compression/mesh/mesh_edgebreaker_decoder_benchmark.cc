@@ -0,0 +1,91 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmarks of the edgebreaker mesh decoding on models from the testdata.
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/cycle_timer.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace draco {
+
+namespace {
+
+// Minimum number of decoded faces for each benchmark. Small models are decoded
+// multiple times to reduce the timing noise.
+constexpr int kMinNumDecodedFaces = 5000000;
+
+void BenchmarkDecoding(const std::string &file_name, bool positions_only) {
+  std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+  ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+  if (positions_only) {
+    for (int i = mesh->num_attributes() - 1; i >= 0; --i) {
+      if (mesh->attribute(i)->attribute_type() != GeometryAttribute::POSITION) {
+        mesh->DeleteAttribute(i);
+      }
+    }
+  }
+  const int num_repetitions =
+      std::max(1, kMinNumDecodedFaces / static_cast<int>(mesh->num_faces()));
+  // Speed 10 uses the standard edgebreaker and speed 0 the valence
+  // edgebreaker.
+  for (const int speed : {10, 0}) {
+    Encoder encoder;
+    encoder.SetEncodingMethod(MESH_EDGEBREAKER_ENCODING);
+    encoder.SetSpeedOptions(speed, speed);
+    encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 11);
+    encoder.SetAttributeQuantization(GeometryAttribute::TEX_COORD, 10);
+    encoder.SetAttributeQuantization(GeometryAttribute::NORMAL, 8);
+    EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+
+    CycleTimer timer;
+    timer.Start();
+    for (int i = 0; i < num_repetitions; ++i) {
+      DecoderBuffer decoder_buffer;
+      decoder_buffer.Init(buffer.data(), buffer.size());
+      Decoder decoder;
+      ASSERT_TRUE(decoder.DecodeMeshFromBuffer(&decoder_buffer).ok());
+    }
+    timer.Stop();
+    const int64_t time_ms = timer.GetInMs();
+    const double num_faces =
+        static_cast<double>(mesh->num_faces()) * num_repetitions;
+    printf("  %-22s %-10s %-8s %6" PRId64 " ms (%.2f Mfaces/s)\n",
+           file_name.c_str(), positions_only ? "positions" : "all",
+           speed == 10 ? "standard" : "valence", time_ms,
+           time_ms > 0 ? num_faces / (1000.0 * time_ms) : 0.0);
+  }
+}
+
+}  // namespace
+
+TEST(MeshEdgebreakerDecoderBenchmark, Testdata) {
+  printf("Edgebreaker decoding throughput\n");
+  for (const std::string file_name :
+       {"bun_zipper.ply", "bunny_norm.obj", "sphere.obj", "test_nm.obj",
+        "cube_subd.obj"}) {
+    BenchmarkDecoding(file_name, true);
+    BenchmarkDecoding(file_name, false);
+  }
+}
+
+}  // namespace draco
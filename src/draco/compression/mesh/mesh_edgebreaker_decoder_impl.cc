@@ -370,12 +370,14 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
     return false;  // Split symbols are a sub-set of all symbols.
   }
 
-  // Decode topology (connectivity).
+  // Decode topology (connectivity). The corner table and the other buffers
+  // are kept when the decoder is reused for another mesh, so that their
+  // memory can be reused.
   vertex_traversal_length_.clear();
-  corner_table_ = std::unique_ptr<CornerTable>(new CornerTable());
   if (corner_table_ == nullptr) {
-    return false;
+    corner_table_ = std::unique_ptr<CornerTable>(new CornerTable());
   }
+  pos_data_decoder_id_ = -1;
   processed_corner_ids_.clear();
   processed_corner_ids_.reserve(num_faces);
   processed_connectivity_corners_.clear();
@@ -453,7 +455,8 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
     return false;
   }
 
-  const int num_connectivity_verts = DecodeConnectivity(num_encoded_symbols);
+  const int num_connectivity_verts =
+      DecodeConnectivity(num_encoded_symbols);
   if (num_connectivity_verts == -1) {
     return false;
   }
@@ -534,6 +537,19 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::OnAttributesDecoded() {
 template <class TraversalDecoder>
 int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
     int num_symbols) {
+  // Meshes without topology split events are decoded using a specialized
+  // version of the decoder that skips the split event lookup for each decoded
+  // symbol. TOPOLOGY_S symbols are supported by both versions.
+  if (!topology_split_data_.empty()) {
+    return DecodeConnectivityImpl<true>(num_symbols);
+  }
+  return DecodeConnectivityImpl<false>(num_symbols);
+}
+
+template <class TraversalDecoder>
+template <bool kHasTopologySplits>
+int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivityImpl(
+    int num_symbols) {
   // Algorithm does the reverse decoding of the symbols encoded with the
   // edgebreaker method. The reverse decoding always keeps track of the active
   // edge identified by its opposite corner (active corner). New faces are
@@ -549,7 +565,10 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
   // Additional active edges may be added as a result of topology split events.
   // They can be added in arbitrary order, but we always know the split symbol
   // id they belong to, so we can address them using this symbol id.
-  std::unordered_map<int, CornerIndex> topology_split_active_corners;
+  std::vector<CornerIndex> topology_split_active_corners;
+  if (kHasTopologySplits) {
+    topology_split_active_corners.assign(num_symbols, kInvalidCornerIndex);
+  }
 
   // Vector used for storing vertices that were marked as isolated during the
   // decoding process. Currently used only when the mesh doesn't contain any
@@ -707,10 +726,10 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
 
       // Corner "a" can correspond either to a normal active edge, or to an edge
       // created from the topology split event.
-      const auto it = topology_split_active_corners.find(symbol_id);
-      if (it != topology_split_active_corners.end()) {
+      if (!topology_split_active_corners.empty() &&
+          topology_split_active_corners[symbol_id] != kInvalidCornerIndex) {
         // Topology split event. Move the retrieved edge to the stack.
-        active_corner_stack.push_back(it->second);
+        active_corner_stack.push_back(topology_split_active_corners[symbol_id]);
       }
       if (active_corner_stack.empty()) {
         return -1;
@@ -797,7 +816,7 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
     // Inform the traversal decoder that a new corner has been reached.
     traversal_decoder_.NewActiveCornerReached(active_corner_stack.back());
 
-    if (check_topology_split) {
+    if (kHasTopologySplits && check_topology_split) {
       // Check for topology splits happens only for TOPOLOGY_L, TOPOLOGY_R and
       // TOPOLOGY_E symbols because those are the symbols that correspond to
       // faces that can be directly connected a TOPOLOGY_S face through the
@@ -837,8 +856,11 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
         // Convert the encoder split symbol id to decoder symbol id.
         const int decoder_split_symbol_id =
             num_symbols - encoder_split_symbol_id - 1;
-        topology_split_active_corners[decoder_split_symbol_id] =
-            new_active_corner;
+        if (decoder_split_symbol_id >= 0) {
+          // Edges of invalid symbol ids are never used, so they are ignored.
+          topology_split_active_corners[decoder_split_symbol_id] =
+              new_active_corner;
+        }
       }
     }
   }
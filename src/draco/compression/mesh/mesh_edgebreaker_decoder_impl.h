@@ -77,6 +77,12 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   // Returns the number of vertices created by the decoder or -1 on error.
   int DecodeConnectivity(int num_symbols);
 
+  // Implementation of the above method. When |kHasTopologySplits| is false,
+  // the input must not contain any topology split events, which allows the
+  // decoder to skip the related bookkeeping for each decoded symbol.
+  template <bool kHasTopologySplits>
+  int DecodeConnectivityImpl(int num_symbols);
+
   // Returns true if the current symbol was part of a topology split event. This
   // means that the current face was connected to the left edge of a face
   // encoded with the TOPOLOGY_S symbol. |out_symbol_edge| can be used to
@@ -15,6 +15,7 @@
 #include "draco/compression/mesh/mesh_edgebreaker_encoder_impl.h"
 
 #include <algorithm>
+#include <memory>
 
 #include "draco/compression/attributes/sequential_attribute_encoders_controller.h"
 #include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
@@ -25,6 +26,7 @@
 #include "draco/compression/mesh/traverser/mesh_attribute_indices_encoding_observer.h"
 #include "draco/compression/mesh/traverser/mesh_traversal_sequencer.h"
 #include "draco/compression/mesh/traverser/traverser_base.h"
+#include "draco/core/thread_pool.h"
 #include "draco/mesh/corner_table_iterators.h"
 #include "draco/mesh/mesh_misc_functions.h"
 
@@ -273,10 +275,22 @@ Status MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   // together, unless the option |use_single_connectivity_| is set in which case
   // we break the mesh along attribute seams and use the same connectivity for
   // all attributes.
+  // When the "num_connectivity_encoding_threads" option is set, the corner
+  // table is constructed in parallel. The resulting corner table is identical
+  // to the serially constructed one.
+  int num_threads = encoder_->options()->GetGlobalInt(
+      "num_connectivity_encoding_threads", 0);
+  if (num_threads < 0) {
+    num_threads = ThreadPool::HardwareConcurrency() - 1;
+  }
+  std::unique_ptr<ThreadPool> pool;
+  if (num_threads > 0) {
+    pool.reset(new ThreadPool(num_threads));
+  }
   if (use_single_connectivity_) {
-    corner_table_ = CreateCornerTableFromAllAttributes(mesh_);
+    corner_table_ = CreateCornerTableFromAllAttributes(mesh_, pool.get());
   } else {
-    corner_table_ = CreateCornerTableFromPositionAttribute(mesh_);
+    corner_table_ = CreateCornerTableFromPositionAttribute(mesh_, pool.get());
   }
   if (corner_table_ == nullptr ||
       corner_table_->num_faces() == corner_table_->NumDegeneratedFaces()) {
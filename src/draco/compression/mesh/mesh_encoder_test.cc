@@ -65,7 +65,7 @@ class MeshEncoderTest : public ::testing::TestWithParam<MeshEncoderTestParams> {
     golden_file_name += ".";
     golden_file_name += std::to_string(kDracoMeshBitstreamVersionMajor);
     golden_file_name += ".";
-    golden_file_name += std::to_string(kDracoMeshBitstreamVersionMinor);
+    golden_file_name += std::to_string(kDracoMeshDefaultBitstreamVersionMinor);
     golden_file_name += ".drc";
     const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile(file_name));
     ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
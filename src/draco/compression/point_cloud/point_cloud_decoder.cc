@@ -14,6 +14,11 @@
 //
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 
+#include <algorithm>
+#include <memory>
+
+#include "draco/attributes/attribute_transform.h"
+#include "draco/core/thread_pool.h"
 #include "draco/metadata/metadata_decoder.h"
 
 namespace draco {
@@ -23,7 +28,10 @@ PointCloudDecoder::PointCloudDecoder()
       buffer_(nullptr),
       version_major_(0),
       version_minor_(0),
-      options_(nullptr) {}
+      options_(nullptr),
+      thread_pool_(nullptr),
+      attribute_decoding_thread_pool_(nullptr),
+      stats_(nullptr) {}
 
 Status PointCloudDecoder::DecodeHeader(DecoderBuffer *buffer,
                                        DracoHeader *out_header) {
@@ -69,8 +77,13 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
   options_ = &options;
   buffer_ = in_buffer;
   point_cloud_ = out_point_cloud;
+  ScopedStageStats total_stats(stats() ? &stats()->total : nullptr, buffer_);
   DracoHeader header;
-  DRACO_RETURN_IF_ERROR(DecodeHeader(buffer_, &header))
+  {
+    ScopedStageStats header_stats(stats() ? &stats()->header : nullptr,
+                                  buffer_);
+    DRACO_RETURN_IF_ERROR(DecodeHeader(buffer_, &header))
+  }
   // Sanity check that we are really using the right decoder (mostly for cases
   // where the Decode method was called manually outside of our main API.
   if (header.encoder_type != GetGeometryType()) {
@@ -111,14 +124,22 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
 
   if (bitstream_version() >= DRACO_BITSTREAM_VERSION(1, 3) &&
       (header.flags & METADATA_FLAG_MASK)) {
+    ScopedStageStats metadata_stats(stats() ? &stats()->metadata : nullptr,
+                                    buffer_);
     DRACO_RETURN_IF_ERROR(DecodeMetadata())
   }
-  if (!InitializeDecoder()) {
-    return Status(Status::DRACO_ERROR, "Failed to initialize the decoder.");
-  }
-  if (!DecodeGeometryData()) {
-    return Status(Status::DRACO_ERROR, "Failed to decode geometry data.");
+  {
+    ScopedStageStats connectivity_stats(
+        stats() ? &stats()->connectivity : nullptr, buffer_);
+    if (!InitializeDecoder()) {
+      return Status(Status::DRACO_ERROR, "Failed to initialize the decoder.");
+    }
+    if (!DecodeGeometryData()) {
+      return Status(Status::DRACO_ERROR, "Failed to decode geometry data.");
+    }
   }
+  ScopedStageStats attribute_data_stats(
+      stats() ? &stats()->attribute_data : nullptr, buffer_);
   if (!DecodePointAttributes()) {
     return Status(Status::DRACO_ERROR, "Failed to decode point attributes.");
   }
@@ -130,6 +151,9 @@ bool PointCloudDecoder::DecodePointAttributes() {
   if (!buffer_->Decode(&num_attributes_decoders)) {
     return false;
   }
+  // Drop attribute decoders left from a previous Decode() call.
+  attributes_decoders_.clear();
+  attribute_to_decoder_map_.clear();
   // Create all attribute decoders. This is implementation specific and the
   // derived classes can use any data encoded in the
   // PointCloudEncoder::EncodeAttributesEncoderIdentifier() call.
@@ -164,6 +188,9 @@ bool PointCloudDecoder::DecodePointAttributes() {
       attribute_to_decoder_map_[att_id] = i;
     }
   }
+  if (stats()) {
+    stats()->InitAttributes(*point_cloud_);
+  }
 
   // Decode the actual attributes using the created attribute decoders.
   if (!DecodeAllAttributes()) {
@@ -177,12 +204,71 @@ bool PointCloudDecoder::DecodePointAttributes() {
 }
 
 bool PointCloudDecoder::DecodeAllAttributes() {
+  // Scheduling the transforms on other threads costs more than it saves when
+  // the attributes are small, so small geometry is always decoded serially.
+  const bool use_threads =
+      point_cloud_->num_points() >
+      AttributeTransform::kMinInverseTransformValuesPerRange;
+  std::unique_ptr<ThreadPool> pool;
+  ThreadPool *thread_pool = nullptr;
+  if (use_threads) {
+    thread_pool = attribute_decoding_thread_pool_;
+    if (thread_pool == nullptr) {
+      const int num_threads = GetNumAttributeDecodingThreads();
+      if (num_threads > 0) {
+        pool.reset(new ThreadPool(num_threads));
+        thread_pool = pool.get();
+      }
+    }
+  }
+  if (thread_pool == nullptr) {
+    for (auto &att_dec : attributes_decoders_) {
+      if (!att_dec->DecodeAttributes(buffer_)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // The attribute data is decoded serially, but the attribute decoders defer
+  // their transforms while |thread_pool_| is set. Predictors use only the
+  // portable attributes so the deferral does not change the decoded values.
+  thread_pool_ = thread_pool;
+  bool success = true;
   for (auto &att_dec : attributes_decoders_) {
     if (!att_dec->DecodeAttributes(buffer_)) {
-      return false;
+      success = false;
+      break;
     }
   }
-  return true;
+  if (success) {
+    success = TransformAllAttributesToOriginalFormat();
+  }
+  thread_pool_ = nullptr;
+  return success;
+}
+
+bool PointCloudDecoder::TransformAllAttributesToOriginalFormat() {
+  const int num_decoders = static_cast<int>(attributes_decoders_.size());
+  std::vector<uint8_t> success(num_decoders, 0);
+  thread_pool_->ParallelFor(num_decoders, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      success[i] =
+          attributes_decoders_[i]->TransformAttributesToOriginalFormat();
+    }
+  });
+  return std::find(success.begin(), success.end(), 0) == success.end();
+}
+
+int PointCloudDecoder::GetNumAttributeDecodingThreads() const {
+  if (options_ == nullptr) {
+    return 0;
+  }
+  const int num_threads =
+      options_->GetGlobalInt("num_attribute_decoding_threads", 0);
+  if (num_threads < 0) {
+    return ThreadPool::HardwareConcurrency() - 1;
+  }
+  return num_threads;
 }
 
 const PointAttribute *PointCloudDecoder::GetPortableAttribute(
@@ -16,6 +16,7 @@
 #define DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_DECODER_H_
 
 #include "draco/compression/attributes/attributes_decoder_interface.h"
+#include "draco/compression/coding_stats.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
 #include "draco/core/status.h"
@@ -23,6 +24,8 @@
 
 namespace draco {
 
+class ThreadPool;
+
 // Abstract base class for all point cloud and mesh decoders. It provides a
 // basic functionality that is shared between different decoders.
 class PointCloudDecoder {
@@ -79,6 +82,41 @@ class PointCloudDecoder {
   DecoderBuffer *buffer() { return buffer_; }
   const DecoderOptions *options() const { return options_; }
 
+  // Returns the pool used to revert the attribute transforms when the
+  // "num_attribute_decoding_threads" option is set, or nullptr otherwise.
+  // The pool is available only while the attributes are being decoded. When
+  // set, the transforms of all attribute decoders are deferred until all
+  // attribute data is decoded and they are then reverted in parallel across
+  // the attributes and across ranges of attribute values.
+  ThreadPool *thread_pool() const { return thread_pool_; }
+
+  // Sets a caller-owned |pool| used to revert the attribute transforms instead
+  // of a pool created for each decoded geometry. The pool must outlive the
+  // Decode() call.
+  void set_attribute_decoding_thread_pool(ThreadPool *pool) {
+    attribute_decoding_thread_pool_ = pool;
+  }
+
+  // Sets the |stats| that are going to be filled in by Decode(). Ignored when
+  // Draco is built without DRACO_INSTRUMENTATION.
+  void set_stats(CodingStats *stats) { stats_ = stats; }
+
+  // Returns the stats filled in by the decoder or nullptr when the stats are
+  // not collected.
+  CodingStats *stats() const {
+#ifdef DRACO_INSTRUMENTATION_SUPPORTED
+    return stats_;
+#else
+    return nullptr;
+#endif
+  }
+
+  // Returns the stats of attribute |att_id| or nullptr when the stats are not
+  // collected.
+  AttributeCodingStats *attribute_stats(int att_id) const {
+    return stats() ? stats()->attribute(att_id) : nullptr;
+  }
+
  protected:
   // Can be implemented by derived classes to perform any custom initialization
   // of the decoder. Called in the Decode() method.
@@ -90,11 +128,18 @@ class PointCloudDecoder {
   virtual bool DecodePointAttributes();
 
   virtual bool DecodeAllAttributes();
+
+  // Reverts the transforms of all decoded attributes using |thread_pool_|.
+  bool TransformAllAttributesToOriginalFormat();
   virtual bool OnAttributesDecoded() { return true; }
 
   Status DecodeMetadata();
 
  private:
+  // Returns the number of worker threads used to revert the attribute
+  // transforms.
+  int GetNumAttributeDecodingThreads() const;
+
   // Point cloud that is being filled in by the decoder.
   PointCloud *point_cloud_;
 
@@ -111,6 +156,14 @@ class PointCloudDecoder {
   uint8_t version_minor_;
 
   const DecoderOptions *options_;
+
+  // Set only during DecodeAllAttributes() when multiple threads are used.
+  ThreadPool *thread_pool_;
+
+  // Optional caller-owned pool, see set_attribute_decoding_thread_pool().
+  ThreadPool *attribute_decoding_thread_pool_;
+
+  CodingStats *stats_;
 };
 
 }  // namespace draco
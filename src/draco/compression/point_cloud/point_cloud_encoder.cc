@@ -19,7 +19,13 @@
 namespace draco {
 
 PointCloudEncoder::PointCloudEncoder()
-    : point_cloud_(nullptr), buffer_(nullptr), num_encoded_points_(0) {}
+    : point_cloud_(nullptr),
+      buffer_(nullptr),
+      num_encoded_points_(0),
+      stats_(nullptr),
+      uses_context_symbol_coding_(false),
+      version_minor_offset_(0),
+      version_minor_(0) {}
 
 void PointCloudEncoder::SetPointCloud(const PointCloud &pc) {
   point_cloud_ = &pc;
@@ -34,28 +40,80 @@ Status PointCloudEncoder::Encode(const EncoderOptions &options,
   attributes_encoders_.clear();
   attribute_to_encoder_map_.clear();
   attributes_encoder_ids_order_.clear();
+  uses_context_symbol_coding_ = false;
 
   if (!point_cloud_) {
     return Status(Status::DRACO_ERROR, "Invalid input geometry.");
   }
-  DRACO_RETURN_IF_ERROR(EncodeHeader())
-  DRACO_RETURN_IF_ERROR(EncodeMetadata())
-  if (!InitializeEncoder()) {
-    return Status(Status::DRACO_ERROR, "Failed to initialize encoder.");
+  for (int i = 0; i < point_cloud_->num_attributes(); ++i) {
+    // Half floats are only produced by the decoder (see
+    // Decoder::SetAttributeOutputDataType()) and the bitstream can't store
+    // them.
+    if (point_cloud_->attribute(i)->data_type() == DT_FLOAT16) {
+      return Status(Status::UNSUPPORTED_FEATURE,
+                    "Half float attributes can't be encoded.");
+    }
+  }
+  ScopedStageStats total_stats(stats() ? &stats()->total : nullptr, buffer_);
+  if (stats()) {
+    stats()->InitAttributes(*point_cloud_);
+  }
+  {
+    ScopedStageStats header_stats(stats() ? &stats()->header : nullptr,
+                                  buffer_);
+    DRACO_RETURN_IF_ERROR(EncodeHeader())
   }
-  if (!EncodeEncoderData()) {
-    return Status(Status::DRACO_ERROR, "Failed to encode internal data.");
+  {
+    ScopedStageStats metadata_stats(stats() ? &stats()->metadata : nullptr,
+                                    buffer_);
+    DRACO_RETURN_IF_ERROR(EncodeMetadata())
   }
-  DRACO_RETURN_IF_ERROR(EncodeGeometryData());
-  if (!EncodePointAttributes()) {
-    return Status(Status::DRACO_ERROR, "Failed to encode point attributes.");
+  DRACO_RETURN_IF_ERROR(FlushBuffer())
+  {
+    ScopedStageStats connectivity_stats(
+        stats() ? &stats()->connectivity : nullptr, buffer_);
+    if (!InitializeEncoder()) {
+      return Status(Status::DRACO_ERROR, "Failed to initialize encoder.");
+    }
+    if (!EncodeEncoderData()) {
+      return Status(Status::DRACO_ERROR, "Failed to encode internal data.");
+    }
+    DRACO_RETURN_IF_ERROR(EncodeGeometryData());
+  }
+  DRACO_RETURN_IF_ERROR(FlushBuffer())
+  {
+    ScopedStageStats attribute_data_stats(
+        stats() ? &stats()->attribute_data : nullptr, buffer_);
+    if (!EncodePointAttributes()) {
+      // Attribute encoders return false both for encoding errors and when
+      // flushing the encoded data fails. The buffer records failed flushes so
+      // that they are reported as IO errors.
+      DRACO_RETURN_IF_ERROR(GetFlushStatus());
+      return Status(Status::DRACO_ERROR, "Failed to encode point attributes.");
+    }
   }
+  DRACO_RETURN_IF_ERROR(UpdateBitstreamVersion());
+  DRACO_RETURN_IF_ERROR(FlushBuffer())
   if (options.GetGlobalBool("store_number_of_encoded_points", false)) {
     ComputeNumberOfEncodedPoints();
   }
   return OkStatus();
 }
 
+Status PointCloudEncoder::FlushBuffer() {
+  if (!buffer_->Flush()) {
+    return Status(Status::IO_ERROR, "Failed to write encoded data.");
+  }
+  return OkStatus();
+}
+
+Status PointCloudEncoder::GetFlushStatus() const {
+  if (buffer_->flush_failed()) {
+    return Status(Status::IO_ERROR, "Failed to write encoded data.");
+  }
+  return OkStatus();
+}
+
 Status PointCloudEncoder::EncodeHeader() {
   // Encode the header according to our v1 specification.
   // Five bytes for Draco format.
@@ -66,11 +124,24 @@ Status PointCloudEncoder::EncodeHeader() {
   version_major = encoder_type == POINT_CLOUD
                       ? kDracoPointCloudBitstreamVersionMajor
                       : kDracoMeshBitstreamVersionMajor;
-  version_minor = encoder_type == POINT_CLOUD
-                      ? kDracoPointCloudBitstreamVersionMinor
-                      : kDracoMeshBitstreamVersionMinor;
+  // Older decoders can't decode data with the latest version. Therefore, the
+  // default version is written first and it is updated only when the encoded
+  // data requires the latest version. When the data is streamed, the header
+  // may be passed on before the attributes are encoded, so the latest version
+  // is written right away whenever it may be needed.
+  if (buffer_->has_flush_callback() && IsContextSymbolCodingAllowed()) {
+    version_minor = encoder_type == POINT_CLOUD
+                        ? kDracoPointCloudBitstreamVersionMinor
+                        : kDracoMeshBitstreamVersionMinor;
+  } else {
+    version_minor = encoder_type == POINT_CLOUD
+                        ? kDracoPointCloudDefaultBitstreamVersionMinor
+                        : kDracoMeshDefaultBitstreamVersionMinor;
+  }
 
   buffer_->Encode(version_major);
+  version_minor_offset_ = buffer_->num_flushed_bytes() + buffer_->size();
+  version_minor_ = version_minor;
   buffer_->Encode(version_minor);
   // Type of the encoder (point cloud, mesh, ...).
   buffer_->Encode(encoder_type);
@@ -86,6 +157,36 @@ Status PointCloudEncoder::EncodeHeader() {
   return OkStatus();
 }
 
+bool PointCloudEncoder::IsContextSymbolCodingAllowed() const {
+  for (int i = 0; i < point_cloud_->num_attributes(); ++i) {
+    if (options_->GetAttributeBool(i, "symbol_encoding_context_modeling",
+                                   false)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Status PointCloudEncoder::UpdateBitstreamVersion() {
+  if (!uses_context_symbol_coding_) {
+    return OkStatus();
+  }
+  const uint8_t latest_version_minor =
+      GetGeometryType() == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMinor
+                                       : kDracoMeshBitstreamVersionMinor;
+  if (version_minor_ == latest_version_minor) {
+    return OkStatus();
+  }
+  if (version_minor_offset_ < buffer_->num_flushed_bytes()) {
+    // Should not happen, see EncodeHeader().
+    return Status(Status::DRACO_ERROR, "Failed to update bitstream version.");
+  }
+  (*buffer_->buffer())[version_minor_offset_ - buffer_->num_flushed_bytes()] =
+      latest_version_minor;
+  version_minor_ = latest_version_minor;
+  return OkStatus();
+}
+
 Status PointCloudEncoder::EncodeMetadata() {
   if (!point_cloud_->GetMetadata()) {
     return OkStatus();
@@ -163,6 +264,9 @@ bool PointCloudEncoder::EncodeAllAttributes() {
     if (!attributes_encoders_[att_encoder_id]->EncodeAttributes(buffer_)) {
       return false;
     }
+    if (!buffer_->Flush()) {
+      return false;
+    }
   }
   return true;
 }
@@ -15,7 +15,10 @@
 #ifndef DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_ENCODER_H_
 #define DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_ENCODER_H_
 
+#include <atomic>
+
 #include "draco/compression/attributes/attributes_encoder.h"
+#include "draco/compression/coding_stats.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/encoder_options.h"
 #include "draco/core/encoder_buffer.h"
@@ -72,10 +75,35 @@ class PointCloudEncoder {
   // as predictor for other attributes.
   const PointAttribute *GetPortableAttribute(int32_t point_attribute_id);
 
+  // Called by the attribute encoders when any attribute data is encoded with
+  // SYMBOL_CODING_CONTEXT. The encoded data is then marked with the latest
+  // bitstream version. Can be called concurrently.
+  void SetUsesContextSymbolCoding() { uses_context_symbol_coding_ = true; }
+
   EncoderBuffer *buffer() { return buffer_; }
   const EncoderOptions *options() const { return options_; }
   const PointCloud *point_cloud() const { return point_cloud_; }
 
+  // Sets the |stats| that are going to be filled in by Encode(). Ignored when
+  // Draco is built without DRACO_INSTRUMENTATION.
+  void set_stats(CodingStats *stats) { stats_ = stats; }
+
+  // Returns the stats filled in by the encoder or nullptr when the stats are
+  // not collected.
+  CodingStats *stats() const {
+#ifdef DRACO_INSTRUMENTATION_SUPPORTED
+    return stats_;
+#else
+    return nullptr;
+#endif
+  }
+
+  // Returns the stats of attribute |att_id| or nullptr when the stats are not
+  // collected.
+  AttributeCodingStats *attribute_stats(int att_id) const {
+    return stats() ? stats()->attribute(att_id) : nullptr;
+  }
+
  protected:
   // Can be implemented by derived classes to perform any custom initialization
   // of the encoder. Called in the Encode() method.
@@ -129,6 +157,20 @@ class PointCloudEncoder {
   // Encode metadata.
   Status EncodeMetadata();
 
+  // Returns true when the options allow SYMBOL_CODING_CONTEXT for any attribute.
+  bool IsContextSymbolCodingAllowed() const;
+
+  // Updates the minor version in the header to the latest version when the
+  // encoded data uses SYMBOL_CODING_CONTEXT.
+  Status UpdateBitstreamVersion();
+
+  // Flushes all data encoded so far from |buffer_| (see
+  // EncoderBuffer::Flush()).
+  Status FlushBuffer();
+
+  // Returns an error when any flush of |buffer_| failed.
+  Status GetFlushStatus() const;
+
   // Rearranges attribute encoders and their attributes to reflect the
   // underlying attribute dependencies. This ensures that the attributes are
   // encoded in the correct order (parent attributes before their children).
@@ -151,6 +193,16 @@ class PointCloudEncoder {
   const EncoderOptions *options_;
 
   size_t num_encoded_points_;
+
+  CodingStats *stats_;
+
+  // Set when any attribute data uses SYMBOL_CODING_CONTEXT.
+  std::atomic<bool> uses_context_symbol_coding_;
+
+  // Position of the minor version in the encoded data (including the flushed
+  // data) and its value.
+  size_t version_minor_offset_;
+  uint8_t version_minor_;
 };
 
 }  // namespace draco
@@ -37,6 +37,10 @@ enum DataType {
   DT_FLOAT32,
   DT_FLOAT64,
   DT_BOOL,
+  // IEEE 754 half precision floating point value. Used only as an output data
+  // type of the decoder (see Decoder::SetAttributeOutputDataType()), it can't
+  // be encoded into the Draco bitstream.
+  DT_FLOAT16,
   DT_TYPES_COUNT
 };
 
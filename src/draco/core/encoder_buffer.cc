@@ -21,11 +21,32 @@
 namespace draco {
 
 EncoderBuffer::EncoderBuffer()
-    : bit_encoder_reserved_bytes_(false), encode_bit_sequence_size_(false) {}
+    : bit_encoder_reserved_bytes_(false),
+      encode_bit_sequence_size_(false),
+      num_flushed_bytes_(0),
+      flush_failed_(false) {}
 
 void EncoderBuffer::Clear() {
   buffer_.clear();
   bit_encoder_reserved_bytes_ = 0;
+  num_flushed_bytes_ = 0;
+  flush_failed_ = false;
+}
+
+bool EncoderBuffer::Flush() {
+  if (bit_encoder_active()) {
+    return false;
+  }
+  if (!flush_callback_ || buffer_.empty()) {
+    return true;
+  }
+  if (!flush_callback_(buffer_.data(), buffer_.size())) {
+    flush_failed_ = true;
+    return false;
+  }
+  num_flushed_bytes_ += buffer_.size();
+  buffer_.clear();
+  return true;
 }
 
 void EncoderBuffer::Resize(int64_t nbytes) { buffer_.resize(nbytes); }
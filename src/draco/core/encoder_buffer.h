@@ -15,6 +15,7 @@
 #ifndef DRACO_CORE_ENCODER_BUFFER_H_
 #define DRACO_CORE_ENCODER_BUFFER_H_
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -26,12 +27,41 @@ namespace draco {
 // Class representing a buffer that can be used for either for byte-aligned
 // encoding of arbitrary data structures or for encoding of variable-length
 // bit data.
+//
+// By default, all encoded data is kept in memory. When a flush callback is
+// set, the data encoded so far can be passed to the callback using Flush(),
+// for example to stream the encoded data into a file as it is produced. The
+// encoders flush the buffer only at points where no previously encoded data
+// is going to be modified anymore. After a flush, data() and size() refer
+// only to the data that was encoded since the last flush.
 class EncoderBuffer {
  public:
+  // Callback that receives the flushed data. Returns false on error.
+  typedef std::function<bool(const char *data, size_t size)> FlushCallback;
+
   EncoderBuffer();
   void Clear();
   void Resize(int64_t nbytes);
 
+  // Sets the |callback| that receives the data passed to Flush().
+  void SetFlushCallback(const FlushCallback &callback) {
+    flush_callback_ = callback;
+  }
+
+  // Returns true when a flush callback is set, i.e., when the encoded data may
+  // be passed on before the encoding is finished.
+  bool has_flush_callback() const { return static_cast<bool>(flush_callback_); }
+
+  // Passes all data encoded since the last flush to the flush callback and
+  // removes it from the buffer. Does nothing when no callback is set. Can't
+  // be called during bit encoding. Returns false when the data couldn't be
+  // flushed.
+  bool Flush();
+
+  // Returns true when any call to Flush() failed to pass the data to the
+  // flush callback since the buffer was created or cleared.
+  bool flush_failed() const { return flush_failed_; }
+
   // Start encoding a bit sequence. A maximum size of the sequence needs to
   // be known upfront.
   // If encode_size is true, the size of encoded bit sequence is stored before
@@ -77,6 +107,9 @@ class EncoderBuffer {
   bool bit_encoder_active() const { return bit_encoder_reserved_bytes_ > 0; }
   const char *data() const { return buffer_.data(); }
   size_t size() const { return buffer_.size(); }
+  // Returns the number of bytes that were already passed to the flush
+  // callback.
+  size_t num_flushed_bytes() const { return num_flushed_bytes_; }
   std::vector<char> *buffer() { return &buffer_; }
 
  private:
@@ -145,6 +178,10 @@ class EncoderBuffer {
   // Flag used indicating that we need to store the length of the currently
   // processed bit sequence.
   bool encode_bit_sequence_size_;
+
+  FlushCallback flush_callback_;
+  size_t num_flushed_bytes_;
+  bool flush_failed_;
 };
 
 }  // namespace draco
@@ -15,6 +15,7 @@
 #include "draco/core/hash_utils.h"
 
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <limits>
 
@@ -55,4 +56,36 @@ uint64_t FingerprintString(const char *s, size_t len) {
   }
   return hash;
 }
+
+uint64_t FingerprintData(const void *data, size_t size, uint64_t seed) {
+  const uint64_t m = 0xc6a4a7935bd1e995ull;
+  const int r = 47;
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  uint64_t hash = seed ^ (static_cast<uint64_t>(size) * m);
+
+  const size_t num_blocks = size / 8;
+  for (size_t i = 0; i < num_blocks; ++i, bytes += 8) {
+    uint64_t k;
+    memcpy(&k, bytes, sizeof(k));
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    hash ^= k;
+    hash *= m;
+  }
+
+  const size_t num_remaining_bytes = size & 7;
+  if (num_remaining_bytes > 0) {
+    for (size_t i = 0; i < num_remaining_bytes; ++i) {
+      hash ^= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    hash *= m;
+  }
+
+  hash ^= hash >> r;
+  hash *= m;
+  hash ^= hash >> r;
+  return hash;
+}
+
 }  // namespace draco
@@ -42,6 +42,13 @@ inline uint64_t HashCombine(uint64_t a, uint64_t b) {
 // Will never return 1 or 0.
 uint64_t FingerprintString(const char *s, size_t len);
 
+// Computes a well distributed 64-bit fingerprint of |size| bytes of |data|
+// (MurmurHash64A). Unlike FingerprintString(), the result is suitable for
+// content-addressed storage. Fingerprints of multiple buffers can be chained
+// by passing the previous fingerprint as |seed|. Note that the result depends
+// on the byte order of the platform.
+uint64_t FingerprintData(const void *data, size_t size, uint64_t seed);
+
 // Hash for std::array.
 template <typename T>
 struct HashArray {
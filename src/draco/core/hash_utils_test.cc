@@ -0,0 +1,59 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/hash_utils.h"
+
+#include <set>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+// Tests that FingerprintData() is deterministic and that it depends on every
+// byte of the input, including the bytes that don't fill a full 8-byte block.
+TEST(HashUtilsTest, TestFingerprintData) {
+  std::vector<uint8_t> data(29);
+  for (int i = 0; i < static_cast<int>(data.size()); ++i) {
+    data[i] = static_cast<uint8_t>(i * 7 + 3);
+  }
+  const uint64_t fingerprint =
+      draco::FingerprintData(data.data(), data.size(), 0);
+  ASSERT_EQ(draco::FingerprintData(data.data(), data.size(), 0), fingerprint);
+
+  std::set<uint64_t> fingerprints;
+  fingerprints.insert(fingerprint);
+  for (int i = 0; i < static_cast<int>(data.size()); ++i) {
+    data[i] ^= 1;
+    fingerprints.insert(draco::FingerprintData(data.data(), data.size(), 0));
+    data[i] ^= 1;
+  }
+  // Different sizes of the same data.
+  for (int size = 0; size < static_cast<int>(data.size()); ++size) {
+    fingerprints.insert(draco::FingerprintData(data.data(), size, 0));
+  }
+  ASSERT_EQ(fingerprints.size(), 2 * data.size() + 1);
+}
+
+// Tests that fingerprints can be chained using the seed.
+TEST(HashUtilsTest, TestFingerprintDataSeed) {
+  const char data[] = "draco";
+  const uint64_t first = draco::FingerprintData(data, sizeof(data), 0);
+  const uint64_t second = draco::FingerprintData(data, sizeof(data), first);
+  ASSERT_NE(first, second);
+  ASSERT_NE(draco::FingerprintData(data, sizeof(data), 1), first);
+  ASSERT_EQ(draco::FingerprintData(data, sizeof(data), first), second);
+}
+
+}  // namespace
@@ -14,8 +14,31 @@
 //
 #include "draco/core/quantization_utils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
 namespace draco {
 
+namespace {
+
+// Stores |values| as normalized integers of type IntT.
+template <typename IntT>
+void StoreNormalizedValues(const float *values, int num_values,
+                           uint8_t *out_address) {
+  const float min_value = std::is_signed<IntT>::value ? -1.f : 0.f;
+  const float scale = static_cast<float>(std::numeric_limits<IntT>::max());
+  for (int i = 0; i < num_values; ++i) {
+    const float value = std::min(std::max(values[i], min_value), 1.f);
+    const IntT int_value = static_cast<IntT>(std::floor(value * scale + 0.5f));
+    memcpy(out_address + i * sizeof(IntT), &int_value, sizeof(IntT));
+  }
+}
+
+}  // namespace
+
 Quantizer::Quantizer() : inverse_delta_(1.f) {}
 
 void Quantizer::Init(float range, int32_t max_quantized_value) {
@@ -39,4 +62,114 @@ bool Dequantizer::Init(float delta) {
   return true;
 }
 
+uint16_t FloatToFloat16(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  uint32_t abs_bits = bits & 0x7fffffff;
+  if (abs_bits >= 0x7f800000) {
+    // Infinity or NaN. NaNs are kept quiet.
+    return sign | (abs_bits > 0x7f800000 ? 0x7e00 : 0x7c00);
+  }
+  if (abs_bits >= 0x477ff000) {
+    // The value is rounded to a number larger than the maximum half (65504).
+    return sign | 0x7c00;
+  }
+  if (abs_bits < 0x38800000) {
+    // The result is a subnormal number (or zero) with a fixed exponent of
+    // 2^-24. The float to integer conversion rounds to nearest even.
+    float abs_value;
+    memcpy(&abs_value, &abs_bits, sizeof(abs_value));
+    return sign | static_cast<uint16_t>(std::nearbyint(abs_value * 16777216.f));
+  }
+  // Normal number. Re-bias the exponent and round the mantissa to nearest
+  // even. Carry from the mantissa correctly increments the exponent.
+  const uint32_t mantissa_odd = (abs_bits >> 13) & 1;
+  abs_bits += 0xc8000fff + mantissa_odd;
+  return sign | static_cast<uint16_t>(abs_bits >> 13);
+}
+
+float Float16ToFloat(uint16_t value) {
+  const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+  const uint32_t exponent = (value >> 10) & 0x1f;
+  const uint32_t mantissa = value & 0x3ff;
+  if (exponent == 0) {
+    // Zero or subnormal number.
+    const float abs_value = static_cast<float>(mantissa) / 16777216.f;
+    return sign ? -abs_value : abs_value;
+  }
+  uint32_t bits;
+  if (exponent == 0x1f) {
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  }
+  float result;
+  memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+bool IsFloatStorageDataTypeSupported(DataType data_type) {
+  switch (data_type) {
+    case DT_FLOAT32:
+    case DT_FLOAT16:
+    case DT_INT8:
+    case DT_UINT8:
+    case DT_INT16:
+    case DT_UINT16:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsFloatRangeStorable(DataType data_type, float min_value,
+                          float max_value) {
+  // Tolerance for values that are in the normalized range but whose bounds
+  // are computed with a rounding error, e.g. as a sum of a minimum and a range.
+  constexpr float kTolerance = 1e-6f;
+  switch (data_type) {
+    case DT_FLOAT32:
+    case DT_FLOAT16:
+      return true;
+    case DT_INT8:
+    case DT_INT16:
+      return min_value >= -1.f - kTolerance && max_value <= 1.f + kTolerance;
+    case DT_UINT8:
+    case DT_UINT16:
+      return min_value >= -kTolerance && max_value <= 1.f + kTolerance;
+    default:
+      return false;
+  }
+}
+
+void StoreFloatValues(const float *values, int num_values, DataType data_type,
+                      uint8_t *out_address) {
+  switch (data_type) {
+    case DT_FLOAT32:
+      memcpy(out_address, values, num_values * sizeof(float));
+      break;
+    case DT_FLOAT16:
+      for (int i = 0; i < num_values; ++i) {
+        const uint16_t half = FloatToFloat16(values[i]);
+        memcpy(out_address + i * sizeof(uint16_t), &half, sizeof(uint16_t));
+      }
+      break;
+    case DT_INT8:
+      StoreNormalizedValues<int8_t>(values, num_values, out_address);
+      break;
+    case DT_UINT8:
+      StoreNormalizedValues<uint8_t>(values, num_values, out_address);
+      break;
+    case DT_INT16:
+      StoreNormalizedValues<int16_t>(values, num_values, out_address);
+      break;
+    case DT_UINT16:
+      StoreNormalizedValues<uint16_t>(values, num_values, out_address);
+      break;
+    default:
+      break;
+  }
+}
+
 }  // namespace draco
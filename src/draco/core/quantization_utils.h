@@ -25,6 +25,7 @@
 
 #include <cmath>
 
+#include "draco/core/draco_types.h"
 #include "draco/core/macros.h"
 
 namespace draco {
@@ -77,6 +78,35 @@ class Dequantizer {
   float delta_;
 };
 
+// Converts a single precision floating point value into an IEEE 754 half
+// precision value using round-to-nearest-even. Values that are too large to be
+// represented are converted to infinity.
+uint16_t FloatToFloat16(float value);
+
+// Converts an IEEE 754 half precision value to a single precision value.
+float Float16ToFloat(uint16_t value);
+
+// Returns true when floating point values can be stored in |data_type| using
+// StoreFloatValues(). Supported are DT_FLOAT32, DT_FLOAT16 and the normalized
+// integer types DT_INT8, DT_INT16 (SNORM) and DT_UINT8, DT_UINT16 (UNORM).
+bool IsFloatStorageDataTypeSupported(DataType data_type);
+
+// Returns true when all values in range [|min_value|, |max_value|] can be
+// stored in |data_type| using StoreFloatValues(). Values stored as normalized
+// integers must be within [-1, 1] for signed and [0, 1] for unsigned types,
+// up to a small tolerance for rounding errors of the range bounds.
+bool IsFloatRangeStorable(DataType data_type, float min_value,
+                          float max_value);
+
+// Stores |num_values| floating point |values| at |out_address| using
+// |data_type|. Integer types are treated as normalized types. Values outside of
+// the normalized range ([-1, 1] for signed and [0, 1] for unsigned types) are
+// clamped and then rounded to the nearest integer, so callers should check the
+// range of the values with IsFloatRangeStorable() first. |data_type| must be
+// supported (see IsFloatStorageDataTypeSupported()).
+void StoreFloatValues(const float *values, int num_values, DataType data_type,
+                      uint8_t *out_address);
+
 }  // namespace draco
 
 #endif  // DRACO_CORE_QUANTIZATION_UTILS_H_
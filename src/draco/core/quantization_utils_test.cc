@@ -88,4 +88,83 @@ TEST_F(QuantizationUtilsTest, TestDeltaQuantization) {
             dequantizer_range.DequantizeFloat(0));
 }
 
+TEST_F(QuantizationUtilsTest, TestFloat16) {
+  EXPECT_EQ(FloatToFloat16(0.f), 0x0000);
+  EXPECT_EQ(FloatToFloat16(-0.f), 0x8000);
+  EXPECT_EQ(FloatToFloat16(1.f), 0x3c00);
+  EXPECT_EQ(FloatToFloat16(-2.f), 0xc000);
+  EXPECT_EQ(FloatToFloat16(0.1f), 0x2e66);
+  EXPECT_EQ(FloatToFloat16(65504.f), 0x7bff);
+  // Values that round above the largest half are converted to infinity.
+  EXPECT_EQ(FloatToFloat16(65519.f), 0x7bff);
+  EXPECT_EQ(FloatToFloat16(65520.f), 0x7c00);
+  EXPECT_EQ(FloatToFloat16(-1e10f), 0xfc00);
+  // Subnormal numbers.
+  EXPECT_EQ(FloatToFloat16(std::ldexp(1.f, -24)), 0x0001);
+  EXPECT_EQ(FloatToFloat16(std::ldexp(1.f, -26)), 0x0000);
+  EXPECT_EQ(FloatToFloat16(std::ldexp(1023.f, -24)), 0x03ff);
+  // Ties are rounded to even.
+  EXPECT_EQ(FloatToFloat16(1.f + std::ldexp(1.f, -11)), 0x3c00);
+  EXPECT_EQ(FloatToFloat16(1.f + 3.f * std::ldexp(1.f, -11)), 0x3c02);
+  EXPECT_EQ(FloatToFloat16(std::nanf("")) & 0x7c00, 0x7c00);
+  EXPECT_NE(FloatToFloat16(std::nanf("")) & 0x03ff, 0);
+
+  // All finite half values must survive the round trip.
+  for (uint32_t i = 0; i < 0x10000; ++i) {
+    const uint16_t half = static_cast<uint16_t>(i);
+    if ((half & 0x7c00) == 0x7c00) {
+      continue;
+    }
+    ASSERT_EQ(FloatToFloat16(Float16ToFloat(half)), half);
+  }
+  EXPECT_EQ(Float16ToFloat(0x3c00), 1.f);
+  EXPECT_EQ(Float16ToFloat(0x0001), std::ldexp(1.f, -24));
+  EXPECT_TRUE(std::isinf(Float16ToFloat(0xfc00)));
+  EXPECT_TRUE(std::isnan(Float16ToFloat(0x7e00)));
+}
+
+TEST_F(QuantizationUtilsTest, TestStoreFloatValues) {
+  const float values[] = {-2.f, -1.f, -0.5f, 0.f, 0.25f, 1.f, 2.f};
+  constexpr int kNumValues = 7;
+
+  int16_t snorm16[kNumValues];
+  StoreFloatValues(values, kNumValues, DT_INT16,
+                   reinterpret_cast<uint8_t *>(snorm16));
+  const int16_t expected_snorm16[] = {-32767, -32767, -16383, 0,
+                                      8192,   32767,  32767};
+  for (int i = 0; i < kNumValues; ++i) {
+    EXPECT_EQ(snorm16[i], expected_snorm16[i]);
+  }
+
+  uint8_t unorm8[kNumValues];
+  StoreFloatValues(values, kNumValues, DT_UINT8, unorm8);
+  const uint8_t expected_unorm8[] = {0, 0, 0, 0, 64, 255, 255};
+  for (int i = 0; i < kNumValues; ++i) {
+    EXPECT_EQ(unorm8[i], expected_unorm8[i]);
+  }
+
+  uint16_t half[kNumValues];
+  StoreFloatValues(values, kNumValues, DT_FLOAT16,
+                   reinterpret_cast<uint8_t *>(half));
+  for (int i = 0; i < kNumValues; ++i) {
+    EXPECT_EQ(Float16ToFloat(half[i]), values[i]);
+  }
+
+  EXPECT_TRUE(IsFloatStorageDataTypeSupported(DT_FLOAT32));
+  EXPECT_TRUE(IsFloatStorageDataTypeSupported(DT_UINT16));
+  EXPECT_FALSE(IsFloatStorageDataTypeSupported(DT_INT32));
+  EXPECT_FALSE(IsFloatStorageDataTypeSupported(DT_FLOAT64));
+}
+
+TEST_F(QuantizationUtilsTest, TestIsFloatRangeStorable) {
+  EXPECT_TRUE(IsFloatRangeStorable(DT_FLOAT32, -100.f, 100.f));
+  EXPECT_TRUE(IsFloatRangeStorable(DT_FLOAT16, -100.f, 100.f));
+  EXPECT_TRUE(IsFloatRangeStorable(DT_INT16, -1.f, 1.f));
+  EXPECT_FALSE(IsFloatRangeStorable(DT_INT16, -1.5f, 0.f));
+  EXPECT_TRUE(IsFloatRangeStorable(DT_UINT8, 0.f, 1.f));
+  EXPECT_FALSE(IsFloatRangeStorable(DT_UINT8, -1.f, 1.f));
+  EXPECT_FALSE(IsFloatRangeStorable(DT_UINT16, 0.f, 2.f));
+  EXPECT_FALSE(IsFloatRangeStorable(DT_INT32, 0.f, 1.f));
+}
+
 }  // namespace draco
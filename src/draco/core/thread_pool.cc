@@ -0,0 +1,222 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace draco {
+
+#ifdef DRACO_THREADING_SUPPORTED
+
+namespace {
+
+// Identifies the pool and the worker that is running on the current thread.
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local int current_worker_id = -1;
+
+// Shared state of a single ParallelFor() call. The state is reference counted
+// because helper tasks may start only after the call has already returned.
+struct ParallelForState {
+  ParallelForState(int num_chunks, int chunk_size, int num_items,
+                   const std::function<void(int, int)> *func)
+      : num_chunks(num_chunks),
+        chunk_size(chunk_size),
+        num_items(num_items),
+        func(func),
+        next_chunk(0),
+        num_finished_chunks(0) {}
+
+  // Processes chunks until there are no chunks left.
+  void Run() {
+    int chunk;
+    while ((chunk = next_chunk.fetch_add(1)) < num_chunks) {
+      const int begin = chunk * chunk_size;
+      const int end = std::min(begin + chunk_size, num_items);
+      (*func)(begin, end);
+      if (num_finished_chunks.fetch_add(1) + 1 == num_chunks) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cond.notify_all();
+      }
+    }
+  }
+
+  const int num_chunks;
+  const int chunk_size;
+  const int num_items;
+  const std::function<void(int, int)> *const func;
+  std::atomic<int> next_chunk;
+  std::atomic<int> num_finished_chunks;
+  std::mutex mutex;
+  std::condition_variable cond;
+};
+
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads)
+    : num_threads_(std::max(num_threads, 0)),
+      next_queue_(0),
+      num_pending_tasks_(0),
+      stop_(false) {
+  for (int i = 0; i < num_threads_; ++i) {
+    queues_.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+  }
+  workers_.reserve(num_threads_);
+  for (int i = 0; i < num_threads_; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  if (num_threads_ == 0) {
+    task();
+    return;
+  }
+  int queue_id;
+  if (current_pool == this) {
+    queue_id = current_worker_id;
+  } else {
+    queue_id = next_queue_.fetch_add(1) % num_threads_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[queue_id]->mutex);
+    queues_[queue_id]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_pending_tasks_;
+  }
+  cond_.notify_one();
+}
+
+void ThreadPool::ParallelFor(int num_items, int min_items_per_chunk,
+                             const std::function<void(int, int)> &func) {
+  if (num_items <= 0) {
+    return;
+  }
+  min_items_per_chunk = std::max(min_items_per_chunk, 1);
+  if (num_threads_ == 0 || num_items <= min_items_per_chunk) {
+    func(0, num_items);
+    return;
+  }
+  // Use a few chunks per thread so that the work is balanced even when the
+  // cost of individual items varies.
+  const int max_num_chunks = 4 * (num_threads_ + 1);
+  const int chunk_size = std::max(
+      min_items_per_chunk, (num_items + max_num_chunks - 1) / max_num_chunks);
+  const int num_chunks = (num_items + chunk_size - 1) / chunk_size;
+  std::shared_ptr<ParallelForState> state(
+      new ParallelForState(num_chunks, chunk_size, num_items, &func));
+  const int num_helpers = std::min(num_threads_, num_chunks - 1);
+  for (int i = 0; i < num_helpers; ++i) {
+    Schedule([state]() { state->Run(); });
+  }
+  state->Run();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cond.wait(lock, [&state]() {
+    return state->num_finished_chunks.load() == state->num_chunks;
+  });
+}
+
+int ThreadPool::CurrentThreadIndex() const {
+  return current_pool == this ? current_worker_id + 1 : 0;
+}
+
+int ThreadPool::HardwareConcurrency() {
+  const unsigned int num_threads = std::thread::hardware_concurrency();
+  return num_threads == 0 ? 1 : static_cast<int>(num_threads);
+}
+
+void ThreadPool::WorkerLoop(int worker_id) {
+  current_pool = this;
+  current_worker_id = worker_id;
+  std::function<void()> task;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock,
+                 [this]() { return num_pending_tasks_ > 0 || stop_; });
+      if (num_pending_tasks_ == 0) {
+        return;  // The pool is being destroyed and all tasks are done.
+      }
+      --num_pending_tasks_;
+    }
+    // A task is guaranteed to be available in one of the queues, but another
+    // worker may be in the middle of taking it from the queue we probe first.
+    while (!PopTask(worker_id, &task)) {
+      std::this_thread::yield();
+    }
+    task();
+    task = nullptr;
+  }
+}
+
+bool ThreadPool::PopTask(int worker_id, std::function<void()> *task) {
+  // Take the most recently added task from the worker's own queue first.
+  {
+    WorkerQueue &queue = *queues_[worker_id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+  // Steal the oldest task from one of the other workers.
+  for (int i = 1; i < num_threads_; ++i) {
+    WorkerQueue &queue = *queues_[(worker_id + i) % num_threads_];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+#else  // DRACO_THREADING_SUPPORTED
+
+ThreadPool::ThreadPool(int /* num_threads */) : num_threads_(0) {}
+
+ThreadPool::~ThreadPool() {}
+
+void ThreadPool::Schedule(std::function<void()> task) { task(); }
+
+void ThreadPool::ParallelFor(int num_items, int /* min_items_per_chunk */,
+                             const std::function<void(int, int)> &func) {
+  if (num_items > 0) {
+    func(0, num_items);
+  }
+}
+
+int ThreadPool::CurrentThreadIndex() const { return 0; }
+
+int ThreadPool::HardwareConcurrency() { return 1; }
+
+#endif  // DRACO_THREADING_SUPPORTED
+
+}  // namespace draco
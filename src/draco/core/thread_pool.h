@@ -0,0 +1,108 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_THREAD_POOL_H_
+#define DRACO_CORE_THREAD_POOL_H_
+
+#include <functional>
+
+#include "draco/draco_features.h"
+
+#ifdef DRACO_THREADING_SUPPORTED
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace draco {
+
+// Simple work-stealing thread pool. Each worker owns a task queue. Tasks
+// scheduled from a worker thread are pushed to that worker's queue, other
+// tasks are distributed among the workers in a round-robin fashion. Idle
+// workers steal tasks from the queues of the other workers.
+//
+// When Draco is built without threading support, or when the pool is created
+// with zero threads, all tasks are executed synchronously on the calling
+// thread. This allows callers to use the same code path regardless of the
+// build configuration.
+class ThreadPool {
+ public:
+  // Creates a pool with |num_threads| worker threads.
+  explicit ThreadPool(int num_threads);
+
+  // Executes all pending tasks and joins the worker threads.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  int num_threads() const { return num_threads_; }
+
+  // Schedules |task| for asynchronous execution.
+  void Schedule(std::function<void()> task);
+
+  // Splits the range [0, |num_items|) into chunks of at least
+  // |min_items_per_chunk| items and calls |func(begin, end)| for each chunk.
+  // The calling thread participates in the work and the function returns once
+  // all chunks have been processed. It is safe to call this function from
+  // tasks running on the same pool.
+  void ParallelFor(int num_items, int min_items_per_chunk,
+                   const std::function<void(int, int)> &func);
+
+  // Returns an index in range [0, num_threads()] that identifies the current
+  // thread among the threads executing work of this pool. The i-th worker
+  // thread of the pool gets index i + 1 and any other thread, such as the
+  // thread calling ParallelFor(), gets index 0. The index can be used to give
+  // each thread its own state without locking, as long as only one external
+  // thread uses the pool at a time.
+  int CurrentThreadIndex() const;
+
+  // Returns the number of concurrent threads supported by the platform, or 1
+  // when the number is not known or threading is not supported.
+  static int HardwareConcurrency();
+
+ private:
+  int num_threads_;
+
+#ifdef DRACO_THREADING_SUPPORTED
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void WorkerLoop(int worker_id);
+
+  // Pops a task from the queue of worker |worker_id| or steals a task from
+  // one of the other workers. Returns false when no task is available.
+  bool PopTask(int worker_id, std::function<void()> *task);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<unsigned int> next_queue_;
+
+  // Guards |num_pending_tasks_| and |stop_|.
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  int num_pending_tasks_;
+  bool stop_;
+#endif
+};
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_THREAD_POOL_H_
@@ -0,0 +1,95 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+TEST(ThreadPoolTest, TestSchedule) {
+  // Tests that all scheduled tasks are executed before the pool is destroyed.
+  std::atomic<int> counter(0);
+  {
+    draco::ThreadPool pool(4);
+    for (int i = 0; i < 1000; ++i) {
+      pool.Schedule([&counter]() { counter.fetch_add(1); });
+    }
+  }
+  ASSERT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPoolTest, TestParallelFor) {
+  // Tests that ParallelFor() visits every item exactly once.
+  for (const int num_threads : {0, 1, 4}) {
+    draco::ThreadPool pool(num_threads);
+    std::vector<int> visits(10000, 0);
+    pool.ParallelFor(static_cast<int>(visits.size()), 16,
+                     [&visits](int begin, int end) {
+                       for (int i = begin; i < end; ++i) {
+                         ++visits[i];
+                       }
+                     });
+    for (const int count : visits) {
+      ASSERT_EQ(count, 1);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, TestNestedParallelFor) {
+  // Tests that ParallelFor() can be called from tasks running on the pool.
+  draco::ThreadPool pool(2);
+  std::atomic<int> counter(0);
+  pool.ParallelFor(8, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      pool.ParallelFor(100, 1, [&counter](int inner_begin, int inner_end) {
+        counter.fetch_add(inner_end - inner_begin);
+      });
+    }
+  });
+  ASSERT_EQ(counter.load(), 800);
+}
+
+TEST(ThreadPoolTest, TestCurrentThreadIndex) {
+  // Tests that each chunk sees the index of the thread it is running on and
+  // that no two threads share an index.
+  for (const int num_threads : {0, 1, 4}) {
+    draco::ThreadPool pool(num_threads);
+    ASSERT_EQ(pool.CurrentThreadIndex(), 0);
+    std::vector<std::atomic<int>> num_running(num_threads + 1);
+    for (auto &count : num_running) {
+      count.store(0);
+    }
+    std::atomic<bool> index_shared(false);
+    std::atomic<bool> index_out_of_range(false);
+    pool.ParallelFor(1000, 1, [&](int /* begin */, int /* end */) {
+      const int index = pool.CurrentThreadIndex();
+      if (index < 0 || index > num_threads) {
+        index_out_of_range.store(true);
+        return;
+      }
+      if (num_running[index].fetch_add(1) != 0) {
+        index_shared.store(true);
+      }
+      num_running[index].fetch_sub(1);
+    });
+    ASSERT_FALSE(index_out_of_range.load());
+    ASSERT_FALSE(index_shared.load());
+  }
+}
+
+}  // namespace
@@ -0,0 +1,275 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/draco_mesh_cache.h"
+
+#ifdef DRACO_TRANSCODER_SUPPORTED
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/core/hash_utils.h"
+#include "draco/io/file_utils.h"
+#include "draco/io/file_writer_utils.h"
+#include "draco/metadata/geometry_metadata.h"
+
+namespace draco {
+
+namespace {
+
+// Identifies files storing the cache entries. Must be changed whenever the
+// layout of the entries or the content of the key changes.
+constexpr char kEntryMagic[8] = {'D', 'R', 'A', 'C', 'O', 'M', 'C', '1'};
+
+// Header of a cache entry file. The header is followed by the Draco
+// compressed data.
+struct EntryHeader {
+  char magic[8];
+  uint64_t key[2];
+  int64_t num_encoded_points;
+  int64_t num_encoded_faces;
+  uint64_t data_size;
+};
+
+// Computes a 128-bit fingerprint from two independently seeded 64-bit
+// fingerprint chains.
+class KeyBuilder {
+ public:
+  KeyBuilder() : key_{{0x2545f4914f6cdd1dull, 0x9e3779b97f4a7c15ull}} {}
+
+  void AddData(const void *data, size_t size) {
+    key_[0] = FingerprintData(data, size, key_[0]);
+    key_[1] = FingerprintData(data, size, key_[1]);
+  }
+
+  template <typename T>
+  void AddValue(T value) {
+    AddData(&value, sizeof(value));
+  }
+
+  void AddString(const std::string &str) {
+    AddValue<uint64_t>(str.size());
+    AddData(str.data(), str.size());
+  }
+
+  const DracoMeshCache::Key &key() const { return key_; }
+
+ private:
+  DracoMeshCache::Key key_;
+};
+
+void AddCompressionOptions(const DracoCompressionOptions &options,
+                           KeyBuilder *builder) {
+  builder->AddValue<int32_t>(options.compression_level);
+  builder->AddValue<uint8_t>(
+      options.quantization_position.AreQuantizationBitsDefined());
+  builder->AddValue<int32_t>(options.quantization_position.quantization_bits());
+  builder->AddValue<float>(options.quantization_position.spacing());
+  builder->AddValue<int32_t>(options.quantization_bits_normal);
+  builder->AddValue<int32_t>(options.quantization_bits_tex_coord);
+  builder->AddValue<int32_t>(options.quantization_bits_color);
+  builder->AddValue<int32_t>(options.quantization_bits_generic);
+  builder->AddValue<int32_t>(options.quantization_bits_tangent);
+  builder->AddValue<int32_t>(options.quantization_bits_weight);
+  builder->AddValue<uint8_t>(options.find_non_degenerate_texture_quantization);
+  builder->AddValue<float>(options.max_position_error);
+  builder->AddValue<float>(options.max_position_error_fraction);
+  builder->AddValue<float>(options.max_tex_coord_error);
+  builder->AddValue<float>(options.max_normal_angle);
+}
+
+void AddAttribute(const Mesh &mesh, const PointAttribute &att,
+                  KeyBuilder *builder) {
+  builder->AddValue<int32_t>(att.attribute_type());
+  builder->AddValue<int32_t>(att.data_type());
+  builder->AddValue<int32_t>(att.num_components());
+  builder->AddValue<uint8_t>(att.normalized());
+  builder->AddValue<uint32_t>(att.unique_id());
+  builder->AddString(att.name());
+
+  // Attribute values.
+  builder->AddValue<uint64_t>(att.size());
+  const size_t value_size = DataTypeLength(att.data_type()) *
+                            static_cast<size_t>(att.num_components());
+  if (att.size() > 0) {
+    if (att.byte_stride() == static_cast<int64_t>(value_size)) {
+      builder->AddData(att.GetAddress(AttributeValueIndex(0)),
+                       value_size * att.size());
+    } else {
+      for (AttributeValueIndex i(0); i < static_cast<uint32_t>(att.size());
+           ++i) {
+        builder->AddData(att.GetAddress(i), value_size);
+      }
+    }
+  }
+
+  // Mapping from points to attribute values.
+  builder->AddValue<uint8_t>(att.is_mapping_identity());
+  if (!att.is_mapping_identity()) {
+    std::vector<uint32_t> indices(mesh.num_points());
+    for (PointIndex i(0); i < mesh.num_points(); ++i) {
+      indices[i.value()] = att.mapped_index(i).value();
+    }
+    builder->AddData(indices.data(), indices.size() * sizeof(uint32_t));
+  }
+}
+
+}  // namespace
+
+DracoMeshCache::DracoMeshCache(const std::string &directory)
+    : directory_(directory), num_hits_(0), num_misses_(0), num_inserts_(0) {}
+
+StatusOr<std::unique_ptr<DracoMeshCache>> DracoMeshCache::Create(
+    const std::string &directory) {
+  if (directory.empty()) {
+    return Status(Status::DRACO_ERROR, "Cache directory is empty.");
+  }
+  // Creates the directory when needed.
+  if (!CheckAndCreatePathForFile(directory + "/entry")) {
+    return Status(Status::DRACO_ERROR,
+                  "Could not create cache directory " + directory + ".");
+  }
+  return std::unique_ptr<DracoMeshCache>(new DracoMeshCache(directory));
+}
+
+DracoMeshCache::Key DracoMeshCache::ComputeKey(
+    const Mesh &mesh, const Eigen::Matrix4d &transform) {
+  KeyBuilder builder;
+  builder.AddData(kEntryMagic, sizeof(kEntryMagic));
+  builder.AddValue<uint16_t>(kDracoMeshBitstreamVersion);
+
+  const DracoCompressionOptions &options = mesh.GetCompressionOptions();
+  AddCompressionOptions(options, &builder);
+  if (!options.quantization_position.AreQuantizationBitsDefined()) {
+    // The quantization grid depends on the scale of the transform.
+    builder.AddData(transform.data(), 16 * sizeof(double));
+  }
+
+  // Connectivity.
+  builder.AddValue<uint32_t>(mesh.num_points());
+  builder.AddValue<uint32_t>(mesh.num_faces());
+  if (mesh.num_faces() > 0) {
+    builder.AddData(&mesh.face(FaceIndex(0))[0],
+                    mesh.num_faces() * sizeof(Mesh::Face));
+  }
+
+  // Attributes.
+  builder.AddValue<int32_t>(mesh.num_attributes());
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    AddAttribute(mesh, *mesh.attribute(i), &builder);
+  }
+
+  // Feature ID attributes are not quantized.
+  builder.AddValue<uint32_t>(mesh.NumMeshFeatures());
+  for (MeshFeaturesIndex i(0); i < mesh.NumMeshFeatures(); ++i) {
+    builder.AddValue<int32_t>(mesh.GetMeshFeatures(i).GetAttributeIndex());
+  }
+
+  // Metadata is encoded in the Draco bitstream.
+  const GeometryMetadata *const metadata = mesh.GetMetadata();
+  builder.AddValue<uint8_t>(metadata != nullptr);
+  if (metadata != nullptr) {
+    builder.AddValue<uint64_t>(GeometryMetadataHasher()(*metadata));
+  }
+  return builder.key();
+}
+
+bool DracoMeshCache::Find(const Key &key, EncoderBuffer *buffer,
+                          int64_t *num_encoded_points,
+                          int64_t *num_encoded_faces) {
+  std::vector<char> data;
+  EntryHeader header;
+  if (!ReadFileToBuffer(GetEntryFilename(key), &data) ||
+      data.size() < sizeof(header)) {
+    num_misses_++;
+    return false;
+  }
+  memcpy(&header, data.data(), sizeof(header));
+  if (memcmp(header.magic, kEntryMagic, sizeof(kEntryMagic)) != 0 ||
+      header.key[0] != key[0] || header.key[1] != key[1] ||
+      header.data_size != data.size() - sizeof(header)) {
+    // Corrupted or incompatible entry.
+    num_misses_++;
+    return false;
+  }
+  buffer->Clear();
+  buffer->buffer()->assign(data.begin() + sizeof(header), data.end());
+  *num_encoded_points = header.num_encoded_points;
+  *num_encoded_faces = header.num_encoded_faces;
+  num_hits_++;
+  return true;
+}
+
+Status DracoMeshCache::Insert(const Key &key, const EncoderBuffer &buffer,
+                              int64_t num_encoded_points,
+                              int64_t num_encoded_faces) {
+  EntryHeader header;
+  memcpy(header.magic, kEntryMagic, sizeof(kEntryMagic));
+  header.key[0] = key[0];
+  header.key[1] = key[1];
+  header.num_encoded_points = num_encoded_points;
+  header.num_encoded_faces = num_encoded_faces;
+  header.data_size = buffer.size();
+  std::vector<char> data(sizeof(header) + buffer.size());
+  memcpy(data.data(), &header, sizeof(header));
+  if (buffer.size() > 0) {
+    memcpy(data.data() + sizeof(header), buffer.data(), buffer.size());
+  }
+
+  // The entry is written to a temporary file that is renamed once it is
+  // complete, so that concurrent readers never see partially written entries.
+  // The name of the temporary file is unique across processes sharing the
+  // cache directory and across cache instances and threads of this process.
+  const std::string filename = GetEntryFilename(key);
+#ifdef _WIN32
+  const int64_t process_id = _getpid();
+#else
+  const int64_t process_id = getpid();
+#endif
+  char suffix[96];
+  snprintf(suffix, sizeof(suffix), ".%" PRId64 ".%p.%" PRId64 ".tmp",
+           process_id, static_cast<const void *>(this), num_inserts_++);
+  const std::string temp_filename = filename + suffix;
+  if (!WriteBufferToFile(data.data(), data.size(), temp_filename)) {
+    return Status(Status::DRACO_ERROR, "Could not write cache entry.");
+  }
+  if (std::rename(temp_filename.c_str(), filename.c_str()) != 0) {
+    std::remove(temp_filename.c_str());
+    // On some platforms rename() fails when another process has already
+    // stored the same entry, which is not an error.
+    if (GetFileSize(filename) == sizeof(header) + buffer.size()) {
+      return OkStatus();
+    }
+    return Status(Status::DRACO_ERROR, "Could not store cache entry.");
+  }
+  return OkStatus();
+}
+
+std::string DracoMeshCache::GetEntryFilename(const Key &key) const {
+  char name[40];
+  snprintf(name, sizeof(name), "%016" PRIx64 "%016" PRIx64 ".drc", key[0],
+           key[1]);
+  return directory_ + "/" + name;
+}
+
+}  // namespace draco
+#endif  // DRACO_TRANSCODER_SUPPORTED
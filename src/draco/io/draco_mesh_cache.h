@@ -0,0 +1,93 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_DRACO_MESH_CACHE_H_
+#define DRACO_IO_DRACO_MESH_CACHE_H_
+
+#include "draco/draco_features.h"
+
+#ifdef DRACO_TRANSCODER_SUPPORTED
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "Eigen/Core"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/core/status_or.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// On-disk content-addressed cache of Draco compressed meshes used by the glTF
+// encoder to avoid re-encoding meshes that did not change between runs. The
+// cache key is a 128-bit fingerprint of the mesh connectivity, the values and
+// layout of all attributes, the mesh features and metadata that affect the
+// Draco bitstream, and the Draco compression options of the mesh. Each entry
+// is stored in a separate file in the cache directory, so a cache directory
+// can be shared by multiple encoders and processes. All methods are
+// thread-safe.
+class DracoMeshCache {
+ public:
+  typedef std::array<uint64_t, 2> Key;
+
+  // Creates a cache stored in |directory|. The directory is created when it
+  // does not exist.
+  static StatusOr<std::unique_ptr<DracoMeshCache>> Create(
+      const std::string &directory);
+
+  // Computes the cache key of |mesh| compressed with its compression options.
+  // |transform| is the base mesh transform used to adjust the position
+  // quantization grid. It is part of the key only when the grid is used.
+  static Key ComputeKey(const Mesh &mesh, const Eigen::Matrix4d &transform);
+
+  // Looks up the compressed mesh stored for |key|. Returns true on a cache
+  // hit, in which case |buffer| is set to the Draco compressed data and the
+  // number of encoded points and faces are returned.
+  bool Find(const Key &key, EncoderBuffer *buffer, int64_t *num_encoded_points,
+            int64_t *num_encoded_faces);
+
+  // Stores the Draco compressed mesh |buffer| for |key|.
+  Status Insert(const Key &key, const EncoderBuffer &buffer,
+                int64_t num_encoded_points, int64_t num_encoded_faces);
+
+  // Statistics of the Find() calls.
+  int64_t num_hits() const { return num_hits_; }
+  int64_t num_misses() const { return num_misses_; }
+  void ResetStatistics() {
+    num_hits_ = 0;
+    num_misses_ = 0;
+  }
+
+  const std::string &directory() const { return directory_; }
+
+ private:
+  explicit DracoMeshCache(const std::string &directory);
+
+  // Returns the name of the file storing the entry for |key|.
+  std::string GetEntryFilename(const Key &key) const;
+
+  const std::string directory_;
+  std::atomic<int64_t> num_hits_;
+  std::atomic<int64_t> num_misses_;
+
+  // Used to create unique names of temporary files.
+  std::atomic<int64_t> num_inserts_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_TRANSCODER_SUPPORTED
+#endif  // DRACO_IO_DRACO_MESH_CACHE_H_
@@ -0,0 +1,116 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/draco_mesh_cache.h"
+
+#ifdef DRACO_TRANSCODER_SUPPORTED
+#include <memory>
+#include <string>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/io/gltf_encoder.h"
+#include "draco/scene/scene_utils.h"
+#include "ghc/filesystem.hpp"
+
+namespace {
+
+// Returns the full path of an empty cache directory named |name|.
+std::string GetEmptyCacheDirectory(const std::string &name) {
+  const std::string directory = draco::GetTestTempFileFullPath(name);
+  ghc::filesystem::remove_all(ghc::filesystem::path(directory));
+  return directory;
+}
+
+TEST(DracoMeshCacheTest, TestComputeKey) {
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  const Eigen::Matrix4d identity = Eigen::Matrix4d::Identity();
+  Eigen::Matrix4d scale = identity;
+  scale(0, 0) = 2.0;
+  const draco::DracoMeshCache::Key key =
+      draco::DracoMeshCache::ComputeKey(*mesh, identity);
+
+  // Same content results in the same key.
+  draco::Mesh mesh_copy;
+  mesh_copy.Copy(*mesh);
+  ASSERT_EQ(draco::DracoMeshCache::ComputeKey(mesh_copy, identity), key);
+
+  // The transform is ignored when the position quantization bits are set.
+  ASSERT_EQ(draco::DracoMeshCache::ComputeKey(mesh_copy, scale), key);
+
+  // Compression options are part of the key.
+  draco::DracoCompressionOptions options;
+  options.quantization_bits_normal = 10;
+  mesh_copy.SetCompressionOptions(options);
+  ASSERT_NE(draco::DracoMeshCache::ComputeKey(mesh_copy, identity), key);
+
+  // The transform is used with the position quantization grid.
+  options.quantization_position.SetGrid(0.1f);
+  mesh_copy.SetCompressionOptions(options);
+  const draco::DracoMeshCache::Key grid_key =
+      draco::DracoMeshCache::ComputeKey(mesh_copy, identity);
+  ASSERT_NE(draco::DracoMeshCache::ComputeKey(mesh_copy, scale), grid_key);
+
+  // Attribute values are part of the key.
+  mesh_copy.SetCompressionOptions(mesh->GetCompressionOptions());
+  draco::PointAttribute *const pos =
+      mesh_copy.attribute(mesh_copy.GetNamedAttributeId(
+          draco::GeometryAttribute::POSITION));
+  const float value[3] = {0.5f, 0.25f, 0.125f};
+  pos->SetAttributeValue(draco::AttributeValueIndex(0), value);
+  ASSERT_NE(draco::DracoMeshCache::ComputeKey(mesh_copy, identity), key);
+}
+
+// Tests that the glTF encoder reuses cached meshes and that the output does
+// not change.
+TEST(DracoMeshCacheTest, TestGltfEncoderWithCache) {
+  const std::unique_ptr<draco::Scene> scene = draco::ReadSceneFromTestFile(
+      "CesiumMilkTruck/glTF/CesiumMilkTruck.gltf");
+  ASSERT_NE(scene, nullptr);
+  const draco::DracoCompressionOptions options;
+  draco::SceneUtils::SetDracoCompressionOptions(&options, scene.get());
+
+  draco::GltfEncoder encoder;
+  draco::EncoderBuffer expected_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(*scene, &expected_buffer));
+
+  const std::string directory = GetEmptyCacheDirectory("mesh_cache_test");
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::DracoMeshCache> cache,
+                         draco::DracoMeshCache::Create(directory));
+  encoder.set_draco_mesh_cache(cache.get());
+  draco::EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(*scene, &buffer));
+  ASSERT_EQ(*buffer.buffer(), *expected_buffer.buffer());
+  ASSERT_EQ(cache->num_hits(), 0);
+  const int64_t num_meshes = cache->num_misses();
+  ASSERT_GT(num_meshes, 0);
+
+  // All meshes are found in a new cache using the same directory, also when
+  // the meshes are compressed in parallel.
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::DracoMeshCache> cache2,
+                         draco::DracoMeshCache::Create(directory));
+  encoder.set_draco_mesh_cache(cache2.get());
+  encoder.set_num_compression_threads(2);
+  buffer.Clear();
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(*scene, &buffer));
+  ASSERT_EQ(*buffer.buffer(), *expected_buffer.buffer());
+  ASSERT_EQ(cache2->num_hits(), num_meshes);
+  ASSERT_EQ(cache2->num_misses(), 0);
+}
+
+}  // namespace
+
+#endif  // DRACO_TRANSCODER_SUPPORTED
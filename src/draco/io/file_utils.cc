@@ -133,6 +133,13 @@ bool WriteBufferToFile(const void *buffer, size_t buffer_size,
                            file_name);
 }
 
+void SetEncoderBufferFileWriter(FileWriterInterface *file_writer,
+                                EncoderBuffer *buffer) {
+  buffer->SetFlushCallback([file_writer](const char *data, size_t size) {
+    return file_writer->Write(data, size);
+  });
+}
+
 size_t GetFileSize(const std::string &file_name) {
   std::unique_ptr<FileReaderInterface> file_reader =
       FileReaderFactory::OpenReader(file_name);
@@ -19,6 +19,9 @@
 #include <string>
 #include <vector>
 
+#include "draco/core/encoder_buffer.h"
+#include "draco/io/file_writer_interface.h"
+
 namespace draco {
 
 // Splits full path to a file into a folder path + file name.
@@ -76,6 +79,13 @@ bool WriteBufferToFile(const unsigned char *buffer, size_t buffer_size,
 bool WriteBufferToFile(const void *buffer, size_t buffer_size,
                        const std::string &file_name);
 
+// Sets up |buffer| to write all data flushed from it (see
+// EncoderBuffer::Flush()) into |file_writer|. This allows the encoders to
+// stream the encoded data into a file without holding the whole output in
+// memory. |file_writer| must outlive the encoding.
+void SetEncoderBufferFileWriter(FileWriterInterface *file_writer,
+                                EncoderBuffer *buffer);
+
 // Convenience method. Uses draco::FileReaderFactory internally. Returns size of
 // file referenced by |file_name|. Returns 0 when referenced file is empty or
 // does not exist.
@@ -19,6 +19,11 @@ class FileWriterInterface {
 
   // Writes |size| bytes from |buffer| to file.
   virtual bool Write(const char *buffer, size_t size) = 0;
+
+  // Closes the file before the writer is destroyed. Returns false when the
+  // written data could not be stored, e.g., when the final flush of buffered
+  // data fails. No data can be written after the file is closed.
+  virtual bool Close() { return true; }
 };
 
 }  // namespace draco
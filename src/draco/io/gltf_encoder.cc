@@ -19,11 +19,13 @@
 
 #include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -37,7 +39,9 @@
 #include "draco/compression/draco_compression_options.h"
 #include "draco/compression/expert_encode.h"
 #include "draco/core/draco_types.h"
+#include "draco/core/thread_pool.h"
 #include "draco/core/vector_d.h"
+#include "draco/io/draco_mesh_cache.h"
 #include "draco/io/file_utils.h"
 #include "draco/io/file_writer_utils.h"
 #include "draco/io/gltf_utils.h"
@@ -259,6 +263,288 @@ struct GltfMesh {
   std::vector<GltfPrimitive> primitives;
 };
 
+// Compresses |mesh| using Draco into |buffer| and returns the number of
+// encoded points and faces. |transform| is the largest transform of the base
+// mesh in the scene that is used to adjust the position quantization grid.
+Status EncodeMeshWithDraco(const Mesh &mesh, const Eigen::Matrix4d &transform,
+                           EncoderBuffer *buffer, int64_t *num_encoded_points,
+                           int64_t *num_encoded_faces) {
+  // Check that geometry comression options are valid.
+  DracoCompressionOptions compression_options = mesh.GetCompressionOptions();
+  DRACO_RETURN_IF_ERROR(compression_options.Check());
+
+  // Make a copy of the mesh. It will be modified and compressed.
+  std::unique_ptr<Mesh> mesh_copy(new Mesh());
+  mesh_copy->Copy(mesh);
+
+  // Delete auto-generated tangents.
+  if (MeshUtils::HasAutoGeneratedTangents(*mesh_copy)) {
+    for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
+      PointAttribute *const att = mesh_copy->attribute(i);
+      if (att->attribute_type() == GeometryAttribute::TANGENT) {
+        while (mesh_copy->GetNamedAttribute(GeometryAttribute::TANGENT)) {
+          mesh_copy->DeleteAttribute(
+              mesh_copy->GetNamedAttributeId(GeometryAttribute::TANGENT));
+        }
+        break;
+      }
+    }
+  }
+
+  // Create Draco encoder.
+  std::unique_ptr<ExpertEncoder> encoder;
+  if (mesh_copy->num_faces() > 0) {
+    // Encode mesh.
+    encoder.reset(new ExpertEncoder(*mesh_copy));
+  } else {
+    return Status(Status::DRACO_ERROR,
+                  "Draco compression is not supported for glTF point clouds.");
+  }
+  encoder->SetTrackEncodedProperties(true);
+
+  // Convert compression level to speed (that 0 = slowest, 10 = fastest).
+  const int speed = 10 - compression_options.compression_level;
+  encoder->SetSpeedOptions(speed, speed);
+
+  // Configure attribute quantization.
+  for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
+    const PointAttribute *const att = mesh_copy->attribute(i);
+    if (att->attribute_type() == GeometryAttribute::POSITION &&
+        !compression_options.quantization_position
+             .AreQuantizationBitsDefined()) {
+      // Desired spacing in the "global" coordinate system.
+      const float global_spacing =
+          compression_options.quantization_position.spacing();
+
+      // Note: Ideally we would transform the whole mesh before encoding and
+      // apply the original global spacing on the transformed mesh. But neither
+      // KHR_draco_mesh_compression, nor Draco bitstream support post-decoding
+      // transformations so we have to modify the grid settings here.
+
+      // Transform this spacing to the local coordinate system of the base mesh.
+      // We will get the largest scale factor from the transformation matrix and
+      // use it to adjust the grid spacing.
+      const Vector3f scale_vec(transform.col(0).norm(), transform.col(1).norm(),
+                               transform.col(2).norm());
+
+      const float max_scale = scale_vec.MaxCoeff();
+
+      // Spacing is inverse to the scale. The larger the scale, the smaller the
+      // spacing must be.
+      const float local_spacing = global_spacing / max_scale;
+
+      // Update the compression options of the processed mesh.
+      compression_options.quantization_position.SetGrid(local_spacing);
+    } else {
+      int num_quantization_bits = -1;
+      switch (att->attribute_type()) {
+        case GeometryAttribute::POSITION:
+          num_quantization_bits =
+              compression_options.quantization_position.quantization_bits();
+          break;
+        case GeometryAttribute::NORMAL:
+          num_quantization_bits = compression_options.quantization_bits_normal;
+          break;
+        case GeometryAttribute::TEX_COORD:
+          num_quantization_bits =
+              compression_options.quantization_bits_tex_coord;
+          break;
+        case GeometryAttribute::TANGENT:
+          num_quantization_bits = compression_options.quantization_bits_tangent;
+          break;
+        case GeometryAttribute::WEIGHTS:
+          num_quantization_bits = compression_options.quantization_bits_weight;
+          break;
+        case GeometryAttribute::GENERIC:
+          if (!IsFeatureIdAttribute(i, *mesh_copy)) {
+            num_quantization_bits =
+                compression_options.quantization_bits_generic;
+          } else {
+            // Quantization is explicitly disabled for feature ID attributes.
+            encoder->SetAttributeQuantization(i, -1);
+          }
+          break;
+        default:
+          break;
+      }
+      if (num_quantization_bits > 0) {
+        encoder->SetAttributeQuantization(i, num_quantization_bits);
+      }
+    }
+  }
+
+  // Flip UV values as required by glTF Draco and non-Draco files.
+  for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
+    PointAttribute *const att = mesh_copy->attribute(i);
+    if (att->attribute_type() == GeometryAttribute::TEX_COORD) {
+      if (!MeshUtils::FlipTextureUvValues(false, true, att)) {
+        return Status(Status::DRACO_ERROR, "Could not flip texture UV values.");
+      }
+    }
+  }
+
+  // Change tangents, joints, and weights attribute types to generic. The
+  // original mesh's attribute type is unchanged and the mapping of the glTF
+  // attribute type to Draco compressed attribute id is written to the output
+  // glTF file.
+  for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
+    PointAttribute *const att = mesh_copy->attribute(i);
+    if (att->attribute_type() == GeometryAttribute::TANGENT ||
+        att->attribute_type() == GeometryAttribute::JOINTS ||
+        att->attribute_type() == GeometryAttribute::WEIGHTS) {
+      att->set_attribute_type(GeometryAttribute::GENERIC);
+    }
+  }
+
+  // |compression_options| may have been modified and we need to update them
+  // before we start the encoding.
+  mesh_copy->SetCompressionOptions(compression_options);
+  DRACO_RETURN_IF_ERROR(encoder->EncodeToBuffer(buffer));
+  *num_encoded_points = encoder->num_encoded_points();
+  if (mesh_copy->num_faces() > 0) {
+    *num_encoded_faces = encoder->num_encoded_faces();
+  } else {
+    *num_encoded_faces = 0;
+  }
+  return OkStatus();
+}
+
+// Same as EncodeMeshWithDraco() but reuses the compressed data stored in
+// |cache| when available and adds newly compressed meshes to the cache.
+// |cache| can be null.
+Status EncodeMeshWithDracoCache(const Mesh &mesh,
+                                const Eigen::Matrix4d &transform,
+                                DracoMeshCache *cache, EncoderBuffer *buffer,
+                                int64_t *num_encoded_points,
+                                int64_t *num_encoded_faces) {
+  if (cache == nullptr) {
+    return EncodeMeshWithDraco(mesh, transform, buffer, num_encoded_points,
+                               num_encoded_faces);
+  }
+  const DracoMeshCache::Key key = DracoMeshCache::ComputeKey(mesh, transform);
+  if (cache->Find(key, buffer, num_encoded_points, num_encoded_faces)) {
+    return OkStatus();
+  }
+  DRACO_RETURN_IF_ERROR(EncodeMeshWithDraco(
+      mesh, transform, buffer, num_encoded_points, num_encoded_faces));
+  // Failing to store the entry only affects later encodings.
+  cache->Insert(key, *buffer, *num_encoded_points, *num_encoded_faces);
+  return OkStatus();
+}
+
+// Compresses the base meshes of a scene with Draco on a thread pool while the
+// glTF asset is assembled. The meshes are compressed in the order in which the
+// asset consumes them, and at most |max_queued_meshes| meshes are being
+// compressed or waiting to be consumed at any time, which bounds the memory
+// used by the compressed data.
+class DracoMeshCompressionPipeline {
+ public:
+  DracoMeshCompressionPipeline(
+      const std::vector<std::pair<const Mesh *, Eigen::Matrix4d>> &meshes,
+      DracoMeshCache *cache, int num_threads, int max_queued_meshes)
+      : meshes_(meshes),
+        cache_(cache),
+        results_(meshes.size()),
+        max_queued_meshes_(max_queued_meshes),
+        num_scheduled_meshes_(0),
+        num_taken_meshes_(0),
+        pool_(num_threads) {
+    for (int i = 0; i < static_cast<int>(meshes_.size()); ++i) {
+      mesh_to_index_[meshes_[i].first] = i;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    ScheduleMeshes(&lock, 0);
+  }
+
+  // Returns true if |mesh| is compressed by the pipeline.
+  bool HasMesh(const Mesh &mesh) const {
+    return mesh_to_index_.count(&mesh) > 0;
+  }
+
+  // Waits until |mesh| is compressed and returns its compressed data. Each
+  // mesh can be taken only once.
+  Status TakeCompressedMesh(const Mesh &mesh, EncoderBuffer *buffer,
+                            int64_t *num_encoded_points,
+                            int64_t *num_encoded_faces) {
+    const int index = mesh_to_index_.at(&mesh);
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Make sure the requested mesh is scheduled even if the meshes are taken
+    // out of order.
+    ScheduleMeshes(&lock, index + 1);
+    cond_.wait(lock, [&]() { return results_[index].done; });
+    Result result = std::move(results_[index]);
+    results_[index] = Result();
+    num_taken_meshes_++;
+    ScheduleMeshes(&lock, 0);
+    lock.unlock();
+
+    DRACO_RETURN_IF_ERROR(result.status);
+    buffer->buffer()->swap(*result.buffer.buffer());
+    *num_encoded_points = result.num_encoded_points;
+    *num_encoded_faces = result.num_encoded_faces;
+    return OkStatus();
+  }
+
+ private:
+  struct Result {
+    Result() : num_encoded_points(0), num_encoded_faces(0), done(false) {}
+    EncoderBuffer buffer;
+    int64_t num_encoded_points;
+    int64_t num_encoded_faces;
+    Status status;
+    bool done;
+  };
+
+  // Schedules the compression of the next meshes while the queue is not full,
+  // and at least |min_num_scheduled_meshes| meshes. Must be called with
+  // |mutex_| locked in |lock|.
+  void ScheduleMeshes(std::unique_lock<std::mutex> *lock,
+                      int min_num_scheduled_meshes) {
+    std::vector<int> indices;
+    const int num_meshes = static_cast<int>(meshes_.size());
+    while (num_scheduled_meshes_ < num_meshes &&
+           (num_scheduled_meshes_ < num_taken_meshes_ + max_queued_meshes_ ||
+            num_scheduled_meshes_ < min_num_scheduled_meshes)) {
+      indices.push_back(num_scheduled_meshes_++);
+    }
+    // Tasks can run synchronously on this thread, so the lock is released.
+    lock->unlock();
+    for (const int index : indices) {
+      pool_.Schedule([this, index]() { CompressMesh(index); });
+    }
+    lock->lock();
+  }
+
+  void CompressMesh(int index) {
+    Result result;
+    result.status = EncodeMeshWithDracoCache(
+        *meshes_[index].first, meshes_[index].second, cache_, &result.buffer,
+        &result.num_encoded_points, &result.num_encoded_faces);
+    result.done = true;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      results_[index] = std::move(result);
+    }
+    cond_.notify_all();
+  }
+
+  const std::vector<std::pair<const Mesh *, Eigen::Matrix4d>> meshes_;
+  std::unordered_map<const Mesh *, int> mesh_to_index_;
+  DracoMeshCache *const cache_;
+
+  // Guards |results_|, |num_scheduled_meshes_| and |num_taken_meshes_|.
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<Result> results_;
+  const int max_queued_meshes_;
+  int num_scheduled_meshes_;
+  int num_taken_meshes_;
+
+  // Declared last so that all tasks are finished before the other members are
+  // destroyed.
+  ThreadPool pool_;
+};
+
 // Class to hold and output glTF data.
 class GltfAsset {
  public:
@@ -309,6 +595,12 @@ class GltfAsset {
   void set_output_type(GltfEncoder::OutputType type) { output_type_ = type; }
   GltfEncoder::OutputType output_type() const { return output_type_; }
   void set_json_output_mode(JsonWriter::Mode mode) { gltf_json_.SetMode(mode); }
+  void set_num_compression_threads(int num_threads) {
+    num_compression_threads_ = num_threads;
+  }
+  void set_draco_mesh_cache(DracoMeshCache *cache) {
+    draco_mesh_cache_ = cache;
+  }
 
  private:
   // Pad |buffer_| to 4 byte boundary.
@@ -425,6 +717,11 @@ class GltfAsset {
   // Adds a Draco SceneNode, referenced by |scene_node_index|, to the glTF data.
   Status AddSceneNode(const Scene &scene, SceneNodeIndex scene_node_index);
 
+  // Returns a pipeline compressing the base meshes of |scene| with Draco, or
+  // nullptr when the meshes should be compressed on the calling thread.
+  std::unique_ptr<DracoMeshCompressionPipeline> CreateCompressionPipeline(
+      const Scene &scene) const;
+
   // Iterate through the materials that are associated with |scene| and add them
   // to the asset.
   void AddMaterials(const Scene &scene);
@@ -692,6 +989,16 @@ class GltfAsset {
   std::vector<std::unique_ptr<Mesh>> local_meshes_;
 
   std::vector<double> cesium_rtc_;
+
+  // Number of threads used to compress the scene meshes with Draco while the
+  // asset is assembled. Zero compresses the meshes on the calling thread.
+  int num_compression_threads_;
+
+  // Pipeline compressing the scene meshes while AddScene() is running.
+  DracoMeshCompressionPipeline *compression_pipeline_;
+
+  // Optional cache of Draco compressed meshes. Not owned.
+  DracoMeshCache *draco_mesh_cache_;
 };
 
 int GltfAsset::UnsignedIntComponentSize(unsigned int max_value) {
@@ -728,7 +1035,10 @@ GltfAsset::GltfAsset()
       structural_metadata_used_(false),
       mesh_features_texture_index_(0),
       add_images_to_buffer_(false),
-      output_type_(GltfEncoder::COMPACT) {}
+      output_type_(GltfEncoder::COMPACT),
+      num_compression_threads_(0),
+      compression_pipeline_(nullptr),
+      draco_mesh_cache_(nullptr) {}
 
 bool GltfAsset::AddDracoMesh(const Mesh &mesh) {
   const int scene_index = AddScene();
@@ -885,143 +1195,16 @@ Status GltfAsset::CompressMeshWithDraco(const Mesh &mesh,
                                         GltfPrimitive *primitive,
                                         int64_t *num_encoded_points,
                                         int64_t *num_encoded_faces) {
-  // Check that geometry comression options are valid.
-  DracoCompressionOptions compression_options = mesh.GetCompressionOptions();
-  DRACO_RETURN_IF_ERROR(compression_options.Check());
-
-  // Make a copy of the mesh. It will be modified and compressed.
-  std::unique_ptr<Mesh> mesh_copy(new Mesh());
-  mesh_copy->Copy(mesh);
-
-  // Delete auto-generated tangents.
-  if (MeshUtils::HasAutoGeneratedTangents(*mesh_copy)) {
-    for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
-      PointAttribute *const att = mesh_copy->attribute(i);
-      if (att->attribute_type() == GeometryAttribute::TANGENT) {
-        while (mesh_copy->GetNamedAttribute(GeometryAttribute::TANGENT)) {
-          mesh_copy->DeleteAttribute(
-              mesh_copy->GetNamedAttributeId(GeometryAttribute::TANGENT));
-        }
-        break;
-      }
-    }
-  }
-
-  // Create Draco encoder.
   EncoderBuffer buffer;
-  std::unique_ptr<ExpertEncoder> encoder;
-  if (mesh_copy->num_faces() > 0) {
-    // Encode mesh.
-    encoder.reset(new ExpertEncoder(*mesh_copy));
-  } else {
-    return Status(Status::DRACO_ERROR,
-                  "Draco compression is not supported for glTF point clouds.");
-  }
-  encoder->SetTrackEncodedProperties(true);
-
-  // Convert compression level to speed (that 0 = slowest, 10 = fastest).
-  const int speed = 10 - compression_options.compression_level;
-  encoder->SetSpeedOptions(speed, speed);
-
-  // Configure attribute quantization.
-  for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
-    const PointAttribute *const att = mesh_copy->attribute(i);
-    if (att->attribute_type() == GeometryAttribute::POSITION &&
-        !compression_options.quantization_position
-             .AreQuantizationBitsDefined()) {
-      // Desired spacing in the "global" coordinate system.
-      const float global_spacing =
-          compression_options.quantization_position.spacing();
-
-      // Note: Ideally we would transform the whole mesh before encoding and
-      // apply the original global spacing on the transformed mesh. But neither
-      // KHR_draco_mesh_compression, nor Draco bitstream support post-decoding
-      // transformations so we have to modify the grid settings here.
-
-      // Transform this spacing to the local coordinate system of the base mesh.
-      // We will get the largest scale factor from the transformation matrix and
-      // use it to adjust the grid spacing.
-      const Vector3f scale_vec(transform.col(0).norm(), transform.col(1).norm(),
-                               transform.col(2).norm());
-
-      const float max_scale = scale_vec.MaxCoeff();
-
-      // Spacing is inverse to the scale. The larger the scale, the smaller the
-      // spacing must be.
-      const float local_spacing = global_spacing / max_scale;
-
-      // Update the compression options of the processed mesh.
-      compression_options.quantization_position.SetGrid(local_spacing);
-    } else {
-      int num_quantization_bits = -1;
-      switch (att->attribute_type()) {
-        case GeometryAttribute::POSITION:
-          num_quantization_bits =
-              compression_options.quantization_position.quantization_bits();
-          break;
-        case GeometryAttribute::NORMAL:
-          num_quantization_bits = compression_options.quantization_bits_normal;
-          break;
-        case GeometryAttribute::TEX_COORD:
-          num_quantization_bits =
-              compression_options.quantization_bits_tex_coord;
-          break;
-        case GeometryAttribute::TANGENT:
-          num_quantization_bits = compression_options.quantization_bits_tangent;
-          break;
-        case GeometryAttribute::WEIGHTS:
-          num_quantization_bits = compression_options.quantization_bits_weight;
-          break;
-        case GeometryAttribute::GENERIC:
-          if (!IsFeatureIdAttribute(i, *mesh_copy)) {
-            num_quantization_bits =
-                compression_options.quantization_bits_generic;
-          } else {
-            // Quantization is explicitly disabled for feature ID attributes.
-            encoder->SetAttributeQuantization(i, -1);
-          }
-          break;
-        default:
-          break;
-      }
-      if (num_quantization_bits > 0) {
-        encoder->SetAttributeQuantization(i, num_quantization_bits);
-      }
-    }
-  }
-
-  // Flip UV values as required by glTF Draco and non-Draco files.
-  for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
-    PointAttribute *const att = mesh_copy->attribute(i);
-    if (att->attribute_type() == GeometryAttribute::TEX_COORD) {
-      if (!MeshUtils::FlipTextureUvValues(false, true, att)) {
-        return Status(Status::DRACO_ERROR, "Could not flip texture UV values.");
-      }
-    }
-  }
-
-  // Change tangents, joints, and weights attribute types to generic. The
-  // original mesh's attribute type is unchanged and the mapping of the glTF
-  // attribute type to Draco compressed attribute id is written to the output
-  // glTF file.
-  for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
-    PointAttribute *const att = mesh_copy->attribute(i);
-    if (att->attribute_type() == GeometryAttribute::TANGENT ||
-        att->attribute_type() == GeometryAttribute::JOINTS ||
-        att->attribute_type() == GeometryAttribute::WEIGHTS) {
-      att->set_attribute_type(GeometryAttribute::GENERIC);
-    }
-  }
-
-  // |compression_options| may have been modified and we need to update them
-  // before we start the encoding.
-  mesh_copy->SetCompressionOptions(compression_options);
-  DRACO_RETURN_IF_ERROR(encoder->EncodeToBuffer(&buffer));
-  *num_encoded_points = encoder->num_encoded_points();
-  if (mesh_copy->num_faces() > 0) {
-    *num_encoded_faces = encoder->num_encoded_faces();
+  if (compression_pipeline_ != nullptr &&
+      compression_pipeline_->HasMesh(mesh)) {
+    DRACO_RETURN_IF_ERROR(compression_pipeline_->TakeCompressedMesh(
+        mesh, &buffer, num_encoded_points, num_encoded_faces));
   } else {
-    *num_encoded_faces = 0;
+    DRACO_RETURN_IF_ERROR(EncodeMeshWithDracoCache(mesh, transform,
+                                                   draco_mesh_cache_, &buffer,
+                                                   num_encoded_points,
+                                                   num_encoded_faces));
   }
   const size_t buffer_start_offset = buffer_.size();
   if (!buffer_.Encode(buffer.data(), buffer.size())) {
@@ -1593,9 +1776,16 @@ Status GltfAsset::AddScene(const Scene &scene) {
   // Initialize base mesh transforms that may be needed when the base meshes are
   // compressed with Draco.
   base_mesh_transforms_ = SceneUtils::FindLargestBaseMeshTransforms(scene);
-  for (SceneNodeIndex i(0); i < scene.NumNodes(); ++i) {
-    DRACO_RETURN_IF_ERROR(AddSceneNode(scene, i));
-  }
+  std::unique_ptr<DracoMeshCompressionPipeline> pipeline =
+      CreateCompressionPipeline(scene);
+  compression_pipeline_ = pipeline.get();
+  Status status;
+  for (SceneNodeIndex i(0); i < scene.NumNodes() && status.ok(); ++i) {
+    status = AddSceneNode(scene, i);
+  }
+  compression_pipeline_ = nullptr;
+  pipeline.reset();
+  DRACO_RETURN_IF_ERROR(status);
   // There is 1:1 mapping between draco::Scene node indices and |nodes_|.
   for (int i = 0; i < scene.NumRootNodes(); ++i) {
     nodes_[scene.GetRootNodeIndex(i).value()].root_node = true;
@@ -1618,6 +1808,48 @@ Status GltfAsset::AddScene(const Scene &scene) {
   return OkStatus();
 }
 
+std::unique_ptr<DracoMeshCompressionPipeline>
+GltfAsset::CreateCompressionPipeline(const Scene &scene) const {
+  int num_threads = num_compression_threads_;
+  if (num_threads < 0) {
+    num_threads = ThreadPool::HardwareConcurrency() - 1;
+  }
+  if (num_threads <= 0) {
+    return nullptr;
+  }
+
+  // Collect the compressed base meshes in the order in which AddSceneNode()
+  // adds them to the asset.
+  std::vector<std::pair<const Mesh *, Eigen::Matrix4d>> meshes;
+  std::unordered_set<int> visited_mesh_groups;
+  std::unordered_set<int> visited_meshes;
+  for (SceneNodeIndex i(0); i < scene.NumNodes(); ++i) {
+    const MeshGroupIndex mesh_group_index =
+        scene.GetNode(i)->GetMeshGroupIndex();
+    if (mesh_group_index == kInvalidMeshGroupIndex ||
+        !visited_mesh_groups.insert(mesh_group_index.value()).second) {
+      continue;
+    }
+    const MeshGroup *const mesh_group = scene.GetMeshGroup(mesh_group_index);
+    for (int j = 0; j < mesh_group->NumMeshInstances(); ++j) {
+      const MeshIndex mesh_index = mesh_group->GetMeshInstance(j).mesh_index;
+      if (!visited_meshes.insert(mesh_index.value()).second) {
+        continue;
+      }
+      const Mesh &mesh = scene.GetMesh(mesh_index);
+      if (mesh.num_faces() > 0 && mesh.IsCompressionEnabled()) {
+        meshes.push_back({&mesh, base_mesh_transforms_[mesh_index]});
+      }
+    }
+  }
+  if (meshes.size() < 2) {
+    return nullptr;
+  }
+  return std::unique_ptr<DracoMeshCompressionPipeline>(
+      new DracoMeshCompressionPipeline(meshes, draco_mesh_cache_, num_threads,
+                                       2 * (num_threads + 1)));
+}
+
 Status GltfAsset::AddSceneNode(const Scene &scene,
                                SceneNodeIndex scene_node_index) {
   const SceneNode *const scene_node = scene.GetNode(scene_node_index);
@@ -3549,7 +3781,11 @@ void GltfAsset::SetCopyrightFromMesh(const Mesh &mesh) {
 const char GltfEncoder::kDracoMetadataGltfAttributeName[] =
     "//GLTF/ApplicationSpecificAttributeName";
 
-GltfEncoder::GltfEncoder() : out_buffer_(nullptr), output_type_(COMPACT) {}
+GltfEncoder::GltfEncoder()
+    : out_buffer_(nullptr),
+      output_type_(COMPACT),
+      num_compression_threads_(0),
+      draco_mesh_cache_(nullptr) {}
 
 template <typename T>
 bool GltfEncoder::EncodeToFile(const T &geometry, const std::string &file_name,
@@ -3601,6 +3837,8 @@ Status GltfEncoder::EncodeFile(const T &geometry, const std::string &filename,
   GltfAsset gltf_asset;
   gltf_asset.set_copyright(copyright_);
   gltf_asset.set_output_type(output_type_);
+  gltf_asset.set_num_compression_threads(num_compression_threads_);
+  gltf_asset.set_draco_mesh_cache(draco_mesh_cache_);
 
   if (extension == "gltf") {
     std::string bin_path;
@@ -3630,6 +3868,8 @@ Status GltfEncoder::EncodeToBuffer(const T &geometry,
   gltf_asset.buffer_name("");
   gltf_asset.set_add_images_to_buffer(true);
   gltf_asset.set_copyright(copyright_);
+  gltf_asset.set_num_compression_threads(num_compression_threads_);
+  gltf_asset.set_draco_mesh_cache(draco_mesh_cache_);
 
   // Encode the geometry into a buffer.
   EncoderBuffer buffer;
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "draco/core/encoder_buffer.h"
+#include "draco/io/draco_mesh_cache.h"
 #include "draco/io/file_writer_factory.h"
 #include "draco/io/file_writer_interface.h"
 #include "draco/io/texture_io.h"
@@ -87,6 +88,24 @@ class GltfEncoder {
   void set_copyright(const std::string &copyright) { copyright_ = copyright; }
   std::string copyright() const { return copyright_; }
 
+  // Sets the number of threads used to compress the meshes of a scene with
+  // Draco. The meshes are compressed ahead of time while the glTF data is
+  // assembled, so that the assembly overlaps with the compression. Negative
+  // values use all available hardware threads. Zero, the default, compresses
+  // the meshes one after another on the calling thread. The output does not
+  // depend on this setting.
+  void set_num_compression_threads(int num_threads) {
+    num_compression_threads_ = num_threads;
+  }
+  int num_compression_threads() const { return num_compression_threads_; }
+
+  // Sets a cache of Draco compressed meshes. Meshes found in the cache are not
+  // compressed again and newly compressed meshes are added to the cache. The
+  // cache is not owned by the encoder and can be null.
+  void set_draco_mesh_cache(DracoMeshCache *cache) {
+    draco_mesh_cache_ = cache;
+  }
+
   // The name of the attribute metadata that contains the glTF attribute
   // name. For application-specific generic attributes, if the metadata for
   // an attribute contains this key, then the value will be used as the
@@ -130,6 +149,8 @@ class GltfEncoder {
   EncoderBuffer *out_buffer_;
   OutputType output_type_;
   std::string copyright_;
+  int num_compression_threads_;
+  DracoMeshCache *draco_mesh_cache_;
 };
 
 }  // namespace draco
@@ -1500,6 +1500,31 @@ TEST_F(GltfEncoderTest, EncodeToBuffer) {
   ASSERT_EQ(std::memcmp(file_data.data(), buffer.data(), buffer.size()), 0);
 }
 
+// Tests that compressing the scene meshes with a thread pool while the glTF
+// data is assembled produces the same output as the sequential compression.
+TEST_F(GltfEncoderTest, EncodeWithParallelDracoCompression) {
+  const std::string file_name = "CesiumMilkTruck/glTF/CesiumMilkTruck.gltf";
+  const std::unique_ptr<Scene> scene = ReadSceneFromTestFile(file_name);
+  ASSERT_NE(scene, nullptr);
+  ASSERT_GT(scene->NumMeshes(), 1);
+  const DracoCompressionOptions options;
+  SceneUtils::SetDracoCompressionOptions(&options, scene.get());
+
+  GltfEncoder encoder;
+  EncoderBuffer expected_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(*scene, &expected_buffer));
+
+  for (const int num_threads : {1, 3, -1}) {
+    encoder.set_num_compression_threads(num_threads);
+    EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder.EncodeToBuffer(*scene, &buffer));
+    ASSERT_EQ(buffer.size(), expected_buffer.size());
+    ASSERT_EQ(std::memcmp(buffer.data(), expected_buffer.data(),
+                          buffer.size()),
+              0);
+  }
+}
+
 TEST_F(GltfEncoderTest, CopyrightAssetIsEncoded) {
   // Load scene from file.
   const std::string file_name = "CesiumMilkTruck/glTF/CesiumMilkTruck.gltf";
@@ -30,6 +30,9 @@ class StdioFileWriter : public FileWriterInterface {
   // Writes |size| bytes to |file_| from |buffer|. Returns true for success.
   bool Write(const char *buffer, size_t size) override;
 
+  // Closes |file_|. Returns true for success.
+  bool Close() override;
+
  private:
   StdioFileWriter(FILE *file) : file_(file) {}
 
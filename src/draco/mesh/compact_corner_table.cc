@@ -0,0 +1,357 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/compact_corner_table.h"
+
+#include <utility>
+#include <vector>
+
+#include "draco/mesh/corner_table_iterators.h"
+
+namespace draco {
+
+CompactCornerTable::CompactCornerTable()
+    : num_original_vertices_(0),
+      num_degenerated_faces_(0),
+      num_isolated_vertices_(0),
+      valence_cache_(*this) {}
+
+std::unique_ptr<CompactCornerTable> CompactCornerTable::Create(
+    const IndexTypeVector<FaceIndex, FaceType> &faces) {
+  std::unique_ptr<CompactCornerTable> ct(new CompactCornerTable());
+  if (!ct->Init(faces)) {
+    return nullptr;
+  }
+  return ct;
+}
+
+std::unique_ptr<CompactCornerTable> CompactCornerTable::Create(
+    const CornerTable &table) {
+  std::unique_ptr<CompactCornerTable> ct(new CompactCornerTable());
+  if (!ct->InitFromCornerTable(table)) {
+    return nullptr;
+  }
+  return ct;
+}
+
+bool CompactCornerTable::Init(
+    const IndexTypeVector<FaceIndex, FaceType> &faces) {
+  valence_cache_.ClearValenceCache();
+  valence_cache_.ClearValenceCacheInaccurate();
+  corners_.resize(faces.size() * 3);
+  for (FaceIndex fi(0); fi < static_cast<uint32_t>(faces.size()); ++fi) {
+    for (int i = 0; i < 3; ++i) {
+      corners_[FirstCorner(fi) + i].vertex = faces[fi][i];
+      corners_[FirstCorner(fi) + i].opposite = kInvalidCornerIndex;
+    }
+  }
+  int num_vertices = -1;
+  if (!ComputeOppositeCorners(&num_vertices)) {
+    return false;
+  }
+  if (!BreakNonManifoldEdges()) {
+    return false;
+  }
+  if (!ComputeVertexCorners(num_vertices)) {
+    return false;
+  }
+  return true;
+}
+
+bool CompactCornerTable::InitFromCornerTable(const CornerTable &table) {
+  valence_cache_.ClearValenceCache();
+  valence_cache_.ClearValenceCacheInaccurate();
+  corners_.resize(table.num_corners());
+  for (CornerIndex c(0); c < table.num_corners(); ++c) {
+    corners_[c].vertex = table.Vertex(c);
+    corners_[c].opposite = table.Opposite(c);
+  }
+  vertices_.resize(table.num_vertices());
+  for (VertexIndex v(0); v < table.num_vertices(); ++v) {
+    vertices_[v].left_most_corner = table.LeftMostCorner(v);
+    vertices_[v].valence = table.Valence(v);
+  }
+  num_original_vertices_ = table.NumOriginalVertices();
+  num_degenerated_faces_ = table.NumDegeneratedFaces();
+  num_isolated_vertices_ = table.NumIsolatedVertices();
+  non_manifold_vertex_parents_.clear();
+  for (VertexIndex v(num_original_vertices_); v < table.num_vertices(); ++v) {
+    non_manifold_vertex_parents_.push_back(table.VertexParent(v));
+  }
+  return true;
+}
+
+bool CompactCornerTable::ComputeOppositeCorners(int *num_vertices) {
+  if (num_vertices == nullptr) {
+    return false;
+  }
+  num_degenerated_faces_ = 0;
+
+  // Half-edges are matched through the outgoing half-edges stored on their
+  // source vertices, see CornerTable::ComputeOppositeCorners() for details.
+  std::vector<int> num_corners_on_vertices;
+  num_corners_on_vertices.reserve(num_corners());
+  for (CornerIndex c(0); c < num_corners(); ++c) {
+    const VertexIndex v1 = corners_[c].vertex;
+    if (v1.value() >= static_cast<int>(num_corners_on_vertices.size())) {
+      num_corners_on_vertices.resize(v1.value() + 1, 0);
+    }
+    num_corners_on_vertices[v1.value()]++;
+  }
+
+  // Storage for the half-edges of each vertex identified by their sink vertex
+  // and the corner opposite to the half-edge. Unused entries are marked with
+  // |sink_vert| == kInvalidVertexIndex.
+  struct VertexEdgePair {
+    VertexEdgePair()
+        : sink_vert(kInvalidVertexIndex), edge_corner(kInvalidCornerIndex) {}
+    VertexIndex sink_vert;
+    CornerIndex edge_corner;
+  };
+  std::vector<VertexEdgePair> vertex_edges(num_corners(), VertexEdgePair());
+
+  std::vector<int> vertex_offset(num_corners_on_vertices.size());
+  int offset = 0;
+  for (size_t i = 0; i < num_corners_on_vertices.size(); ++i) {
+    vertex_offset[i] = offset;
+    offset += num_corners_on_vertices[i];
+  }
+
+  for (CornerIndex c(0); c < num_corners(); ++c) {
+    const VertexIndex tip_v = corners_[c].vertex;
+    const VertexIndex source_v = corners_[Next(c)].vertex;
+    const VertexIndex sink_v = corners_[Previous(c)].vertex;
+
+    if (LocalIndex(c) == 0) {
+      // Ignore degenerated faces.
+      if (tip_v == source_v || tip_v == sink_v || source_v == sink_v) {
+        ++num_degenerated_faces_;
+        c += 2;
+        continue;
+      }
+    }
+
+    CornerIndex opposite_c(kInvalidCornerIndex);
+    const int num_corners_on_vert = num_corners_on_vertices[sink_v.value()];
+    offset = vertex_offset[sink_v.value()];
+    for (int i = 0; i < num_corners_on_vert; ++i, ++offset) {
+      const VertexIndex other_v = vertex_edges[offset].sink_vert;
+      if (other_v == kInvalidVertexIndex) {
+        break;  // No matching half-edge found on the sink vertex.
+      }
+      if (other_v == source_v) {
+        if (tip_v == corners_[vertex_edges[offset].edge_corner].vertex) {
+          continue;  // Don't connect mirrored faces.
+        }
+        opposite_c = vertex_edges[offset].edge_corner;
+        // Remove the matched half-edge from the sink vertex.
+        for (int j = i + 1; j < num_corners_on_vert; ++j, ++offset) {
+          vertex_edges[offset] = vertex_edges[offset + 1];
+          if (vertex_edges[offset].sink_vert == kInvalidVertexIndex) {
+            break;
+          }
+        }
+        vertex_edges[offset].sink_vert = kInvalidVertexIndex;
+        break;
+      }
+    }
+    if (opposite_c == kInvalidCornerIndex) {
+      // No opposite corner found. Insert the new half-edge to the first unused
+      // slot on the source vertex.
+      const int num_corners_on_source_vert =
+          num_corners_on_vertices[source_v.value()];
+      offset = vertex_offset[source_v.value()];
+      for (int i = 0; i < num_corners_on_source_vert; ++i, ++offset) {
+        if (vertex_edges[offset].sink_vert == kInvalidVertexIndex) {
+          vertex_edges[offset].sink_vert = sink_v;
+          vertex_edges[offset].edge_corner = c;
+          break;
+        }
+      }
+    } else {
+      corners_[c].opposite = opposite_c;
+      corners_[opposite_c].opposite = c;
+    }
+  }
+  *num_vertices = static_cast<int>(num_corners_on_vertices.size());
+  return true;
+}
+
+bool CompactCornerTable::BreakNonManifoldEdges() {
+  // Disconnects all faces attached to edges that are passed more than once by
+  // the 1-ring of a vertex, see CornerTable::BreakNonManifoldEdges().
+  std::vector<bool> visited_corners(num_corners(), false);
+  std::vector<std::pair<VertexIndex, CornerIndex>> sink_vertices;
+  bool mesh_connectivity_updated = false;
+  do {
+    mesh_connectivity_updated = false;
+    for (CornerIndex c(0); c < num_corners(); ++c) {
+      if (visited_corners[c.value()]) {
+        continue;
+      }
+      sink_vertices.clear();
+
+      // Swing all the way to the left-most corner of the corner's vertex.
+      CornerIndex first_c = c;
+      CornerIndex current_c = c;
+      CornerIndex next_c;
+      while (next_c = SwingLeft(current_c),
+             next_c != first_c && next_c != kInvalidCornerIndex &&
+                 !visited_corners[next_c.value()]) {
+        current_c = next_c;
+      }
+      first_c = current_c;
+
+      // Swing right and check whether all visited edges are unique.
+      do {
+        visited_corners[current_c.value()] = true;
+        const CornerIndex sink_c = Next(current_c);
+        const VertexIndex sink_v = corners_[sink_c].vertex;
+        const CornerIndex edge_corner = Previous(current_c);
+        bool vertex_connectivity_updated = false;
+        for (auto &&attached_sink_vertex : sink_vertices) {
+          if (attached_sink_vertex.first == sink_v) {
+            const CornerIndex other_edge_corner = attached_sink_vertex.second;
+            const CornerIndex opp_edge_corner = Opposite(edge_corner);
+            if (opp_edge_corner == other_edge_corner) {
+              // We are closing the loop so no need to change the connectivity.
+              continue;
+            }
+            // Break the connectivity on the non-manifold edge.
+            const CornerIndex opp_other_edge_corner =
+                Opposite(other_edge_corner);
+            if (opp_edge_corner != kInvalidCornerIndex) {
+              corners_[opp_edge_corner].opposite = kInvalidCornerIndex;
+            }
+            if (opp_other_edge_corner != kInvalidCornerIndex) {
+              corners_[opp_other_edge_corner].opposite = kInvalidCornerIndex;
+            }
+            corners_[edge_corner].opposite = kInvalidCornerIndex;
+            corners_[other_edge_corner].opposite = kInvalidCornerIndex;
+            vertex_connectivity_updated = true;
+            break;
+          }
+        }
+        if (vertex_connectivity_updated) {
+          // Not all corners of this vertex have been processed with the
+          // updated connectivity so we need to go over them again.
+          mesh_connectivity_updated = true;
+          break;
+        }
+        sink_vertices.push_back(std::make_pair(
+            corners_[Previous(current_c)].vertex, sink_c));
+        current_c = SwingRight(current_c);
+      } while (current_c != first_c && current_c != kInvalidCornerIndex);
+    }
+  } while (mesh_connectivity_updated);
+  return true;
+}
+
+bool CompactCornerTable::ComputeVertexCorners(int num_vertices) {
+  num_original_vertices_ = num_vertices;
+  VertexData invalid_vertex;
+  invalid_vertex.left_most_corner = kInvalidCornerIndex;
+  invalid_vertex.valence = 0;
+  vertices_.assign(num_vertices, invalid_vertex);
+  non_manifold_vertex_parents_.clear();
+  // Visited vertices and corners that allow us to detect non-manifold
+  // vertices, see CornerTable::ComputeVertexCorners().
+  std::vector<bool> visited_vertices(num_vertices, false);
+  std::vector<bool> visited_corners(num_corners(), false);
+
+  for (FaceIndex f(0); f < num_faces(); ++f) {
+    if (IsDegenerated(f)) {
+      continue;
+    }
+    const CornerIndex first_face_corner = FirstCorner(f);
+    for (int k = 0; k < 3; ++k) {
+      const CornerIndex c = first_face_corner + k;
+      if (visited_corners[c.value()]) {
+        continue;
+      }
+      VertexIndex v = corners_[c].vertex;
+      bool is_non_manifold_vertex = false;
+      if (visited_vertices[v.value()]) {
+        // A visited vertex of an unvisited corner must be a non-manifold
+        // vertex. Create a new vertex for it.
+        vertices_.push_back(invalid_vertex);
+        non_manifold_vertex_parents_.push_back(v);
+        visited_vertices.push_back(false);
+        v = VertexIndex(num_vertices++);
+        is_non_manifold_vertex = true;
+      }
+      visited_vertices[v.value()] = true;
+
+      // Swing all the way to the left and mark all corners on the way.
+      CornerIndex act_c(c);
+      while (act_c != kInvalidCornerIndex) {
+        visited_corners[act_c.value()] = true;
+        vertices_[v].left_most_corner = act_c;
+        if (is_non_manifold_vertex) {
+          corners_[act_c].vertex = v;
+        }
+        act_c = SwingLeft(act_c);
+        if (act_c == c) {
+          break;  // Full circle reached.
+        }
+      }
+      if (act_c == kInvalidCornerIndex) {
+        // Open boundary reached. Swing right from the initial corner to mark
+        // all corners in the opposite direction.
+        act_c = SwingRight(c);
+        while (act_c != kInvalidCornerIndex) {
+          visited_corners[act_c.value()] = true;
+          if (is_non_manifold_vertex) {
+            corners_[act_c].vertex = v;
+          }
+          act_c = SwingRight(act_c);
+        }
+      }
+    }
+  }
+
+  num_isolated_vertices_ = 0;
+  for (bool visited : visited_vertices) {
+    if (!visited) {
+      ++num_isolated_vertices_;
+    }
+  }
+
+  // The valences are stored next to the left-most corners.
+  for (VertexIndex v(0); v < num_vertices; ++v) {
+    int valence = 0;
+    for (VertexRingIterator<CompactCornerTable> vi(this, v); !vi.End();
+         vi.Next()) {
+      ++valence;
+    }
+    vertices_[v].valence = valence;
+  }
+  return true;
+}
+
+bool CompactCornerTable::IsDegenerated(FaceIndex face) const {
+  if (face == kInvalidFaceIndex) {
+    return true;
+  }
+  const CornerIndex first_face_corner = FirstCorner(face);
+  const VertexIndex v0 = Vertex(first_face_corner);
+  const VertexIndex v1 = Vertex(Next(first_face_corner));
+  const VertexIndex v2 = Vertex(Previous(first_face_corner));
+  if (v0 == v1 || v0 == v2 || v1 == v2) {
+    return true;
+  }
+  return false;
+}
+
+}  // namespace draco
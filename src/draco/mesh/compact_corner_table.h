@@ -0,0 +1,257 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_MESH_COMPACT_CORNER_TABLE_H_
+#define DRACO_MESH_COMPACT_CORNER_TABLE_H_
+
+#include <array>
+#include <memory>
+
+#include "draco/attributes/geometry_indices.h"
+#include "draco/core/draco_index_type_vector.h"
+#include "draco/core/macros.h"
+#include "draco/mesh/corner_table.h"
+#include "draco/mesh/valence_cache.h"
+
+namespace draco {
+
+// CompactCornerTable is a read-only alternative to CornerTable that stores the
+// same connectivity using an interleaved (array-of-structs) memory layout.
+// For each corner, the mapped vertex and the opposite corner are stored as a
+// pair of 32-bit values, so all data of a single face occupies 24 consecutive
+// bytes. For each vertex, the left-most corner is stored together with the
+// valence of the vertex. As a result, the common traversal operations such as
+// Opposite(), Next(), Previous(), Vertex() and SwingLeft()/SwingRight() on one
+// face touch a single cache line instead of one cache line per array.
+//
+// The class implements the read-only interface of CornerTable and can be used
+// with all templates that are parametrized by a corner table type, such as
+// the traversers in compression/mesh/traverser/, the iterators defined in
+// corner_table_iterators.h, or MeshPredictionSchemeData.
+class CompactCornerTable {
+ public:
+  // Corner table face type.
+  typedef CornerTable::FaceType FaceType;
+
+  CompactCornerTable();
+
+  // Creates a compact corner table from the given indexed faces. The input
+  // faces can represent a non-manifold topology, in which case the
+  // non-manifold edges and vertices are going to be split like in CornerTable.
+  // The table is built directly without an intermediate CornerTable.
+  static std::unique_ptr<CompactCornerTable> Create(
+      const IndexTypeVector<FaceIndex, FaceType> &faces);
+
+  // Creates a compact copy of an existing |table|.
+  static std::unique_ptr<CompactCornerTable> Create(const CornerTable &table);
+
+  // Initializes the compact corner table from the given indexed faces.
+  bool Init(const IndexTypeVector<FaceIndex, FaceType> &faces);
+
+  // Initializes the compact corner table from an existing |table|.
+  bool InitFromCornerTable(const CornerTable &table);
+
+  inline int num_vertices() const {
+    return static_cast<int>(vertices_.size());
+  }
+  inline int num_corners() const { return static_cast<int>(corners_.size()); }
+  inline int num_faces() const {
+    return static_cast<int>(corners_.size() / 3);
+  }
+
+  inline CornerIndex Opposite(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return corner;
+    }
+    return corners_[corner].opposite;
+  }
+  inline CornerIndex Next(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return corner;
+    }
+    return LocalIndex(++corner) ? corner : corner - 3;
+  }
+  inline CornerIndex Previous(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return corner;
+    }
+    return LocalIndex(corner) ? corner - 1 : corner + 2;
+  }
+  inline VertexIndex Vertex(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return kInvalidVertexIndex;
+    }
+    return ConfidentVertex(corner);
+  }
+  inline VertexIndex ConfidentVertex(CornerIndex corner) const {
+    DRACO_DCHECK_GE(corner.value(), 0);
+    DRACO_DCHECK_LT(corner.value(), num_corners());
+    return corners_[corner].vertex;
+  }
+  inline FaceIndex Face(CornerIndex corner) const {
+    if (corner == kInvalidCornerIndex) {
+      return kInvalidFaceIndex;
+    }
+    return FaceIndex(corner.value() / 3);
+  }
+  inline CornerIndex FirstCorner(FaceIndex face) const {
+    if (face == kInvalidFaceIndex) {
+      return kInvalidCornerIndex;
+    }
+    return CornerIndex(face.value() * 3);
+  }
+  inline std::array<CornerIndex, 3> AllCorners(FaceIndex face) const {
+    const CornerIndex ci = CornerIndex(face.value() * 3);
+    return {{ci, ci + 1, ci + 2}};
+  }
+  inline int LocalIndex(CornerIndex corner) const { return corner.value() % 3; }
+
+  inline FaceType FaceData(FaceIndex face) const {
+    const CornerIndex first_corner = FirstCorner(face);
+    FaceType face_data;
+    for (int i = 0; i < 3; ++i) {
+      face_data[i] = corners_[first_corner + i].vertex;
+    }
+    return face_data;
+  }
+
+  // Returns the left-most corner of a single vertex 1-ring. If a vertex is not
+  // on a boundary (in which case it has a full 1-ring), this function returns
+  // any of the corners mapped to the given vertex.
+  inline CornerIndex LeftMostCorner(VertexIndex v) const {
+    return vertices_[v].left_most_corner;
+  }
+
+  // Returns the parent vertex index of a given corner table vertex.
+  VertexIndex VertexParent(VertexIndex vertex) const {
+    if (vertex.value() < static_cast<uint32_t>(num_original_vertices_)) {
+      return vertex;
+    }
+    return non_manifold_vertex_parents_[vertex - num_original_vertices_];
+  }
+
+  // Returns true if the corner is valid.
+  inline bool IsValid(CornerIndex c) const {
+    return Vertex(c) != kInvalidVertexIndex;
+  }
+
+  // Returns the valence (or degree) of a vertex. The valences are computed
+  // when the table is initialized so this is a simple lookup.
+  // Returns -1 if the given vertex index is not valid.
+  inline int Valence(VertexIndex v) const {
+    if (v == kInvalidVertexIndex) {
+      return -1;
+    }
+    return ConfidentValence(v);
+  }
+  // Same as above but does not check for validity and does not return -1
+  inline int ConfidentValence(VertexIndex v) const {
+    DRACO_DCHECK_GE(v.value(), 0);
+    DRACO_DCHECK_LT(v.value(), num_vertices());
+    return vertices_[v].valence;
+  }
+  // Returns the valence of the vertex at the given corner.
+  inline int Valence(CornerIndex c) const {
+    if (c == kInvalidCornerIndex) {
+      return -1;
+    }
+    return ConfidentValence(c);
+  }
+  inline int ConfidentValence(CornerIndex c) const {
+    DRACO_DCHECK_LT(c.value(), num_corners());
+    return ConfidentValence(ConfidentVertex(c));
+  }
+
+  // Returns true if the specified vertex is on a boundary.
+  inline bool IsOnBoundary(VertexIndex vert) const {
+    const CornerIndex corner = LeftMostCorner(vert);
+    if (SwingLeft(corner) == kInvalidCornerIndex) {
+      return true;
+    }
+    return false;
+  }
+
+  // See CornerTable::SwingRight().
+  inline CornerIndex SwingRight(CornerIndex corner) const {
+    return Previous(Opposite(Previous(corner)));
+  }
+  // See CornerTable::SwingLeft().
+  inline CornerIndex SwingLeft(CornerIndex corner) const {
+    return Next(Opposite(Next(corner)));
+  }
+
+  // See CornerTable::GetLeftCorner() and CornerTable::GetRightCorner().
+  inline CornerIndex GetLeftCorner(CornerIndex corner_id) const {
+    if (corner_id == kInvalidCornerIndex) {
+      return kInvalidCornerIndex;
+    }
+    return Opposite(Previous(corner_id));
+  }
+  inline CornerIndex GetRightCorner(CornerIndex corner_id) const {
+    if (corner_id == kInvalidCornerIndex) {
+      return kInvalidCornerIndex;
+    }
+    return Opposite(Next(corner_id));
+  }
+
+  int NumNewVertices() const { return num_vertices() - num_original_vertices_; }
+  int NumOriginalVertices() const { return num_original_vertices_; }
+  int NumDegeneratedFaces() const { return num_degenerated_faces_; }
+  int NumIsolatedVertices() const { return num_isolated_vertices_; }
+
+  bool IsDegenerated(FaceIndex face) const;
+
+  // Returns true if a vertex is not attached to any face.
+  inline bool IsVertexIsolated(VertexIndex v) const {
+    return LeftMostCorner(v) == kInvalidCornerIndex;
+  }
+
+  // Valence cache for compatibility with CornerTable. Note that all valences
+  // are always available through Valence() without any caching.
+  const draco::ValenceCache<CompactCornerTable> &GetValenceCache() const {
+    return valence_cache_;
+  }
+
+ private:
+  // Same as the methods of CornerTable with the same name.
+  bool ComputeOppositeCorners(int *num_vertices);
+  bool BreakNonManifoldEdges();
+  bool ComputeVertexCorners(int num_vertices);
+
+  // Connectivity data of a single corner.
+  struct CornerData {
+    VertexIndex vertex;
+    CornerIndex opposite;
+  };
+
+  // Connectivity data of a single vertex.
+  struct VertexData {
+    CornerIndex left_most_corner;
+    int32_t valence;
+  };
+
+  IndexTypeVector<CornerIndex, CornerData> corners_;
+  IndexTypeVector<VertexIndex, VertexData> vertices_;
+
+  int num_original_vertices_;
+  int num_degenerated_faces_;
+  int num_isolated_vertices_;
+  IndexTypeVector<VertexIndex, VertexIndex> non_manifold_vertex_parents_;
+
+  draco::ValenceCache<CompactCornerTable> valence_cache_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_MESH_COMPACT_CORNER_TABLE_H_
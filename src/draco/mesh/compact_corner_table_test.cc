@@ -0,0 +1,247 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/compact_corner_table.h"
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_data.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_decoder.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_encoder.h"
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_decoding_transform.h"
+#include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_encoding_transform.h"
+#include "draco/compression/mesh/traverser/depth_first_traverser.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/mesh/corner_table_iterators.h"
+#include "draco/mesh/mesh_connected_components.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+namespace draco {
+
+// Traversal observer that records the corners of the visited vertices.
+class VisitedCornersObserver {
+ public:
+  VisitedCornersObserver() : corners_(nullptr) {}
+  explicit VisitedCornersObserver(std::vector<CornerIndex> *corners)
+      : corners_(corners) {}
+  void OnNewFaceVisited(FaceIndex /* face */) {}
+  void OnNewVertexVisited(VertexIndex /* vertex */, CornerIndex corner) {
+    corners_->push_back(corner);
+  }
+
+ private:
+  std::vector<CornerIndex> *corners_;
+};
+
+class CompactCornerTableTest : public ::testing::Test {
+ protected:
+  // Returns the faces of |mesh| defined on the position attribute values.
+  IndexTypeVector<FaceIndex, CornerTable::FaceType> GetPositionFaces(
+      const Mesh &mesh) {
+    const PointAttribute *const pos_att =
+        mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+    IndexTypeVector<FaceIndex, CornerTable::FaceType> faces(mesh.num_faces());
+    for (FaceIndex fi(0); fi < mesh.num_faces(); ++fi) {
+      for (int c = 0; c < 3; ++c) {
+        faces[fi][c] =
+            VertexIndex(pos_att->mapped_index(mesh.face(fi)[c]).value());
+      }
+    }
+    return faces;
+  }
+
+  // Returns the vertex corners of |table| in the depth first traversal order.
+  template <class CornerTableT>
+  std::vector<CornerIndex> TraverseDepthFirst(const CornerTableT &table) {
+    std::vector<CornerIndex> corners;
+    DepthFirstTraverser<CornerTableT, VisitedCornersObserver> traverser;
+    traverser.Init(&table, VisitedCornersObserver(&corners));
+    traverser.OnTraversalStart();
+    for (FaceIndex f(0); f < table.num_faces(); ++f) {
+      traverser.TraverseFromCorner(table.FirstCorner(f));
+    }
+    traverser.OnTraversalEnd();
+    return corners;
+  }
+
+  // Verifies that |compact_table| represents the same connectivity as |table|.
+  void CompareTables(const CornerTable &table,
+                     const CompactCornerTable &compact_table) {
+    ASSERT_EQ(table.num_vertices(), compact_table.num_vertices());
+    ASSERT_EQ(table.num_corners(), compact_table.num_corners());
+    ASSERT_EQ(table.num_faces(), compact_table.num_faces());
+    ASSERT_EQ(table.NumNewVertices(), compact_table.NumNewVertices());
+    ASSERT_EQ(table.NumDegeneratedFaces(), compact_table.NumDegeneratedFaces());
+    ASSERT_EQ(table.NumIsolatedVertices(), compact_table.NumIsolatedVertices());
+    for (CornerIndex ci(0); ci < table.num_corners(); ++ci) {
+      ASSERT_EQ(table.Vertex(ci), compact_table.Vertex(ci));
+      ASSERT_EQ(table.Opposite(ci), compact_table.Opposite(ci));
+      ASSERT_EQ(table.SwingLeft(ci), compact_table.SwingLeft(ci));
+      ASSERT_EQ(table.SwingRight(ci), compact_table.SwingRight(ci));
+    }
+    for (VertexIndex vi(0); vi < table.num_vertices(); ++vi) {
+      ASSERT_EQ(table.LeftMostCorner(vi), compact_table.LeftMostCorner(vi));
+      ASSERT_EQ(table.VertexParent(vi), compact_table.VertexParent(vi));
+      ASSERT_EQ(table.Valence(vi), compact_table.Valence(vi));
+      if (table.IsVertexIsolated(vi)) {
+        continue;
+      }
+      ASSERT_EQ(table.IsOnBoundary(vi), compact_table.IsOnBoundary(vi));
+      // Iterate over the vertex 1-ring using the shared iterator template.
+      VertexRingIterator<CornerTable> it(&table, vi);
+      VertexRingIterator<CompactCornerTable> compact_it(&compact_table, vi);
+      for (; !it.End(); it.Next(), compact_it.Next()) {
+        ASSERT_FALSE(compact_it.End());
+        ASSERT_EQ(it.Vertex(), compact_it.Vertex());
+      }
+      ASSERT_TRUE(compact_it.End());
+    }
+  }
+};
+
+TEST_F(CompactCornerTableTest, TestSameConnectivity) {
+  for (const std::string file_name :
+       {"cube_att.obj", "non_manifold_wrap.obj", "deg_faces.obj",
+        "extra_vertex.obj", "bun_zipper.ply"}) {
+    std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    std::unique_ptr<CornerTable> table =
+        CreateCornerTableFromPositionAttribute(mesh.get());
+    ASSERT_NE(table, nullptr);
+    std::unique_ptr<CompactCornerTable> compact_table =
+        CompactCornerTable::Create(*table);
+    ASSERT_NE(compact_table, nullptr);
+    CompareTables(*table, *compact_table);
+  }
+}
+
+TEST_F(CompactCornerTableTest, TestCreateFromFaces) {
+  for (const std::string file_name :
+       {"cube_att.obj", "non_manifold_wrap.obj", "deg_faces.obj",
+        "extra_vertex.obj", "bun_zipper.ply"}) {
+    std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    const IndexTypeVector<FaceIndex, CornerTable::FaceType> faces =
+        GetPositionFaces(*mesh);
+    std::unique_ptr<CornerTable> table = CornerTable::Create(faces);
+    ASSERT_NE(table, nullptr);
+    std::unique_ptr<CompactCornerTable> compact_table =
+        CompactCornerTable::Create(faces);
+    ASSERT_NE(compact_table, nullptr);
+    CompareTables(*table, *compact_table);
+  }
+}
+
+TEST_F(CompactCornerTableTest, TestParallelogramPrediction) {
+  // Tests that the compact table works with the traverser and the
+  // parallelogram prediction used by the encoder and the decoder.
+  std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("bun_zipper.ply");
+  ASSERT_NE(mesh, nullptr);
+  const IndexTypeVector<FaceIndex, CornerTable::FaceType> faces =
+      GetPositionFaces(*mesh);
+  std::unique_ptr<CornerTable> table = CornerTable::Create(faces);
+  ASSERT_NE(table, nullptr);
+  std::unique_ptr<CompactCornerTable> compact_table =
+      CompactCornerTable::Create(faces);
+  ASSERT_NE(compact_table, nullptr);
+
+  const std::vector<CornerIndex> data_to_corner_map =
+      TraverseDepthFirst(*table);
+  ASSERT_EQ(TraverseDepthFirst(*compact_table), data_to_corner_map);
+
+  // Integer position values in the traversal order.
+  const PointAttribute *const pos_att =
+      mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+  const int num_values = static_cast<int>(data_to_corner_map.size());
+  std::vector<int32_t> values(num_values * 3);
+  std::vector<int32_t> vertex_to_data_map(table->num_vertices(), -1);
+  for (int p = 0; p < num_values; ++p) {
+    const CornerIndex c = data_to_corner_map[p];
+    const PointIndex point = mesh->face(table->Face(c))[table->LocalIndex(c)];
+    float pos[3];
+    pos_att->GetMappedValue(point, pos);
+    for (int i = 0; i < 3; ++i) {
+      values[3 * p + i] = static_cast<int32_t>(pos[i] * 10000.f);
+    }
+    vertex_to_data_map[table->Vertex(c).value()] = p;
+  }
+
+  typedef PredictionSchemeWrapEncodingTransform<int32_t> EncodingTransform;
+  MeshPredictionSchemeData<CornerTable> mesh_data;
+  mesh_data.Set(mesh.get(), table.get(), &data_to_corner_map,
+                &vertex_to_data_map);
+  MeshPredictionSchemeParallelogramEncoder<
+      int32_t, EncodingTransform, MeshPredictionSchemeData<CornerTable>>
+      encoder(pos_att, EncodingTransform(), mesh_data);
+  std::vector<int32_t> corrections(values.size());
+  ASSERT_TRUE(encoder.ComputeCorrectionValues(
+      values.data(), corrections.data(), static_cast<int>(values.size()), 3,
+      nullptr));
+
+  MeshPredictionSchemeData<CompactCornerTable> compact_mesh_data;
+  compact_mesh_data.Set(mesh.get(), compact_table.get(), &data_to_corner_map,
+                        &vertex_to_data_map);
+  MeshPredictionSchemeParallelogramEncoder<
+      int32_t, EncodingTransform, MeshPredictionSchemeData<CompactCornerTable>>
+      compact_encoder(pos_att, EncodingTransform(), compact_mesh_data);
+  std::vector<int32_t> compact_corrections(values.size());
+  ASSERT_TRUE(compact_encoder.ComputeCorrectionValues(
+      values.data(), compact_corrections.data(),
+      static_cast<int>(values.size()), 3, nullptr));
+  ASSERT_EQ(compact_corrections, corrections);
+
+  // Restore the original values using the compact table.
+  EncoderBuffer buffer;
+  ASSERT_TRUE(compact_encoder.EncodePredictionData(&buffer));
+  DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(buffer.data(), buffer.size());
+  typedef PredictionSchemeWrapDecodingTransform<int32_t> DecodingTransform;
+  MeshPredictionSchemeParallelogramDecoder<
+      int32_t, DecodingTransform, MeshPredictionSchemeData<CompactCornerTable>>
+      compact_decoder(pos_att, DecodingTransform(), compact_mesh_data);
+  ASSERT_TRUE(compact_decoder.DecodePredictionData(&decoder_buffer));
+  std::vector<int32_t> decoded_values(values.size());
+  ASSERT_TRUE(compact_decoder.ComputeOriginalValues(
+      compact_corrections.data(), decoded_values.data(),
+      static_cast<int>(values.size()), 3, nullptr));
+  ASSERT_EQ(decoded_values, values);
+}
+
+TEST_F(CompactCornerTableTest, TestConnectedComponents) {
+  // Tests that the compact table works with templated mesh algorithms.
+  std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("non_manifold_wrap.obj");
+  ASSERT_NE(mesh, nullptr);
+  std::unique_ptr<CornerTable> table =
+      CreateCornerTableFromPositionAttribute(mesh.get());
+  ASSERT_NE(table, nullptr);
+  std::unique_ptr<CompactCornerTable> compact_table =
+      CompactCornerTable::Create(*table);
+  ASSERT_NE(compact_table, nullptr);
+
+  MeshConnectedComponents components;
+  components.FindConnectedComponents(table.get());
+  MeshConnectedComponents compact_components;
+  compact_components.FindConnectedComponents(compact_table.get());
+  ASSERT_EQ(components.NumConnectedComponents(),
+            compact_components.NumConnectedComponents());
+  for (int i = 0; i < components.NumConnectedComponents(); ++i) {
+    ASSERT_EQ(components.GetConnectedComponent(i).vertices,
+              compact_components.GetConnectedComponent(i).vertices);
+    ASSERT_EQ(components.GetConnectedComponent(i).faces,
+              compact_components.GetConnectedComponent(i).faces);
+  }
+}
+
+}  // namespace draco
@@ -14,14 +14,87 @@
 //
 #include "draco/mesh/corner_table.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "draco/attributes/geometry_indices.h"
+#include "draco/core/thread_pool.h"
 #include "draco/mesh/corner_table_iterators.h"
 
 namespace draco {
 
+namespace {
+
+// Minimum number of items processed by a single parallel task.
+constexpr int kMinItemsPerTask = 1 << 12;
+
+// Atomically replaces |value| with |candidate| if |candidate| is smaller.
+void AtomicMin(std::atomic<uint32_t> *value, uint32_t candidate) {
+  uint32_t current = value->load(std::memory_order_relaxed);
+  while (candidate < current &&
+         !value->compare_exchange_weak(current, candidate,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+// Exclusive prefix sums of item counts over consecutive blocks of a range.
+// Used for parallel processing of items that need to be assigned ranks in the
+// order of their indices.
+struct BlockPrefixSums {
+  int num_items;
+  int block_size;
+  // Offset of each block. The last entry is the total count.
+  std::vector<int> offsets;
+};
+
+// Splits range [0, |num_items|) into consecutive blocks and calls
+// |count_func(begin, end)| on each block in parallel. Returns the prefix sums
+// of the counts.
+BlockPrefixSums ComputeBlockPrefixSums(
+    ThreadPool *pool, int num_items,
+    const std::function<int(int, int)> &count_func) {
+  BlockPrefixSums sums;
+  const int num_blocks = std::max(
+      1, std::min(4 * (pool->num_threads() + 1),
+                  (num_items + kMinItemsPerTask - 1) / kMinItemsPerTask));
+  sums.num_items = num_items;
+  sums.block_size = std::max(1, (num_items + num_blocks - 1) / num_blocks);
+  sums.offsets.resize(num_blocks + 1, 0);
+  pool->ParallelFor(num_blocks, 1, [&](int begin, int end) {
+    for (int b = begin; b < end; ++b) {
+      const int block_begin = std::min(b * sums.block_size, num_items);
+      const int block_end = std::min(block_begin + sums.block_size, num_items);
+      sums.offsets[b + 1] = count_func(block_begin, block_end);
+    }
+  });
+  for (int b = 0; b < num_blocks; ++b) {
+    sums.offsets[b + 1] += sums.offsets[b];
+  }
+  return sums;
+}
+
+// Calls |process_func(begin, end, offset)| in parallel on each block of
+// |sums|, where |offset| is the prefix sum of all preceding blocks.
+void ProcessBlocks(ThreadPool *pool, const BlockPrefixSums &sums,
+                   const std::function<void(int, int, int)> &process_func) {
+  const int num_blocks = static_cast<int>(sums.offsets.size()) - 1;
+  pool->ParallelFor(num_blocks, 1, [&](int begin, int end) {
+    for (int b = begin; b < end; ++b) {
+      const int block_begin = std::min(b * sums.block_size, sums.num_items);
+      const int block_end =
+          std::min(block_begin + sums.block_size, sums.num_items);
+      process_func(block_begin, block_end, sums.offsets[b]);
+    }
+  });
+}
+
+}  // namespace
+
 CornerTable::CornerTable()
     : num_original_vertices_(0),
       num_degenerated_faces_(0),
@@ -37,23 +110,60 @@ std::unique_ptr<CornerTable> CornerTable::Create(
   return ct;
 }
 
+std::unique_ptr<CornerTable> CornerTable::Create(
+    const IndexTypeVector<FaceIndex, FaceType> &faces, ThreadPool *pool) {
+  std::unique_ptr<CornerTable> ct(new CornerTable());
+  if (!ct->Init(faces, pool)) {
+    return nullptr;
+  }
+  return ct;
+}
+
 bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces) {
+  return Init(faces, nullptr);
+}
+
+bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces,
+                       ThreadPool *pool) {
   valence_cache_.ClearValenceCache();
   valence_cache_.ClearValenceCacheInaccurate();
   corner_to_vertex_map_.resize(faces.size() * 3);
-  for (FaceIndex fi(0); fi < static_cast<uint32_t>(faces.size()); ++fi) {
-    for (int i = 0; i < 3; ++i) {
-      corner_to_vertex_map_[FirstCorner(fi) + i] = faces[fi][i];
+  if (pool == nullptr || faces.size() == 0) {
+    for (FaceIndex fi(0); fi < static_cast<uint32_t>(faces.size()); ++fi) {
+      for (int i = 0; i < 3; ++i) {
+        corner_to_vertex_map_[FirstCorner(fi) + i] = faces[fi][i];
+      }
+    }
+    int num_vertices = -1;
+    if (!ComputeOppositeCorners(&num_vertices)) {
+      return false;
+    }
+    if (!BreakNonManifoldEdges()) {
+      return false;
     }
+    if (!ComputeVertexCorners(num_vertices)) {
+      return false;
+    }
+    return true;
   }
+
+  pool->ParallelFor(static_cast<int>(faces.size()), kMinItemsPerTask,
+                    [&](int begin, int end) {
+                      for (FaceIndex fi(begin); fi < end; ++fi) {
+                        for (int i = 0; i < 3; ++i) {
+                          corner_to_vertex_map_[FirstCorner(fi) + i] =
+                              faces[fi][i];
+                        }
+                      }
+                    });
   int num_vertices = -1;
-  if (!ComputeOppositeCorners(&num_vertices)) {
+  if (!ComputeOppositeCornersParallel(&num_vertices, pool)) {
     return false;
   }
-  if (!BreakNonManifoldEdges()) {
+  if (!BreakNonManifoldEdgesParallel(num_vertices, pool)) {
     return false;
   }
-  if (!ComputeVertexCorners(num_vertices)) {
+  if (!ComputeVertexCornersParallel(num_vertices, pool)) {
     return false;
   }
   return true;
@@ -74,7 +184,12 @@ bool CornerTable::Reset(int num_faces, int num_vertices) {
   }
   corner_to_vertex_map_.assign(num_faces_unsigned * 3, kInvalidVertexIndex);
   opposite_corners_.assign(num_faces_unsigned * 3, kInvalidCornerIndex);
+  vertex_corners_.clear();
   vertex_corners_.reserve(num_vertices);
+  non_manifold_vertex_parents_.clear();
+  num_original_vertices_ = 0;
+  num_degenerated_faces_ = 0;
+  num_isolated_vertices_ = 0;
   valence_cache_.ClearValenceCache();
   valence_cache_.ClearValenceCacheInaccurate();
   return true;
@@ -209,6 +324,139 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
   return true;
 }
 
+bool CornerTable::ComputeOppositeCornersParallel(int *num_vertices,
+                                                 ThreadPool *pool) {
+  DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
+  if (num_vertices == nullptr) {
+    return false;
+  }
+  opposite_corners_.resize(num_corners(), kInvalidCornerIndex);
+
+  // Two half-edges can be connected only if they are defined by the same pair
+  // of vertices. The serial algorithm processes half-edges in the order of
+  // their opposite corners and the outcome for a given vertex pair depends
+  // only on the half-edges of that pair. Therefore we can group half-edges by
+  // the lower index of their two vertices and match each group independently,
+  // while still processing the half-edges in the same order as the serial
+  // algorithm. This guarantees that both algorithms produce identical results.
+
+  // Compute the number of vertices and the number of degenerated faces.
+  std::mutex mutex;
+  int max_vertex = -1;
+  int num_degenerated_faces = 0;
+  pool->ParallelFor(num_faces(), kMinItemsPerTask, [&](int begin, int end) {
+    int local_max_vertex = -1;
+    int local_num_degenerated_faces = 0;
+    for (FaceIndex f(begin); f < end; ++f) {
+      const CornerIndex c = FirstCorner(f);
+      for (int i = 0; i < 3; ++i) {
+        local_max_vertex = std::max(
+            local_max_vertex, static_cast<int>(Vertex(c + i).value()));
+      }
+      if (IsDegenerated(f)) {
+        ++local_num_degenerated_faces;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    max_vertex = std::max(max_vertex, local_max_vertex);
+    num_degenerated_faces += local_num_degenerated_faces;
+  });
+  num_degenerated_faces_ += num_degenerated_faces;
+  const int num_verts = max_vertex + 1;
+
+  // Compute the number of half-edges in each group.
+  std::vector<std::atomic<int>> group_sizes(num_verts);
+  pool->ParallelFor(num_faces(), kMinItemsPerTask, [&](int begin, int end) {
+    for (FaceIndex f(begin); f < end; ++f) {
+      if (IsDegenerated(f)) {
+        continue;
+      }
+      for (const CornerIndex &c : AllCorners(f)) {
+        const VertexIndex source_v = Vertex(Next(c));
+        const VertexIndex sink_v = Vertex(Previous(c));
+        group_sizes[std::min(source_v, sink_v).value()].fetch_add(
+            1, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  // Compute offsets of the groups and reset the sizes so that they can be
+  // used as insertion cursors.
+  const BlockPrefixSums group_sums =
+      ComputeBlockPrefixSums(pool, num_verts, [&](int begin, int end) {
+        int count = 0;
+        for (int v = begin; v < end; ++v) {
+          count += group_sizes[v].load(std::memory_order_relaxed);
+        }
+        return count;
+      });
+  std::vector<int> group_offsets(num_verts + 1);
+  group_offsets[num_verts] = group_sums.offsets.back();
+  ProcessBlocks(pool, group_sums, [&](int begin, int end, int offset) {
+    for (int v = begin; v < end; ++v) {
+      group_offsets[v] = offset;
+      offset += group_sizes[v].load(std::memory_order_relaxed);
+      group_sizes[v].store(0, std::memory_order_relaxed);
+    }
+  });
+
+  // Distribute the half-edges (their opposite corners) into the groups.
+  std::vector<CornerIndex> group_corners(group_offsets[num_verts]);
+  pool->ParallelFor(num_faces(), kMinItemsPerTask, [&](int begin, int end) {
+    for (FaceIndex f(begin); f < end; ++f) {
+      if (IsDegenerated(f)) {
+        continue;
+      }
+      for (const CornerIndex &c : AllCorners(f)) {
+        const VertexIndex source_v = Vertex(Next(c));
+        const VertexIndex sink_v = Vertex(Previous(c));
+        const int group = std::min(source_v, sink_v).value();
+        group_corners[group_offsets[group] +
+                      group_sizes[group].fetch_add(
+                          1, std::memory_order_relaxed)] = c;
+      }
+    }
+  });
+
+  // Match half-edges within each group.
+  pool->ParallelFor(num_verts, kMinItemsPerTask, [&](int begin, int end) {
+    // Unmatched half-edges of the current group in the order of insertion.
+    std::vector<CornerIndex> open_corners;
+    for (int v = begin; v < end; ++v) {
+      const auto group_begin = group_corners.begin() + group_offsets[v];
+      const auto group_end = group_corners.begin() + group_offsets[v + 1];
+      std::sort(group_begin, group_end);
+      open_corners.clear();
+      for (auto it = group_begin; it != group_end; ++it) {
+        const CornerIndex c = *it;
+        const VertexIndex tip_v = Vertex(c);
+        const VertexIndex source_v = Vertex(Next(c));
+        const VertexIndex sink_v = Vertex(Previous(c));
+        // Look for the first unmatched half-edge going in the opposite
+        // direction that does not belong to a mirrored face.
+        auto open_it = open_corners.begin();
+        for (; open_it != open_corners.end(); ++open_it) {
+          const CornerIndex other_c = *open_it;
+          if (Vertex(Next(other_c)) == sink_v &&
+              Vertex(Previous(other_c)) == source_v &&
+              Vertex(other_c) != tip_v) {
+            break;
+          }
+        }
+        if (open_it == open_corners.end()) {
+          open_corners.push_back(c);
+        } else {
+          opposite_corners_[c] = *open_it;
+          opposite_corners_[*open_it] = c;
+          open_corners.erase(open_it);
+        }
+      }
+    }
+  });
+  *num_vertices = num_verts;
+  return true;
+}
+
 bool CornerTable::BreakNonManifoldEdges() {
   // This function detects and breaks non-manifold edges that are caused by
   // folds in 1-ring neighborhood around a vertex. Non-manifold edges can occur
@@ -316,6 +564,149 @@ bool CornerTable::BreakNonManifoldEdges() {
   return true;
 }
 
+bool CornerTable::BreakNonManifoldEdgesParallel(int num_vertices,
+                                                ThreadPool *pool) {
+  // Non-manifold edges are rare and the serial algorithm modifies the corner
+  // table only when it encounters one. Therefore we first check all fans in
+  // parallel and run the serial algorithm only if it would break any edge.
+  std::vector<CornerIndex> fan_starts;
+  ComputeFanStartsParallel(num_vertices, pool, &fan_starts);
+  std::atomic<bool> found_non_manifold_edge(false);
+  pool->ParallelFor(num_corners(), kMinItemsPerTask, [&](int begin, int end) {
+    std::vector<std::pair<VertexIndex, CornerIndex>> sink_vertices;
+    for (int c = begin; c < end; ++c) {
+      if (found_non_manifold_edge.load(std::memory_order_relaxed)) {
+        return;
+      }
+      if (fan_starts[c] != kInvalidCornerIndex &&
+          FanHasNonManifoldEdge(fan_starts[c], &sink_vertices)) {
+        found_non_manifold_edge.store(true, std::memory_order_relaxed);
+        return;
+      }
+    }
+  });
+  if (!found_non_manifold_edge.load()) {
+    return true;
+  }
+  return BreakNonManifoldEdges();
+}
+
+void CornerTable::ComputeFanStartsParallel(
+    int num_vertices, ThreadPool *pool,
+    std::vector<CornerIndex> *fan_starts) const {
+  fan_starts->assign(num_corners(), kInvalidCornerIndex);
+
+  // Swinging around a vertex never leaves the vertex, so the fans of each
+  // vertex can be processed independently. Group the corners by their vertex
+  // so that every fan is traversed only once, starting from its lowest corner.
+  std::vector<std::atomic<int>> vertex_sizes(num_vertices);
+  pool->ParallelFor(num_faces(), kMinItemsPerTask, [&](int begin, int end) {
+    for (FaceIndex f(begin); f < end; ++f) {
+      if (IsDegenerated(f)) {
+        continue;
+      }
+      for (const CornerIndex &c : AllCorners(f)) {
+        vertex_sizes[Vertex(c).value()].fetch_add(1,
+                                                  std::memory_order_relaxed);
+      }
+    }
+  });
+  const BlockPrefixSums vertex_sums =
+      ComputeBlockPrefixSums(pool, num_vertices, [&](int begin, int end) {
+        int count = 0;
+        for (int v = begin; v < end; ++v) {
+          count += vertex_sizes[v].load(std::memory_order_relaxed);
+        }
+        return count;
+      });
+  std::vector<int> vertex_offsets(num_vertices + 1);
+  vertex_offsets[num_vertices] = vertex_sums.offsets.back();
+  ProcessBlocks(pool, vertex_sums, [&](int begin, int end, int offset) {
+    for (int v = begin; v < end; ++v) {
+      vertex_offsets[v] = offset;
+      offset += vertex_sizes[v].load(std::memory_order_relaxed);
+      vertex_sizes[v].store(0, std::memory_order_relaxed);
+    }
+  });
+  std::vector<CornerIndex> sorted_corners(vertex_offsets[num_vertices]);
+  pool->ParallelFor(num_faces(), kMinItemsPerTask, [&](int begin, int end) {
+    for (FaceIndex f(begin); f < end; ++f) {
+      if (IsDegenerated(f)) {
+        continue;
+      }
+      for (const CornerIndex &c : AllCorners(f)) {
+        const int v = Vertex(c).value();
+        sorted_corners[vertex_offsets[v] +
+                       vertex_sizes[v].fetch_add(
+                           1, std::memory_order_relaxed)] = c;
+      }
+    }
+  });
+
+  // Corners of each vertex are visited only by the task processing the vertex.
+  std::vector<uint8_t> visited_corners(num_corners(), 0);
+  pool->ParallelFor(num_vertices, kMinItemsPerTask, [&](int begin, int end) {
+    for (int v = begin; v < end; ++v) {
+      const auto corners_begin = sorted_corners.begin() + vertex_offsets[v];
+      const auto corners_end = sorted_corners.begin() + vertex_offsets[v + 1];
+      std::sort(corners_begin, corners_end);
+      for (auto it = corners_begin; it != corners_end; ++it) {
+        const CornerIndex c = *it;
+        if (visited_corners[c.value()]) {
+          continue;
+        }
+        // |c| is the lowest corner of a new fan. Swing left until we reach an
+        // open boundary or until we return back to |c|.
+        CornerIndex act_c = c;
+        bool is_closed_fan = false;
+        while (true) {
+          visited_corners[act_c.value()] = 1;
+          const CornerIndex next_c = SwingLeft(act_c);
+          if (next_c == kInvalidCornerIndex) {
+            break;
+          }
+          if (next_c == c) {
+            is_closed_fan = true;
+            break;
+          }
+          act_c = next_c;
+        }
+        (*fan_starts)[c.value()] = act_c;
+        if (!is_closed_fan) {
+          // Mark the remaining corners of the open fan.
+          for (CornerIndex next_c = SwingRight(c);
+               next_c != kInvalidCornerIndex; next_c = SwingRight(next_c)) {
+            visited_corners[next_c.value()] = 1;
+          }
+        }
+      }
+    }
+  });
+}
+
+bool CornerTable::FanHasNonManifoldEdge(
+    CornerIndex fan_start,
+    std::vector<std::pair<VertexIndex, CornerIndex>> *sink_vertices) const {
+  // Same check as in BreakNonManifoldEdges() without modifying the table.
+  sink_vertices->clear();
+  CornerIndex current_c = fan_start;
+  do {
+    const CornerIndex sink_c = Next(current_c);
+    const VertexIndex sink_v = corner_to_vertex_map_[sink_c];
+    const CornerIndex edge_corner = Previous(current_c);
+    for (auto &&attached_sink_vertex : *sink_vertices) {
+      if (attached_sink_vertex.first == sink_v &&
+          Opposite(edge_corner) != attached_sink_vertex.second) {
+        return true;
+      }
+    }
+    sink_vertices->push_back(
+        std::make_pair(corner_to_vertex_map_[edge_corner], sink_c));
+    current_c = SwingRight(current_c);
+  } while (current_c != fan_start && current_c != kInvalidCornerIndex);
+  return false;
+}
+
 bool CornerTable::ComputeVertexCorners(int num_vertices) {
   DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
   num_original_vertices_ = num_vertices;
@@ -398,6 +789,107 @@ bool CornerTable::ComputeVertexCorners(int num_vertices) {
   return true;
 }
 
+bool CornerTable::ComputeVertexCornersParallel(int num_vertices,
+                                               ThreadPool *pool) {
+  DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
+  num_original_vertices_ = num_vertices;
+
+  // The serial algorithm processes the fans in the order of their lowest
+  // corners. The first processed fan of each vertex keeps the vertex index
+  // while each subsequent fan gets a new vertex. Here we find the lowest corner
+  // of all fans in parallel and then assign the new vertex indices using a
+  // prefix sum over the fans that need them.
+  std::vector<CornerIndex> fan_starts;
+  ComputeFanStartsParallel(num_vertices, pool, &fan_starts);
+  std::vector<std::atomic<uint32_t>> first_fan_corners(num_vertices);
+  pool->ParallelFor(num_vertices, kMinItemsPerTask, [&](int begin, int end) {
+    for (int v = begin; v < end; ++v) {
+      first_fan_corners[v].store(kInvalidCornerIndex.value(),
+                                 std::memory_order_relaxed);
+    }
+  });
+  pool->ParallelFor(num_corners(), kMinItemsPerTask, [&](int begin, int end) {
+    for (CornerIndex c(begin); c < end; ++c) {
+      if (fan_starts[c.value()] != kInvalidCornerIndex) {
+        AtomicMin(&first_fan_corners[Vertex(c).value()], c.value());
+      }
+    }
+  });
+
+  // Returns true for fans that need to be assigned a new vertex.
+  const auto is_non_manifold_fan = [&](int c) {
+    return fan_starts[c] != kInvalidCornerIndex &&
+           first_fan_corners[Vertex(CornerIndex(c)).value()].load(
+               std::memory_order_relaxed) != static_cast<uint32_t>(c);
+  };
+  const BlockPrefixSums new_vertex_sums =
+      ComputeBlockPrefixSums(pool, num_corners(), [&](int begin, int end) {
+        int count = 0;
+        for (int c = begin; c < end; ++c) {
+          if (is_non_manifold_fan(c)) {
+            ++count;
+          }
+        }
+        return count;
+      });
+  const int num_new_vertices = new_vertex_sums.offsets.back();
+  vertex_corners_.resize(num_vertices + num_new_vertices, kInvalidCornerIndex);
+  non_manifold_vertex_parents_.resize(num_new_vertices);
+
+  // Process all fans. Each fan is processed by the task owning its lowest
+  // corner so all corners of the fan are updated by a single task.
+  ProcessBlocks(pool, new_vertex_sums, [&](int begin, int end, int offset) {
+    for (CornerIndex c(begin); c < end; ++c) {
+      if (fan_starts[c.value()] == kInvalidCornerIndex) {
+        continue;
+      }
+      VertexIndex v = corner_to_vertex_map_[c];
+      const bool is_non_manifold_vertex = is_non_manifold_fan(c.value());
+      if (is_non_manifold_vertex) {
+        // Create a new vertex for the fan.
+        non_manifold_vertex_parents_[VertexIndex(offset)] = v;
+        v = VertexIndex(num_vertices + offset);
+        ++offset;
+      }
+      vertex_corners_[v] = fan_starts[c.value()];
+      if (!is_non_manifold_vertex) {
+        continue;
+      }
+      // Update vertex index in all corners of the fan.
+      CornerIndex act_c(c);
+      while (act_c != kInvalidCornerIndex) {
+        corner_to_vertex_map_[act_c] = v;
+        act_c = SwingLeft(act_c);
+        if (act_c == c) {
+          break;  // Full circle reached.
+        }
+      }
+      if (act_c == kInvalidCornerIndex) {
+        act_c = SwingRight(c);
+        while (act_c != kInvalidCornerIndex) {
+          corner_to_vertex_map_[act_c] = v;
+          act_c = SwingRight(act_c);
+        }
+      }
+    }
+  });
+
+  // Count the number of isolated (unprocessed) vertices.
+  std::atomic<int> num_isolated_vertices(0);
+  pool->ParallelFor(num_vertices, kMinItemsPerTask, [&](int begin, int end) {
+    int count = 0;
+    for (int v = begin; v < end; ++v) {
+      if (first_fan_corners[v].load(std::memory_order_relaxed) ==
+          kInvalidCornerIndex.value()) {
+        ++count;
+      }
+    }
+    num_isolated_vertices.fetch_add(count, std::memory_order_relaxed);
+  });
+  num_isolated_vertices_ = num_isolated_vertices.load();
+  return true;
+}
+
 bool CornerTable::IsDegenerated(FaceIndex face) const {
   if (face == kInvalidFaceIndex) {
     return true;
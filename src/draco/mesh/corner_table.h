@@ -17,6 +17,8 @@
 
 #include <array>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "draco/attributes/geometry_indices.h"
 #include "draco/core/draco_index_type_vector.h"
@@ -26,6 +28,8 @@
 
 namespace draco {
 
+class ThreadPool;
+
 // CornerTable is used to represent connectivity of triangular meshes.
 // For every corner of all faces, the corner table stores the index of the
 // opposite corner in the neighboring face (if it exists) as illustrated in the
@@ -59,15 +63,29 @@ class CornerTable {
   static std::unique_ptr<CornerTable> Create(
       const IndexTypeVector<FaceIndex, FaceType> &faces);
 
+  // Same as above but the construction is parallelized using |pool|. When
+  // |pool| is nullptr, the corner table is constructed serially.
+  static std::unique_ptr<CornerTable> Create(
+      const IndexTypeVector<FaceIndex, FaceType> &faces, ThreadPool *pool);
+
   // Initializes the CornerTable from provides set of indexed faces.
   // The input faces can represent a non-manifold topology, in which case the
   // non-manifold edges and vertices are going to be split.
   bool Init(const IndexTypeVector<FaceIndex, FaceType> &faces);
 
+  // Same as above but the construction is parallelized using |pool|. When
+  // |pool| is nullptr, the corner table is constructed serially. The resulting
+  // corner table is identical to the one produced by the serial construction.
+  bool Init(const IndexTypeVector<FaceIndex, FaceType> &faces,
+            ThreadPool *pool);
+
   // Resets the corner table to the given number of invalid faces.
   bool Reset(int num_faces);
 
-  // Resets the corner table to the given number of invalid faces and vertices.
+  // Resets the corner table to the given number of invalid faces without any
+  // vertices. Memory is reserved for |num_vertices| vertices that can be added
+  // with AddNewVertex(). Existing storage is reused, so a table can be reset
+  // many times without new allocations.
   bool Reset(int num_faces, int num_vertices);
 
   inline int num_vertices() const {
@@ -365,16 +383,43 @@ class CornerTable {
   // |corner_to_vertex_map_|.
   bool ComputeOppositeCorners(int *num_vertices);
 
+  // Parallel version of ComputeOppositeCorners(). Half-edges are bucketed by
+  // their lower vertex index and each bucket is matched independently in the
+  // same order as in the serial version.
+  bool ComputeOppositeCornersParallel(int *num_vertices, ThreadPool *pool);
+
   // Finds and breaks non-manifold edges in the 1-ring neighborhood around
   // vertices (vertices themselves will be split in the ComputeVertexCorners()
   // function if necessary).
   bool BreakNonManifoldEdges();
 
+  // Same as above but all vertex 1-rings are first checked in parallel using
+  // |pool|. The serial version is run only when a non-manifold edge is found.
+  bool BreakNonManifoldEdgesParallel(int num_vertices, ThreadPool *pool);
+
   // Computes the lookup map for going from a vertex to a corner. This method
   // can handle non-manifold vertices by splitting them into multiple manifold
   // vertices.
   bool ComputeVertexCorners(int num_vertices);
 
+  // Parallel version of ComputeVertexCorners(). New vertices created for
+  // non-manifold vertices get the same indices as in the serial version.
+  bool ComputeVertexCornersParallel(int num_vertices, ThreadPool *pool);
+
+  // Finds all 1-ring fans around vertices in parallel. For the lowest corner of
+  // each fan, |fan_starts| is set to the corner where the serial algorithms
+  // start processing the fan (the left-most corner for open fans). All other
+  // corners, including corners of degenerated faces, are set to
+  // kInvalidCornerIndex. Each fan is traversed only once.
+  void ComputeFanStartsParallel(int num_vertices, ThreadPool *pool,
+                                std::vector<CornerIndex> *fan_starts) const;
+
+  // Returns true if the fan starting at |fan_start| contains a non-manifold
+  // edge that would be broken by BreakNonManifoldEdges().
+  bool FanHasNonManifoldEdge(
+      CornerIndex fan_start,
+      std::vector<std::pair<VertexIndex, CornerIndex>> *sink_vertices) const;
+
   // Each three consecutive corners represent one face.
   IndexTypeVector<CornerIndex, VertexIndex> corner_to_vertex_map_;
   IndexTypeVector<CornerIndex, CornerIndex> opposite_corners_;
@@ -0,0 +1,184 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmarks of the common corner table traversal patterns using the
+// CornerTable and the CompactCornerTable memory layouts.
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "draco/compression/mesh/traverser/depth_first_traverser.h"
+#include "draco/core/cycle_timer.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/mesh/compact_corner_table.h"
+#include "draco/mesh/corner_table.h"
+#include "draco/mesh/corner_table_iterators.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+namespace draco {
+
+namespace {
+
+// Number of times each benchmark is repeated.
+constexpr int kNumRepetitions = 20;
+
+// Traversal observer that only accumulates the visited vertices.
+class SumObserver {
+ public:
+  SumObserver() : sum_(nullptr) {}
+  explicit SumObserver(int64_t *sum) : sum_(sum) {}
+  void OnNewFaceVisited(FaceIndex face) { *sum_ += face.value(); }
+  void OnNewVertexVisited(VertexIndex vert, CornerIndex /* corner */) {
+    *sum_ += vert.value();
+  }
+
+ private:
+  int64_t *sum_;
+};
+
+// Visits the 1-ring of every vertex.
+template <class CornerTableT>
+int64_t VisitVertexRings(const CornerTableT &table) {
+  int64_t sum = 0;
+  for (VertexIndex v(0); v < table.num_vertices(); ++v) {
+    if (table.IsVertexIsolated(v)) {
+      continue;
+    }
+    for (VertexRingIterator<CornerTableT> it(&table, v); !it.End();
+         it.Next()) {
+      sum += it.Vertex().value();
+    }
+  }
+  return sum;
+}
+
+// Traverses all faces using the depth first traverser used by the encoders.
+template <class CornerTableT>
+int64_t TraverseDepthFirst(const CornerTableT &table) {
+  int64_t sum = 0;
+  DepthFirstTraverser<CornerTableT, SumObserver> traverser;
+  traverser.Init(&table, SumObserver(&sum));
+  traverser.OnTraversalStart();
+  for (FaceIndex f(0); f < table.num_faces(); ++f) {
+    traverser.TraverseFromCorner(table.FirstCorner(f));
+  }
+  traverser.OnTraversalEnd();
+  return sum;
+}
+
+// Emulates the memory access pattern of the parallelogram prediction where
+// each corner is predicted from the vertices of the opposite face.
+template <class CornerTableT>
+int64_t PredictParallelogram(const CornerTableT &table,
+                             const std::vector<int32_t> &values) {
+  int64_t sum = 0;
+  for (CornerIndex c(0); c < table.num_corners(); ++c) {
+    const CornerIndex oci = table.Opposite(c);
+    if (oci == kInvalidCornerIndex) {
+      continue;
+    }
+    const int next_value = values[table.Vertex(table.Next(oci)).value()];
+    const int prev_value = values[table.Vertex(table.Previous(oci)).value()];
+    const int opp_value = values[table.Vertex(oci).value()];
+    sum += next_value + prev_value - opp_value;
+  }
+  return sum;
+}
+
+template <class CornerTableT>
+void RunBenchmarks(const std::string &table_name, const CornerTableT &table) {
+  std::vector<int32_t> values(table.num_vertices());
+  for (int i = 0; i < table.num_vertices(); ++i) {
+    values[i] = i;
+  }
+  int64_t checksum = 0;
+  CycleTimer timer;
+  timer.Start();
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    checksum += VisitVertexRings(table);
+  }
+  timer.Stop();
+  printf("  %-20s vertex rings:         %6" PRId64 " ms\n", table_name.c_str(),
+         timer.GetInMs());
+  timer.Start();
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    checksum += TraverseDepthFirst(table);
+  }
+  timer.Stop();
+  printf("  %-20s depth first traversal: %5" PRId64 " ms\n",
+         table_name.c_str(), timer.GetInMs());
+  timer.Start();
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    checksum += PredictParallelogram(table, values);
+  }
+  timer.Stop();
+  printf("  %-20s parallelogram access:  %5" PRId64 " ms\n",
+         table_name.c_str(), timer.GetInMs());
+  // Prevents the compiler from optimizing the benchmarks away.
+  printf("  %-20s checksum: %" PRId64 "\n", table_name.c_str(), checksum);
+}
+
+void BenchmarkTable(const std::string &name, const CornerTable &table) {
+  printf("%s (%d faces, %d vertices)\n", name.c_str(), table.num_faces(),
+         table.num_vertices());
+  const std::unique_ptr<CompactCornerTable> compact_table =
+      CompactCornerTable::Create(table);
+  ASSERT_NE(compact_table, nullptr);
+  RunBenchmarks("CornerTable", table);
+  RunBenchmarks("CompactCornerTable", *compact_table);
+}
+
+}  // namespace
+
+TEST(CornerTableBenchmark, TestModel) {
+  const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("bun_zipper.ply");
+  ASSERT_NE(mesh, nullptr);
+  const std::unique_ptr<CornerTable> table =
+      CreateCornerTableFromPositionAttribute(mesh.get());
+  ASSERT_NE(table, nullptr);
+  BenchmarkTable("bun_zipper.ply", *table);
+}
+
+TEST(CornerTableBenchmark, ShuffledGrid) {
+  // Regular grid with randomly ordered faces and vertices, which represents
+  // the worst case for the memory locality of the traversals.
+  const int grid_size = 1000;
+  std::vector<int> vertex_map(grid_size * grid_size);
+  for (int i = 0; i < static_cast<int>(vertex_map.size()); ++i) {
+    vertex_map[i] = i;
+  }
+  std::mt19937 generator(1);
+  std::shuffle(vertex_map.begin(), vertex_map.end(), generator);
+  IndexTypeVector<FaceIndex, CornerTable::FaceType> faces;
+  for (int y = 0; y < grid_size - 1; ++y) {
+    for (int x = 0; x < grid_size - 1; ++x) {
+      const VertexIndex v00(vertex_map[y * grid_size + x]);
+      const VertexIndex v10(vertex_map[y * grid_size + x + 1]);
+      const VertexIndex v01(vertex_map[(y + 1) * grid_size + x]);
+      const VertexIndex v11(vertex_map[(y + 1) * grid_size + x + 1]);
+      faces.push_back({{v00, v10, v11}});
+      faces.push_back({{v00, v11, v01}});
+    }
+  }
+  std::shuffle(faces.begin(), faces.end(), generator);
+  const std::unique_ptr<CornerTable> table = CornerTable::Create(faces);
+  ASSERT_NE(table, nullptr);
+  BenchmarkTable("shuffled grid", *table);
+}
+
+}  // namespace draco
@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "draco/core/draco_test_utils.h"
+#include "draco/core/thread_pool.h"
 #include "draco/io/obj_decoder.h"
 #include "draco/mesh/mesh_connected_components.h"
 #include "draco/mesh/mesh_misc_functions.h"
@@ -123,4 +124,47 @@ TEST_F(CornerTableTest, TestNewFace) {
   ASSERT_EQ(ct->Vertex(CornerIndex(3 * 12) + 2), new_vi);
 }
 
+TEST_F(CornerTableTest, TestParallelInit) {
+  // Tests that the parallel construction produces the same corner table as the
+  // serial construction, including meshes with non-manifold elements and
+  // degenerate faces.
+  ThreadPool pool(4);
+  for (const std::string file_name :
+       {"cube_att.obj", "non_manifold_wrap.obj", "deg_faces.obj",
+        "multiple_tetrahedrons.obj", "extra_vertex.obj", "bun_zipper.ply"}) {
+    std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    const PointAttribute *const pos_att =
+        mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+    IndexTypeVector<FaceIndex, CornerTable::FaceType> faces(mesh->num_faces());
+    for (FaceIndex fi(0); fi < mesh->num_faces(); ++fi) {
+      for (int c = 0; c < 3; ++c) {
+        faces[fi][c] =
+            VertexIndex(pos_att->mapped_index(mesh->face(fi)[c]).value());
+      }
+    }
+    std::unique_ptr<CornerTable> serial_ct =
+        CornerTable::Create(faces, nullptr);
+    std::unique_ptr<CornerTable> parallel_ct =
+        CornerTable::Create(faces, &pool);
+    ASSERT_NE(serial_ct, nullptr);
+    ASSERT_NE(parallel_ct, nullptr);
+    ASSERT_EQ(serial_ct->num_vertices(), parallel_ct->num_vertices());
+    ASSERT_EQ(serial_ct->num_corners(), parallel_ct->num_corners());
+    ASSERT_EQ(serial_ct->NumNewVertices(), parallel_ct->NumNewVertices());
+    ASSERT_EQ(serial_ct->NumDegeneratedFaces(),
+              parallel_ct->NumDegeneratedFaces());
+    ASSERT_EQ(serial_ct->NumIsolatedVertices(),
+              parallel_ct->NumIsolatedVertices());
+    for (CornerIndex ci(0); ci < serial_ct->num_corners(); ++ci) {
+      ASSERT_EQ(serial_ct->Vertex(ci), parallel_ct->Vertex(ci));
+      ASSERT_EQ(serial_ct->Opposite(ci), parallel_ct->Opposite(ci));
+    }
+    for (VertexIndex vi(0); vi < serial_ct->num_vertices(); ++vi) {
+      ASSERT_EQ(serial_ct->LeftMostCorner(vi), parallel_ct->LeftMostCorner(vi));
+      ASSERT_EQ(serial_ct->VertexParent(vi), parallel_ct->VertexParent(vi));
+    }
+  }
+}
+
 }  // namespace draco
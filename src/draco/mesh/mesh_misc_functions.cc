@@ -18,11 +18,22 @@ namespace draco {
 
 std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
     const Mesh *mesh) {
-  return CreateCornerTableFromAttribute(mesh, GeometryAttribute::POSITION);
+  return CreateCornerTableFromPositionAttribute(mesh, nullptr);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
+    const Mesh *mesh, ThreadPool *pool) {
+  return CreateCornerTableFromAttribute(mesh, GeometryAttribute::POSITION,
+                                        pool);
 }
 
 std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(
     const Mesh *mesh, GeometryAttribute::Type type) {
+  return CreateCornerTableFromAttribute(mesh, type, nullptr);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(
+    const Mesh *mesh, GeometryAttribute::Type type, ThreadPool *pool) {
   typedef CornerTable::FaceType FaceType;
 
   const PointAttribute *const att = mesh->GetNamedAttribute(type);
@@ -40,11 +51,16 @@ std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(
     faces[FaceIndex(i)] = new_face;
   }
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return CornerTable::Create(faces, pool);
 }
 
 std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     const Mesh *mesh) {
+  return CreateCornerTableFromAllAttributes(mesh, nullptr);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
+    const Mesh *mesh, ThreadPool *pool) {
   typedef CornerTable::FaceType FaceType;
   IndexTypeVector<FaceIndex, FaceType> faces(mesh->num_faces());
   FaceType new_face;
@@ -58,6 +74,6 @@ std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     faces[i] = new_face;
   }
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return CornerTable::Create(faces, pool);
 }
 }  // namespace draco
@@ -33,16 +33,30 @@ namespace draco {
 std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
     const Mesh *mesh);
 
+// Same as above but the corner table is constructed in parallel using |pool|
+// (see CornerTable::Init()). When |pool| is nullptr, the corner table is
+// constructed serially.
+std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
+    const Mesh *mesh, ThreadPool *pool);
+
 // Creates a CornerTable from the first named attribute of |mesh| with a given
 // type. Returns nullptr on error.
 std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(
     const Mesh *mesh, GeometryAttribute::Type type);
 
+// Same as above but the corner table is constructed in parallel using |pool|.
+std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(
+    const Mesh *mesh, GeometryAttribute::Type type, ThreadPool *pool);
+
 // Creates a CornerTable from all attributes of |mesh|. Boundaries are
 // automatically introduced on all attribute seams. Returns nullptr on error.
 std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     const Mesh *mesh);
 
+// Same as above but the corner table is constructed in parallel using |pool|.
+std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
+    const Mesh *mesh, ThreadPool *pool);
+
 // Returns true when the given corner lies opposite to an attribute seam.
 inline bool IsCornerOppositeToAttributeSeam(CornerIndex ci,
                                             const PointAttribute &att,
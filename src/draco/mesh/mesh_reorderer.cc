@@ -0,0 +1,250 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/mesh_reorderer.h"
+
+#include <memory>
+#include <vector>
+
+namespace draco {
+
+Status MeshReorderer::Reorder(Mesh *mesh, const MeshReordererOptions &options) {
+  if (options.cache_size <= 0) {
+    return Status(Status::DRACO_ERROR, "Invalid vertex cache size.");
+  }
+  for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      if (mesh->face(f)[c] >= mesh->num_points()) {
+        return Status(Status::DRACO_ERROR, "Invalid point index.");
+      }
+    }
+  }
+  if (options.reorder_faces) {
+    ReorderFaces(mesh, options.cache_size);
+  }
+  if (options.reorder_points) {
+    ReorderPoints(mesh);
+  }
+  return OkStatus();
+}
+
+MeshVertexCacheStats MeshReorderer::ComputeVertexCacheStats(const Mesh &mesh,
+                                                            int cache_size) {
+  MeshVertexCacheStats stats;
+  if (mesh.num_faces() == 0 || cache_size <= 0) {
+    return stats;
+  }
+  // For each point we store the value of the miss counter at the time the
+  // point was inserted into the cache. A point is still in the FIFO cache if
+  // fewer than |cache_size| other points were inserted since then.
+  std::vector<int64_t> insertion_time(mesh.num_points(), -1);
+  int64_t num_misses = 0;
+  int64_t num_referenced_points = 0;
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    const Mesh::Face &face = mesh.face(f);
+    for (int c = 0; c < 3; ++c) {
+      int64_t &time = insertion_time[face[c].value()];
+      if (time < 0) {
+        ++num_referenced_points;
+      } else if (num_misses - time < cache_size) {
+        continue;  // Cache hit.
+      }
+      time = num_misses++;
+    }
+  }
+  stats.acmr = static_cast<float>(num_misses) / mesh.num_faces();
+  stats.atvr = static_cast<float>(num_misses) / num_referenced_points;
+  return stats;
+}
+
+void MeshReorderer::ReorderFaces(Mesh *mesh, int cache_size) {
+  const int num_points = mesh->num_points();
+  const int num_faces = mesh->num_faces();
+  if (num_faces == 0) {
+    return;
+  }
+
+  // Number of not yet emitted faces attached to each point.
+  std::vector<int> live_counts(num_points, 0);
+  for (FaceIndex f(0); f < num_faces; ++f) {
+    for (int c = 0; c < 3; ++c) {
+      ++live_counts[mesh->face(f)[c].value()];
+    }
+  }
+
+  // Faces attached to each point stored in a compressed sparse row format.
+  std::vector<int> adjacency_offsets(num_points + 1, 0);
+  for (int p = 0; p < num_points; ++p) {
+    adjacency_offsets[p + 1] = adjacency_offsets[p] + live_counts[p];
+  }
+  std::vector<FaceIndex> adjacent_faces(3 * num_faces);
+  {
+    std::vector<int> next_offsets(adjacency_offsets.begin(),
+                                  adjacency_offsets.end() - 1);
+    for (FaceIndex f(0); f < num_faces; ++f) {
+      for (int c = 0; c < 3; ++c) {
+        adjacent_faces[next_offsets[mesh->face(f)[c].value()]++] = f;
+      }
+    }
+  }
+
+  IndexTypeVector<FaceIndex, Mesh::Face> new_faces;
+  new_faces.reserve(num_faces);
+  std::vector<bool> is_face_emitted(num_faces, false);
+  std::vector<int> cache_times(num_points, 0);
+  std::vector<int> dead_end_stack;
+  std::vector<int> candidates;
+  int time_stamp = cache_size + 1;
+  int cursor = 0;
+
+  // Start with the first point referenced by any face.
+  int fanning_point = mesh->face(FaceIndex(0))[0].value();
+  while (fanning_point >= 0) {
+    // Emit all remaining faces around the fanning point.
+    candidates.clear();
+    for (int i = adjacency_offsets[fanning_point];
+         i < adjacency_offsets[fanning_point + 1]; ++i) {
+      const FaceIndex f = adjacent_faces[i];
+      if (is_face_emitted[f.value()]) {
+        continue;
+      }
+      is_face_emitted[f.value()] = true;
+      const Mesh::Face &face = mesh->face(f);
+      new_faces.push_back(face);
+      for (int c = 0; c < 3; ++c) {
+        const int p = face[c].value();
+        dead_end_stack.push_back(p);
+        candidates.push_back(p);
+        --live_counts[p];
+        if (time_stamp - cache_times[p] > cache_size) {
+          // The point was not in the cache.
+          cache_times[p] = time_stamp++;
+        }
+      }
+    }
+
+    // Select the next fanning point among the points of the emitted faces.
+    // Points that will still be in the cache after all their remaining faces
+    // are emitted are preferred, older points first.
+    int best_priority = -1;
+    fanning_point = -1;
+    for (const int p : candidates) {
+      if (live_counts[p] <= 0) {
+        continue;
+      }
+      int priority = 0;
+      if (time_stamp - cache_times[p] + 2 * live_counts[p] <= cache_size) {
+        priority = time_stamp - cache_times[p];
+      }
+      if (priority > best_priority) {
+        best_priority = priority;
+        fanning_point = p;
+      }
+    }
+    if (fanning_point >= 0) {
+      continue;
+    }
+
+    // Dead end. Try the most recently used points with remaining faces first
+    // and then continue with the next point in the original order.
+    while (!dead_end_stack.empty()) {
+      const int p = dead_end_stack.back();
+      dead_end_stack.pop_back();
+      if (live_counts[p] > 0) {
+        fanning_point = p;
+        break;
+      }
+    }
+    while (fanning_point < 0 && cursor < num_points) {
+      if (live_counts[cursor] > 0) {
+        fanning_point = cursor;
+      }
+      ++cursor;
+    }
+  }
+
+  for (FaceIndex f(0); f < num_faces; ++f) {
+    mesh->SetFace(f, new_faces[f]);
+  }
+}
+
+void MeshReorderer::ReorderPoints(Mesh *mesh) {
+  const int num_points = mesh->num_points();
+  IndexTypeVector<PointIndex, PointIndex> old_to_new_points(num_points,
+                                                            kInvalidPointIndex);
+  IndexTypeVector<PointIndex, PointIndex> new_to_old_points;
+  new_to_old_points.reserve(num_points);
+  for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+    const Mesh::Face &face = mesh->face(f);
+    for (int c = 0; c < 3; ++c) {
+      if (old_to_new_points[face[c]] == kInvalidPointIndex) {
+        old_to_new_points[face[c]] = PointIndex(new_to_old_points.size());
+        new_to_old_points.push_back(face[c]);
+      }
+    }
+  }
+  // Points that are not referenced by any face are kept at the end.
+  for (PointIndex p(0); p < num_points; ++p) {
+    if (old_to_new_points[p] == kInvalidPointIndex) {
+      old_to_new_points[p] = PointIndex(new_to_old_points.size());
+      new_to_old_points.push_back(p);
+    }
+  }
+  bool is_identity = true;
+  for (PointIndex p(0); p < num_points; ++p) {
+    if (new_to_old_points[p] != p) {
+      is_identity = false;
+      break;
+    }
+  }
+  if (is_identity) {
+    return;  // Points are already in the optimal order.
+  }
+
+  for (int a = 0; a < mesh->num_attributes(); ++a) {
+    PointAttribute *const att = mesh->attribute(a);
+    if (att->is_mapping_identity() &&
+        att->size() >= static_cast<size_t>(num_points)) {
+      // Reorder the attribute values to keep the identity mapping.
+      PointAttribute old_att;
+      old_att.CopyFrom(*att);
+      for (PointIndex p(0); p < num_points; ++p) {
+        const AttributeValueIndex old_avi(new_to_old_points[p].value());
+        att->SetAttributeValue(AttributeValueIndex(p.value()),
+                               old_att.GetAddress(old_avi));
+      }
+    } else {
+      IndexTypeVector<PointIndex, AttributeValueIndex> old_map(num_points);
+      for (PointIndex p(0); p < num_points; ++p) {
+        old_map[p] = att->mapped_index(p);
+      }
+      if (att->is_mapping_identity()) {
+        att->SetExplicitMapping(num_points);
+      }
+      for (PointIndex p(0); p < num_points; ++p) {
+        att->SetPointMapEntry(p, old_map[new_to_old_points[p]]);
+      }
+    }
+  }
+
+  for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+    Mesh::Face face = mesh->face(f);
+    for (int c = 0; c < 3; ++c) {
+      face[c] = old_to_new_points[face[c]];
+    }
+    mesh->SetFace(f, face);
+  }
+}
+
+}  // namespace draco
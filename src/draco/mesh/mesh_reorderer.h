@@ -0,0 +1,75 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_MESH_MESH_REORDERER_H_
+#define DRACO_MESH_MESH_REORDERER_H_
+
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Options used by the MeshReorderer class.
+struct MeshReordererOptions {
+  // If true, faces are reordered to maximize the reuse of vertices in the
+  // post-transform vertex cache of the GPU.
+  bool reorder_faces = true;
+
+  // If true, point ids are renumbered in the order in which they are first
+  // referenced by the faces. This improves the locality of vertex fetches and
+  // of the connectivity data used by the encoder.
+  bool reorder_points = true;
+
+  // Size of the simulated FIFO post-transform vertex cache.
+  int cache_size = 16;
+};
+
+// Statistics of the post-transform vertex cache usage of a mesh.
+struct MeshVertexCacheStats {
+  // Average cache miss ratio. Number of transformed vertices per face. The
+  // value is between 0.5 (theoretical optimum for large meshes) and 3.0.
+  float acmr = 0.f;
+
+  // Average transform to vertex ratio. Number of transformed vertices per
+  // point referenced by the faces. The optimal value is 1.0.
+  float atvr = 0.f;
+};
+
+// Tool that reorders faces and points of a draco::Mesh for better memory
+// locality. The faces are ordered using the Tipsify algorithm described in
+// "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" by
+// P. V. Sander, D. Nehab and J. Barczak (SIGGRAPH 2007), which runs in linear
+// time. The points are then renumbered in the order of their first use.
+//
+// The tool can be used to preprocess meshes before encoding or to optimize
+// decoded meshes for rendering (see Decoder::SetOptimizeVertexCache()).
+class MeshReorderer {
+ public:
+  // Performs in-place reordering of the input mesh according to the input
+  // options. The geometry of the mesh is not changed.
+  static Status Reorder(Mesh *mesh, const MeshReordererOptions &options);
+
+  // Simulates a FIFO vertex cache of size |cache_size| and returns the cache
+  // statistics for the current face order of the |mesh|.
+  static MeshVertexCacheStats ComputeVertexCacheStats(const Mesh &mesh,
+                                                      int cache_size);
+
+ private:
+  static void ReorderFaces(Mesh *mesh, int cache_size);
+  static void ReorderPoints(Mesh *mesh);
+};
+
+}  // namespace draco
+
+#endif  // DRACO_MESH_MESH_REORDERER_H_
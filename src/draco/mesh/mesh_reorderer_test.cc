@@ -0,0 +1,142 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/mesh_reorderer.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace draco {
+
+class MeshReordererTest : public ::testing::Test {
+ protected:
+  // Returns the attribute values of all faces of the |mesh| as a sorted list.
+  // Each entry contains the values of all attributes on all corners of a face.
+  static std::vector<std::vector<uint8_t>> GetSortedFaceValues(
+      const Mesh &mesh) {
+    std::vector<std::vector<uint8_t>> face_values(mesh.num_faces());
+    for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+      for (int c = 0; c < 3; ++c) {
+        for (int a = 0; a < mesh.num_attributes(); ++a) {
+          const PointAttribute *const att = mesh.attribute(a);
+          std::vector<uint8_t> value(att->byte_stride());
+          att->GetMappedValue(mesh.face(f)[c], value.data());
+          face_values[f.value()].insert(face_values[f.value()].end(),
+                                        value.begin(), value.end());
+        }
+      }
+    }
+    std::sort(face_values.begin(), face_values.end());
+    return face_values;
+  }
+
+  // Randomly shuffles the faces of the |mesh|.
+  static void ShuffleFaces(Mesh *mesh) {
+    std::vector<Mesh::Face> faces;
+    for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+      faces.push_back(mesh->face(f));
+    }
+    std::mt19937 generator(1);
+    std::shuffle(faces.begin(), faces.end(), generator);
+    for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+      mesh->SetFace(f, faces[f.value()]);
+    }
+  }
+};
+
+TEST_F(MeshReordererTest, TestGeometryIsPreserved) {
+  // Tests that reordering does not change the geometry of meshes with both
+  // identity and explicit attribute mappings.
+  for (const std::string file_name : {"bun_zipper.ply", "cube_att.obj"}) {
+    std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    ShuffleFaces(mesh.get());
+    const std::vector<std::vector<uint8_t>> face_values =
+        GetSortedFaceValues(*mesh);
+    const int num_points = mesh->num_points();
+    DRACO_ASSERT_OK(MeshReorderer::Reorder(mesh.get(), MeshReordererOptions()));
+    ASSERT_EQ(mesh->num_points(), num_points);
+    ASSERT_EQ(GetSortedFaceValues(*mesh), face_values);
+  }
+}
+
+TEST_F(MeshReordererTest, TestPointsInFirstUseOrder) {
+  // Tests that points are renumbered in the order of their first use.
+  std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("bun_zipper.ply");
+  ASSERT_NE(mesh, nullptr);
+  ShuffleFaces(mesh.get());
+  DRACO_ASSERT_OK(MeshReorderer::Reorder(mesh.get(), MeshReordererOptions()));
+  PointIndex::ValueType num_used_points = 0;
+  for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      const PointIndex p = mesh->face(f)[c];
+      ASSERT_LE(p.value(), num_used_points);
+      if (p.value() == num_used_points) {
+        ++num_used_points;
+      }
+    }
+  }
+}
+
+TEST_F(MeshReordererTest, TestCacheStatsImproved) {
+  // Tests that the reordering reduces the number of vertex cache misses of a
+  // mesh with randomly ordered faces.
+  std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("bun_zipper.ply");
+  ASSERT_NE(mesh, nullptr);
+  ShuffleFaces(mesh.get());
+  const MeshReordererOptions options;
+  const MeshVertexCacheStats stats_before =
+      MeshReorderer::ComputeVertexCacheStats(*mesh, options.cache_size);
+  DRACO_ASSERT_OK(MeshReorderer::Reorder(mesh.get(), options));
+  const MeshVertexCacheStats stats_after =
+      MeshReorderer::ComputeVertexCacheStats(*mesh, options.cache_size);
+  ASSERT_GT(stats_before.acmr, 2.5f);
+  ASSERT_LT(stats_after.acmr, 0.8f);
+  ASSERT_LT(stats_after.atvr, 1.5f);
+  ASSERT_GE(stats_after.atvr, 1.f);
+}
+
+TEST_F(MeshReordererTest, TestDecoderOption) {
+  // Tests that the decoder can reorder the decoded mesh.
+  std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("bun_zipper.ply");
+  ASSERT_NE(mesh, nullptr);
+  Encoder encoder;
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+
+  DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(buffer.data(), buffer.size());
+  Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<Mesh> decoded_mesh,
+                         decoder.DecodeMeshFromBuffer(&decoder_buffer));
+
+  decoder_buffer.Init(buffer.data(), buffer.size());
+  decoder.SetOptimizeVertexCache(true);
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<Mesh> reordered_mesh,
+                         decoder.DecodeMeshFromBuffer(&decoder_buffer));
+  ASSERT_EQ(GetSortedFaceValues(*decoded_mesh),
+            GetSortedFaceValues(*reordered_mesh));
+  const int cache_size = MeshReordererOptions().cache_size;
+  ASSERT_LT(
+      MeshReorderer::ComputeVertexCacheStats(*reordered_mesh, cache_size).acmr,
+      MeshReorderer::ComputeVertexCacheStats(*decoded_mesh, cache_size).acmr);
+}
+
+}  // namespace draco
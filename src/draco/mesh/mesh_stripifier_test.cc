@@ -0,0 +1,103 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/mesh_stripifier.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "draco/core/draco_test_utils.h"
+
+namespace draco {
+
+class MeshStripifierTest : public ::testing::Test {
+ protected:
+  typedef std::array<uint32_t, 3> Triangle;
+
+  // Returns |triangle| with sorted point indices.
+  static Triangle SortedTriangle(Triangle triangle) {
+    std::sort(triangle.begin(), triangle.end());
+    return triangle;
+  }
+
+  // Returns the number of occurrences of all non-degenerate faces of |mesh|.
+  static std::map<Triangle, int> GetMeshTriangles(const Mesh &mesh) {
+    std::map<Triangle, int> triangles;
+    for (FaceIndex fi(0); fi < mesh.num_faces(); ++fi) {
+      const Mesh::Face &face = mesh.face(fi);
+      const Triangle triangle = SortedTriangle(
+          {{face[0].value(), face[1].value(), face[2].value()}});
+      if (triangle[0] != triangle[1] && triangle[1] != triangle[2]) {
+        triangles[triangle]++;
+      }
+    }
+    return triangles;
+  }
+
+  // Returns the number of occurrences of all non-degenerate triangles of the
+  // strips in |indices|. Strips are separated by |restart_index|.
+  static std::map<Triangle, int> GetStripTriangles(
+      const std::vector<uint32_t> &indices, uint32_t restart_index) {
+    std::map<Triangle, int> triangles;
+    size_t strip_start = 0;
+    for (size_t i = 0; i <= indices.size(); ++i) {
+      if (i < indices.size() && indices[i] != restart_index) {
+        continue;
+      }
+      for (size_t j = strip_start; j + 2 < i; ++j) {
+        const Triangle triangle =
+            SortedTriangle({{indices[j], indices[j + 1], indices[j + 2]}});
+        if (triangle[0] != triangle[1] && triangle[1] != triangle[2]) {
+          triangles[triangle]++;
+        }
+      }
+      strip_start = i + 1;
+    }
+    return triangles;
+  }
+
+  void TestStrips(const std::string &file_name) {
+    const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    const std::map<Triangle, int> expected_triangles = GetMeshTriangles(*mesh);
+
+    const uint32_t restart_index = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> indices;
+    MeshStripifier stripifier;
+    ASSERT_TRUE(stripifier.GenerateTriangleStripsWithPrimitiveRestart(
+        *mesh, restart_index, std::back_inserter(indices)));
+    ASSERT_GT(stripifier.num_strips(), 0);
+    ASSERT_EQ(GetStripTriangles(indices, restart_index), expected_triangles);
+
+    indices.clear();
+    ASSERT_TRUE(stripifier.GenerateTriangleStripsWithDegenerateTriangles(
+        *mesh, std::back_inserter(indices)));
+    ASSERT_GT(stripifier.num_strips(), 0);
+    ASSERT_EQ(GetStripTriangles(indices, restart_index), expected_triangles);
+  }
+};
+
+TEST_F(MeshStripifierTest, TestCube) { TestStrips("cube_att.obj"); }
+
+TEST_F(MeshStripifierTest, TestNonManifold) { TestStrips("test_nm.obj"); }
+
+TEST_F(MeshStripifierTest, TestBunny) { TestStrips("bunny_norm.obj"); }
+
+}  // namespace draco
@@ -14,12 +14,16 @@
 //
 #include "draco/mesh/mesh_utils.h"
 
+#include <algorithm>
+#include <cmath>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #ifdef DRACO_TRANSCODER_SUPPORTED
 #include "draco/attributes/attribute_quantization_transform.h"
+#include "draco/compression/attributes/normal_compression_utils.h"
+#include "draco/core/constants.h"
 #include "draco/core/quantization_utils.h"
 
 namespace draco {
@@ -28,15 +32,8 @@ void MeshUtils::TransformMesh(const Eigen::Matrix4d &transform, Mesh *mesh) {
   // Transform positions.
   PointAttribute *pos_att =
       mesh->attribute(mesh->GetNamedAttributeId(GeometryAttribute::POSITION));
-  for (AttributeValueIndex avi(0); avi < pos_att->size(); ++avi) {
-    Vector3f pos_val;
-    pos_att->GetValue(avi, &pos_val[0]);
-    Eigen::Vector4d transformed_val(pos_val[0], pos_val[1], pos_val[2], 1);
-    transformed_val = transform * transformed_val;
-    pos_val =
-        Vector3f(transformed_val[0], transformed_val[1], transformed_val[2]);
-    pos_att->SetAttributeValue(avi, &pos_val[0]);
-  }
+  TransformPositions(transform, AttributeValueIndex(0),
+                     AttributeValueIndex(pos_att->size()), pos_att);
 
   // Transform normals and tangents.
   PointAttribute *normal_att = nullptr;
@@ -57,14 +54,80 @@ void MeshUtils::TransformMesh(const Eigen::Matrix4d &transform, Mesh *mesh) {
     it_transform = it_transform.inverse().transpose();
 
     if (normal_att) {
-      TransformNormalizedAttribute(it_transform, normal_att);
+      TransformNormals(it_transform, AttributeValueIndex(0),
+                       AttributeValueIndex(normal_att->size()), normal_att);
     }
     if (tangent_att) {
-      TransformNormalizedAttribute(it_transform, tangent_att);
+      TransformNormals(it_transform, AttributeValueIndex(0),
+                       AttributeValueIndex(tangent_att->size()), tangent_att);
     }
   }
 }
 
+// The transformations below operate directly on the attribute buffers. The
+// loops have no calls and no branches that depend on the data, which allows the
+// compiler to vectorize them.
+void MeshUtils::TransformPositions(const Eigen::Matrix4d &transform,
+                                   AttributeValueIndex begin,
+                                   AttributeValueIndex end,
+                                   PointAttribute *att) {
+  if (att->data_type() != DT_FLOAT32 || att->num_components() != 3 ||
+      begin >= end) {
+    return;
+  }
+  const double m00 = transform(0, 0), m01 = transform(0, 1),
+               m02 = transform(0, 2), m03 = transform(0, 3);
+  const double m10 = transform(1, 0), m11 = transform(1, 1),
+               m12 = transform(1, 2), m13 = transform(1, 3);
+  const double m20 = transform(2, 0), m21 = transform(2, 1),
+               m22 = transform(2, 2), m23 = transform(2, 3);
+  const int64_t stride = att->byte_stride() / sizeof(float);
+  const int64_t num_values = end.value() - begin.value();
+  float *const data = reinterpret_cast<float *>(att->GetAddress(begin));
+  for (int64_t i = 0; i < num_values; ++i) {
+    float *const value = data + i * stride;
+    const double x = value[0];
+    const double y = value[1];
+    const double z = value[2];
+    value[0] = static_cast<float>(m00 * x + m01 * y + m02 * z + m03);
+    value[1] = static_cast<float>(m10 * x + m11 * y + m12 * z + m13);
+    value[2] = static_cast<float>(m20 * x + m21 * y + m22 * z + m23);
+  }
+}
+
+void MeshUtils::TransformNormals(const Eigen::Matrix3d &transform,
+                                 AttributeValueIndex begin,
+                                 AttributeValueIndex end, PointAttribute *att) {
+  if (att->data_type() != DT_FLOAT32 || att->num_components() < 3 ||
+      att->num_components() > 4 || begin >= end) {
+    return;
+  }
+  const double m00 = transform(0, 0), m01 = transform(0, 1),
+               m02 = transform(0, 2);
+  const double m10 = transform(1, 0), m11 = transform(1, 1),
+               m12 = transform(1, 2);
+  const double m20 = transform(2, 0), m21 = transform(2, 1),
+               m22 = transform(2, 2);
+  const int64_t stride = att->byte_stride() / sizeof(float);
+  const int64_t num_values = end.value() - begin.value();
+  float *const data = reinterpret_cast<float *>(att->GetAddress(begin));
+  for (int64_t i = 0; i < num_values; ++i) {
+    float *const value = data + i * stride;
+    const double x = value[0];
+    const double y = value[1];
+    const double z = value[2];
+    const double tx = m00 * x + m01 * y + m02 * z;
+    const double ty = m10 * x + m11 * y + m12 * z;
+    const double tz = m20 * x + m21 * y + m22 * z;
+    // Zero vectors are left unchanged.
+    const double length = std::sqrt(tx * tx + ty * ty + tz * tz);
+    const double scale = length > 0.0 ? 1.0 / length : 1.0;
+    value[0] = static_cast<float>(tx * scale);
+    value[1] = static_cast<float>(ty * scale);
+    value[2] = static_cast<float>(tz * scale);
+  }
+}
+
 namespace {
 
 // Merges entries from |src_metadata| to |dst_metadata|. Any metadata entries
@@ -414,24 +477,86 @@ StatusOr<int> MeshUtils::FindLowestTextureQuantization(
   return lowest_quantization_bits;
 }
 
-void MeshUtils::TransformNormalizedAttribute(const Eigen::Matrix3d &transform,
-                                             PointAttribute *att) {
-  for (AttributeValueIndex avi(0); avi < att->size(); ++avi) {
-    // Store up to 4 component values.
-    Vector4f val(0, 0, 0, 1);
-    att->GetValue(avi, &val);
-    // Ignore the last component during transformation.
-    Eigen::Vector3d transformed_val(val[0], val[1], val[2]);
-    transformed_val = transform * transformed_val;
-    transformed_val = transformed_val.normalized();
-    // Last component is passed to the transformed value.
-    val = Vector4f(transformed_val[0], transformed_val[1], transformed_val[2],
-                   val[3]);
-
-    // Set the value to the attribute. Note that in case the attribute is using
-    // fewer than 4 components, the 4th component is going to be ignored.
-    att->SetAttributeValue(avi, &val[0]);
+StatusOr<int> MeshUtils::FindLowestQuantizationForMaxError(
+    const PointAttribute &att, float max_error) {
+  if (!(max_error > 0.f)) {
+    return Status(Status::DRACO_ERROR, "Maximum error must be positive.");
   }
+  // The quantization range does not depend on the number of bits.
+  AttributeQuantizationTransform transform;
+  if (!transform.ComputeParameters(att, 1)) {
+    return Status(Status::DRACO_ERROR,
+                  "Failed computing quantization parameters.");
+  }
+  // Values are rounded to the nearest of the 2^bits evenly spaced quantized
+  // values so the maximum error is half of the quantization step.
+  const double max_step = 2.0 * max_error;
+  for (int bits = 1; bits <= 30; ++bits) {
+    const uint32_t max_quantized_value = (1u << bits) - 1;
+    if (transform.range() / max_quantized_value <= max_step) {
+      return bits;
+    }
+  }
+  return Status(Status::DRACO_ERROR,
+                "Maximum error cannot be satisfied with 30 quantization bits.");
+}
+
+StatusOr<int> MeshUtils::FindLowestNormalQuantizationForMaxAngle(
+    const PointAttribute &norm_att, float max_angle) {
+  if (!(max_angle > 0.f)) {
+    return Status(Status::DRACO_ERROR, "Maximum angle must be positive.");
+  }
+  if (norm_att.data_type() != DT_FLOAT32 || norm_att.num_components() != 3) {
+    return Status(Status::DRACO_ERROR,
+                  "Normal attribute must have 3 float components.");
+  }
+  const double min_cos = std::cos(std::min<double>(max_angle, DRACO_PI));
+
+  // Returns true when all normals can be quantized to |bits| within the bound.
+  const auto is_within_bound = [&](int bits) {
+    OctahedronToolBox octahedron_tool_box;
+    octahedron_tool_box.SetQuantizationBits(bits);
+    for (AttributeValueIndex avi(0); avi < norm_att.size(); ++avi) {
+      Vector3f normal;
+      norm_att.GetValue(avi, &normal[0]);
+      const float length = std::sqrt(normal.SquaredNorm());
+      if (length == 0.f) {
+        continue;  // Degenerate normals have no direction to preserve.
+      }
+      int32_t s, t;
+      octahedron_tool_box.FloatVectorToQuantizedOctahedralCoords(&normal[0], &s,
+                                                                 &t);
+      Vector3f quantized_normal;
+      octahedron_tool_box.QuantizedOctahedralCoordsToUnitVector(
+          s, t, &quantized_normal[0]);
+      if (normal.Dot(quantized_normal) / length < min_cos) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Binary search over the valid range of octahedral quantization bits.
+  int lowest_quantization_bits = 0;
+  int min_quantization_bits = 2;
+  int max_quantization_bits = 30;
+  while (min_quantization_bits <= max_quantization_bits) {
+    const int curr_quantization_bits =
+        min_quantization_bits +
+        (max_quantization_bits - min_quantization_bits) / 2;
+    if (is_within_bound(curr_quantization_bits)) {
+      lowest_quantization_bits = curr_quantization_bits;
+      max_quantization_bits = curr_quantization_bits - 1;
+    } else {
+      min_quantization_bits = curr_quantization_bits + 1;
+    }
+  }
+  if (lowest_quantization_bits == 0) {
+    return Status(Status::DRACO_ERROR,
+                  "Maximum angle cannot be satisfied with 30 quantization "
+                  "bits.");
+  }
+  return lowest_quantization_bits;
 }
 
 template <typename att_components_t>
@@ -33,6 +33,25 @@ class MeshUtils {
   // in-place.
   static void TransformMesh(const Eigen::Matrix4d &transform, Mesh *mesh);
 
+  // Transforms position values in range [|begin|, |end|) of |att| using the
+  // |transform| matrix. The values must be stored as three 32-bit floats.
+  // Attributes of other formats are silently left unmodified, so callers must
+  // validate the attribute format beforehand.
+  static void TransformPositions(const Eigen::Matrix4d &transform,
+                                 AttributeValueIndex begin,
+                                 AttributeValueIndex end, PointAttribute *att);
+
+  // Transforms normal or tangent values in range [|begin|, |end|) of |att|
+  // using the |transform| matrix and normalizes them. The fourth component of
+  // tangents is not modified. The values must be stored as three or four
+  // 32-bit floats. Attributes of other formats are silently left unmodified,
+  // so callers must validate the attribute format beforehand. Normals
+  // should be transformed by the inverse-transpose of the upper 3x3 block of
+  // the transformation matrix used for positions.
+  static void TransformNormals(const Eigen::Matrix3d &transform,
+                               AttributeValueIndex begin,
+                               AttributeValueIndex end, PointAttribute *att);
+
   // Merges metadata from |src_mesh| to |dst_mesh|. Any metadata with the same
   // names are left unchanged.
   static void MergeMetadata(const Mesh &src_mesh, Mesh *dst_mesh);
@@ -67,14 +86,26 @@ class MeshUtils {
       int pos_quantization_bits, const PointAttribute &tex_att,
       int tex_target_quantization_bits);
 
+  // Returns the lowest number of quantization bits for |att| for which the
+  // quantization error of any attribute component does not exceed |max_error|.
+  // The values are assumed to be quantized within their bounding box like in
+  // AttributeQuantizationTransform. Returns an error if |max_error| cannot be
+  // satisfied with at most 30 bits.
+  static StatusOr<int> FindLowestQuantizationForMaxError(
+      const PointAttribute &att, float max_error);
+
+  // Returns the lowest number of octahedral quantization bits for the normal
+  // attribute |norm_att| for which the angle between any original and
+  // quantized normal does not exceed |max_angle| (in radians). Returns an
+  // error if |max_angle| cannot be satisfied with at most 30 bits.
+  static StatusOr<int> FindLowestNormalQuantizationForMaxAngle(
+      const PointAttribute &norm_att, float max_angle);
+
   // Helper function that checks whether a mesh has auto-generated tangents.
   // See go/tangents_and_draco_simplifier.
   static bool HasAutoGeneratedTangents(const Mesh &mesh);
 
  private:
-  static void TransformNormalizedAttribute(const Eigen::Matrix3d &transform,
-                                           PointAttribute *att);
-
   template <typename att_components_t>
   static int CountDegenerateFaces(const Mesh &mesh, const PointAttribute &att);
 
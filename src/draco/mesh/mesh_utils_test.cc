@@ -15,6 +15,10 @@
 #include "draco/mesh/mesh_utils.h"
 
 #ifdef DRACO_TRANSCODER_SUPPORTED
+#include <algorithm>
+#include <cmath>
+
+#include "draco/compression/attributes/normal_compression_utils.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
 
@@ -253,6 +257,80 @@ TEST(MeshUtilsTest, FindLowsetTextureQuantizationLanternScene) {
   }
 }
 
+TEST(MeshUtilsTest, FindLowestQuantizationForMaxError) {
+  // The positions of the cube span the range [0, 1] in each axis.
+  std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  const draco::PointAttribute *const pos_att =
+      mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+  ASSERT_NE(pos_att, nullptr);
+
+  // The maximum error is half of the quantization step 1 / (2^bits - 1).
+  DRACO_ASSIGN_OR_ASSERT(
+      int bits, draco::MeshUtils::FindLowestQuantizationForMaxError(*pos_att,
+                                                                     0.5f));
+  ASSERT_EQ(bits, 1);
+  DRACO_ASSIGN_OR_ASSERT(
+      bits, draco::MeshUtils::FindLowestQuantizationForMaxError(*pos_att,
+                                                                0.01f));
+  ASSERT_EQ(bits, 6);
+
+  // Test failures.
+  ASSERT_FALSE(
+      draco::MeshUtils::FindLowestQuantizationForMaxError(*pos_att, 0.f).ok());
+  ASSERT_FALSE(
+      draco::MeshUtils::FindLowestQuantizationForMaxError(*pos_att, 1e-12f)
+          .ok());
+}
+
+TEST(MeshUtilsTest, FindLowestNormalQuantizationForMaxAngle) {
+  std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("sphere.gltf");
+  ASSERT_NE(mesh, nullptr);
+  const draco::PointAttribute *const norm_att =
+      mesh->GetNamedAttribute(draco::GeometryAttribute::NORMAL);
+  ASSERT_NE(norm_att, nullptr);
+
+  // Returns the maximum angle between the original and the quantized normals.
+  const auto compute_max_angle = [&](int bits) {
+    draco::OctahedronToolBox octahedron_tool_box;
+    octahedron_tool_box.SetQuantizationBits(bits);
+    float max_angle = 0.f;
+    for (draco::AttributeValueIndex avi(0); avi < norm_att->size(); ++avi) {
+      draco::Vector3f normal, quantized_normal;
+      norm_att->GetValue(avi, &normal[0]);
+      normal.Normalize();
+      int32_t s, t;
+      octahedron_tool_box.FloatVectorToQuantizedOctahedralCoords(&normal[0],
+                                                                 &s, &t);
+      octahedron_tool_box.QuantizedOctahedralCoordsToUnitVector(
+          s, t, &quantized_normal[0]);
+      const float dot =
+          std::min(1.f, std::max(-1.f, normal.Dot(quantized_normal)));
+      max_angle = std::max(max_angle, std::acos(dot));
+    }
+    return max_angle;
+  };
+
+  int prev_bits = 0;
+  for (const float max_angle : {0.1f, 0.01f, 0.001f}) {
+    DRACO_ASSIGN_OR_ASSERT(
+        const int bits,
+        draco::MeshUtils::FindLowestNormalQuantizationForMaxAngle(*norm_att,
+                                                                  max_angle));
+    // The found quantization satisfies the bound but one bit less does not.
+    ASSERT_LE(compute_max_angle(bits), max_angle + 1e-6f);
+    ASSERT_GT(compute_max_angle(bits - 1), max_angle);
+    // Smaller angles require more bits.
+    ASSERT_GT(bits, prev_bits);
+    prev_bits = bits;
+  }
+  ASSERT_FALSE(
+      draco::MeshUtils::FindLowestNormalQuantizationForMaxAngle(*norm_att, 0.f)
+          .ok());
+}
+
 TEST(MeshUtilsTest, CheckAutoGeneratedTangents) {
   // Test verifies that MeshUtils::HasAutoGeneratedTangents works as intended.
   std::unique_ptr<draco::Mesh> mesh =
@@ -0,0 +1,1009 @@
+// Copyright 2026 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Python extension module "draco" exposing the Draco decoder and encoder.
+//
+// Decoded attribute values and faces are exported through the Python buffer
+// protocol directly from the memory of the decoded geometry, so that they can
+// be wrapped by numpy.asarray() or memoryview() without copying. The exported
+// views keep the decoded geometry alive. The encoder reads its inputs through
+// the buffer protocol as well and the decoding and encoding itself runs with
+// the GIL released.
+//
+// Example:
+//
+//   import draco, numpy as np
+//   mesh = draco.Decoder().decode(data)
+//   positions = np.asarray(mesh.get_named_attribute(draco.POSITION))
+//   faces = np.asarray(mesh.faces)
+//   data = draco.Encoder().encode([(draco.POSITION, positions)], faces)
+//
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/expert_encode.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/mesh/mesh.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace {
+
+// Returns the buffer protocol format character of |data_type| or nullptr when
+// the data type cannot be exported.
+const char *DataTypeFormat(draco::DataType data_type) {
+  switch (data_type) {
+    case draco::DT_INT8:
+      return "b";
+    case draco::DT_UINT8:
+      return "B";
+    case draco::DT_INT16:
+      return "h";
+    case draco::DT_UINT16:
+      return "H";
+    case draco::DT_INT32:
+      return "i";
+    case draco::DT_UINT32:
+      return "I";
+    case draco::DT_INT64:
+      return "q";
+    case draco::DT_UINT64:
+      return "Q";
+    case draco::DT_FLOAT32:
+      return "f";
+    case draco::DT_FLOAT64:
+      return "d";
+    case draco::DT_BOOL:
+      return "?";
+    case draco::DT_FLOAT16:
+      return "e";
+    default:
+      return nullptr;
+  }
+}
+
+// Returns the Draco data type of buffer items described by |format| and
+// |item_size| or DT_INVALID for unsupported formats.
+draco::DataType FormatDataType(const char *format, Py_ssize_t item_size) {
+  if (format == nullptr) {
+    // No format means unsigned bytes.
+    return draco::DT_UINT8;
+  }
+  // Skip the native and little-endian byte order prefixes.
+  if (*format == '@' || *format == '=' || *format == '<') {
+    ++format;
+  }
+  if (format[0] == '\0' || format[1] != '\0') {
+    return draco::DT_INVALID;
+  }
+  const char type = format[0];
+  if (type == 'f' && item_size == 4) {
+    return draco::DT_FLOAT32;
+  }
+  if (type == 'd' && item_size == 8) {
+    return draco::DT_FLOAT64;
+  }
+  if (type == 'e' && item_size == 2) {
+    return draco::DT_FLOAT16;
+  }
+  const bool is_signed = std::strchr("bhilq", type) != nullptr;
+  const bool is_unsigned = std::strchr("BHILQ", type) != nullptr;
+  if (!is_signed && !is_unsigned) {
+    return draco::DT_INVALID;
+  }
+  switch (item_size) {
+    case 1:
+      return is_signed ? draco::DT_INT8 : draco::DT_UINT8;
+    case 2:
+      return is_signed ? draco::DT_INT16 : draco::DT_UINT16;
+    case 4:
+      return is_signed ? draco::DT_INT32 : draco::DT_UINT32;
+    case 8:
+      return is_signed ? draco::DT_INT64 : draco::DT_UINT64;
+    default:
+      return draco::DT_INVALID;
+  }
+}
+
+// Sets a Python RuntimeError from a failed Draco |status|.
+void SetErrorFromStatus(const draco::Status &status) {
+  PyErr_SetString(PyExc_RuntimeError, status.error_msg());
+}
+
+// Releases a Py_buffer when it goes out of scope.
+class ScopedBuffer {
+ public:
+  ScopedBuffer() : view_(), valid_(false) {}
+  ~ScopedBuffer() { Release(); }
+
+  // Requests a buffer with |flags| from |obj|. Returns false and sets
+  // a Python error on failure.
+  bool Get(PyObject *obj, int flags) {
+    Release();
+    valid_ = PyObject_GetBuffer(obj, &view_, flags) == 0;
+    return valid_;
+  }
+  void Release() {
+    if (valid_) {
+      PyBuffer_Release(&view_);
+      valid_ = false;
+    }
+  }
+  const Py_buffer &view() const { return view_; }
+
+ private:
+  Py_buffer view_;
+  bool valid_;
+};
+
+// Python object owning a decoded (or encoded) point cloud or mesh.
+struct GeometryObject {
+  PyObject_HEAD
+  draco::PointCloud *geometry;
+  // Same as |geometry| when the geometry is a mesh, nullptr otherwise.
+  draco::Mesh *mesh;
+};
+
+// Python object exporting the values of one attribute of a GeometryObject as
+// a (num_values, num_components) array.
+struct AttributeObject {
+  PyObject_HEAD
+  // Keeps the geometry owning |attribute| alive.
+  GeometryObject *owner;
+  const draco::PointAttribute *attribute;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+};
+
+// Python object exporting the faces of a GeometryObject as a (num_faces, 3)
+// array of uint32 point indices.
+struct FacesObject {
+  PyObject_HEAD
+  GeometryObject *owner;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+};
+
+struct DecoderObject {
+  PyObject_HEAD
+  draco::Decoder *decoder;
+};
+
+struct EncoderObject {
+  PyObject_HEAD
+  draco::Encoder *encoder;
+};
+
+// Heap types created from the type specs in PyInit_draco().
+PyTypeObject *GeometryType = nullptr;
+PyTypeObject *AttributeType = nullptr;
+PyTypeObject *FacesType = nullptr;
+PyTypeObject *DecoderType = nullptr;
+PyTypeObject *EncoderType = nullptr;
+
+// Releases |obj| of a heap type created with PyObject_New() or tp_alloc().
+// Instances of heap types hold a reference to their type.
+void FreeObject(PyObject *obj) {
+  PyTypeObject *const type = Py_TYPE(obj);
+  type->tp_free(obj);
+  Py_DECREF(type);
+}
+
+// Fills |view| with a strided two dimensional view of |data|. Sets a Python
+// error and returns -1 when the consumer cannot handle the layout.
+int FillArrayView(PyObject *obj, void *data, Py_ssize_t item_size,
+                  const char *format, Py_ssize_t *shape, Py_ssize_t *strides,
+                  Py_buffer *view, int flags) {
+  const bool is_contiguous =
+      shape[0] <= 1 || strides[0] == shape[1] * item_size;
+  if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES && !is_contiguous) {
+    PyErr_SetString(PyExc_BufferError, "Attribute values are interleaved.");
+    view->obj = nullptr;
+    return -1;
+  }
+  // Empty arrays still need a valid non-null pointer.
+  static char empty_data = 0;
+  view->buf = data != nullptr ? data : &empty_data;
+  view->obj = obj;
+  Py_INCREF(obj);
+  view->len = shape[0] * shape[1] * item_size;
+  view->readonly = 0;
+  view->itemsize = item_size;
+  view->format =
+      (flags & PyBUF_FORMAT) ? const_cast<char *>(format) : nullptr;
+  view->ndim = 2;
+  view->shape = (flags & PyBUF_ND) == PyBUF_ND ? shape : nullptr;
+  view->strides =
+      (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? strides : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  return 0;
+}
+
+// draco.Attribute
+
+PyObject *NewAttributeObject(GeometryObject *owner,
+                             const draco::PointAttribute *attribute) {
+  AttributeObject *const self = PyObject_New(AttributeObject, AttributeType);
+  if (self == nullptr) {
+    return nullptr;
+  }
+  Py_INCREF(owner);
+  self->owner = owner;
+  self->attribute = attribute;
+  self->shape[0] = attribute->size();
+  self->shape[1] = attribute->num_components();
+  self->strides[0] = attribute->byte_stride();
+  self->strides[1] = draco::DataTypeLength(attribute->data_type());
+  return reinterpret_cast<PyObject *>(self);
+}
+
+void AttributeDealloc(PyObject *obj) {
+  AttributeObject *const self = reinterpret_cast<AttributeObject *>(obj);
+  Py_XDECREF(self->owner);
+  FreeObject(obj);
+}
+
+int AttributeGetBuffer(PyObject *obj, Py_buffer *view, int flags) {
+  AttributeObject *const self = reinterpret_cast<AttributeObject *>(obj);
+  const draco::PointAttribute *const att = self->attribute;
+  const char *const format = DataTypeFormat(att->data_type());
+  if (format == nullptr) {
+    PyErr_SetString(PyExc_BufferError, "Unsupported attribute data type.");
+    view->obj = nullptr;
+    return -1;
+  }
+  void *data = nullptr;
+  if (att->size() > 0) {
+    data = const_cast<uint8_t *>(
+        att->GetAddress(draco::AttributeValueIndex(0)));
+  }
+  return FillArrayView(obj, data, self->strides[1], format, self->shape,
+                       self->strides, view, flags);
+}
+
+PyObject *AttributeGetType(PyObject *obj, void *) {
+  return PyLong_FromLong(
+      reinterpret_cast<AttributeObject *>(obj)->attribute->attribute_type());
+}
+
+PyObject *AttributeGetNumComponents(PyObject *obj, void *) {
+  return PyLong_FromLong(
+      reinterpret_cast<AttributeObject *>(obj)->attribute->num_components());
+}
+
+PyObject *AttributeGetNormalized(PyObject *obj, void *) {
+  return PyBool_FromLong(
+      reinterpret_cast<AttributeObject *>(obj)->attribute->normalized());
+}
+
+PyObject *AttributeGetUniqueId(PyObject *obj, void *) {
+  return PyLong_FromUnsignedLong(
+      reinterpret_cast<AttributeObject *>(obj)->attribute->unique_id());
+}
+
+PyObject *AttributeGetFormat(PyObject *obj, void *) {
+  const char *const format = DataTypeFormat(
+      reinterpret_cast<AttributeObject *>(obj)->attribute->data_type());
+  if (format == nullptr) {
+    Py_RETURN_NONE;
+  }
+  return PyUnicode_FromString(format);
+}
+
+PyObject *AttributeGetIsMappingIdentity(PyObject *obj, void *) {
+  return PyBool_FromLong(reinterpret_cast<AttributeObject *>(obj)
+                             ->attribute->is_mapping_identity());
+}
+
+// Returns a copy of the point to attribute value mapping as a uint32
+// memoryview, or None when the mapping is the identity.
+PyObject *AttributePointToValueMap(PyObject *obj, PyObject *) {
+  const AttributeObject *const self = reinterpret_cast<AttributeObject *>(obj);
+  const draco::PointAttribute *const att = self->attribute;
+  if (att->is_mapping_identity()) {
+    Py_RETURN_NONE;
+  }
+  const uint32_t num_points = self->owner->geometry->num_points();
+  PyObject *const bytes =
+      PyBytes_FromStringAndSize(nullptr, num_points * sizeof(uint32_t));
+  if (bytes == nullptr) {
+    return nullptr;
+  }
+  uint32_t *const out = reinterpret_cast<uint32_t *>(PyBytes_AS_STRING(bytes));
+  for (draco::PointIndex i(0); i < num_points; ++i) {
+    out[i.value()] = att->mapped_index(i).value();
+  }
+  PyObject *const bytes_view = PyMemoryView_FromObject(bytes);
+  Py_DECREF(bytes);
+  if (bytes_view == nullptr) {
+    return nullptr;
+  }
+  PyObject *const view = PyObject_CallMethod(bytes_view, "cast", "s", "I");
+  Py_DECREF(bytes_view);
+  return view;
+}
+
+PyGetSetDef attribute_getset[] = {
+    {"type", AttributeGetType, nullptr, "Attribute type, e.g. POSITION.",
+     nullptr},
+    {"num_components", AttributeGetNumComponents, nullptr,
+     "Number of components per attribute value.", nullptr},
+    {"normalized", AttributeGetNormalized, nullptr,
+     "Whether integer values represent normalized [0, 1] or [-1, 1] values.",
+     nullptr},
+    {"unique_id", AttributeGetUniqueId, nullptr, "Unique id of the attribute.",
+     nullptr},
+    {"format", AttributeGetFormat, nullptr,
+     "Buffer protocol format character of the attribute values.", nullptr},
+    {"is_mapping_identity", AttributeGetIsMappingIdentity, nullptr,
+     "Whether the attribute value index is equal to the point index.",
+     nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+PyMethodDef attribute_methods[] = {
+    {"point_to_value_map", AttributePointToValueMap, METH_NOARGS,
+     "Returns the uint32 attribute value index of each point as a "
+     "memoryview, or None when the mapping is the identity."},
+    {nullptr, nullptr, 0, nullptr}};
+
+// draco.Faces
+
+void FacesDealloc(PyObject *obj) {
+  Py_XDECREF(reinterpret_cast<FacesObject *>(obj)->owner);
+  FreeObject(obj);
+}
+
+int FacesGetBuffer(PyObject *obj, Py_buffer *view, int flags) {
+  FacesObject *const self = reinterpret_cast<FacesObject *>(obj);
+  const draco::Mesh *const mesh = self->owner->mesh;
+  void *const data =
+      (mesh == nullptr || mesh->num_faces() == 0)
+          ? nullptr
+          : const_cast<draco::Mesh::Face *>(&mesh->face(draco::FaceIndex(0)));
+  return FillArrayView(obj, data, sizeof(uint32_t), "I", self->shape,
+                       self->strides, view, flags);
+}
+
+// draco.Mesh
+
+PyObject *NewGeometryObject(std::unique_ptr<draco::PointCloud> geometry,
+                            draco::Mesh *mesh) {
+  GeometryObject *const self = PyObject_New(GeometryObject, GeometryType);
+  if (self == nullptr) {
+    return nullptr;
+  }
+  self->geometry = geometry.release();
+  self->mesh = mesh;
+  return reinterpret_cast<PyObject *>(self);
+}
+
+void GeometryDealloc(PyObject *obj) {
+  delete reinterpret_cast<GeometryObject *>(obj)->geometry;
+  FreeObject(obj);
+}
+
+PyObject *GeometryGetNumPoints(PyObject *obj, void *) {
+  return PyLong_FromUnsignedLong(
+      reinterpret_cast<GeometryObject *>(obj)->geometry->num_points());
+}
+
+PyObject *GeometryGetNumFaces(PyObject *obj, void *) {
+  const draco::Mesh *const mesh = reinterpret_cast<GeometryObject *>(obj)->mesh;
+  return PyLong_FromUnsignedLong(mesh == nullptr ? 0 : mesh->num_faces());
+}
+
+PyObject *GeometryGetFaces(PyObject *obj, void *) {
+  GeometryObject *const owner = reinterpret_cast<GeometryObject *>(obj);
+  FacesObject *const self = PyObject_New(FacesObject, FacesType);
+  if (self == nullptr) {
+    return nullptr;
+  }
+  Py_INCREF(owner);
+  self->owner = owner;
+  self->shape[0] = owner->mesh == nullptr ? 0 : owner->mesh->num_faces();
+  self->shape[1] = 3;
+  self->strides[0] = sizeof(draco::Mesh::Face);
+  self->strides[1] = sizeof(uint32_t);
+  return reinterpret_cast<PyObject *>(self);
+}
+
+PyObject *GeometryGetAttributes(PyObject *obj, void *) {
+  GeometryObject *const self = reinterpret_cast<GeometryObject *>(obj);
+  const int num_attributes = self->geometry->num_attributes();
+  PyObject *const list = PyList_New(num_attributes);
+  if (list == nullptr) {
+    return nullptr;
+  }
+  for (int i = 0; i < num_attributes; ++i) {
+    PyObject *const att =
+        NewAttributeObject(self, self->geometry->attribute(i));
+    if (att == nullptr) {
+      Py_DECREF(list);
+      return nullptr;
+    }
+    PyList_SET_ITEM(list, i, att);
+  }
+  return list;
+}
+
+PyObject *GeometryGetNamedAttribute(PyObject *obj, PyObject *args) {
+  GeometryObject *const self = reinterpret_cast<GeometryObject *>(obj);
+  int type;
+  int index = 0;
+  if (!PyArg_ParseTuple(args, "i|i", &type, &index)) {
+    return nullptr;
+  }
+  if (type < 0 || type >= draco::GeometryAttribute::NAMED_ATTRIBUTES_COUNT ||
+      index < 0 ||
+      index >= self->geometry->NumNamedAttributes(
+                   static_cast<draco::GeometryAttribute::Type>(type))) {
+    Py_RETURN_NONE;
+  }
+  return NewAttributeObject(
+      self, self->geometry->GetNamedAttribute(
+                static_cast<draco::GeometryAttribute::Type>(type), index));
+}
+
+PyGetSetDef geometry_getset[] = {
+    {"num_points", GeometryGetNumPoints, nullptr, "Number of points.",
+     nullptr},
+    {"num_faces", GeometryGetNumFaces, nullptr,
+     "Number of faces, 0 for point clouds.", nullptr},
+    {"faces", GeometryGetFaces, nullptr,
+     "Zero-copy (num_faces, 3) uint32 buffer of point indices.", nullptr},
+    {"attributes", GeometryGetAttributes, nullptr,
+     "List of zero-copy attribute buffers.", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+PyMethodDef geometry_methods[] = {
+    {"get_named_attribute", GeometryGetNamedAttribute, METH_VARARGS,
+     "get_named_attribute(type, index=0): Returns the index-th attribute of "
+     "the given type or None."},
+    {nullptr, nullptr, 0, nullptr}};
+
+// draco.Decoder
+
+PyObject *DecoderNew(PyTypeObject *type, PyObject *, PyObject *) {
+  DecoderObject *const self =
+      reinterpret_cast<DecoderObject *>(type->tp_alloc(type, 0));
+  if (self != nullptr) {
+    self->decoder = new draco::Decoder();
+  }
+  return reinterpret_cast<PyObject *>(self);
+}
+
+void DecoderDealloc(PyObject *obj) {
+  delete reinterpret_cast<DecoderObject *>(obj)->decoder;
+  FreeObject(obj);
+}
+
+PyObject *DecoderDecode(PyObject *obj, PyObject *arg) {
+  DecoderObject *const self = reinterpret_cast<DecoderObject *>(obj);
+  ScopedBuffer data;
+  if (!data.Get(arg, PyBUF_SIMPLE)) {
+    return nullptr;
+  }
+  // The decoding runs on a copy of the decoder so that the same Python
+  // decoder can be used from multiple threads at once.
+  draco::Decoder decoder = *self->decoder;
+  draco::DecoderBuffer buffer;
+  buffer.Init(static_cast<const char *>(data.view().buf), data.view().len);
+  draco::Status status;
+  std::unique_ptr<draco::PointCloud> geometry;
+  Py_BEGIN_ALLOW_THREADS;
+  auto statusor = decoder.DecodePointCloudFromBuffer(&buffer);
+  status = statusor.status();
+  if (status.ok()) {
+    geometry = std::move(statusor).value();
+  }
+  Py_END_ALLOW_THREADS;
+  if (!status.ok()) {
+    SetErrorFromStatus(status);
+    return nullptr;
+  }
+  draco::Mesh *const mesh = dynamic_cast<draco::Mesh *>(geometry.get());
+  return NewGeometryObject(std::move(geometry), mesh);
+}
+
+PyObject *DecoderSetSkipAttributeTransform(PyObject *obj, PyObject *args) {
+  int type;
+  if (!PyArg_ParseTuple(args, "i", &type)) {
+    return nullptr;
+  }
+  reinterpret_cast<DecoderObject *>(obj)->decoder->SetSkipAttributeTransform(
+      static_cast<draco::GeometryAttribute::Type>(type));
+  Py_RETURN_NONE;
+}
+
+PyObject *DecoderSetNumThreads(PyObject *obj, PyObject *args) {
+  int num_threads;
+  if (!PyArg_ParseTuple(args, "i", &num_threads)) {
+    return nullptr;
+  }
+  reinterpret_cast<DecoderObject *>(obj)
+      ->decoder->SetNumAttributeDecodingThreads(num_threads);
+  Py_RETURN_NONE;
+}
+
+PyMethodDef decoder_methods[] = {
+    {"decode", DecoderDecode, METH_O,
+     "decode(data): Decodes a mesh or a point cloud from a bytes-like "
+     "object. Returns a draco.Mesh."},
+    {"set_skip_attribute_transform", DecoderSetSkipAttributeTransform,
+     METH_VARARGS,
+     "set_skip_attribute_transform(type): Keeps quantized values of the "
+     "given attribute type."},
+    {"set_num_threads", DecoderSetNumThreads, METH_VARARGS,
+     "set_num_threads(n): Number of threads reverting attribute transforms."},
+    {nullptr, nullptr, 0, nullptr}};
+
+// draco.Encoder
+
+PyObject *EncoderNew(PyTypeObject *type, PyObject *, PyObject *) {
+  EncoderObject *const self =
+      reinterpret_cast<EncoderObject *>(type->tp_alloc(type, 0));
+  if (self != nullptr) {
+    self->encoder = new draco::Encoder();
+  }
+  return reinterpret_cast<PyObject *>(self);
+}
+
+void EncoderDealloc(PyObject *obj) {
+  delete reinterpret_cast<EncoderObject *>(obj)->encoder;
+  FreeObject(obj);
+}
+
+PyObject *EncoderSetSpeed(PyObject *obj, PyObject *args) {
+  int encoding_speed;
+  int decoding_speed;
+  if (!PyArg_ParseTuple(args, "ii", &encoding_speed, &decoding_speed)) {
+    return nullptr;
+  }
+  reinterpret_cast<EncoderObject *>(obj)->encoder->SetSpeedOptions(
+      encoding_speed, decoding_speed);
+  Py_RETURN_NONE;
+}
+
+PyObject *EncoderSetAttributeQuantization(PyObject *obj, PyObject *args) {
+  int type;
+  int quantization_bits;
+  if (!PyArg_ParseTuple(args, "ii", &type, &quantization_bits)) {
+    return nullptr;
+  }
+  reinterpret_cast<EncoderObject *>(obj)->encoder->SetAttributeQuantization(
+      static_cast<draco::GeometryAttribute::Type>(type), quantization_bits);
+  Py_RETURN_NONE;
+}
+
+PyObject *EncoderSetEncodingMethod(PyObject *obj, PyObject *args) {
+  int method;
+  if (!PyArg_ParseTuple(args, "i", &method)) {
+    return nullptr;
+  }
+  reinterpret_cast<EncoderObject *>(obj)->encoder->SetEncodingMethod(method);
+  Py_RETURN_NONE;
+}
+
+PyObject *EncoderSetNumThreads(PyObject *obj, PyObject *args) {
+  int num_threads;
+  if (!PyArg_ParseTuple(args, "i", &num_threads)) {
+    return nullptr;
+  }
+  reinterpret_cast<EncoderObject *>(obj)
+      ->encoder->SetNumAttributeEncodingThreads(num_threads);
+  Py_RETURN_NONE;
+}
+
+// Sets the point to attribute value mapping of |att| from the integer
+// |view|. Returns false with a Python error set for invalid input.
+template <typename IndexT>
+bool CopyPointMap(const Py_buffer &view, draco::PointAttribute *att) {
+  const IndexT *const indices = static_cast<const IndexT *>(view.buf);
+  const Py_ssize_t num_points = view.shape[0];
+  const uint64_t num_values = att->size();
+  att->SetExplicitMapping(num_points);
+  for (Py_ssize_t i = 0; i < num_points; ++i) {
+    // Negative indices wrap to large unsigned values.
+    const uint64_t index =
+        static_cast<uint64_t>(static_cast<int64_t>(indices[i]));
+    if (index >= num_values) {
+      PyErr_SetString(PyExc_ValueError,
+                      "Point to value map index out of range.");
+      return false;
+    }
+    att->SetPointMapEntry(
+        draco::PointIndex(static_cast<uint32_t>(i)),
+        draco::AttributeValueIndex(static_cast<uint32_t>(index)));
+  }
+  return true;
+}
+
+bool SetPointMapFromArray(PyObject *array, draco::PointAttribute *att) {
+  ScopedBuffer map;
+  if (!map.Get(array, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)) {
+    return false;
+  }
+  const Py_buffer &view = map.view();
+  if (view.ndim != 1) {
+    PyErr_SetString(PyExc_ValueError,
+                    "Point to value maps must have one dimension.");
+    return false;
+  }
+  switch (FormatDataType(view.format, view.itemsize)) {
+    case draco::DT_INT32:
+      return CopyPointMap<int32_t>(view, att);
+    case draco::DT_UINT32:
+      return CopyPointMap<uint32_t>(view, att);
+    case draco::DT_INT64:
+      return CopyPointMap<int64_t>(view, att);
+    case draco::DT_UINT64:
+      return CopyPointMap<uint64_t>(view, att);
+    case draco::DT_INT16:
+      return CopyPointMap<int16_t>(view, att);
+    case draco::DT_UINT16:
+      return CopyPointMap<uint16_t>(view, att);
+    default:
+      PyErr_SetString(PyExc_ValueError,
+                      "Point to value maps must be integer arrays.");
+      return false;
+  }
+}
+
+// Adds an attribute described by the |spec| tuple
+// (type, array[, normalized[, quantization_bits[, point_to_value_map]]]) to
+// |pc|. Returns the attribute id or -1 with a Python error set.
+// |quantization_bits| is set to the optional per-attribute quantization or to
+// -1. Without a point to value map, |array| holds one value per point.
+int AddAttributeFromSpec(PyObject *spec, draco::PointCloud *pc,
+                         int *quantization_bits) {
+  int type;
+  PyObject *array;
+  int normalized = 0;
+  PyObject *point_map = Py_None;
+  *quantization_bits = -1;
+  if (!PyArg_ParseTuple(spec, "iO|piO", &type, &array, &normalized,
+                        quantization_bits, &point_map)) {
+    return -1;
+  }
+  if (type < 0 || type >= draco::GeometryAttribute::NAMED_ATTRIBUTES_COUNT) {
+    PyErr_SetString(PyExc_ValueError, "Invalid attribute type.");
+    return -1;
+  }
+  ScopedBuffer values;
+  if (!values.Get(array, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)) {
+    return -1;
+  }
+  const Py_buffer &view = values.view();
+  const draco::DataType data_type = FormatDataType(view.format, view.itemsize);
+  if (data_type == draco::DT_INVALID) {
+    PyErr_SetString(PyExc_ValueError, "Unsupported attribute array dtype.");
+    return -1;
+  }
+  if (view.ndim < 1 || view.ndim > 2) {
+    PyErr_SetString(PyExc_ValueError,
+                    "Attribute arrays must have one or two dimensions.");
+    return -1;
+  }
+  const Py_ssize_t num_values = view.shape[0];
+  const Py_ssize_t num_components = view.ndim == 2 ? view.shape[1] : 1;
+  if (num_components < 1 || num_components > 127) {
+    PyErr_SetString(PyExc_ValueError, "Invalid number of components.");
+    return -1;
+  }
+  std::unique_ptr<draco::PointAttribute> att(new draco::PointAttribute());
+  att->Init(static_cast<draco::GeometryAttribute::Type>(type),
+            static_cast<int8_t>(num_components), data_type, normalized != 0,
+            num_values);
+  // Draco attributes own their storage, so the caller's array is copied
+  // exactly once, straight into the attribute buffer.
+  if (view.len > 0) {
+    att->buffer()->Write(0, view.buf, view.len);
+  }
+  Py_ssize_t num_points = num_values;
+  if (point_map != Py_None) {
+    if (!SetPointMapFromArray(point_map, att.get())) {
+      return -1;
+    }
+    num_points = att->indices_map_size();
+  }
+  if (pc->num_attributes() > 0 &&
+      num_points != static_cast<Py_ssize_t>(pc->num_points())) {
+    PyErr_SetString(PyExc_ValueError,
+                    "All attributes must have the same number of points.");
+    return -1;
+  }
+  pc->set_num_points(static_cast<uint32_t>(num_points));
+  return pc->AddAttribute(std::move(att));
+}
+
+// Copies the (num_faces, 3) integer |array| into the faces of |mesh|. Returns
+// false with a Python error set for invalid input.
+template <typename IndexT>
+bool CopyFaces(const Py_buffer &view, draco::Mesh *mesh) {
+  const IndexT *const indices = static_cast<const IndexT *>(view.buf);
+  const Py_ssize_t num_faces = view.shape[0];
+  const uint64_t num_points = mesh->num_points();
+  mesh->SetNumFaces(num_faces);
+  for (Py_ssize_t f = 0; f < num_faces; ++f) {
+    draco::Mesh::Face face;
+    for (int c = 0; c < 3; ++c) {
+      // Negative indices wrap to large unsigned values.
+      const uint64_t index = static_cast<uint64_t>(
+          static_cast<int64_t>(indices[3 * f + c]));
+      if (index >= num_points) {
+        PyErr_SetString(PyExc_ValueError, "Face index out of range.");
+        return false;
+      }
+      face[c] = draco::PointIndex(static_cast<uint32_t>(index));
+    }
+    mesh->SetFace(draco::FaceIndex(static_cast<uint32_t>(f)), face);
+  }
+  return true;
+}
+
+bool SetFacesFromArray(PyObject *array, draco::Mesh *mesh) {
+  ScopedBuffer faces;
+  if (!faces.Get(array, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)) {
+    return false;
+  }
+  const Py_buffer &view = faces.view();
+  if (view.ndim != 2 || view.shape[1] != 3) {
+    PyErr_SetString(PyExc_ValueError, "Faces must be a (num_faces, 3) array.");
+    return false;
+  }
+  switch (FormatDataType(view.format, view.itemsize)) {
+    case draco::DT_INT32:
+      return CopyFaces<int32_t>(view, mesh);
+    case draco::DT_UINT32:
+      return CopyFaces<uint32_t>(view, mesh);
+    case draco::DT_INT64:
+      return CopyFaces<int64_t>(view, mesh);
+    case draco::DT_UINT64:
+      return CopyFaces<uint64_t>(view, mesh);
+    case draco::DT_INT16:
+      return CopyFaces<int16_t>(view, mesh);
+    case draco::DT_UINT16:
+      return CopyFaces<uint16_t>(view, mesh);
+    default:
+      PyErr_SetString(PyExc_ValueError, "Faces must be an integer array.");
+      return false;
+  }
+}
+
+PyObject *EncoderEncode(PyObject *obj, PyObject *args, PyObject *kwargs) {
+  EncoderObject *const self = reinterpret_cast<EncoderObject *>(obj);
+  static const char *keywords[] = {"attributes", "faces", nullptr};
+  PyObject *attributes;
+  PyObject *faces = Py_None;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O",
+                                   const_cast<char **>(keywords), &attributes,
+                                   &faces)) {
+    return nullptr;
+  }
+  PyObject *const specs =
+      PySequence_Fast(attributes, "attributes must be a sequence.");
+  if (specs == nullptr) {
+    return nullptr;
+  }
+  draco::Mesh *mesh = nullptr;
+  std::unique_ptr<draco::PointCloud> pc;
+  if (faces == Py_None) {
+    pc.reset(new draco::PointCloud());
+  } else {
+    mesh = new draco::Mesh();
+    pc.reset(mesh);
+  }
+  std::vector<std::pair<int, int>> attribute_quantization;
+  const Py_ssize_t num_specs = PySequence_Fast_GET_SIZE(specs);
+  for (Py_ssize_t i = 0; i < num_specs; ++i) {
+    int quantization_bits;
+    const int att_id = AddAttributeFromSpec(
+        PySequence_Fast_GET_ITEM(specs, i), pc.get(), &quantization_bits);
+    if (att_id < 0) {
+      Py_DECREF(specs);
+      return nullptr;
+    }
+    if (quantization_bits >= 0) {
+      attribute_quantization.push_back({att_id, quantization_bits});
+    }
+  }
+  Py_DECREF(specs);
+  if (mesh != nullptr && !SetFacesFromArray(faces, mesh)) {
+    return nullptr;
+  }
+
+  // Per-type options of the encoder are resolved to per-attribute options of
+  // the expert encoder while holding the GIL.
+  std::unique_ptr<draco::ExpertEncoder> encoder(
+      mesh != nullptr ? new draco::ExpertEncoder(*mesh)
+                      : new draco::ExpertEncoder(*pc));
+  encoder->Reset(self->encoder->CreateExpertEncoderOptions(*pc));
+  for (const auto &q : attribute_quantization) {
+    encoder->SetAttributeQuantization(q.first, q.second);
+  }
+  draco::EncoderBuffer buffer;
+  draco::Status status;
+  Py_BEGIN_ALLOW_THREADS;
+  status = encoder->EncodeToBuffer(&buffer);
+  Py_END_ALLOW_THREADS;
+  if (!status.ok()) {
+    SetErrorFromStatus(status);
+    return nullptr;
+  }
+  return PyBytes_FromStringAndSize(buffer.data(), buffer.size());
+}
+
+PyMethodDef encoder_methods[] = {
+    {"set_speed", EncoderSetSpeed, METH_VARARGS,
+     "set_speed(encoding_speed, decoding_speed): Speed options in [0, 10]."},
+    {"set_attribute_quantization", EncoderSetAttributeQuantization,
+     METH_VARARGS,
+     "set_attribute_quantization(type, bits): Quantization of all attributes "
+     "of the given type."},
+    {"set_encoding_method", EncoderSetEncodingMethod, METH_VARARGS,
+     "set_encoding_method(method): e.g. MESH_EDGEBREAKER_ENCODING."},
+    {"set_num_threads", EncoderSetNumThreads, METH_VARARGS,
+     "set_num_threads(n): Number of threads encoding attributes."},
+    {"encode",
+     reinterpret_cast<PyCFunction>(
+         reinterpret_cast<void (*)()>(EncoderEncode)),
+     METH_VARARGS | METH_KEYWORDS,
+     "encode(attributes, faces=None): Encodes a list of attribute tuples "
+     "(type, array[, normalized[, quantization_bits[, point_to_value_map]]]) "
+     "and an optional (num_faces, 3) integer array of faces. Arrays are read "
+     "through the buffer protocol. quantization_bits -1 uses the option of "
+     "the attribute type. point_to_value_map is an optional integer array "
+     "with the index into array of each point, e.g. the result of "
+     "Attribute.point_to_value_map(). Returns bytes."},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyModuleDef draco_module = {
+    PyModuleDef_HEAD_INIT,
+    "draco",
+    "Draco geometry compression with zero-copy buffer protocol arrays.",
+    -1,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr};
+
+// Casts the function |func| to the untyped pointer of a PyType_Slot.
+template <typename FuncT>
+void *Slot(FuncT func) {
+  return reinterpret_cast<void *>(func);
+}
+
+PyType_Slot geometry_slots[] = {
+    {Py_tp_doc, const_cast<char *>("Decoded mesh or point cloud.")},
+    {Py_tp_dealloc, Slot(GeometryDealloc)},
+    {Py_tp_getset, geometry_getset},
+    {Py_tp_methods, geometry_methods},
+    {0, nullptr}};
+
+PyType_Slot attribute_slots[] = {
+    {Py_tp_doc, const_cast<char *>("Zero-copy buffer of attribute values.")},
+    {Py_tp_dealloc, Slot(AttributeDealloc)},
+    {Py_tp_getset, attribute_getset},
+    {Py_tp_methods, attribute_methods},
+    {Py_bf_getbuffer, Slot(AttributeGetBuffer)},
+    {0, nullptr}};
+
+PyType_Slot faces_slots[] = {
+    {Py_tp_doc, const_cast<char *>("Zero-copy buffer of faces.")},
+    {Py_tp_dealloc, Slot(FacesDealloc)},
+    {Py_bf_getbuffer, Slot(FacesGetBuffer)},
+    {0, nullptr}};
+
+PyType_Slot decoder_slots[] = {
+    {Py_tp_doc, const_cast<char *>("Draco decoder.")},
+    {Py_tp_new, Slot(DecoderNew)},
+    {Py_tp_dealloc, Slot(DecoderDealloc)},
+    {Py_tp_methods, decoder_methods},
+    {0, nullptr}};
+
+PyType_Slot encoder_slots[] = {
+    {Py_tp_doc, const_cast<char *>("Draco encoder.")},
+    {Py_tp_new, Slot(EncoderNew)},
+    {Py_tp_dealloc, Slot(EncoderDealloc)},
+    {Py_tp_methods, encoder_methods},
+    {0, nullptr}};
+
+PyType_Spec geometry_spec = {"draco.Mesh", sizeof(GeometryObject), 0,
+                             Py_TPFLAGS_DEFAULT, geometry_slots};
+PyType_Spec attribute_spec = {"draco.Attribute", sizeof(AttributeObject), 0,
+                              Py_TPFLAGS_DEFAULT, attribute_slots};
+PyType_Spec faces_spec = {"draco.Faces", sizeof(FacesObject), 0,
+                          Py_TPFLAGS_DEFAULT, faces_slots};
+PyType_Spec decoder_spec = {"draco.Decoder", sizeof(DecoderObject), 0,
+                            Py_TPFLAGS_DEFAULT, decoder_slots};
+PyType_Spec encoder_spec = {"draco.Encoder", sizeof(EncoderObject), 0,
+                            Py_TPFLAGS_DEFAULT, encoder_slots};
+
+// Creates the type described by |spec|, stores it in |type| and adds it to
+// |module|. Types without a Py_tp_new slot can only be created by the module.
+bool AddType(PyType_Spec *spec, PyTypeObject **type, PyObject *module) {
+  PyObject *const type_obj = PyType_FromSpec(spec);
+  if (type_obj == nullptr) {
+    return false;
+  }
+  *type = reinterpret_cast<PyTypeObject *>(type_obj);
+  bool has_new = false;
+  for (const PyType_Slot *slot = spec->slots; slot->slot != 0; ++slot) {
+    has_new |= slot->slot == Py_tp_new;
+  }
+  if (!has_new) {
+    // Otherwise the type would inherit object.__new__() and Python code could
+    // create instances with uninitialized members.
+    (*type)->tp_new = nullptr;
+  }
+  // |type| keeps a reference for the lifetime of the process in addition to
+  // the reference stolen by the module.
+  Py_INCREF(type_obj);
+  if (PyModule_AddObject(module, std::strchr(spec->name, '.') + 1,
+                         type_obj) < 0) {
+    Py_DECREF(type_obj);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+PyMODINIT_FUNC PyInit_draco() {
+  PyObject *const module = PyModule_Create(&draco_module);
+  if (module == nullptr) {
+    return nullptr;
+  }
+
+  if (!AddType(&geometry_spec, &GeometryType, module) ||
+      !AddType(&attribute_spec, &AttributeType, module) ||
+      !AddType(&faces_spec, &FacesType, module) ||
+      !AddType(&decoder_spec, &DecoderType, module) ||
+      !AddType(&encoder_spec, &EncoderType, module)) {
+    Py_DECREF(module);
+    return nullptr;
+  }
+
+  const struct {
+    const char *name;
+    int value;
+  } constants[] = {
+      {"POSITION", draco::GeometryAttribute::POSITION},
+      {"NORMAL", draco::GeometryAttribute::NORMAL},
+      {"COLOR", draco::GeometryAttribute::COLOR},
+      {"TEX_COORD", draco::GeometryAttribute::TEX_COORD},
+      {"GENERIC", draco::GeometryAttribute::GENERIC},
+      {"POINT_CLOUD_SEQUENTIAL_ENCODING",
+       draco::POINT_CLOUD_SEQUENTIAL_ENCODING},
+      {"POINT_CLOUD_KD_TREE_ENCODING", draco::POINT_CLOUD_KD_TREE_ENCODING},
+      {"MESH_SEQUENTIAL_ENCODING", draco::MESH_SEQUENTIAL_ENCODING},
+      {"MESH_EDGEBREAKER_ENCODING", draco::MESH_EDGEBREAKER_ENCODING},
+  };
+  for (const auto &constant : constants) {
+    if (PyModule_AddIntConstant(module, constant.name, constant.value) < 0) {
+      Py_DECREF(module);
+      return nullptr;
+    }
+  }
+  return module;
+}
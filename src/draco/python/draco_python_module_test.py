@@ -0,0 +1,170 @@
+#!/usr/bin/python3
+#
+# Copyright 2026 The Draco Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests the draco Python extension module.
+
+Run through ctest, or directly with:
+
+  python3 draco_python_module_test.py --module_dir <draco build dir> \
+      --testdata_dir <draco root>/testdata
+"""
+
+import argparse
+import array
+import gc
+import os
+import sys
+import unittest
+
+# Directory of the draco test files, set in main().
+TESTDATA_DIR = None
+
+# Imported in main() once the module directory is on the path.
+draco = None
+
+
+def read_test_file(name):
+  with open(os.path.join(TESTDATA_DIR, name), 'rb') as f:
+    return f.read()
+
+
+def as_array(values, format_char, shape):
+  """Returns a memoryview of |values| with the given format and shape."""
+  return memoryview(array.array(format_char, values)).cast('B').cast(
+      format_char, shape)
+
+
+class DracoPythonModuleTest(unittest.TestCase):
+
+  def test_decode_mesh(self):
+    mesh = draco.Decoder().decode(read_test_file('cube_att.drc'))
+    self.assertEqual(mesh.num_faces, 12)
+    self.assertGreater(mesh.num_points, 0)
+    faces = memoryview(mesh.faces)
+    self.assertEqual(faces.format, 'I')
+    self.assertEqual(faces.shape, (12, 3))
+    for face in faces.tolist():
+      for index in face:
+        self.assertLess(index, mesh.num_points)
+    pos = mesh.get_named_attribute(draco.POSITION)
+    self.assertEqual(pos.type, draco.POSITION)
+    self.assertEqual(pos.num_components, 3)
+    values = memoryview(pos)
+    self.assertEqual(values.format, 'f')
+    self.assertEqual(values.shape[1], 3)
+    self.assertIsNone(mesh.get_named_attribute(draco.POSITION, 1))
+
+  def test_decode_point_cloud(self):
+    pc = draco.Decoder().decode(read_test_file('pc_kd_color.drc'))
+    self.assertEqual(pc.num_faces, 0)
+    self.assertEqual(memoryview(pc.faces).shape, (0, 3))
+    self.assertGreater(pc.num_points, 0)
+
+  def test_decode_invalid_data(self):
+    with self.assertRaises(RuntimeError):
+      draco.Decoder().decode(b'not a draco file')
+
+  def test_views_are_zero_copy(self):
+    mesh = draco.Decoder().decode(read_test_file('cube_att.drc'))
+    values = memoryview(mesh.get_named_attribute(draco.POSITION))
+    values[0, 0] = 123.5
+    self.assertEqual(
+        memoryview(mesh.get_named_attribute(draco.POSITION))[0, 0], 123.5)
+
+  def test_views_outlive_mesh(self):
+    mesh = draco.Decoder().decode(read_test_file('cube_att.drc'))
+    expected_values = memoryview(
+        mesh.get_named_attribute(draco.POSITION)).tolist()
+    expected_faces = memoryview(mesh.faces).tolist()
+    values = memoryview(mesh.get_named_attribute(draco.POSITION))
+    faces = memoryview(mesh.faces)
+    del mesh
+    gc.collect()
+    # Allocate and free other geometry to overwrite released memory.
+    for _ in range(10):
+      draco.Decoder().decode(read_test_file('pc_kd_color.drc'))
+    self.assertEqual(values.tolist(), expected_values)
+    self.assertEqual(faces.tolist(), expected_faces)
+
+  def test_types_cannot_be_created_directly(self):
+    with self.assertRaises(TypeError):
+      draco.Mesh()
+    with self.assertRaises(TypeError):
+      draco.Attribute()
+
+  def test_encode_round_trip(self):
+    positions = [0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0]
+    encoder = draco.Encoder()
+    data = encoder.encode([(draco.POSITION, as_array(positions, 'f', (4, 3)))],
+                          as_array([0, 1, 2, 2, 1, 3], 'I', (2, 3)))
+    mesh = draco.Decoder().decode(data)
+    self.assertEqual(mesh.num_faces, 2)
+    self.assertEqual(mesh.num_points, 4)
+    decoded = memoryview(mesh.get_named_attribute(draco.POSITION)).tolist()
+    self.assertEqual(sorted(decoded), sorted([
+        positions[i:i + 3] for i in range(0, len(positions), 3)]))
+
+  def test_encode_point_cloud(self):
+    positions = as_array([0, 0, 0, 1, 0, 0, 0, 1, 0], 'f', (3, 3))
+    data = draco.Encoder().encode([(draco.POSITION, positions, False, 8)])
+    pc = draco.Decoder().decode(data)
+    self.assertEqual(pc.num_faces, 0)
+    self.assertEqual(pc.num_points, 3)
+
+  def test_encode_decoded_mesh_with_point_map(self):
+    mesh = draco.Decoder().decode(read_test_file('cube_att.drc'))
+    attributes = []
+    has_point_map = False
+    for att in mesh.attributes:
+      point_map = att.point_to_value_map()
+      has_point_map |= point_map is not None
+      attributes.append((att.type, att, att.normalized, -1, point_map))
+    self.assertTrue(has_point_map)
+    data = draco.Encoder().encode(attributes, mesh.faces)
+    decoded = draco.Decoder().decode(data)
+    self.assertEqual(decoded.num_faces, mesh.num_faces)
+    self.assertEqual(len(decoded.attributes), len(mesh.attributes))
+
+  def test_encode_invalid_input(self):
+    positions = as_array([0, 0, 0, 1, 0, 0, 0, 1, 0], 'f', (3, 3))
+    encoder = draco.Encoder()
+    with self.assertRaises(ValueError):
+      encoder.encode([(draco.POSITION, positions)],
+                     as_array([0, 1, 9], 'i', (1, 3)))
+    with self.assertRaises(ValueError):
+      encoder.encode([(draco.POSITION, positions, False, -1,
+                       as_array([0, 1, 3], 'I', (3,)))])
+    with self.assertRaises(ValueError):
+      encoder.encode([(draco.POSITION, positions),
+                      (draco.NORMAL, as_array([0, 0, 1], 'f', (1, 3)))])
+
+
+def main():
+  global TESTDATA_DIR, draco
+  parser = argparse.ArgumentParser()
+  parser.add_argument('--module_dir', required=True,
+                      help='Directory of the built draco module.')
+  parser.add_argument('--testdata_dir', required=True,
+                      help='Directory of the draco test files.')
+  args, unittest_args = parser.parse_known_args()
+  TESTDATA_DIR = args.testdata_dir
+  sys.path.insert(0, args.module_dir)
+  import draco as draco_module  # pylint: disable=g-import-not-at-top
+  draco = draco_module
+  unittest.main(argv=[sys.argv[0]] + unittest_args)
+
+
+if __name__ == '__main__':
+  main()
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "draco/core/draco_index_type_vector.h"
 #include "draco/core/macros.h"
 #include "draco/scene/scene_indices.h"
 
@@ -127,6 +128,32 @@ class MeshGroup {
     }
   }
 
+  // Replaces base mesh indices of all mesh instances with the indices given by
+  // |mesh_index_map|. Mesh instances whose base mesh is mapped to
+  // |kInvalidMeshIndex| or is not covered by |mesh_index_map| are removed.
+  void RemapMeshInstances(
+      const IndexTypeVector<MeshIndex, MeshIndex> &mesh_index_map) {
+    int num_instances = 0;
+    for (int i = 0; i < static_cast<int>(mesh_instances_.size()); ++i) {
+      MeshInstance &instance = mesh_instances_[i];
+      if (instance.mesh_index != kInvalidMeshIndex) {
+        if (instance.mesh_index >= mesh_index_map.size()) {
+          continue;
+        }
+        instance.mesh_index = mesh_index_map[instance.mesh_index];
+        if (instance.mesh_index == kInvalidMeshIndex) {
+          continue;
+        }
+      }
+      if (i != num_instances) {
+        mesh_instances_[num_instances] = std::move(instance);
+      }
+      num_instances++;
+    }
+    mesh_instances_.erase(mesh_instances_.begin() + num_instances,
+                          mesh_instances_.end());
+  }
+
  private:
   std::string name_;
   std::vector<MeshInstance> mesh_instances_;
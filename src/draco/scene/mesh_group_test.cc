@@ -148,6 +148,33 @@ TEST(MeshGroupTest, TestRemoveThreeMeshInstances) {
   ASSERT_EQ(mi2.materials_variants_mappings, MakeMappings(7));
 }
 
+TEST(MeshGroupTest, TestRemapMeshInstances) {
+  // Test that base mesh indices of mesh instances can be remapped and that
+  // mesh instances of removed or unknown base meshes are removed.
+
+  // Create test mesh group.
+  MeshGroup mesh_group;
+  mesh_group.AddMeshInstance({MeshIndex(0), 0, {}});
+  mesh_group.AddMeshInstance({MeshIndex(1), 10, {}});
+  mesh_group.AddMeshInstance({MeshIndex(5), 50, {}});
+  mesh_group.AddMeshInstance({MeshIndex(2), 20, {}});
+
+  // Remove base mesh 1 and swap base meshes 0 and 2. Base mesh 5 is not
+  // covered by the map.
+  draco::IndexTypeVector<MeshIndex, MeshIndex> mesh_index_map(3);
+  mesh_index_map[MeshIndex(0)] = MeshIndex(1);
+  mesh_index_map[MeshIndex(1)] = draco::kInvalidMeshIndex;
+  mesh_index_map[MeshIndex(2)] = MeshIndex(0);
+  mesh_group.RemapMeshInstances(mesh_index_map);
+
+  // Check result.
+  ASSERT_EQ(mesh_group.NumMeshInstances(), 2);
+  ASSERT_EQ(mesh_group.GetMeshInstance(0).mesh_index, MeshIndex(1));
+  ASSERT_EQ(mesh_group.GetMeshInstance(0).material_index, 0);
+  ASSERT_EQ(mesh_group.GetMeshInstance(1).mesh_index, MeshIndex(0));
+  ASSERT_EQ(mesh_group.GetMeshInstance(1).material_index, 20);
+}
+
 TEST(MeshGroupTest, TestCopy) {
   // Tests that a mesh group can be copied.
 
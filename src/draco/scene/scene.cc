@@ -154,6 +154,70 @@ Status Scene::RemoveMeshGroup(MeshGroupIndex index) {
   return OkStatus();
 }
 
+Status Scene::RemoveMeshes(const std::vector<bool> &is_mesh_removed) {
+  if (is_mesh_removed.size() != meshes_.size()) {
+    return Status(Status::DRACO_ERROR, "Invalid number of removed meshes.");
+  }
+  // Compact the remaining base meshes and compute their new indices.
+  IndexTypeVector<MeshIndex, MeshIndex> new_mesh_index(meshes_.size(),
+                                                       kInvalidMeshIndex);
+  MeshIndex num_meshes(0);
+  for (MeshIndex i(0); i < meshes_.size(); ++i) {
+    if (is_mesh_removed[i.value()]) {
+      continue;
+    }
+    new_mesh_index[i] = num_meshes;
+    meshes_[num_meshes++] = std::move(meshes_[i]);
+  }
+  meshes_.resize(num_meshes.value());
+
+  // Remove references to removed base meshes from mesh groups and update
+  // references to remaining base meshes.
+  for (MeshGroupIndex mgi(0); mgi < NumMeshGroups(); ++mgi) {
+    MeshGroup *const mesh_group = GetMeshGroup(mgi);
+    if (!mesh_group) {
+      return Status(Status::DRACO_ERROR, "MeshGroup is null.");
+    }
+    mesh_group->RemapMeshInstances(new_mesh_index);
+  }
+  return OkStatus();
+}
+
+Status Scene::RemoveMeshGroups(const std::vector<bool> &is_mesh_group_removed) {
+  if (is_mesh_group_removed.size() != mesh_groups_.size()) {
+    return Status(Status::DRACO_ERROR,
+                  "Invalid number of removed mesh groups.");
+  }
+  // Compact the remaining mesh groups and compute their new indices.
+  IndexTypeVector<MeshGroupIndex, MeshGroupIndex> new_mesh_group_index(
+      mesh_groups_.size(), kInvalidMeshGroupIndex);
+  MeshGroupIndex num_mesh_groups(0);
+  for (MeshGroupIndex i(0); i < mesh_groups_.size(); ++i) {
+    if (is_mesh_group_removed[i.value()]) {
+      continue;
+    }
+    new_mesh_group_index[i] = num_mesh_groups;
+    mesh_groups_[num_mesh_groups++] = std::move(mesh_groups_[i]);
+  }
+  mesh_groups_.resize(num_mesh_groups.value());
+
+  // Invalidate references to removed mesh groups in scene nodes, and update
+  // references to remaining mesh groups in scene nodes.
+  for (SceneNodeIndex sni(0); sni < NumNodes(); ++sni) {
+    SceneNode *node = GetNode(sni);
+    if (!node) {
+      return Status(Status::DRACO_ERROR, "Node is null.");
+    }
+    const MeshGroupIndex mgi = node->GetMeshGroupIndex();
+    if (mgi == kInvalidMeshGroupIndex ||
+        mgi.value() >= new_mesh_group_index.size()) {
+      continue;
+    }
+    node->SetMeshGroupIndex(new_mesh_group_index[mgi]);
+  }
+  return OkStatus();
+}
+
 Status Scene::RemoveMaterial(int index) {
   if (index < 0 || index >= material_library_.NumMaterials()) {
     return Status(Status::DRACO_ERROR, "Material index is out of range.");
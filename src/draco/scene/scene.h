@@ -61,6 +61,12 @@ class Scene {
   // updates references to remaining base meshes in mesh groups.
   Status RemoveMesh(MeshIndex index);
 
+  // Removes all base meshes whose entry in |is_mesh_removed| is true. Same as
+  // calling RemoveMesh() for each removed mesh but the mesh groups are updated
+  // only once, so the complexity does not depend on the number of removed
+  // meshes.
+  Status RemoveMeshes(const std::vector<bool> &is_mesh_removed);
+
   // Returns the number of meshes in a scene before instancing is applied.
   int NumMeshes() const { return meshes_.size(); }
 
@@ -81,6 +87,12 @@ class Scene {
   // nodes.
   Status RemoveMeshGroup(MeshGroupIndex index);
 
+  // Removes all mesh groups whose entry in |is_mesh_group_removed| is true.
+  // Same as calling RemoveMeshGroup() for each removed mesh group but the scene
+  // nodes are updated only once. Nodes referencing mesh groups that are not in
+  // the scene are left unchanged.
+  Status RemoveMeshGroups(const std::vector<bool> &is_mesh_group_removed);
+
   // Removes unused material at |index| and updates references to materials at
   // indices greater than |index|. Returns error status when |index| is out of
   // valid range and when material at |index| is used in the scene.
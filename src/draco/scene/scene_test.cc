@@ -222,6 +222,29 @@ TEST(SceneTest, TestRemoveMeshGroup) {
             draco::kInvalidMeshGroupIndex);
 }
 
+TEST(SceneTest, TestRemoveMeshGroups) {
+  // Test that multiple mesh groups can be removed from scene at once and that
+  // nodes referencing mesh groups outside of the scene are left unchanged.
+  draco::Scene scene;
+  for (int i = 0; i < 3; ++i) {
+    scene.AddMeshGroup();
+  }
+  for (const int mgi : {0, 1, 2, 7}) {
+    const draco::SceneNodeIndex sni = scene.AddNode();
+    scene.GetNode(sni)->SetMeshGroupIndex(draco::MeshGroupIndex(mgi));
+  }
+  DRACO_ASSERT_OK(scene.RemoveMeshGroups({false, true, false}));
+  ASSERT_EQ(scene.NumMeshGroups(), 2);
+  ASSERT_EQ(scene.GetNode(draco::SceneNodeIndex(0))->GetMeshGroupIndex(),
+            draco::MeshGroupIndex(0));
+  ASSERT_EQ(scene.GetNode(draco::SceneNodeIndex(1))->GetMeshGroupIndex(),
+            draco::kInvalidMeshGroupIndex);
+  ASSERT_EQ(scene.GetNode(draco::SceneNodeIndex(2))->GetMeshGroupIndex(),
+            draco::MeshGroupIndex(1));
+  ASSERT_EQ(scene.GetNode(draco::SceneNodeIndex(3))->GetMeshGroupIndex(),
+            draco::MeshGroupIndex(7));
+}
+
 void CheckMeshMaterials(const draco::Scene &scene,
                         const std::vector<int> &expected_material_indices) {
   ASSERT_EQ(scene.NumMeshes(), expected_material_indices.size());
@@ -16,6 +16,9 @@
 #include "draco/scene/scene_utils.h"
 
 #ifdef DRACO_TRANSCODER_SUPPORTED
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -23,8 +26,11 @@
 #include <unordered_set>
 #include <utility>
 
+#include "Eigen/Eigenvalues"
+#include "Eigen/SVD"
 #include "draco/core/draco_index_type_vector.h"
 #include "draco/core/hash_utils.h"
+#include "draco/core/thread_pool.h"
 #include "draco/core/vector_d.h"
 #include "draco/mesh/mesh_splitter.h"
 #include "draco/mesh/mesh_utils.h"
@@ -457,7 +463,7 @@ StatusOr<std::unique_ptr<Mesh>> SceneUtils::InstantiateMesh(
     const Scene &scene, const MeshInstance &instance) {
   // Check if the |scene| has base mesh corresponding to mesh |instance|.
   if (scene.NumMeshes() <= instance.mesh_index.value()) {
-    Status(Status::DRACO_ERROR, "Scene has no corresponding base mesh.");
+    return Status(Status::DRACO_ERROR, "Scene has no corresponding base mesh.");
   }
 
   // Check that mesh has valid positions.
@@ -483,6 +489,230 @@ StatusOr<std::unique_ptr<Mesh>> SceneUtils::InstantiateMesh(
   return mesh;
 }
 
+StatusOr<std::unique_ptr<Mesh>> SceneUtils::FlattenScene(const Scene &scene,
+                                                         int num_threads) {
+  const auto instances = ComputeAllInstances(scene);
+  if (instances.size() == 0) {
+    return Status(Status::DRACO_ERROR, "Scene has no mesh instances.");
+  }
+  const int num_instances = instances.size();
+  const Mesh &ref_mesh =
+      scene.GetMesh(instances[MeshInstanceIndex(0)].mesh_index);
+  const int num_attributes = ref_mesh.num_attributes();
+  const int num_materials = scene.GetMaterialLibrary().NumMaterials();
+  const bool add_material_attribute = num_materials > 1;
+  if (add_material_attribute &&
+      ref_mesh.NumNamedAttributes(GeometryAttribute::MATERIAL) > 0) {
+    return Status(Status::DRACO_ERROR,
+                  "Base meshes must not have material attributes.");
+  }
+
+  // For each instanced base mesh, find attributes that correspond to the
+  // attributes of |ref_mesh|. Attributes of the same type are matched in the
+  // order in which they are stored in the meshes.
+  std::vector<int> ref_att_type_index(num_attributes, 0);
+  for (int i = 0; i < num_attributes; ++i) {
+    for (int j = 0; j < i; ++j) {
+      if (ref_mesh.attribute(j)->attribute_type() ==
+          ref_mesh.attribute(i)->attribute_type()) {
+        ref_att_type_index[i]++;
+      }
+    }
+  }
+  IndexTypeVector<MeshIndex, std::vector<int>> mesh_att_ids(scene.NumMeshes());
+  std::vector<bool> is_mapping_identity(num_attributes, true);
+  for (MeshInstanceIndex i(0); i < num_instances; ++i) {
+    const MeshIndex mi = instances[i].mesh_index;
+    if (mi == kInvalidMeshIndex || mi >= MeshIndex(scene.NumMeshes())) {
+      return Status(Status::DRACO_ERROR, "Scene has no corresponding mesh.");
+    }
+    if (!mesh_att_ids[mi].empty() || num_attributes == 0) {
+      continue;
+    }
+    const Mesh &mesh = scene.GetMesh(mi);
+    if (mesh.num_attributes() != num_attributes) {
+      return Status(Status::DRACO_ERROR, "Meshes have different attributes.");
+    }
+    for (int j = 0; j < num_attributes; ++j) {
+      const PointAttribute &ref_att = *ref_mesh.attribute(j);
+      const int att_id = mesh.GetNamedAttributeId(ref_att.attribute_type(),
+                                                   ref_att_type_index[j]);
+      if (att_id < 0) {
+        return Status(Status::DRACO_ERROR, "Meshes have different attributes.");
+      }
+      const PointAttribute *const att = mesh.attribute(att_id);
+      if (att == nullptr || att->data_type() != ref_att.data_type() ||
+          att->num_components() != ref_att.num_components() ||
+          att->normalized() != ref_att.normalized()) {
+        return Status(Status::DRACO_ERROR, "Meshes have different attributes.");
+      }
+      // Transformed attributes must be in a format supported by
+      // MeshUtils::TransformPositions() and MeshUtils::TransformNormals().
+      switch (att->attribute_type()) {
+        case GeometryAttribute::POSITION:
+          if (att->data_type() != DT_FLOAT32 || att->num_components() != 3) {
+            return Status(Status::DRACO_ERROR, "Mesh has invalid positions.");
+          }
+          break;
+        case GeometryAttribute::NORMAL:
+        case GeometryAttribute::TANGENT:
+          if (att->data_type() != DT_FLOAT32 || att->num_components() < 3 ||
+              att->num_components() > 4) {
+            return Status(Status::DRACO_ERROR,
+                          "Mesh has invalid normals or tangents.");
+          }
+          break;
+        default:
+          break;
+      }
+      mesh_att_ids[mi].push_back(att_id);
+      if (!att->is_mapping_identity()) {
+        is_mapping_identity[j] = false;
+      }
+    }
+  }
+
+  // Compute where each instance is stored in the output mesh.
+  std::vector<int64_t> point_offsets(num_instances + 1, 0);
+  std::vector<int64_t> face_offsets(num_instances + 1, 0);
+  std::vector<std::vector<int64_t>> value_offsets(
+      num_attributes, std::vector<int64_t>(num_instances + 1, 0));
+  std::vector<int> material_indices(num_instances, 0);
+  for (int i = 0; i < num_instances; ++i) {
+    const MeshInstance &instance = instances[MeshInstanceIndex(i)];
+    const Mesh &mesh = scene.GetMesh(instance.mesh_index);
+    point_offsets[i + 1] = point_offsets[i] + mesh.num_points();
+    face_offsets[i + 1] = face_offsets[i] + mesh.num_faces();
+    for (int j = 0; j < num_attributes; ++j) {
+      value_offsets[j][i + 1] =
+          value_offsets[j][i] +
+          mesh.attribute(mesh_att_ids[instance.mesh_index][j])->size();
+    }
+    if (add_material_attribute) {
+      material_indices[i] = GetMeshInstanceMaterialIndex(scene, instance);
+      if (material_indices[i] < 0 || material_indices[i] >= num_materials) {
+        return Status(Status::DRACO_ERROR, "Invalid material index.");
+      }
+    }
+  }
+  if (point_offsets.back() > std::numeric_limits<uint32_t>::max() ||
+      face_offsets.back() > std::numeric_limits<uint32_t>::max()) {
+    return Status(Status::DRACO_ERROR, "Flattened mesh is too large.");
+  }
+
+  // Allocate the output mesh.
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  mesh->set_num_points(point_offsets.back());
+  mesh->SetNumFaces(face_offsets.back());
+  for (int j = 0; j < num_attributes; ++j) {
+    const PointAttribute &ref_att = *ref_mesh.attribute(j);
+    GeometryAttribute ga;
+    ga.Init(ref_att.attribute_type(), nullptr, ref_att.num_components(),
+            ref_att.data_type(), ref_att.normalized(),
+            ref_att.num_components() * DataTypeLength(ref_att.data_type()), 0);
+    ga.set_name(ref_att.name());
+    mesh->AddAttribute(mesh->CreateAttribute(ga, is_mapping_identity[j],
+                                             value_offsets[j].back()));
+  }
+  PointAttribute *mat_att = nullptr;
+  if (add_material_attribute) {
+    DataType component_type = DT_UINT32;
+    if (num_materials < 256) {
+      component_type = DT_UINT8;
+    } else if (num_materials < (1 << 16)) {
+      component_type = DT_UINT16;
+    }
+    GeometryAttribute ga;
+    ga.Init(GeometryAttribute::MATERIAL, nullptr, 1, component_type, false,
+            DataTypeLength(component_type), 0);
+    mat_att = mesh->attribute(
+        mesh->AddAttribute(mesh->CreateAttribute(ga, false, num_materials)));
+    for (AttributeValueIndex avi(0); avi < num_materials; ++avi) {
+      const uint32_t material_index = avi.value();
+      mat_att->SetAttributeValue(avi, &material_index);
+    }
+  }
+  if (num_materials > 0) {
+    mesh->GetMaterialLibrary().Copy(scene.GetMaterialLibrary());
+  }
+
+  // Copy and transform the instances in parallel. Each instance is written to
+  // its own range of points, faces and attribute values.
+  if (num_threads < 0) {
+    num_threads = ThreadPool::HardwareConcurrency() - 1;
+  }
+  ThreadPool pool(num_threads);
+  pool.ParallelFor(num_instances, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      const MeshInstance &instance = instances[MeshInstanceIndex(i)];
+      const Mesh &src_mesh = scene.GetMesh(instance.mesh_index);
+      const uint32_t point_offset = point_offsets[i];
+      for (FaceIndex fi(0); fi < src_mesh.num_faces(); ++fi) {
+        const Mesh::Face &src_face = src_mesh.face(fi);
+        Mesh::Face face;
+        for (int c = 0; c < 3; ++c) {
+          face[c] = src_face[c] + point_offset;
+        }
+        mesh->SetFace(FaceIndex(face_offsets[i] + fi.value()), face);
+      }
+      const bool is_identity = instance.transform.isIdentity();
+      const Eigen::Matrix3d normal_transform =
+          is_identity ? Eigen::Matrix3d::Identity()
+                      : Eigen::Matrix3d(instance.transform.block<3, 3>(0, 0)
+                                            .inverse()
+                                            .transpose());
+      for (int j = 0; j < num_attributes; ++j) {
+        const PointAttribute &src_att =
+            *src_mesh.attribute(mesh_att_ids[instance.mesh_index][j]);
+        PointAttribute *const att = mesh->attribute(j);
+        const AttributeValueIndex value_begin(value_offsets[j][i]);
+        const AttributeValueIndex value_end(value_offsets[j][i + 1]);
+        if (src_att.size() > 0 &&
+            src_att.byte_stride() == att->byte_stride()) {
+          memcpy(att->GetAddress(value_begin),
+                 src_att.GetAddress(AttributeValueIndex(0)),
+                 src_att.size() * src_att.byte_stride());
+        } else {
+          for (AttributeValueIndex avi(0); avi < src_att.size(); ++avi) {
+            att->SetAttributeValue(value_begin + avi.value(),
+                                   src_att.GetAddress(avi));
+          }
+        }
+        if (!is_mapping_identity[j]) {
+          for (PointIndex pi(0); pi < src_mesh.num_points(); ++pi) {
+            att->SetPointMapEntry(
+                PointIndex(point_offset + pi.value()),
+                value_begin + src_att.mapped_index(pi).value());
+          }
+        }
+        if (is_identity) {
+          continue;
+        }
+        switch (att->attribute_type()) {
+          case GeometryAttribute::POSITION:
+            MeshUtils::TransformPositions(instance.transform, value_begin,
+                                          value_end, att);
+            break;
+          case GeometryAttribute::NORMAL:
+          case GeometryAttribute::TANGENT:
+            MeshUtils::TransformNormals(normal_transform, value_begin,
+                                        value_end, att);
+            break;
+          default:
+            break;
+        }
+      }
+      if (mat_att != nullptr) {
+        for (PointIndex pi(0); pi < src_mesh.num_points(); ++pi) {
+          mat_att->SetPointMapEntry(PointIndex(point_offset + pi.value()),
+                                    AttributeValueIndex(material_indices[i]));
+        }
+      }
+    }
+  });
+  return mesh;
+}
+
 namespace {
 
 // Helper class for deleting unused nodes from the scene.
@@ -699,24 +929,24 @@ void SceneUtils::Cleanup(Scene *scene, const CleanupOptions &options) {
   }
 
   if (options.remove_unused_meshes) {
-    // Remove base meshes with no references to them.
-    for (int i = scene->NumMeshes() - 1; i >= 0; i--) {
-      const MeshIndex mi(i);
-      if (!is_base_mesh_referenced[mi.value()]) {
-        scene->RemoveMesh(mi);
-      }
+    // Remove base meshes with no references to them. All meshes are removed
+    // at once because removing them one by one is quadratic in the number of
+    // meshes.
+    std::vector<bool> is_mesh_removed(scene->NumMeshes());
+    for (int i = 0; i < scene->NumMeshes(); ++i) {
+      is_mesh_removed[i] = !is_base_mesh_referenced[i];
     }
+    scene->RemoveMeshes(is_mesh_removed);
   }
 
   if (options.remove_unused_mesh_groups) {
     // Remove empty mesh groups with no geometry or no references to them.
-    for (int i = scene->NumMeshGroups() - 1; i >= 0; i--) {
-      const MeshGroupIndex mgi(i);
-      if (is_mesh_group_empty[mgi.value()] ||
-          !is_mesh_group_referenced[mgi.value()]) {
-        scene->RemoveMeshGroup(mgi);
-      }
+    std::vector<bool> is_mesh_group_removed(scene->NumMeshGroups());
+    for (int i = 0; i < scene->NumMeshGroups(); ++i) {
+      is_mesh_group_removed[i] =
+          is_mesh_group_empty[i] || !is_mesh_group_referenced[i];
     }
+    scene->RemoveMeshGroups(is_mesh_group_removed);
   }
 
   // Find materials that reference a texture.
@@ -945,6 +1175,575 @@ void SceneUtils::DeduplicateMeshGroups(Scene *scene) {
   Cleanup(scene);
 }
 
+Status SceneUtils::CleanupMeshes(const MeshCleanupOptions &options,
+                                 int num_threads, Scene *scene) {
+  if (num_threads < 0) {
+    num_threads = ThreadPool::HardwareConcurrency() - 1;
+  }
+  const int num_meshes = scene->NumMeshes();
+  std::vector<Status> statuses(num_meshes);
+  ThreadPool pool(num_threads);
+  pool.ParallelFor(num_meshes, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      statuses[i] =
+          MeshCleanup::Cleanup(&scene->GetMesh(MeshIndex(i)), options);
+    }
+  });
+  for (const Status &status : statuses) {
+    DRACO_RETURN_IF_ERROR(status);
+  }
+  return OkStatus();
+}
+
+namespace {
+
+// Returns true if the mesh can be replaced by an identical mesh.
+bool CanDeduplicateMesh(const Mesh &mesh) {
+  return mesh.NumMeshFeatures() == 0 &&
+         mesh.NumPropertyAttributesIndices() == 0 &&
+         mesh.GetMetadata() == nullptr;
+}
+
+// Returns true when |a| and |b| contain the same faces, points and attribute
+// values and the same per-mesh compression settings.
+bool AreMeshesIdentical(const Mesh &a, const Mesh &b) {
+  if (a.GetName() != b.GetName() || a.num_faces() != b.num_faces() ||
+      a.num_points() != b.num_points() ||
+      a.num_attributes() != b.num_attributes() ||
+      a.IsCompressionEnabled() != b.IsCompressionEnabled() ||
+      !(a.GetCompressionOptions() == b.GetCompressionOptions())) {
+    return false;
+  }
+  for (FaceIndex fi(0); fi < a.num_faces(); ++fi) {
+    if (a.face(fi) != b.face(fi)) {
+      return false;
+    }
+  }
+  for (int i = 0; i < a.num_attributes(); ++i) {
+    const PointAttribute &att_a = *a.attribute(i);
+    const PointAttribute &att_b = *b.attribute(i);
+    if (att_a.attribute_type() != att_b.attribute_type() ||
+        att_a.data_type() != att_b.data_type() ||
+        att_a.num_components() != att_b.num_components() ||
+        att_a.normalized() != att_b.normalized() ||
+        att_a.unique_id() != att_b.unique_id() ||
+        att_a.name() != att_b.name() || att_a.size() != att_b.size()) {
+      return false;
+    }
+    const size_t value_size =
+        att_a.num_components() * DataTypeLength(att_a.data_type());
+    for (AttributeValueIndex avi(0); avi < att_a.size(); ++avi) {
+      if (memcmp(att_a.GetAddress(avi), att_b.GetAddress(avi), value_size) !=
+          0) {
+        return false;
+      }
+    }
+    for (PointIndex pi(0); pi < a.num_points(); ++pi) {
+      if (att_a.mapped_index(pi) != att_b.mapped_index(pi)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+StatusOr<int> SceneUtils::DeduplicateMeshes(int num_threads, Scene *scene) {
+  if (num_threads < 0) {
+    num_threads = ThreadPool::HardwareConcurrency() - 1;
+  }
+  const int num_meshes = scene->NumMeshes();
+  if (num_meshes <= 1) {
+    return 0;
+  }
+
+  // Hashing is the expensive part so it is done in parallel for all meshes.
+  std::vector<size_t> hashes(num_meshes, 0);
+  ThreadPool pool(num_threads);
+  pool.ParallelFor(num_meshes, 1, [&](int begin, int end) {
+    const MeshHasher hasher;
+    for (int i = begin; i < end; ++i) {
+      const Mesh &mesh = scene->GetMesh(MeshIndex(i));
+      if (CanDeduplicateMesh(mesh)) {
+        hashes[i] = hasher(mesh);
+      }
+    }
+  });
+
+  // Group meshes with equal hashes. Each mesh is then compared with the
+  // preceding meshes of its group and it is mapped to the first identical
+  // mesh. A mesh identical to a preceding duplicate is also identical to the
+  // mesh that the duplicate maps to, which is found earlier in the group.
+  std::unordered_map<size_t, std::vector<int>> hash_groups;
+  std::vector<int> group_position(num_meshes, -1);
+  for (int i = 0; i < num_meshes; ++i) {
+    if (!CanDeduplicateMesh(scene->GetMesh(MeshIndex(i)))) {
+      continue;
+    }
+    std::vector<int> &group = hash_groups[hashes[i]];
+    group_position[i] = static_cast<int>(group.size());
+    group.push_back(i);
+  }
+  IndexTypeVector<MeshIndex, MeshIndex> mesh_map(num_meshes);
+  pool.ParallelFor(num_meshes, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      mesh_map[MeshIndex(i)] = MeshIndex(i);
+      if (group_position[i] <= 0) {
+        continue;
+      }
+      const std::vector<int> &group = hash_groups.find(hashes[i])->second;
+      const Mesh &mesh = scene->GetMesh(MeshIndex(i));
+      for (int j = 0; j < group_position[i]; ++j) {
+        if (AreMeshesIdentical(scene->GetMesh(MeshIndex(group[j])), mesh)) {
+          mesh_map[MeshIndex(i)] = MeshIndex(group[j]);
+          break;
+        }
+      }
+    }
+  });
+
+  // Update the mesh groups and remove the duplicate meshes.
+  std::vector<bool> is_mesh_removed(num_meshes, false);
+  int num_removed_meshes = 0;
+  for (MeshIndex mi(0); mi < num_meshes; ++mi) {
+    if (mesh_map[mi] != mi) {
+      is_mesh_removed[mi.value()] = true;
+      num_removed_meshes++;
+    }
+  }
+  if (num_removed_meshes == 0) {
+    return 0;
+  }
+  for (MeshGroupIndex mgi(0); mgi < scene->NumMeshGroups(); ++mgi) {
+    scene->GetMeshGroup(mgi)->RemapMeshInstances(mesh_map);
+  }
+  DRACO_RETURN_IF_ERROR(scene->RemoveMeshes(is_mesh_removed));
+  return num_removed_meshes;
+}
+
+namespace {
+
+// Centroid and principal variances of mesh positions. The variances do not
+// change with rigid transformations and they are used to quickly reject meshes
+// that differ by more than a rigid transformation.
+struct RigidMeshFrame {
+  bool is_valid = false;
+  Eigen::Vector3d centroid;
+  // Variances of positions along the principal axes in ascending order.
+  Eigen::Vector3d variances;
+};
+
+// Returns true for attributes whose values change with the rotation of a mesh.
+bool IsRigidGeometryAttribute(GeometryAttribute::Type type) {
+  return type == GeometryAttribute::POSITION ||
+         type == GeometryAttribute::NORMAL ||
+         type == GeometryAttribute::TANGENT;
+}
+
+// Returns true if the |mesh| can be represented by a rigidly transformed
+// instance of another mesh.
+bool CanInstanceRigidMesh(const Mesh &mesh) {
+  if (!CanDeduplicateMesh(mesh) || mesh.num_faces() == 0 ||
+      mesh.NumNamedAttributes(GeometryAttribute::POSITION) != 1) {
+    return false;
+  }
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    const PointAttribute &att = *mesh.attribute(i);
+    if (att.attribute_type() == GeometryAttribute::JOINTS ||
+        att.attribute_type() == GeometryAttribute::WEIGHTS) {
+      // Skinned geometry is defined in the space of the joints.
+      return false;
+    }
+    if (IsRigidGeometryAttribute(att.attribute_type()) &&
+        (att.data_type() != DT_FLOAT32 || att.num_components() < 3 ||
+         att.num_components() > 4)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+RigidMeshFrame ComputeRigidMeshFrame(const Mesh &mesh) {
+  RigidMeshFrame frame;
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  if (pos_att->size() == 0) {
+    return frame;
+  }
+  Eigen::Vector3d centroid = Eigen::Vector3d::Zero();
+  for (AttributeValueIndex avi(0); avi < pos_att->size(); ++avi) {
+    float value[3];
+    pos_att->ConvertValue<float, 3>(avi, value);
+    centroid += Eigen::Vector3d(value[0], value[1], value[2]);
+  }
+  centroid /= static_cast<double>(pos_att->size());
+  Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+  for (AttributeValueIndex avi(0); avi < pos_att->size(); ++avi) {
+    float value[3];
+    pos_att->ConvertValue<float, 3>(avi, value);
+    const Eigen::Vector3d d =
+        Eigen::Vector3d(value[0], value[1], value[2]) - centroid;
+    covariance += d * d.transpose();
+  }
+  covariance /= static_cast<double>(pos_att->size());
+  const Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(
+      covariance, Eigen::EigenvaluesOnly);
+  if (solver.info() != Eigen::Success) {
+    return frame;
+  }
+  frame.is_valid = true;
+  frame.centroid = centroid;
+  frame.variances = solver.eigenvalues();
+  return frame;
+}
+
+// Returns a hash of the |mesh| that does not change with rigid transformations
+// of the mesh, i.e., a hash of the connectivity, attribute layouts, point to
+// value mappings and attribute values except for positions, normals and
+// tangents.
+uint64_t ComputeRigidMeshHash(const Mesh &mesh) {
+  const int32_t counts[3] = {static_cast<int32_t>(mesh.num_points()),
+                             static_cast<int32_t>(mesh.num_faces()),
+                             mesh.num_attributes()};
+  uint64_t hash = FingerprintData(counts, sizeof(counts), 0);
+  hash = FingerprintData(&mesh.face(FaceIndex(0))[0],
+                         mesh.num_faces() * sizeof(Mesh::Face), hash);
+  std::vector<uint32_t> indices;
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    const PointAttribute &att = *mesh.attribute(i);
+    const int32_t layout[5] = {
+        att.attribute_type(), att.data_type(), att.num_components(),
+        att.normalized(), static_cast<int32_t>(att.size())};
+    hash = FingerprintData(layout, sizeof(layout), hash);
+    if (!att.is_mapping_identity()) {
+      indices.resize(mesh.num_points());
+      for (PointIndex pi(0); pi < mesh.num_points(); ++pi) {
+        indices[pi.value()] = att.mapped_index(pi).value();
+      }
+      hash = FingerprintData(indices.data(), indices.size() * sizeof(uint32_t),
+                             hash);
+    }
+    if (!IsRigidGeometryAttribute(att.attribute_type())) {
+      const size_t value_size =
+          att.num_components() * DataTypeLength(att.data_type());
+      for (AttributeValueIndex avi(0); avi < att.size(); ++avi) {
+        hash = FingerprintData(att.GetAddress(avi), value_size, hash);
+      }
+    }
+  }
+  return hash;
+}
+
+// Returns true when |a| and |b| have the same data hashed by
+// ComputeRigidMeshHash() and the same compression settings.
+bool HaveSameRigidMeshStructure(const Mesh &a, const Mesh &b) {
+  if (a.num_faces() != b.num_faces() || a.num_points() != b.num_points() ||
+      a.num_attributes() != b.num_attributes() ||
+      a.IsCompressionEnabled() != b.IsCompressionEnabled() ||
+      !(a.GetCompressionOptions() == b.GetCompressionOptions())) {
+    return false;
+  }
+  for (FaceIndex fi(0); fi < a.num_faces(); ++fi) {
+    if (a.face(fi) != b.face(fi)) {
+      return false;
+    }
+  }
+  for (int i = 0; i < a.num_attributes(); ++i) {
+    const PointAttribute &att_a = *a.attribute(i);
+    const PointAttribute &att_b = *b.attribute(i);
+    if (att_a.attribute_type() != att_b.attribute_type() ||
+        att_a.data_type() != att_b.data_type() ||
+        att_a.num_components() != att_b.num_components() ||
+        att_a.normalized() != att_b.normalized() ||
+        att_a.size() != att_b.size()) {
+      return false;
+    }
+    for (PointIndex pi(0); pi < a.num_points(); ++pi) {
+      if (att_a.mapped_index(pi) != att_b.mapped_index(pi)) {
+        return false;
+      }
+    }
+    if (IsRigidGeometryAttribute(att_a.attribute_type())) {
+      continue;
+    }
+    const size_t value_size =
+        att_a.num_components() * DataTypeLength(att_a.data_type());
+    for (AttributeValueIndex avi(0); avi < att_a.size(); ++avi) {
+      if (memcmp(att_a.GetAddress(avi), att_b.GetAddress(avi), value_size) !=
+          0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Returns true when all positions, normals and tangents of |a| transformed by
+// |rotation| and |translation| match the corresponding values of |b|.
+bool AreRigidAttributesMatching(
+    const Mesh &a, const Mesh &b, const Eigen::Matrix3d &rotation,
+    const Eigen::Vector3d &translation, double position_tolerance,
+    const SceneUtils::RigidInstancingOptions &options) {
+  for (int i = 0; i < a.num_attributes(); ++i) {
+    const PointAttribute &att_a = *a.attribute(i);
+    const PointAttribute &att_b = *b.attribute(i);
+    if (!IsRigidGeometryAttribute(att_a.attribute_type())) {
+      continue;
+    }
+    const bool is_position =
+        att_a.attribute_type() == GeometryAttribute::POSITION;
+    for (AttributeValueIndex avi(0); avi < att_a.size(); ++avi) {
+      float value_a[4];
+      float value_b[4];
+      att_a.ConvertValue<float, 4>(avi, value_a);
+      att_b.ConvertValue<float, 4>(avi, value_b);
+      // The optional fourth component of tangents defines the handedness of
+      // the tangent space and it must not change.
+      if (att_a.num_components() == 4 && value_a[3] != value_b[3]) {
+        return false;
+      }
+      Eigen::Vector3d expected =
+          rotation * Eigen::Vector3d(value_a[0], value_a[1], value_a[2]);
+      if (is_position) {
+        expected += translation;
+      }
+      const double distance =
+          (expected - Eigen::Vector3d(value_b[0], value_b[1], value_b[2]))
+              .norm();
+      if (distance >
+          (is_position ? position_tolerance : options.normal_tolerance)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Finds a rigid transformation of mesh |a| to mesh |b|. Returns false if no
+// such transformation exists within the tolerances specified in |options|.
+bool FindRigidMeshTransform(const Mesh &a, const RigidMeshFrame &frame_a,
+                            const Mesh &b, const RigidMeshFrame &frame_b,
+                            const SceneUtils::RigidInstancingOptions &options,
+                            Eigen::Matrix4d *transform) {
+  constexpr double kRelativeVarianceTolerance = 1e-3;
+  const double total_variance = frame_a.variances.sum();
+  if ((frame_a.variances - frame_b.variances).cwiseAbs().maxCoeff() >
+      kRelativeVarianceTolerance * total_variance) {
+    return false;
+  }
+
+  // Positions of both meshes correspond to each other so the rotation that
+  // best aligns them is computed directly from their cross-covariance matrix
+  // (Kabsch algorithm).
+  const PointAttribute *const pos_a =
+      a.GetNamedAttribute(GeometryAttribute::POSITION);
+  const PointAttribute *const pos_b =
+      b.GetNamedAttribute(GeometryAttribute::POSITION);
+  Eigen::Matrix3d cross_covariance = Eigen::Matrix3d::Zero();
+  for (AttributeValueIndex avi(0); avi < pos_a->size(); ++avi) {
+    float value_a[3];
+    float value_b[3];
+    pos_a->ConvertValue<float, 3>(avi, value_a);
+    pos_b->ConvertValue<float, 3>(avi, value_b);
+    cross_covariance +=
+        (Eigen::Vector3d(value_a[0], value_a[1], value_a[2]) -
+         frame_a.centroid) *
+        (Eigen::Vector3d(value_b[0], value_b[1], value_b[2]) -
+         frame_b.centroid)
+            .transpose();
+  }
+  const Eigen::JacobiSVD<Eigen::Matrix3d> svd(
+      cross_covariance, Eigen::ComputeFullU | Eigen::ComputeFullV);
+  Eigen::Matrix3d v = svd.matrixV();
+  if ((v * svd.matrixU().transpose()).determinant() < 0.0) {
+    // Flip the axis with the smallest singular value to avoid reflections.
+    v.col(2) = -v.col(2);
+  }
+  const Eigen::Matrix3d rotation = v * svd.matrixU().transpose();
+  const Eigen::Vector3d translation =
+      frame_b.centroid - rotation * frame_a.centroid;
+  const double position_tolerance =
+      options.position_tolerance * std::sqrt(total_variance);
+  if (!AreRigidAttributesMatching(a, b, rotation, translation,
+                                  position_tolerance, options)) {
+    return false;
+  }
+  transform->setIdentity();
+  transform->block<3, 3>(0, 0) = rotation;
+  transform->block<3, 1>(0, 3) = translation;
+  return true;
+}
+
+// Returns the number of bytes used by attribute values and faces of |mesh|.
+int64_t ComputeMeshDataSize(const Mesh &mesh) {
+  int64_t size = static_cast<int64_t>(mesh.num_faces()) * sizeof(Mesh::Face);
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    const PointAttribute &att = *mesh.attribute(i);
+    size += static_cast<int64_t>(att.size()) * att.byte_stride();
+  }
+  return size;
+}
+
+}  // namespace
+
+StatusOr<SceneUtils::RigidInstancingStats> SceneUtils::InstanceRigidMeshes(
+    const RigidInstancingOptions &options, Scene *scene) {
+  RigidInstancingStats stats;
+  const int num_meshes = scene->NumMeshes();
+  const int num_mesh_groups = scene->NumMeshGroups();
+
+  // Collect nodes referencing each mesh group and find meshes that cannot be
+  // replaced because they are instanced by skinned nodes or instance arrays.
+  IndexTypeVector<MeshGroupIndex, std::vector<SceneNodeIndex>>
+      mesh_group_nodes(num_mesh_groups);
+  std::vector<bool> is_mesh_fixed(num_meshes, false);
+  for (SceneNodeIndex sni(0); sni < scene->NumNodes(); ++sni) {
+    const SceneNode &node = *scene->GetNode(sni);
+    const MeshGroupIndex mgi = node.GetMeshGroupIndex();
+    if (mgi == kInvalidMeshGroupIndex) {
+      continue;
+    }
+    if (mgi.value() >= static_cast<uint32_t>(num_mesh_groups)) {
+      return Status(Status::DRACO_ERROR, "Invalid mesh group index.");
+    }
+    mesh_group_nodes[mgi].push_back(sni);
+    if (node.GetSkinIndex() == kInvalidSkinIndex &&
+        node.GetInstanceArrayIndex() == kInvalidInstanceArrayIndex) {
+      continue;
+    }
+    const MeshGroup &mesh_group = *scene->GetMeshGroup(mgi);
+    for (int i = 0; i < mesh_group.NumMeshInstances(); ++i) {
+      const MeshIndex mi = mesh_group.GetMeshInstance(i).mesh_index;
+      if (mi != kInvalidMeshIndex &&
+          mi.value() < static_cast<uint32_t>(num_meshes)) {
+        is_mesh_fixed[mi.value()] = true;
+      }
+    }
+  }
+
+  // Compute principal axes and hashes of all meshes in parallel.
+  int num_threads = options.num_threads;
+  if (num_threads < 0) {
+    num_threads = ThreadPool::HardwareConcurrency() - 1;
+  }
+  ThreadPool pool(num_threads);
+  std::vector<RigidMeshFrame> frames(num_meshes);
+  std::vector<uint64_t> hashes(num_meshes, 0);
+  pool.ParallelFor(num_meshes, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      const Mesh &mesh = scene->GetMesh(MeshIndex(i));
+      if (!CanInstanceRigidMesh(mesh)) {
+        continue;
+      }
+      frames[i] = ComputeRigidMeshFrame(mesh);
+      if (frames[i].is_valid) {
+        hashes[i] = ComputeRigidMeshHash(mesh);
+      }
+    }
+  });
+
+  // Group meshes with equal hashes. Groups are processed in parallel and each
+  // mesh is compared with the meshes of its group that have not been replaced.
+  std::unordered_map<uint64_t, std::vector<int>> hash_to_meshes;
+  for (int i = 0; i < num_meshes; ++i) {
+    if (frames[i].is_valid) {
+      hash_to_meshes[hashes[i]].push_back(i);
+    }
+  }
+  std::vector<const std::vector<int> *> candidate_groups;
+  for (const auto &it : hash_to_meshes) {
+    if (it.second.size() > 1) {
+      candidate_groups.push_back(&it.second);
+    }
+  }
+  std::vector<int> source_mesh(num_meshes, -1);
+  std::vector<Eigen::Matrix4d> transforms(num_meshes);
+  pool.ParallelFor(
+      static_cast<int>(candidate_groups.size()), 1, [&](int begin, int end) {
+        for (int g = begin; g < end; ++g) {
+          std::vector<int> sources;
+          for (const int i : *candidate_groups[g]) {
+            const Mesh &mesh = scene->GetMesh(MeshIndex(i));
+            if (!is_mesh_fixed[i]) {
+              for (const int s : sources) {
+                const Mesh &source = scene->GetMesh(MeshIndex(s));
+                if (HaveSameRigidMeshStructure(source, mesh) &&
+                    FindRigidMeshTransform(source, frames[s], mesh, frames[i],
+                                           options, &transforms[i])) {
+                  source_mesh[i] = s;
+                  break;
+                }
+              }
+            }
+            if (source_mesh[i] == -1) {
+              sources.push_back(i);
+            }
+          }
+        }
+      });
+
+  IndexTypeVector<MeshIndex, MeshIndex> mesh_map(num_meshes);
+  std::vector<bool> is_mesh_replaced(num_meshes, false);
+  for (int i = 0; i < num_meshes; ++i) {
+    mesh_map[MeshIndex(i)] = MeshIndex(i);
+    if (source_mesh[i] != -1) {
+      mesh_map[MeshIndex(i)] = kInvalidMeshIndex;
+      is_mesh_replaced[i] = true;
+      stats.num_replaced_meshes++;
+      stats.num_saved_bytes +=
+          ComputeMeshDataSize(scene->GetMesh(MeshIndex(i)));
+    }
+  }
+  if (stats.num_replaced_meshes == 0) {
+    return stats;
+  }
+
+  // Move each instance of a replaced mesh into a new mesh group with an
+  // instance of the source mesh. The new mesh group is referenced by new child
+  // nodes of all nodes that referenced the original mesh group.
+  std::vector<bool> is_mesh_group_removed(num_mesh_groups, false);
+  for (MeshGroupIndex mgi(0); mgi < num_mesh_groups; ++mgi) {
+    MeshGroup *const mesh_group = scene->GetMeshGroup(mgi);
+    bool has_replaced_meshes = false;
+    for (int i = 0; i < mesh_group->NumMeshInstances(); ++i) {
+      MeshGroup::MeshInstance instance = mesh_group->GetMeshInstance(i);
+      if (instance.mesh_index == kInvalidMeshIndex ||
+          instance.mesh_index.value() >= static_cast<uint32_t>(num_meshes) ||
+          !is_mesh_replaced[instance.mesh_index.value()]) {
+        continue;
+      }
+      has_replaced_meshes = true;
+      const int mesh_index = instance.mesh_index.value();
+      const MeshGroupIndex new_mgi = scene->AddMeshGroup();
+      MeshGroup *const new_mesh_group = scene->GetMeshGroup(new_mgi);
+      new_mesh_group->SetName(scene->GetMesh(instance.mesh_index).GetName());
+      instance.mesh_index = MeshIndex(source_mesh[mesh_index]);
+      new_mesh_group->AddMeshInstance(instance);
+      TrsMatrix trs_matrix;
+      trs_matrix.SetMatrix(transforms[mesh_index]);
+      for (const SceneNodeIndex &sni : mesh_group_nodes[mgi]) {
+        const SceneNodeIndex child_index = scene->AddNode();
+        SceneNode *const child = scene->GetNode(child_index);
+        child->SetTrsMatrix(trs_matrix);
+        child->SetMeshGroupIndex(new_mgi);
+        child->AddParentIndex(sni);
+        scene->GetNode(sni)->AddChildIndex(child_index);
+      }
+    }
+    if (has_replaced_meshes) {
+      mesh_group->RemapMeshInstances(mesh_map);
+      is_mesh_group_removed[mgi.value()] = mesh_group->NumMeshInstances() == 0;
+    }
+  }
+
+  // Remove mesh groups that became empty and the replaced meshes.
+  is_mesh_group_removed.resize(scene->NumMeshGroups(), false);
+  DRACO_RETURN_IF_ERROR(scene->RemoveMeshGroups(is_mesh_group_removed));
+  DRACO_RETURN_IF_ERROR(scene->RemoveMeshes(is_mesh_replaced));
+  return stats;
+}
+
 void SceneUtils::SetDracoCompressionOptions(
     const DracoCompressionOptions *options, Scene *scene) {
   for (MeshIndex i(0); i < scene->NumMeshes(); ++i) {
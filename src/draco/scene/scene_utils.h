@@ -19,6 +19,7 @@
 
 #ifdef DRACO_TRANSCODER_SUPPORTED
 #include "draco/attributes/geometry_attribute.h"
+#include "draco/mesh/mesh_cleanup.h"
 #include "draco/scene/scene.h"
 
 namespace draco {
@@ -119,6 +120,21 @@ class SceneUtils {
   static StatusOr<std::unique_ptr<Mesh>> InstantiateMesh(
       const Scene &scene, const MeshInstance &instance);
 
+  // Creates a single mesh containing all mesh instances of the |scene| with
+  // their transformations applied to positions, normals and tangents. All
+  // instanced base meshes must have the same number of attributes of each type
+  // with matching data types and number of components. Positions must be
+  // stored as three 32-bit floats and normals and tangents as three or four
+  // 32-bit floats, otherwise an error is returned. The output mesh gets a
+  // copy of the scene material library and, if the scene has multiple
+  // materials, a MATERIAL attribute with material indices of the instances.
+  // Mesh features, property attributes and metadata are not copied. The output
+  // is allocated up front and the instances are copied into it in parallel by
+  // |num_threads| worker threads in addition to the calling thread. Negative
+  // |num_threads| uses all available hardware threads.
+  static StatusOr<std::unique_ptr<Mesh>> FlattenScene(const Scene &scene,
+                                                      int num_threads);
+
   // Cleans up a |scene| by removing unused base meshes, unused and empty mesh
   // groups, unused materials, unused texture coordinates and unused scene
   // nodes. The actual behavior of the cleanup operation can be controller via
@@ -142,6 +158,53 @@ class SceneUtils {
   // exactly the same meshes and materials.
   static void DeduplicateMeshGroups(Scene *scene);
 
+  // Runs MeshCleanup::Cleanup() with |options| on all base meshes of the
+  // |scene|. The meshes are processed in parallel by |num_threads| worker
+  // threads in addition to the calling thread. Negative |num_threads| uses all
+  // available hardware threads.
+  static Status CleanupMeshes(const MeshCleanupOptions &options,
+                              int num_threads, Scene *scene);
+
+  // Removes base meshes that are identical to other base meshes of the
+  // |scene| and updates the mesh groups to reference the first of the
+  // identical meshes. The meshes are matched using content hashes that are
+  // computed in parallel by |num_threads| worker threads (see CleanupMeshes())
+  // and the matches are then verified by a full comparison. Meshes with mesh
+  // features, property attributes or metadata are never removed. Returns the
+  // number of removed meshes.
+  static StatusOr<int> DeduplicateMeshes(int num_threads, Scene *scene);
+
+  // Replaces base meshes that are equal to other base meshes up to a rigid
+  // transformation (rotation and translation) by instances of the other
+  // meshes. Candidate meshes are found by hashing their connectivity and
+  // non-geometric attribute values and by comparing the principal variances
+  // of their positions. The rigid transformation is computed from the
+  // corresponding positions and it is verified against all positions, normals
+  // and tangents. Each replaced mesh instance is moved into a new mesh group
+  // referenced by a new child node with the rigid transformation of every node
+  // that referenced the original mesh instance. Meshes with skinning
+  // attributes, mesh features, property attributes or metadata and meshes
+  // instanced via skinned nodes or instance arrays are never replaced.
+  struct RigidInstancingOptions {
+    // Maximum allowed distance between corresponding positions relative to
+    // the root-mean-square radius of the mesh.
+    double position_tolerance = 1e-4;
+    // Maximum allowed distance between corresponding normals and tangents.
+    double normal_tolerance = 1e-3;
+    // Number of worker threads in addition to the calling thread. Negative
+    // value uses all available hardware threads.
+    int num_threads = -1;
+  };
+  struct RigidInstancingStats {
+    // Number of base meshes that were replaced by instances.
+    int num_replaced_meshes = 0;
+    // Number of uncompressed bytes of attribute values and faces of the
+    // replaced base meshes.
+    int64_t num_saved_bytes = 0;
+  };
+  static StatusOr<RigidInstancingStats> InstanceRigidMeshes(
+      const RigidInstancingOptions &options, Scene *scene);
+
   // Enables geometry compression and sets compression |options| to all meshes
   // in the |scene|. If |options| is nullptr then geometry compression is
   // disabled for all meshes in the |scene|.
@@ -14,6 +14,7 @@
 //
 #include "draco/scene/scene_utils.h"
 
+#include <array>
 #include <string>
 #include <utility>
 
@@ -22,6 +23,10 @@
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
 #include "draco/io/texture_io.h"
+#include "draco/mesh/mesh_are_equivalent.h"
+#include "draco/mesh/mesh_cleanup.h"
+#include "draco/mesh/mesh_utils.h"
+#include "draco/mesh/triangle_soup_mesh_builder.h"
 #include "draco/metadata/property_table.h"
 #include "draco/metadata/structural_metadata.h"
 #include "draco/scene/scene_indices.h"
@@ -37,6 +42,42 @@ void AssertMatrixNear(const Eigen::Matrix4d &a, const Eigen::Matrix4d &b,
   ASSERT_NEAR(diff.norm(), 0.f, tolerance) << a << " vs " << b;
 }
 
+// Returns a single triangle mesh with float positions and one more attribute
+// of |att_type| with zero values stored in the given format.
+std::unique_ptr<draco::Mesh> CreateTriangleMesh(
+    draco::GeometryAttribute::Type att_type, int8_t num_components,
+    draco::DataType data_type) {
+  draco::TriangleSoupMeshBuilder builder;
+  builder.Start(1);
+  const int pos_att_id = builder.AddAttribute(
+      draco::GeometryAttribute::POSITION, 3, draco::DT_FLOAT32);
+  const int att_id = builder.AddAttribute(att_type, num_components, data_type);
+  const std::array<float, 3> p0 = {0.f, 0.f, 0.f};
+  const std::array<float, 3> p1 = {1.f, 0.f, 0.f};
+  const std::array<float, 3> p2 = {0.f, 1.f, 0.f};
+  builder.SetAttributeValuesForFace(pos_att_id, draco::FaceIndex(0),
+                                    p0.data(), p1.data(), p2.data());
+  const std::array<uint8_t, 32> value = {};
+  builder.SetAttributeValuesForFace(att_id, draco::FaceIndex(0), value.data(),
+                                    value.data(), value.data());
+  return builder.Finalize();
+}
+
+// Adds |mesh| to |scene| and instances it under a new root node with the given
+// |transform|.
+void AddMeshInstance(std::unique_ptr<draco::Mesh> mesh,
+                     const Eigen::Matrix4d &transform, draco::Scene *scene) {
+  const MeshIndex mesh_index = scene->AddMesh(std::move(mesh));
+  const draco::MeshGroupIndex mgi = scene->AddMeshGroup();
+  scene->GetMeshGroup(mgi)->AddMeshInstance({mesh_index, 0});
+  const draco::SceneNodeIndex sni = scene->AddNode();
+  scene->GetNode(sni)->SetMeshGroupIndex(mgi);
+  draco::TrsMatrix trs;
+  trs.SetMatrix(transform);
+  scene->GetNode(sni)->SetTrsMatrix(trs);
+  scene->AddRootNodeIndex(sni);
+}
+
 // TODO(fgalligan): Re-factor this code with gltf_encoder_test.
 void CompareScenes(const draco::Scene *scene0, const draco::Scene *scene1) {
   ASSERT_EQ(scene0->NumMeshGroups(), scene1->NumMeshGroups());
@@ -677,6 +718,278 @@ TEST(SceneUtilsTest, TestDeduplicateMeshGroups) {
   ASSERT_EQ(draco::SceneUtils::ComputeAllInstances(*scene).size(), 7);
 }
 
+TEST(SceneUtilsTest, TestDeduplicateMeshes) {
+  // Tests that identical base meshes are merged and that the mesh groups are
+  // updated to reference the remaining mesh.
+  auto scene =
+      draco::ReadSceneFromTestFile("CesiumMilkTruck/glTF/CesiumMilkTruck.gltf");
+  ASSERT_NE(scene, nullptr);
+  ASSERT_EQ(scene->NumMeshes(), 4);
+  const size_t num_instances =
+      draco::SceneUtils::ComputeAllInstances(*scene).size();
+
+  // Nothing should be removed from the original scene.
+  DRACO_ASSIGN_OR_ASSERT(int num_removed,
+                         draco::SceneUtils::DeduplicateMeshes(-1, scene.get()));
+  ASSERT_EQ(num_removed, 0);
+  ASSERT_EQ(scene->NumMeshes(), 4);
+
+  // Add two copies of the second mesh, one of them modified, and reference
+  // both copies from the first mesh group.
+  std::unique_ptr<draco::Mesh> copy(new draco::Mesh());
+  copy->Copy(scene->GetMesh(MeshIndex(1)));
+  std::unique_ptr<draco::Mesh> modified_copy(new draco::Mesh());
+  modified_copy->Copy(scene->GetMesh(MeshIndex(1)));
+  modified_copy->SetName("modified");
+  const MeshIndex copy_index = scene->AddMesh(std::move(copy));
+  const MeshIndex modified_index = scene->AddMesh(std::move(modified_copy));
+  draco::MeshGroup *const mesh_group =
+      scene->GetMeshGroup(draco::MeshGroupIndex(0));
+  mesh_group->AddMeshInstance({copy_index, 0});
+  mesh_group->AddMeshInstance({modified_index, 0});
+  const int num_mesh_instances = mesh_group->NumMeshInstances();
+
+  DRACO_ASSIGN_OR_ASSERT(num_removed,
+                         draco::SceneUtils::DeduplicateMeshes(-1, scene.get()));
+  ASSERT_EQ(num_removed, 1);
+  ASSERT_EQ(scene->NumMeshes(), 5);
+  ASSERT_EQ(mesh_group->NumMeshInstances(), num_mesh_instances);
+  ASSERT_EQ(mesh_group->GetMeshInstance(num_mesh_instances - 2).mesh_index,
+            MeshIndex(1));
+  ASSERT_EQ(mesh_group->GetMeshInstance(num_mesh_instances - 1).mesh_index,
+            MeshIndex(4));
+  ASSERT_EQ(scene->GetMesh(MeshIndex(4)).GetName(), "modified");
+  ASSERT_GT(draco::SceneUtils::ComputeAllInstances(*scene).size(),
+            num_instances);
+}
+
+TEST(SceneUtilsTest, TestCleanupMeshes) {
+  // Tests that cleaning up base meshes in parallel gives the same result as
+  // cleaning up each mesh serially.
+  draco::Scene scene;
+  std::vector<std::unique_ptr<draco::Mesh>> expected_meshes;
+  for (int m = 0; m < 5; ++m) {
+    // Every third face of the mesh is degenerate.
+    const int num_faces = 4 + m;
+    draco::TriangleSoupMeshBuilder builder;
+    builder.Start(num_faces);
+    const int pos_att_id = builder.AddAttribute(
+        draco::GeometryAttribute::POSITION, 3, draco::DT_FLOAT32);
+    for (int f = 0; f < num_faces; ++f) {
+      const float x = static_cast<float>(f);
+      const std::array<float, 3> p0 = {x, 0.f, 0.f};
+      const std::array<float, 3> p1 = {x + 1.f, 0.f, 0.f};
+      const std::array<float, 3> p2 = {x, 1.f, 0.f};
+      if (f % 3 == 0) {
+        builder.SetAttributeValuesForFace(pos_att_id, draco::FaceIndex(f),
+                                          p0.data(), p0.data(), p0.data());
+      } else {
+        builder.SetAttributeValuesForFace(pos_att_id, draco::FaceIndex(f),
+                                          p0.data(), p1.data(), p2.data());
+      }
+    }
+    std::unique_ptr<draco::Mesh> mesh = builder.Finalize();
+    ASSERT_NE(mesh, nullptr);
+    std::unique_ptr<draco::Mesh> expected_mesh(new draco::Mesh());
+    expected_mesh->Copy(*mesh);
+    DRACO_ASSERT_OK(draco::MeshCleanup::Cleanup(expected_mesh.get(),
+                                                draco::MeshCleanupOptions()));
+    ASSERT_LT(expected_mesh->num_faces(), mesh->num_faces());
+    expected_meshes.push_back(std::move(expected_mesh));
+    AddMeshInstance(std::move(mesh), Eigen::Matrix4d::Identity(), &scene);
+  }
+
+  DRACO_ASSERT_OK(draco::SceneUtils::CleanupMeshes(draco::MeshCleanupOptions(),
+                                                   2, &scene));
+  ASSERT_EQ(scene.NumMeshes(), expected_meshes.size());
+  for (MeshIndex i(0); i < scene.NumMeshes(); ++i) {
+    const draco::Mesh &mesh = scene.GetMesh(i);
+    const draco::Mesh &expected_mesh = *expected_meshes[i.value()];
+    ASSERT_EQ(mesh.num_faces(), expected_mesh.num_faces());
+    ASSERT_EQ(mesh.num_points(), expected_mesh.num_points());
+    ASSERT_EQ(mesh.num_attributes(), expected_mesh.num_attributes());
+    draco::MeshAreEquivalent equiv;
+    ASSERT_TRUE(equiv(mesh, expected_mesh));
+  }
+}
+
+TEST(SceneUtilsTest, TestInstanceRigidMeshes) {
+  // Tests that a rigidly transformed copy of a mesh is replaced by an instance
+  // of the original mesh and that a scaled copy is kept.
+  std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("bunny_norm.obj");
+  ASSERT_NE(mesh, nullptr);
+  DRACO_ASSIGN_OR_ASSERT(auto scene,
+                         draco::SceneUtils::MeshToScene(std::move(mesh)));
+  ASSERT_EQ(scene->NumMeshes(), 1);
+
+  Eigen::Matrix4d rigid_transform = Eigen::Matrix4d::Identity();
+  rigid_transform.block<3, 3>(0, 0) =
+      Eigen::AngleAxisd(0.7, Eigen::Vector3d(1.0, 2.0, 3.0).normalized())
+          .toRotationMatrix();
+  rigid_transform.block<3, 1>(0, 3) = Eigen::Vector3d(1.0, -2.0, 0.5);
+  Eigen::Matrix4d scale_transform = Eigen::Matrix4d::Identity();
+  scale_transform.block<3, 3>(0, 0) *= 1.1;
+
+  // Add transformed copies of the mesh, each referenced by a new root node.
+  std::unique_ptr<draco::Mesh> rigid_copy(new draco::Mesh());
+  for (const Eigen::Matrix4d &transform : {rigid_transform, scale_transform}) {
+    std::unique_ptr<draco::Mesh> copy(new draco::Mesh());
+    copy->Copy(scene->GetMesh(MeshIndex(0)));
+    draco::MeshUtils::TransformMesh(transform, copy.get());
+    if (rigid_copy->num_points() == 0) {
+      rigid_copy->Copy(*copy);
+    }
+    const MeshIndex mesh_index = scene->AddMesh(std::move(copy));
+    const draco::MeshGroupIndex mgi = scene->AddMeshGroup();
+    scene->GetMeshGroup(mgi)->AddMeshInstance({mesh_index, 0});
+    const draco::SceneNodeIndex sni = scene->AddNode();
+    scene->GetNode(sni)->SetMeshGroupIndex(mgi);
+    scene->AddRootNodeIndex(sni);
+  }
+  ASSERT_EQ(scene->NumMeshes(), 3);
+  int64_t mesh_size = rigid_copy->num_faces() * sizeof(draco::Mesh::Face);
+  for (int i = 0; i < rigid_copy->num_attributes(); ++i) {
+    const draco::PointAttribute &att = *rigid_copy->attribute(i);
+    mesh_size += att.size() * att.byte_stride();
+  }
+
+  DRACO_ASSIGN_OR_ASSERT(
+      const auto stats,
+      draco::SceneUtils::InstanceRigidMeshes({}, scene.get()));
+  ASSERT_EQ(stats.num_replaced_meshes, 1);
+  ASSERT_EQ(stats.num_saved_bytes, mesh_size);
+  ASSERT_EQ(scene->NumMeshes(), 2);
+
+  // The rigid copy is now an instance of the original mesh placed by a child
+  // node of the node that referenced the copy.
+  const auto instances = draco::SceneUtils::ComputeAllInstances(*scene);
+  ASSERT_EQ(instances.size(), 3);
+  int num_original_mesh_instances = 0;
+  for (draco::MeshInstanceIndex i(0); i < instances.size(); ++i) {
+    if (instances[i].mesh_index != MeshIndex(0)) {
+      continue;
+    }
+    num_original_mesh_instances++;
+    if (instances[i].transform.isIdentity()) {
+      continue;
+    }
+    DRACO_ASSIGN_OR_ASSERT(
+        auto instance_mesh,
+        draco::SceneUtils::InstantiateMesh(*scene, instances[i]));
+    ASSERT_EQ(instance_mesh->num_points(), rigid_copy->num_points());
+    const draco::PointAttribute *const pos =
+        instance_mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+    const draco::PointAttribute *const expected_pos =
+        rigid_copy->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+    for (draco::PointIndex pi(0); pi < rigid_copy->num_points(); ++pi) {
+      const auto value = pos->GetValue<float, 3>(pos->mapped_index(pi));
+      const auto expected_value =
+          expected_pos->GetValue<float, 3>(expected_pos->mapped_index(pi));
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_NEAR(value[c], expected_value[c], 1e-4);
+      }
+    }
+  }
+  ASSERT_EQ(num_original_mesh_instances, 2);
+}
+
+TEST(SceneUtilsTest, TestFlattenScene) {
+  // Tests that all mesh instances of a scene are flattened into a single mesh
+  // that matches the individually instantiated meshes.
+  auto scene =
+      draco::ReadSceneFromTestFile("CubeScaledInstances/glTF/cube_att.gltf");
+  ASSERT_NE(scene, nullptr);
+  const auto instances = draco::SceneUtils::ComputeAllInstances(*scene);
+  ASSERT_EQ(instances.size(), 4);
+
+  DRACO_ASSIGN_OR_ASSERT(auto mesh,
+                         draco::SceneUtils::FlattenScene(*scene, 2));
+  ASSERT_EQ(mesh->num_faces(),
+            draco::SceneUtils::NumFacesOnInstancedMeshes(*scene));
+  ASSERT_EQ(mesh->num_points(),
+            draco::SceneUtils::NumPointsOnInstancedMeshes(*scene));
+  ASSERT_EQ(mesh->num_attributes(),
+            scene->GetMesh(MeshIndex(0)).num_attributes());
+
+  // Check that each instance is stored in the flattened mesh.
+  draco::PointIndex::ValueType point_offset = 0;
+  draco::FaceIndex::ValueType face_offset = 0;
+  for (draco::MeshInstanceIndex i(0); i < instances.size(); ++i) {
+    DRACO_ASSIGN_OR_ASSERT(
+        auto instance_mesh,
+        draco::SceneUtils::InstantiateMesh(*scene, instances[i]));
+    for (draco::FaceIndex fi(0); fi < instance_mesh->num_faces(); ++fi) {
+      const auto &face = mesh->face(draco::FaceIndex(face_offset + fi.value()));
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_EQ(face[c].value(),
+                  instance_mesh->face(fi)[c].value() + point_offset);
+      }
+    }
+    for (int a = 0; a < mesh->num_attributes(); ++a) {
+      const draco::PointAttribute *const att = mesh->attribute(a);
+      const draco::PointAttribute *const instance_att =
+          instance_mesh->attribute(a);
+      ASSERT_EQ(att->attribute_type(), instance_att->attribute_type());
+      for (draco::PointIndex pi(0); pi < instance_mesh->num_points(); ++pi) {
+        std::array<float, 4> value = {0.f, 0.f, 0.f, 0.f};
+        std::array<float, 4> instance_value = {0.f, 0.f, 0.f, 0.f};
+        att->ConvertValue<float>(
+            att->mapped_index(draco::PointIndex(point_offset + pi.value())),
+            att->num_components(), value.data());
+        instance_att->ConvertValue<float>(instance_att->mapped_index(pi),
+                                          instance_att->num_components(),
+                                          instance_value.data());
+        for (int c = 0; c < 4; ++c) {
+          ASSERT_NEAR(value[c], instance_value[c], 1e-6);
+        }
+      }
+    }
+    point_offset += instance_mesh->num_points();
+    face_offset += instance_mesh->num_faces();
+  }
+}
+
+TEST(SceneUtilsTest, TestFlattenSceneDifferentAttributeTypes) {
+  // Tests that meshes with the same number of attributes but different
+  // attribute types cannot be flattened.
+  draco::Scene scene;
+  AddMeshInstance(CreateTriangleMesh(draco::GeometryAttribute::TEX_COORD, 2,
+                                     draco::DT_FLOAT32),
+                  Eigen::Matrix4d::Identity(), &scene);
+  AddMeshInstance(CreateTriangleMesh(draco::GeometryAttribute::COLOR, 2,
+                                     draco::DT_FLOAT32),
+                  Eigen::Matrix4d::Identity(), &scene);
+  ASSERT_FALSE(draco::SceneUtils::FlattenScene(scene, 2).ok());
+}
+
+TEST(SceneUtilsTest, TestFlattenSceneUnsupportedNormals) {
+  // Tests that meshes with normals that cannot be transformed are rejected
+  // instead of being flattened with untransformed normals.
+  Eigen::Matrix4d transform = Eigen::Matrix4d::Identity();
+  transform(0, 3) = 1.0;
+  draco::Scene scene;
+  AddMeshInstance(
+      CreateTriangleMesh(draco::GeometryAttribute::NORMAL, 3, draco::DT_INT16),
+      Eigen::Matrix4d::Identity(), &scene);
+  AddMeshInstance(
+      CreateTriangleMesh(draco::GeometryAttribute::NORMAL, 3, draco::DT_INT16),
+      transform, &scene);
+  ASSERT_FALSE(draco::SceneUtils::FlattenScene(scene, 2).ok());
+
+  // The same meshes with float normals can be flattened.
+  draco::Scene float_scene;
+  AddMeshInstance(CreateTriangleMesh(draco::GeometryAttribute::NORMAL, 3,
+                                     draco::DT_FLOAT32),
+                  Eigen::Matrix4d::Identity(), &float_scene);
+  AddMeshInstance(CreateTriangleMesh(draco::GeometryAttribute::NORMAL, 3,
+                                     draco::DT_FLOAT32),
+                  transform, &float_scene);
+  DRACO_ASSIGN_OR_ASSERT(auto mesh,
+                         draco::SceneUtils::FlattenScene(float_scene, 2));
+  ASSERT_EQ(mesh->num_faces(), 2);
+}
+
 TEST(SceneUtilsTest, TestCleanupUnusedTexCoordsNoTextures) {
   // The glTF file has two tex coords that are unused because the materials do
   // not reference any textures.
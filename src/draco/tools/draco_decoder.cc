@@ -29,9 +29,11 @@ struct Options {
 
   std::string input;
   std::string output;
+  bool reorder_mesh;
+  bool print_stats;
 };
 
-Options::Options() {}
+Options::Options() : reorder_mesh(false), print_stats(false) {}
 
 void Usage() {
   printf("Usage: draco_decoder [options] -i input\n");
@@ -39,6 +41,13 @@ void Usage() {
   printf("Main options:\n");
   printf("  -h | -?               show help.\n");
   printf("  -o <output>           output file name.\n");
+  printf(
+      "  -reorder              reorder decoded mesh faces and vertices for "
+      "better\n"
+      "                        vertex cache locality.\n");
+  printf(
+      "  -stats                print time and size of the decoding stages.\n"
+      "                        Requires DRACO_INSTRUMENTATION build option.\n");
 }
 
 int ReturnError(const draco::Status &status) {
@@ -60,6 +69,10 @@ int main(int argc, char **argv) {
       options.input = argv[++i];
     } else if (!strcmp("-o", argv[i]) && i < argc_check) {
       options.output = argv[++i];
+    } else if (!strcmp("-reorder", argv[i])) {
+      options.reorder_mesh = true;
+    } else if (!strcmp("-stats", argv[i])) {
+      options.print_stats = true;
     }
   }
   if (argc < 3 || options.input.empty()) {
@@ -83,6 +96,7 @@ int main(int argc, char **argv) {
   buffer.Init(data.data(), data.size());
 
   draco::CycleTimer timer;
+  draco::Decoder decoder;
   // Decode the input data into a geometry.
   std::unique_ptr<draco::PointCloud> pc;
   draco::Mesh *mesh = nullptr;
@@ -93,7 +107,7 @@ int main(int argc, char **argv) {
   const draco::EncodedGeometryType geom_type = type_statusor.value();
   if (geom_type == draco::TRIANGULAR_MESH) {
     timer.Start();
-    draco::Decoder decoder;
+    decoder.SetOptimizeVertexCache(options.reorder_mesh);
     auto statusor = decoder.DecodeMeshFromBuffer(&buffer);
     if (!statusor.ok()) {
       return ReturnError(statusor.status());
@@ -107,7 +121,6 @@ int main(int argc, char **argv) {
   } else if (geom_type == draco::POINT_CLOUD) {
     // Failed to decode it as mesh, so let's try to decode it as a point cloud.
     timer.Start();
-    draco::Decoder decoder;
     auto statusor = decoder.DecodePointCloudFromBuffer(&buffer);
     if (!statusor.ok()) {
       return ReturnError(statusor.status());
@@ -176,5 +189,14 @@ int main(int argc, char **argv) {
   }
   printf("Decoded geometry saved to %s (%" PRId64 " ms to decode)\n",
          options.output.c_str(), timer.GetInMs());
+  if (options.print_stats) {
+    if (draco::CodingStats::IsSupported()) {
+      printf("\n%s", decoder.stats().ToString().c_str());
+    } else {
+      printf(
+          "Decoding stats are not available. Rebuild Draco with "
+          "DRACO_INSTRUMENTATION enabled.\n");
+    }
+  }
   return 0;
 }
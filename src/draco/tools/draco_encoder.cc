@@ -13,15 +13,19 @@
 // limitations under the License.
 //
 #include <cinttypes>
+#include <cstdio>
 #include <cstdlib>
+#include <memory>
 
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/encode.h"
 #include "draco/compression/expert_encode.h"
 #include "draco/core/cycle_timer.h"
 #include "draco/io/file_utils.h"
+#include "draco/io/file_writer_factory.h"
 #include "draco/io/mesh_io.h"
 #include "draco/io/point_cloud_io.h"
+#include "draco/mesh/mesh_reorderer.h"
 
 namespace {
 
@@ -39,6 +43,10 @@ struct Options {
   int compression_level;
   bool preserve_polygons;
   bool use_metadata;
+  bool reorder_mesh;
+  bool optimize_attributes;
+  bool context_modeling;
+  bool print_stats;
   std::string input;
   std::string output;
 };
@@ -54,7 +62,11 @@ Options::Options()
       generic_deleted(false),
       compression_level(7),
       preserve_polygons(false),
-      use_metadata(false) {}
+      use_metadata(false),
+      reorder_mesh(false),
+      optimize_attributes(false),
+      context_modeling(false),
+      print_stats(false) {}
 
 void Usage() {
   printf("Usage: draco_encoder [options] -i input\n");
@@ -91,6 +103,22 @@ void Usage() {
   // mesh and polygon reconstruction information is encoded into a new generic
   // attribute.
   printf("  -preserve_polygons    encode polygon info as an attribute.\n");
+  printf(
+      "  -reorder              reorder mesh faces and vertices for better "
+      "cache locality.\n");
+  printf(
+      "  -optimize             search for the per-attribute settings that "
+      "result\n"
+      "                        in the smallest output.\n");
+  printf(
+      "  -context_modeling     allow context modeling in the entropy coding "
+      "of\n"
+      "                        attribute values (usually only 1-5%% "
+      "smaller, not\n"
+      "                        supported by older decoders).\n");
+  printf(
+      "  -stats                print time and size of the encoding stages.\n"
+      "                        Requires DRACO_INSTRUMENTATION build option.\n");
 
   printf(
       "\nUse negative quantization values to skip the specified attribute\n");
@@ -146,27 +174,60 @@ void PrintOptions(const draco::PointCloud &pc, const Options &options) {
   printf("\n");
 }
 
+// Encodes the geometry of |encoder| into |file|. The encoded data is streamed
+// into a temporary file that replaces |file| only when the encoding and all
+// writes succeed, so that a failed encoding doesn't leave a truncated output.
+draco::Status EncodeToFile(const std::string &file,
+                           draco::ExpertEncoder *encoder,
+                           size_t *encoded_size) {
+  const std::string temp_file = file + ".tmp";
+  std::unique_ptr<draco::FileWriterInterface> file_writer =
+      draco::FileWriterFactory::OpenWriter(temp_file);
+  if (file_writer == nullptr) {
+    return draco::Status(draco::Status::IO_ERROR,
+                         "Failed to create the output file.");
+  }
+  draco::EncoderBuffer buffer;
+  draco::SetEncoderBufferFileWriter(file_writer.get(), &buffer);
+  draco::Status status = encoder->EncodeToBuffer(&buffer);
+  if (status.ok() && !file_writer->Close()) {
+    status = draco::Status(draco::Status::IO_ERROR,
+                           "Failed to write the output file.");
+  }
+  file_writer.reset();
+  if (status.ok()) {
+    // On some platforms rename() fails when |file| already exists.
+    if (std::rename(temp_file.c_str(), file.c_str()) != 0 &&
+        (std::remove(file.c_str()) != 0 ||
+         std::rename(temp_file.c_str(), file.c_str()) != 0)) {
+      status = draco::Status(draco::Status::IO_ERROR,
+                             "Failed to write the output file.");
+    }
+  }
+  if (!status.ok()) {
+    std::remove(temp_file.c_str());
+    return status;
+  }
+  *encoded_size = buffer.num_flushed_bytes();
+  return status;
+}
+
 int EncodePointCloudToFile(const draco::PointCloud &pc, const std::string &file,
                            draco::ExpertEncoder *encoder) {
   draco::CycleTimer timer;
   // Encode the geometry.
-  draco::EncoderBuffer buffer;
+  size_t encoded_size = 0;
   timer.Start();
-  const draco::Status status = encoder->EncodeToBuffer(&buffer);
+  const draco::Status status = EncodeToFile(file, encoder, &encoded_size);
   if (!status.ok()) {
     printf("Failed to encode the point cloud.\n");
     printf("%s\n", status.error_msg());
     return -1;
   }
   timer.Stop();
-  // Save the encoded geometry into a file.
-  if (!draco::WriteBufferToFile(buffer.data(), buffer.size(), file)) {
-    printf("Failed to write the output file.\n");
-    return -1;
-  }
   printf("Encoded point cloud saved to %s (%" PRId64 " ms to encode).\n",
          file.c_str(), timer.GetInMs());
-  printf("\nEncoded size = %zu bytes\n\n", buffer.size());
+  printf("\nEncoded size = %zu bytes\n\n", encoded_size);
   return 0;
 }
 
@@ -174,23 +235,18 @@ int EncodeMeshToFile(const draco::Mesh &mesh, const std::string &file,
                      draco::ExpertEncoder *encoder) {
   draco::CycleTimer timer;
   // Encode the geometry.
-  draco::EncoderBuffer buffer;
+  size_t encoded_size = 0;
   timer.Start();
-  const draco::Status status = encoder->EncodeToBuffer(&buffer);
+  const draco::Status status = EncodeToFile(file, encoder, &encoded_size);
   if (!status.ok()) {
     printf("Failed to encode the mesh.\n");
     printf("%s\n", status.error_msg());
     return -1;
   }
   timer.Stop();
-  // Save the encoded geometry into a file.
-  if (!draco::WriteBufferToFile(buffer.data(), buffer.size(), file)) {
-    printf("Failed to create the output file.\n");
-    return -1;
-  }
   printf("Encoded mesh saved to %s (%" PRId64 " ms to encode).\n", file.c_str(),
          timer.GetInMs());
-  printf("\nEncoded size = %zu bytes\n\n", buffer.size());
+  printf("\nEncoded size = %zu bytes\n\n", encoded_size);
   return 0;
 }
 
@@ -260,6 +316,14 @@ int main(int argc, char **argv) {
       options.use_metadata = true;
     } else if (!strcmp("-preserve_polygons", argv[i])) {
       options.preserve_polygons = true;
+    } else if (!strcmp("-reorder", argv[i])) {
+      options.reorder_mesh = true;
+    } else if (!strcmp("-optimize", argv[i])) {
+      options.optimize_attributes = true;
+    } else if (!strcmp("-context_modeling", argv[i])) {
+      options.context_modeling = true;
+    } else if (!strcmp("-stats", argv[i])) {
+      options.print_stats = true;
     }
   }
   if (argc < 3 || options.input.empty()) {
@@ -334,6 +398,25 @@ int main(int argc, char **argv) {
   }
 #endif
 
+  if (mesh && options.reorder_mesh) {
+    const draco::MeshReordererOptions reorder_options;
+    const draco::MeshVertexCacheStats stats_before =
+        draco::MeshReorderer::ComputeVertexCacheStats(
+            *mesh, reorder_options.cache_size);
+    const draco::Status status =
+        draco::MeshReorderer::Reorder(mesh, reorder_options);
+    if (!status.ok()) {
+      printf("Failed to reorder the input mesh: %s.\n", status.error_msg());
+      return -1;
+    }
+    const draco::MeshVertexCacheStats stats_after =
+        draco::MeshReorderer::ComputeVertexCacheStats(
+            *mesh, reorder_options.cache_size);
+    printf("Reordered mesh: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+           stats_before.acmr, stats_after.acmr, stats_before.atvr,
+           stats_after.atvr);
+  }
+
   // Convert compression level to speed (that 0 = slowest, 10 = fastest).
   const int speed = 10 - options.compression_level;
 
@@ -357,6 +440,9 @@ int main(int argc, char **argv) {
                                      options.generic_quantization_bits);
   }
   encoder.SetSpeedOptions(speed, speed);
+  if (options.context_modeling) {
+    encoder.SetSymbolEncodingContextModeling(true);
+  }
 
   if (options.output.empty()) {
     // Create a default output file by attaching .drc to the input file name.
@@ -386,6 +472,32 @@ int main(int argc, char **argv) {
         poly_att_id, draco::PredictionSchemeMethod::PREDICTION_NONE);
   }
 
+  if (options.optimize_attributes) {
+    auto maybe_optimization = expert_encoder->OptimizeAttributeEncoding(-1);
+    if (!maybe_optimization.ok()) {
+      printf("Failed to optimize the encoder options: %s.\n",
+             maybe_optimization.status().error_msg());
+      return -1;
+    }
+    const auto &optimization = maybe_optimization.value();
+    printf("Optimized attribute encoding: %" PRId64 " -> %" PRId64 " bytes\n",
+           optimization.default_size, optimization.optimized_size);
+    for (int i = 0; i < static_cast<int>(optimization.attributes.size());
+         ++i) {
+      const auto &config = optimization.attributes[i];
+      if (config.prediction_scheme == -1 &&
+          config.symbol_encoding_compression_level == -1) {
+        continue;
+      }
+      printf("  Attribute %d (%s): prediction scheme = %d, level = %d\n", i,
+             draco::GeometryAttribute::TypeToString(
+                 pc->attribute(i)->attribute_type())
+                 .c_str(),
+             config.prediction_scheme,
+             config.symbol_encoding_compression_level);
+    }
+  }
+
   int ret = -1;
 
   if (input_is_mesh) {
@@ -394,6 +506,16 @@ int main(int argc, char **argv) {
     ret = EncodePointCloudToFile(*pc, options.output, expert_encoder.get());
   }
 
+  if (ret != -1 && options.print_stats) {
+    if (draco::CodingStats::IsSupported()) {
+      printf("%s\n", expert_encoder->stats().ToString().c_str());
+    } else {
+      printf(
+          "Encoding stats are not available. Rebuild Draco with "
+          "DRACO_INSTRUMENTATION enabled.\n\n");
+    }
+  }
+
   if (ret != -1 && options.compression_level < 10) {
     printf(
         "For better compression, increase the compression level up to '-cl 10' "
@@ -45,6 +45,12 @@ void Usage() {
   printf("default=8.\n");
   printf("  -qg <value>     quantization bits for any generic attribute, ");
   printf("default=8.\n");
+  printf("  -threads <value> number of threads used to compress the meshes, ");
+  printf("-1 uses all hardware threads, default=0.\n");
+  printf("  -cache_dir <dir> directory of a cache of compressed meshes that ");
+  printf("are reused across runs.\n");
+  printf("  -instance_meshes replace meshes that differ only by a rigid ");
+  printf("transformation by instances, default=false.\n");
 
   printf("\nBoolean options may be negated by prefixing 'no'.\n");
 }
@@ -72,6 +78,15 @@ draco::Status TranscodeFile(
   timer.Stop();
   printf("Transcode\t%s\t%" PRId64 "\n", file_options.input_filename.c_str(),
          timer.GetInMs());
+  if (dt->mesh_cache() != nullptr) {
+    printf("Mesh cache\thits %" PRId64 "\tmisses %" PRId64 "\n",
+           dt->mesh_cache()->num_hits(), dt->mesh_cache()->num_misses());
+  }
+  if (transcode_options.instance_rigid_meshes) {
+    printf("Instanced meshes\t%d\tsaved bytes %" PRId64 "\n",
+           dt->rigid_instancing_stats().num_replaced_meshes,
+           dt->rigid_instancing_stats().num_saved_bytes);
+  }
 
   return draco::OkStatus();
 }
@@ -112,6 +127,13 @@ int main(int argc, char **argv) {
     } else if (!strcmp("-qg", argv[i]) && i < argc_check) {
       transcode_options.geometry.quantization_bits_generic =
           StringToInt(argv[++i]);
+    } else if (!strcmp("-threads", argv[i]) && i < argc_check) {
+      transcode_options.num_compression_threads = StringToInt(argv[++i]);
+    } else if (!strcmp("-cache_dir", argv[i]) && i < argc_check) {
+      transcode_options.mesh_cache_directory = argv[++i];
+    } else if (MatchesBooleanOption("instance_meshes", argv[i])) {
+      transcode_options.instance_rigid_meshes =
+          strcmp("-noinstance_meshes", argv[i]) != 0;
     }
   }
   if (argc < 3 || file_options.input_filename.empty() ||
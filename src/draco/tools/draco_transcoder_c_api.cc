@@ -14,16 +14,206 @@
 
 #include "draco/tools/draco_transcoder_c_api.h"
 
+#include <climits>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/core/status.h"
+#include "draco/core/thread_pool.h"
 #include "draco/io/gltf_decoder.h"
 #include "draco/io/gltf_encoder.h"
 #include "draco/scene/scene_utils.h"
 #include "draco/tools/draco_transcoder_lib.h"
 
+// Output buffer that owns the storage used by the glTF encoder.
+struct DracoOutputBuffer {
+  draco::EncoderBuffer buffer;
+};
+
+namespace {
+
+// Converts the C |options| into transcoding options.
+void SetTranscodingOptions(const DracoOptions &options,
+                           draco::DracoTranscodingOptions *out_options) {
+  draco::DracoCompressionOptions &geometry = out_options->geometry;
+  geometry.compression_level = options.compression_level;
+  geometry.quantization_position.SetQuantizationBits(
+      options.quantization_position);
+  geometry.quantization_bits_tex_coord = options.quantization_tex_coord;
+  geometry.quantization_bits_normal = options.quantization_normal;
+  geometry.quantization_bits_color = options.quantization_color;
+  geometry.quantization_bits_tangent = options.quantization_tangent;
+  geometry.quantization_bits_weight = options.quantization_weight;
+  geometry.quantization_bits_generic = options.quantization_generic;
+}
+
+// Transcodes glTF |input_data| into a Draco compressed GLB stored in
+// |out_buffer|. Returns 0 on success or the same error codes as
+// draco_transcode_gltf().
+int TranscodeToEncoderBuffer(const void *input_data, size_t input_size,
+                             const DracoOptions &options,
+                             draco::EncoderBuffer *out_buffer) {
+  // Set up transcoding options from C struct
+  draco::DracoTranscodingOptions transcode_options;
+  SetTranscodingOptions(options, &transcode_options);
+
+  // Check options validity
+  const draco::Status check_status = transcode_options.geometry.Check();
+  if (!check_status.ok()) {
+    return -2;  // Invalid options
+  }
+
+  // Decode input glTF from buffer
+  draco::DecoderBuffer input_buffer;
+  input_buffer.Init(reinterpret_cast<const char *>(input_data), input_size);
+
+  draco::GltfDecoder decoder;
+  draco::StatusOr<std::unique_ptr<draco::Scene>> scene_result =
+      decoder.DecodeFromBufferToScene(&input_buffer);
+  if (!scene_result.ok()) {
+    return -4;  // Decoding failed
+  }
+  std::unique_ptr<draco::Scene> scene = std::move(scene_result).value();
+
+  // Apply compression settings to scene
+  draco::SceneUtils::SetDracoCompressionOptions(&transcode_options.geometry,
+                                                scene.get());
+
+  // Encode directly into the output buffer
+  draco::GltfEncoder encoder;
+  if (!encoder.EncodeToBuffer(*scene, out_buffer).ok()) {
+    return -4;  // Encoding failed
+  }
+  return 0;
+}
+
+// Decodes Draco compressed glTF |input_data| into an uncompressed GLB stored
+// in |out_buffer|. Returns 0 on success or -4 on failure.
+int DecompressToEncoderBuffer(const void *input_data, size_t input_size,
+                              draco::EncoderBuffer *out_buffer) {
+  // Decode input Draco glTF from buffer
+  draco::DecoderBuffer input_buffer;
+  input_buffer.Init(reinterpret_cast<const char *>(input_data), input_size);
+
+  draco::GltfDecoder decoder;
+  draco::StatusOr<std::unique_ptr<draco::Scene>> scene_result =
+      decoder.DecodeFromBufferToScene(&input_buffer);
+  if (!scene_result.ok()) {
+    return -4;  // Decoding failed
+  }
+  std::unique_ptr<draco::Scene> scene = std::move(scene_result).value();
+
+  // Encode directly into the uncompressed output buffer
+  draco::GltfEncoder encoder;
+  if (!encoder.EncodeToBuffer(*scene, out_buffer).ok()) {
+    return -4;  // Encoding failed
+  }
+  return 0;
+}
+
+// Copies |buffer| into memory allocated with malloc() that can be released
+// with draco_free_buffer(). Returns nullptr when the allocation fails.
+void *CopyToMallocBuffer(const draco::EncoderBuffer &buffer,
+                         size_t *output_size) {
+  void *const result = malloc(buffer.size());
+  if (!result) {
+    return nullptr;  // Memory allocation failed
+  }
+  memcpy(result, buffer.data(), buffer.size());
+  *output_size = buffer.size();
+  return result;
+}
+
+// Transcoders shared by the tasks of a batch. A task takes an idle transcoder
+// or creates a new one when all of them are in use, and returns it when it is
+// done. Therefore at most one transcoder is created per concurrently running
+// task and its state is reused by all items processed by the task.
+class TranscoderPool {
+ public:
+  explicit TranscoderPool(const draco::DracoTranscodingOptions &options)
+      : options_(options) {}
+
+  // Returns nullptr when a new transcoder could not be created.
+  std::unique_ptr<draco::DracoTranscoder> Acquire() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!idle_transcoders_.empty()) {
+        std::unique_ptr<draco::DracoTranscoder> transcoder =
+            std::move(idle_transcoders_.back());
+        idle_transcoders_.pop_back();
+        return transcoder;
+      }
+    }
+    draco::StatusOr<std::unique_ptr<draco::DracoTranscoder>> dt_result =
+        draco::DracoTranscoder::Create(options_);
+    if (!dt_result.ok()) {
+      return nullptr;
+    }
+    return std::move(dt_result).value();
+  }
+
+  void Release(std::unique_ptr<draco::DracoTranscoder> transcoder) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_transcoders_.push_back(std::move(transcoder));
+  }
+
+ private:
+  const draco::DracoTranscodingOptions options_;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<draco::DracoTranscoder>> idle_transcoders_;
+};
+
+// Transcodes a single batch |item| with |transcoder| and returns its status
+// code.
+int TranscodeBatchItem(const DracoBatchItem &item,
+                       draco::DracoTranscoder *transcoder,
+                       DracoBatchResult *result) {
+  if (item.output_filename) {
+    if (!item.input_filename) {
+      return -1;  // Only files can be transcoded to files
+    }
+    draco::DracoTranscoder::FileOptions file_options;
+    file_options.input_filename = item.input_filename;
+    file_options.output_filename = item.output_filename;
+    if (!transcoder->Transcode(file_options).ok()) {
+      return -4;  // Transcoding failed
+    }
+    return 0;
+  }
+
+  draco::EncoderBuffer output_buffer;
+  if (item.input_filename) {
+    if (!transcoder->TranscodeToBuffer(item.input_filename, &output_buffer)
+             .ok()) {
+      return -4;  // Transcoding failed
+    }
+  } else {
+    if (!item.input_data || !item.input_size) {
+      return -1;  // Invalid arguments
+    }
+    draco::DecoderBuffer input_buffer;
+    input_buffer.Init(reinterpret_cast<const char *>(item.input_data),
+                      item.input_size);
+    if (!transcoder->TranscodeToBuffer(&input_buffer, &output_buffer).ok()) {
+      return -4;  // Transcoding failed
+    }
+  }
+
+  // Allocate output buffer and copy data
+  result->output_data = CopyToMallocBuffer(output_buffer, &result->output_size);
+  if (!result->output_data) {
+    return -5;  // Memory allocation failed
+  }
+  return 0;
+}
+
+}  // namespace
+
 extern "C" {
 
 int draco_transcode_gltf(const char *input_filename,
@@ -39,21 +229,7 @@ int draco_transcode_gltf(const char *input_filename,
 
   // Set up transcoding options from C struct
   draco::DracoTranscodingOptions transcode_options;
-  transcode_options.geometry.compression_level = options->compression_level;
-  transcode_options.geometry.quantization_position.SetQuantizationBits(
-      options->quantization_position);
-  transcode_options.geometry.quantization_bits_tex_coord =
-      options->quantization_tex_coord;
-  transcode_options.geometry.quantization_bits_normal =
-      options->quantization_normal;
-  transcode_options.geometry.quantization_bits_color =
-      options->quantization_color;
-  transcode_options.geometry.quantization_bits_tangent =
-      options->quantization_tangent;
-  transcode_options.geometry.quantization_bits_weight =
-      options->quantization_weight;
-  transcode_options.geometry.quantization_bits_generic =
-      options->quantization_generic;
+  SetTranscodingOptions(*options, &transcode_options);
 
   // Check options validity
   const draco::Status check_status = transcode_options.geometry.Check();
@@ -87,104 +263,118 @@ void *draco_transcode_gltf_from_buffer(const void *input_data,
 
   *output_size = 0;
 
-  // Set up transcoding options from C struct
-  draco::DracoTranscodingOptions transcode_options;
-  transcode_options.geometry.compression_level = options->compression_level;
-  transcode_options.geometry.quantization_position.SetQuantizationBits(
-      options->quantization_position);
-  transcode_options.geometry.quantization_bits_tex_coord =
-      options->quantization_tex_coord;
-  transcode_options.geometry.quantization_bits_normal =
-      options->quantization_normal;
-  transcode_options.geometry.quantization_bits_color =
-      options->quantization_color;
-  transcode_options.geometry.quantization_bits_tangent =
-      options->quantization_tangent;
-  transcode_options.geometry.quantization_bits_weight =
-      options->quantization_weight;
-  transcode_options.geometry.quantization_bits_generic =
-      options->quantization_generic;
-
-  // Check options validity
-  const draco::Status check_status = transcode_options.geometry.Check();
-  if (!check_status.ok()) {
-    return nullptr;  // Invalid options
+  draco::EncoderBuffer output_buffer;
+  if (TranscodeToEncoderBuffer(input_data, input_size, *options,
+                               &output_buffer) != 0) {
+    return nullptr;
   }
+  return CopyToMallocBuffer(output_buffer, output_size);
+}
 
-  // Decode input glTF from buffer
-  draco::DecoderBuffer input_buffer;
-  input_buffer.Init(reinterpret_cast<const char *>(input_data), input_size);
-
-  draco::GltfDecoder decoder;
-  draco::StatusOr<std::unique_ptr<draco::Scene>> scene_result =
-      decoder.DecodeFromBufferToScene(&input_buffer);
-  if (!scene_result.ok()) {
-    return nullptr;  // Decoding failed
+void *draco_decompress_gltf_to_buffer(const void *input_data, size_t input_size,
+                                      size_t *output_size) {
+  if (!input_data || !input_size || !output_size) {
+    return nullptr;  // Invalid arguments
   }
-  std::unique_ptr<draco::Scene> scene = std::move(scene_result).value();
 
-  // Apply compression settings to scene
-  draco::SceneUtils::SetDracoCompressionOptions(&transcode_options.geometry,
-                                                scene.get());
+  *output_size = 0;
 
-  // Encode to output buffer
   draco::EncoderBuffer output_buffer;
-  draco::GltfEncoder encoder;
-  draco::Status encode_status = encoder.EncodeToBuffer(*scene, &output_buffer);
-  if (!encode_status.ok()) {
-    return nullptr;  // Encoding failed
+  if (DecompressToEncoderBuffer(input_data, input_size, &output_buffer) != 0) {
+    return nullptr;
   }
+  return CopyToMallocBuffer(output_buffer, output_size);
+}
 
-  // Allocate output buffer and copy data
-  void *result = malloc(output_buffer.size());
-  if (!result) {
-    return nullptr;  // Memory allocation failed
+DracoOutputBuffer *draco_transcode_gltf_to_output(const void *input_data,
+                                                  size_t input_size,
+                                                  DracoOptions *options) {
+  if (!input_data || !input_size || !options) {
+    return nullptr;  // Invalid arguments
   }
 
-  memcpy(result, output_buffer.data(), output_buffer.size());
-  *output_size = output_buffer.size();
-
-  return result;
+  std::unique_ptr<DracoOutputBuffer> output(new DracoOutputBuffer());
+  if (TranscodeToEncoderBuffer(input_data, input_size, *options,
+                               &output->buffer) != 0) {
+    return nullptr;
+  }
+  return output.release();
 }
 
-void *draco_decompress_gltf_to_buffer(const void *input_data, size_t input_size,
-                                      size_t *output_size) {
-  if (!input_data || !input_size || !output_size) {
+DracoOutputBuffer *draco_decompress_gltf_to_output(const void *input_data,
+                                                   size_t input_size) {
+  if (!input_data || !input_size) {
     return nullptr;  // Invalid arguments
   }
 
-  *output_size = 0;
+  std::unique_ptr<DracoOutputBuffer> output(new DracoOutputBuffer());
+  if (DecompressToEncoderBuffer(input_data, input_size, &output->buffer) !=
+      0) {
+    return nullptr;
+  }
+  return output.release();
+}
 
-  // Decode input Draco glTF from buffer
-  draco::DecoderBuffer input_buffer;
-  input_buffer.Init(reinterpret_cast<const char *>(input_data), input_size);
+const void *draco_output_buffer_data(const DracoOutputBuffer *output) {
+  return output ? output->buffer.data() : nullptr;
+}
 
-  draco::GltfDecoder decoder;
-  draco::StatusOr<std::unique_ptr<draco::Scene>> scene_result =
-      decoder.DecodeFromBufferToScene(&input_buffer);
-  if (!scene_result.ok()) {
-    return nullptr;  // Decoding failed
-  }
-  std::unique_ptr<draco::Scene> scene = std::move(scene_result).value();
+size_t draco_output_buffer_size(const DracoOutputBuffer *output) {
+  return output ? output->buffer.size() : 0;
+}
 
-  // Encode to uncompressed output buffer
-  draco::EncoderBuffer output_buffer;
-  draco::GltfEncoder encoder;
-  draco::Status encode_status = encoder.EncodeToBuffer(*scene, &output_buffer);
-  if (!encode_status.ok()) {
-    return nullptr;  // Encoding failed
+void draco_free_output_buffer(DracoOutputBuffer *output) { delete output; }
+
+int draco_transcode_gltf_batch(const DracoBatchItem *items, size_t num_items,
+                               DracoOptions *options, int num_threads,
+                               DracoBatchResult *results) {
+  if (!items || !options || !results || num_items > INT_MAX) {
+    return -1;  // Invalid arguments
   }
 
-  // Allocate output buffer and copy data
-  void *result = malloc(output_buffer.size());
-  if (!result) {
-    return nullptr;  // Memory allocation failed
+  for (size_t i = 0; i < num_items; ++i) {
+    results[i].status = 0;
+    results[i].output_data = nullptr;
+    results[i].output_size = 0;
   }
 
-  memcpy(result, output_buffer.data(), output_buffer.size());
-  *output_size = output_buffer.size();
+  // Set up transcoding options from C struct
+  draco::DracoTranscodingOptions transcode_options;
+  SetTranscodingOptions(*options, &transcode_options);
 
-  return result;
+  // Check options validity
+  if (!transcode_options.geometry.Check().ok()) {
+    for (size_t i = 0; i < num_items; ++i) {
+      results[i].status = -2;  // Invalid options
+    }
+    return static_cast<int>(num_items);
+  }
+
+  if (num_threads < 0) {
+    num_threads = draco::ThreadPool::HardwareConcurrency() - 1;
+  }
+  draco::ThreadPool pool(num_threads);
+  TranscoderPool transcoders(transcode_options);
+  pool.ParallelFor(static_cast<int>(num_items), 1, [&](int begin, int end) {
+    std::unique_ptr<draco::DracoTranscoder> transcoder = transcoders.Acquire();
+    for (int i = begin; i < end; ++i) {
+      results[i].status =
+          transcoder ? TranscodeBatchItem(items[i], transcoder.get(),
+                                          &results[i])
+                     : -3;  // Failed to create transcoder
+    }
+    if (transcoder) {
+      transcoders.Release(std::move(transcoder));
+    }
+  });
+
+  int num_failed_items = 0;
+  for (size_t i = 0; i < num_items; ++i) {
+    if (results[i].status != 0) {
+      ++num_failed_items;
+    }
+  }
+  return num_failed_items;
 }
 
 void draco_free_buffer(void *buffer) {
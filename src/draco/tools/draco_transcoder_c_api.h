@@ -52,6 +52,65 @@ void *draco_transcode_gltf_from_buffer(const void *input_data,
 void *draco_decompress_gltf_to_buffer(const void *input_data, size_t input_size,
                                       size_t *output_size);
 
+// Opaque output buffer owning the data produced by the glTF encoder. Unlike
+// the functions above, functions returning a DracoOutputBuffer hand the
+// encoder's storage over to the caller without copying it.
+typedef struct DracoOutputBuffer DracoOutputBuffer;
+
+// Same as draco_transcode_gltf_from_buffer() but returns the output without
+// copying it. Returns NULL on error. The caller must free the returned buffer
+// using draco_free_output_buffer().
+DracoOutputBuffer *draco_transcode_gltf_to_output(const void *input_data,
+                                                  size_t input_size,
+                                                  DracoOptions *options);
+
+// Same as draco_decompress_gltf_to_buffer() but returns the output without
+// copying it. Returns NULL on error. The caller must free the returned buffer
+// using draco_free_output_buffer().
+DracoOutputBuffer *draco_decompress_gltf_to_output(const void *input_data,
+                                                   size_t input_size);
+
+// Returns the data of |output|. The data stays valid until |output| is freed.
+const void *draco_output_buffer_data(const DracoOutputBuffer *output);
+
+// Returns the size of the data of |output| in bytes.
+size_t draco_output_buffer_size(const DracoOutputBuffer *output);
+
+// Frees an output buffer returned by the C API functions.
+void draco_free_output_buffer(DracoOutputBuffer *output);
+
+// Input of a single item of a batch transcoding. Either |input_filename| or
+// |input_data| must be set.
+typedef struct {
+  const char *input_filename;   // Input glTF file, or NULL.
+  const void *input_data;       // Input glTF data used when no file is set.
+  size_t input_size;            // Size of |input_data| in bytes.
+  const char *output_filename;  // Output glTF file, or NULL to return the
+                                // output in DracoBatchResult::output_data.
+} DracoBatchItem;
+
+// Result of a single item of a batch transcoding.
+typedef struct {
+  int status;         // 0 on success, negative error code otherwise.
+  void *output_data;  // Output GLB data when no output file was set. The
+                      // caller must free it using draco_free_buffer().
+  size_t output_size;
+} DracoBatchResult;
+
+// Transcodes |num_items| glTF inputs with the same |options| concurrently on
+// an internal work-stealing thread pool. |num_threads| is the number of extra
+// worker threads used next to the calling thread, negative values use all
+// available hardware threads. Transcoders are reused across the items
+// processed by the same worker. |results| must point to |num_items| entries
+// that receive the status and the output of each item. Item error codes are
+// -1 for invalid items, -2 for invalid options, -3 when a transcoder could not
+// be created, -4 when transcoding failed and -5 when the output could not be
+// allocated.
+// Returns the number of failed items, or -1 on invalid arguments.
+int draco_transcode_gltf_batch(const DracoBatchItem *items, size_t num_items,
+                               DracoOptions *options, int num_threads,
+                               DracoBatchResult *results);
+
 // Frees a buffer allocated by the C API functions.
 void draco_free_buffer(void *buffer);
 
@@ -0,0 +1,277 @@
+// Copyright 2025 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/tools/draco_transcoder_c_api.h"
+
+#include "draco/draco_features.h"
+
+#ifdef DRACO_TRANSCODER_SUPPORTED
+#include <string>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/io/file_utils.h"
+
+namespace {
+
+// Returns the same options as the defaults of draco_transcoder.
+DracoOptions DefaultOptions() {
+  DracoOptions options;
+  options.quantization_position = 11;
+  options.quantization_tex_coord = 10;
+  options.quantization_normal = 8;
+  options.quantization_color = 8;
+  options.quantization_tangent = 8;
+  options.quantization_weight = 8;
+  options.quantization_generic = 8;
+  options.compression_level = 7;
+  return options;
+}
+
+// Copies the data of |output| into a vector and frees |output|.
+std::vector<char> TakeOutputBuffer(DracoOutputBuffer *output) {
+  const char *const data =
+      static_cast<const char *>(draco_output_buffer_data(output));
+  const std::vector<char> result(data, data + draco_output_buffer_size(output));
+  draco_free_output_buffer(output);
+  return result;
+}
+
+// Copies |size| bytes of |buffer| into a vector and frees |buffer|.
+std::vector<char> TakeBuffer(void *buffer, size_t size) {
+  const char *const data = static_cast<const char *>(buffer);
+  const std::vector<char> result(data, data + size);
+  draco_free_buffer(buffer);
+  return result;
+}
+
+// Transcodes |input_data| with draco_transcode_gltf_from_buffer().
+std::vector<char> TranscodeFromBuffer(const std::vector<char> &input_data,
+                                      DracoOptions options) {
+  size_t output_size = 0;
+  void *const output = draco_transcode_gltf_from_buffer(
+      input_data.data(), input_data.size(), &options, &output_size);
+  if (!output) {
+    return std::vector<char>();
+  }
+  return TakeBuffer(output, output_size);
+}
+
+// Tests that the zero-copy output of draco_transcode_gltf_to_output() matches
+// the copied output of draco_transcode_gltf_from_buffer().
+TEST(DracoTranscoderCApiTest, TranscodeToOutput) {
+  std::vector<char> input_data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(
+      draco::GetTestFileFullPath(
+          "KhronosSampleModels/Duck/glTF_Binary/Duck.glb"),
+      &input_data));
+  DracoOptions options = DefaultOptions();
+  const std::vector<char> expected_data =
+      TranscodeFromBuffer(input_data, options);
+  ASSERT_FALSE(expected_data.empty());
+
+  DracoOutputBuffer *const output = draco_transcode_gltf_to_output(
+      input_data.data(), input_data.size(), &options);
+  ASSERT_NE(output, nullptr);
+  ASSERT_EQ(TakeOutputBuffer(output), expected_data);
+}
+
+// Tests that the zero-copy output of draco_decompress_gltf_to_output() matches
+// the copied output of draco_decompress_gltf_to_buffer().
+TEST(DracoTranscoderCApiTest, DecompressToOutput) {
+  std::vector<char> input_data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(
+      draco::GetTestFileFullPath("Box/glTF_Binary/Box.glb"), &input_data));
+  const std::vector<char> compressed_data =
+      TranscodeFromBuffer(input_data, DefaultOptions());
+  ASSERT_FALSE(compressed_data.empty());
+
+  size_t output_size = 0;
+  void *const buffer = draco_decompress_gltf_to_buffer(
+      compressed_data.data(), compressed_data.size(), &output_size);
+  ASSERT_NE(buffer, nullptr);
+  const std::vector<char> expected_data = TakeBuffer(buffer, output_size);
+  ASSERT_FALSE(expected_data.empty());
+
+  DracoOutputBuffer *const output = draco_decompress_gltf_to_output(
+      compressed_data.data(), compressed_data.size());
+  ASSERT_NE(output, nullptr);
+  ASSERT_EQ(TakeOutputBuffer(output), expected_data);
+}
+
+// Tests that the zero-copy functions reject invalid inputs and that the output
+// buffer accessors accept null buffers.
+TEST(DracoTranscoderCApiTest, OutputInvalidInput) {
+  DracoOptions options = DefaultOptions();
+  const std::string invalid_data = "not a glTF file";
+  ASSERT_EQ(draco_transcode_gltf_to_output(nullptr, 10, &options), nullptr);
+  ASSERT_EQ(draco_transcode_gltf_to_output(invalid_data.data(),
+                                           invalid_data.size(), nullptr),
+            nullptr);
+  ASSERT_EQ(draco_transcode_gltf_to_output(invalid_data.data(),
+                                           invalid_data.size(), &options),
+            nullptr);
+  ASSERT_EQ(draco_decompress_gltf_to_output(nullptr, 10), nullptr);
+  ASSERT_EQ(draco_decompress_gltf_to_output(invalid_data.data(),
+                                            invalid_data.size()),
+            nullptr);
+
+  std::vector<char> input_data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(
+      draco::GetTestFileFullPath("Box/glTF_Binary/Box.glb"), &input_data));
+  options.quantization_position = 31;
+  ASSERT_EQ(draco_transcode_gltf_to_output(input_data.data(),
+                                           input_data.size(), &options),
+            nullptr);
+
+  ASSERT_EQ(draco_output_buffer_data(nullptr), nullptr);
+  ASSERT_EQ(draco_output_buffer_size(nullptr), 0);
+  draco_free_output_buffer(nullptr);
+}
+
+// Tests that a batch with file and buffer inputs produces the same outputs as
+// transcoding each input separately, for different numbers of threads.
+TEST(DracoTranscoderCApiTest, TranscodeBatch) {
+  const std::string duck_filename = draco::GetTestFileFullPath(
+      "KhronosSampleModels/Duck/glTF_Binary/Duck.glb");
+  const std::string sphere_filename =
+      draco::GetTestFileFullPath("sphere.gltf");
+  std::vector<char> box_data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(
+      draco::GetTestFileFullPath("Box/glTF_Binary/Box.glb"), &box_data));
+
+  // Expected outputs of the single-item API.
+  DracoOptions options = DefaultOptions();
+  const std::string expected_duck_filename =
+      draco::GetTestTempFileFullPath("c_api_batch_expected_duck.glb");
+  ASSERT_EQ(draco_transcode_gltf(duck_filename.c_str(),
+                                 expected_duck_filename.c_str(), &options),
+            0);
+  std::vector<char> expected_duck_data;
+  ASSERT_TRUE(
+      draco::ReadFileToBuffer(expected_duck_filename, &expected_duck_data));
+  const std::vector<char> expected_box_data =
+      TranscodeFromBuffer(box_data, options);
+  ASSERT_FALSE(expected_box_data.empty());
+
+  const std::string sphere_output_filename =
+      draco::GetTestTempFileFullPath("c_api_batch_sphere.gltf");
+  const std::string sphere_output_bin_filename =
+      draco::GetTestTempFileFullPath("c_api_batch_sphere.bin");
+
+  for (const int num_threads : {0, 2, -1}) {
+    SCOPED_TRACE(num_threads);
+    std::vector<DracoBatchItem> items(3);
+    items[0] = {duck_filename.c_str(), nullptr, 0, nullptr};
+    items[1] = {nullptr, box_data.data(), box_data.size(), nullptr};
+    items[2] = {sphere_filename.c_str(), nullptr, 0,
+                sphere_output_filename.c_str()};
+    std::vector<DracoBatchResult> results(items.size());
+    ASSERT_EQ(draco_transcode_gltf_batch(items.data(), items.size(), &options,
+                                         num_threads, results.data()),
+              0);
+    for (const DracoBatchResult &result : results) {
+      ASSERT_EQ(result.status, 0);
+    }
+    ASSERT_EQ(TakeBuffer(results[0].output_data, results[0].output_size),
+              expected_duck_data);
+    ASSERT_EQ(TakeBuffer(results[1].output_data, results[1].output_size),
+              expected_box_data);
+    ASSERT_EQ(results[2].output_data, nullptr);
+    ASSERT_GT(draco::GetFileSize(sphere_output_bin_filename), 0);
+  }
+}
+
+// Tests that failures of batch items are reported per item and do not affect
+// the other items.
+TEST(DracoTranscoderCApiTest, TranscodeBatchInvalidItems) {
+  const std::string duck_filename = draco::GetTestFileFullPath(
+      "KhronosSampleModels/Duck/glTF_Binary/Duck.glb");
+  const std::string missing_filename =
+      draco::GetTestFileFullPath("does_not_exist.glb");
+  const std::string output_filename =
+      draco::GetTestTempFileFullPath("c_api_batch_invalid.glb");
+  const std::string invalid_data = "not a glTF file";
+
+  std::vector<DracoBatchItem> items(5);
+  // No input.
+  items[0] = {nullptr, nullptr, 0, nullptr};
+  // Buffer inputs can't be transcoded to files.
+  items[1] = {nullptr, invalid_data.data(), invalid_data.size(),
+              output_filename.c_str()};
+  // Missing input file.
+  items[2] = {missing_filename.c_str(), nullptr, 0, nullptr};
+  // Invalid input data.
+  items[3] = {nullptr, invalid_data.data(), invalid_data.size(), nullptr};
+  // Valid input.
+  items[4] = {duck_filename.c_str(), nullptr, 0, nullptr};
+
+  DracoOptions options = DefaultOptions();
+  std::vector<DracoBatchResult> results(items.size());
+  ASSERT_EQ(draco_transcode_gltf_batch(items.data(), items.size(), &options, 1,
+                                       results.data()),
+            4);
+  ASSERT_EQ(results[0].status, -1);
+  ASSERT_EQ(results[1].status, -1);
+  ASSERT_EQ(results[2].status, -4);
+  ASSERT_EQ(results[3].status, -4);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(results[i].output_data, nullptr);
+    ASSERT_EQ(results[i].output_size, 0);
+  }
+  ASSERT_EQ(results[4].status, 0);
+  ASSERT_NE(results[4].output_data, nullptr);
+  ASSERT_GT(results[4].output_size, 0);
+  draco_free_buffer(results[4].output_data);
+}
+
+// Tests that invalid options fail all items of a batch and that invalid
+// arguments fail the whole batch.
+TEST(DracoTranscoderCApiTest, TranscodeBatchInvalidArguments) {
+  const std::string duck_filename = draco::GetTestFileFullPath(
+      "KhronosSampleModels/Duck/glTF_Binary/Duck.glb");
+  std::vector<DracoBatchItem> items(2);
+  items[0] = {duck_filename.c_str(), nullptr, 0, nullptr};
+  items[1] = {duck_filename.c_str(), nullptr, 0, nullptr};
+  std::vector<DracoBatchResult> results(items.size());
+
+  DracoOptions options = DefaultOptions();
+  options.compression_level = 11;
+  ASSERT_EQ(draco_transcode_gltf_batch(items.data(), items.size(), &options, 0,
+                                       results.data()),
+            2);
+  for (const DracoBatchResult &result : results) {
+    ASSERT_EQ(result.status, -2);
+    ASSERT_EQ(result.output_data, nullptr);
+  }
+
+  options = DefaultOptions();
+  ASSERT_EQ(draco_transcode_gltf_batch(nullptr, items.size(), &options, 0,
+                                       results.data()),
+            -1);
+  ASSERT_EQ(draco_transcode_gltf_batch(items.data(), items.size(), nullptr, 0,
+                                       results.data()),
+            -1);
+  ASSERT_EQ(draco_transcode_gltf_batch(items.data(), items.size(), &options, 0,
+                                       nullptr),
+            -1);
+  ASSERT_EQ(draco_transcode_gltf_batch(items.data(), 0, &options, 0,
+                                       results.data()),
+            0);
+}
+
+}  // namespace
+
+#endif  // DRACO_TRANSCODER_SUPPORTED
@@ -17,6 +17,7 @@
 #ifdef DRACO_TRANSCODER_SUPPORTED
 #include "draco/core/status_or.h"
 #include "draco/io/file_utils.h"
+#include "draco/io/gltf_decoder.h"
 #include "draco/io/scene_io.h"
 #include "draco/scene/scene_utils.h"
 #include "draco/texture/texture_utils.h"
@@ -30,6 +31,13 @@ StatusOr<std::unique_ptr<DracoTranscoder>> DracoTranscoder::Create(
   DRACO_RETURN_IF_ERROR(options.geometry.Check());
   std::unique_ptr<DracoTranscoder> dt(new DracoTranscoder());
   dt->transcoding_options_ = options;
+  dt->gltf_encoder_.set_num_compression_threads(
+      options.num_compression_threads);
+  if (!options.mesh_cache_directory.empty()) {
+    DRACO_ASSIGN_OR_RETURN(
+        dt->mesh_cache_, DracoMeshCache::Create(options.mesh_cache_directory));
+    dt->gltf_encoder_.set_draco_mesh_cache(dt->mesh_cache_.get());
+  }
   return dt;
 }
 
@@ -47,6 +55,24 @@ Status DracoTranscoder::Transcode(const FileOptions &file_options) {
   return OkStatus();
 }
 
+Status DracoTranscoder::TranscodeToBuffer(const std::string &input_filename,
+                                          EncoderBuffer *out_buffer) {
+  if (input_filename.empty()) {
+    return Status(Status::DRACO_ERROR, "Input filename is empty.");
+  }
+  DRACO_ASSIGN_OR_RETURN(scene_, ReadSceneFromFile(input_filename));
+  DRACO_RETURN_IF_ERROR(CompressScene());
+  return gltf_encoder_.EncodeToBuffer(*scene_, out_buffer);
+}
+
+Status DracoTranscoder::TranscodeToBuffer(DecoderBuffer *in_buffer,
+                                          EncoderBuffer *out_buffer) {
+  GltfDecoder decoder;
+  DRACO_ASSIGN_OR_RETURN(scene_, decoder.DecodeFromBufferToScene(in_buffer));
+  DRACO_RETURN_IF_ERROR(CompressScene());
+  return gltf_encoder_.EncodeToBuffer(*scene_, out_buffer);
+}
+
 Status DracoTranscoder::ReadScene(const FileOptions &file_options) {
   if (file_options.input_filename.empty()) {
     return Status(Status::DRACO_ERROR, "Input filename is empty.");
@@ -76,6 +102,17 @@ Status DracoTranscoder::WriteScene(const FileOptions &file_options) {
 }
 
 Status DracoTranscoder::CompressScene() {
+  rigid_instancing_stats_ = SceneUtils::RigidInstancingStats();
+  if (transcoding_options_.instance_rigid_meshes) {
+    // Replace repeated geometry by instances so that it is compressed once.
+    SceneUtils::RigidInstancingOptions instancing_options;
+    instancing_options.num_threads =
+        transcoding_options_.num_compression_threads;
+    DRACO_ASSIGN_OR_RETURN(
+        rigid_instancing_stats_,
+        SceneUtils::InstanceRigidMeshes(instancing_options, scene_.get()));
+  }
+
   // Apply geometry compression settings to all scene meshes.
   SceneUtils::SetDracoCompressionOptions(&transcoding_options_.geometry,
                                          scene_.get());
@@ -21,18 +21,38 @@
 #include <string>
 
 #include "draco/compression/draco_compression_options.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/encoder_buffer.h"
 #include "draco/core/options.h"
+#include "draco/io/draco_mesh_cache.h"
 #include "draco/io/gltf_encoder.h"
 #include "draco/io/image_compression_options.h"
+#include "draco/scene/scene_utils.h"
 
 namespace draco {
 
 // Struct to hold Draco transcoding options.
 struct DracoTranscodingOptions {
-  DracoTranscodingOptions() {}
+  DracoTranscodingOptions()
+      : num_compression_threads(0), instance_rigid_meshes(false) {}
 
   // Options used when geometry compression optimization is disabled.
   DracoCompressionOptions geometry;
+
+  // Number of threads used to compress the scene meshes while the output glTF
+  // is assembled. Negative values use all available hardware threads. See
+  // GltfEncoder::set_num_compression_threads().
+  int num_compression_threads;
+
+  // Directory of an on-disk cache of Draco compressed meshes. When set, meshes
+  // that were already compressed with the same content and options are not
+  // compressed again. The cache can be shared by multiple transcoders.
+  std::string mesh_cache_directory;
+
+  // When set, scene meshes that differ from other scene meshes only by a rigid
+  // transformation are replaced by instances of the other meshes before the
+  // compression. See SceneUtils::InstanceRigidMeshes().
+  bool instance_rigid_meshes;
 };
 
 // Class that supports input of glTF (and some simple USD) files, encodes
@@ -77,6 +97,25 @@ class DracoTranscoder {
   // transcoder once and call Transcode for multiple files.
   Status Transcode(const FileOptions &file_options);
 
+  // Same as above, but the compressed scene is encoded as GLB into
+  // |out_buffer|. The input scene is read from |input_filename|.
+  Status TranscodeToBuffer(const std::string &input_filename,
+                           EncoderBuffer *out_buffer);
+
+  // Same as above, but the input scene is decoded from |in_buffer| that must
+  // contain a GLB or a glTF with embedded resources.
+  Status TranscodeToBuffer(DecoderBuffer *in_buffer, EncoderBuffer *out_buffer);
+
+  // Returns the mesh cache with its hit and miss statistics, or nullptr when
+  // no cache directory was set in the options.
+  const DracoMeshCache *mesh_cache() const { return mesh_cache_.get(); }
+
+  // Returns the number of meshes replaced by rigid instances in the last
+  // transcoded scene and the number of bytes saved by the replacement.
+  const SceneUtils::RigidInstancingStats &rigid_instancing_stats() const {
+    return rigid_instancing_stats_;
+  }
+
  private:
   // Read scene from file.
   Status ReadScene(const FileOptions &file_options);
@@ -90,11 +129,17 @@ class DracoTranscoder {
  private:
   GltfEncoder gltf_encoder_;
 
+  // Optional cache of Draco compressed meshes used by |gltf_encoder_|.
+  std::unique_ptr<DracoMeshCache> mesh_cache_;
+
   // The scene being transcoded.
   std::unique_ptr<Scene> scene_;
 
   // Copy of the transcoding options passed into the Create function.
   DracoTranscodingOptions transcoding_options_;
+
+  // Stats of the rigid mesh instancing of the last transcoded scene.
+  SceneUtils::RigidInstancingStats rigid_instancing_stats_;
 };
 
 }  // namespace draco
@@ -12,13 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
-#ifdef DRACO_TRANSCODER_SUPPORTED
-
 #include "draco/tools/draco_transcoder_lib.h"
 
+#ifdef DRACO_TRANSCODER_SUPPORTED
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
 #include "draco/io/file_utils.h"
+#include "ghc/filesystem.hpp"
 
 // Tests encoding a .gltf file with default Draco compression.
 TEST(DracoTranscoderTest, DefaultDracoCompression) {
@@ -169,4 +169,91 @@ TEST(DracoTranscoderTest, TestPositionQuantization) {
   ASSERT_GT(first_glb_size, second_glb_size);
 }
 
+// Tests that transcoding a file into a buffer produces the same GLB as
+// transcoding it into a .glb file and that transcoding from a buffer is stable
+// when the transcoder is reused.
+TEST(DracoTranscoderTest, TranscodeToBuffer) {
+  const std::string input_name =
+      "KhronosSampleModels/Duck/glTF_Binary/Duck.glb";
+  const std::string input_filename = draco::GetTestFileFullPath(input_name);
+  const std::string output_filename =
+      draco::GetTestTempFileFullPath("buffer_test.glb");
+
+  const draco::DracoTranscodingOptions options;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::DracoTranscoder> dt,
+                         draco::DracoTranscoder::Create(options));
+  draco::DracoTranscoder::FileOptions file_options;
+  file_options.input_filename = input_filename;
+  file_options.output_filename = output_filename;
+  DRACO_ASSERT_OK(dt->Transcode(file_options));
+  std::vector<char> expected_data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(output_filename, &expected_data));
+
+  std::vector<char> input_data;
+  ASSERT_TRUE(draco::ReadFileToBuffer(input_filename, &input_data));
+  std::vector<char> first_buffer_output;
+  for (int i = 0; i < 2; ++i) {
+    draco::EncoderBuffer file_output;
+    DRACO_ASSERT_OK(dt->TranscodeToBuffer(input_filename, &file_output));
+    ASSERT_EQ(*file_output.buffer(), expected_data);
+
+    draco::DecoderBuffer input_buffer;
+    input_buffer.Init(input_data.data(), input_data.size());
+    draco::EncoderBuffer buffer_output;
+    DRACO_ASSERT_OK(dt->TranscodeToBuffer(&input_buffer, &buffer_output));
+    ASSERT_GT(buffer_output.size(), 0);
+    if (i == 0) {
+      first_buffer_output = *buffer_output.buffer();
+    } else {
+      ASSERT_EQ(*buffer_output.buffer(), first_buffer_output);
+    }
+  }
+}
+
+// Tests that compressing meshes on multiple threads produces the same output
+// as the default transcoding.
+TEST(DracoTranscoderTest, CompressionThreads) {
+  const std::string input_filename =
+      draco::GetTestFileFullPath("CesiumMan/glTF/CesiumMan.gltf");
+
+  draco::DracoTranscodingOptions options;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::DracoTranscoder> dt,
+                         draco::DracoTranscoder::Create(options));
+  draco::EncoderBuffer expected_output;
+  DRACO_ASSERT_OK(dt->TranscodeToBuffer(input_filename, &expected_output));
+
+  options.num_compression_threads = 2;
+  DRACO_ASSIGN_OR_ASSERT(dt, draco::DracoTranscoder::Create(options));
+  draco::EncoderBuffer threads_output;
+  DRACO_ASSERT_OK(dt->TranscodeToBuffer(input_filename, &threads_output));
+  ASSERT_EQ(*threads_output.buffer(), *expected_output.buffer());
+}
+
+// Tests that reusing meshes from the mesh cache produces the same output as
+// the default transcoding.
+TEST(DracoTranscoderTest, MeshCache) {
+  const std::string input_filename =
+      draco::GetTestFileFullPath("CesiumMan/glTF/CesiumMan.gltf");
+  const std::string cache_directory =
+      draco::GetTestTempFileFullPath("transcoder_mesh_cache");
+  ghc::filesystem::remove_all(ghc::filesystem::path(cache_directory));
+
+  draco::DracoTranscodingOptions options;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::DracoTranscoder> dt,
+                         draco::DracoTranscoder::Create(options));
+  draco::EncoderBuffer expected_output;
+  DRACO_ASSERT_OK(dt->TranscodeToBuffer(input_filename, &expected_output));
+
+  // The first transcoding fills the cache and the second one uses it.
+  options.mesh_cache_directory = cache_directory;
+  for (int i = 0; i < 2; ++i) {
+    DRACO_ASSIGN_OR_ASSERT(dt, draco::DracoTranscoder::Create(options));
+    draco::EncoderBuffer cache_output;
+    DRACO_ASSERT_OK(dt->TranscodeToBuffer(input_filename, &cache_output));
+    ASSERT_EQ(*cache_output.buffer(), *expected_output.buffer());
+    ASSERT_FALSE(
+        ghc::filesystem::is_empty(ghc::filesystem::path(cache_directory)));
+  }
+}
+
 #endif  // DRACO_TRANSCODER_SUPPORTED
@@ -88,6 +88,49 @@ void *ConvertAttributeData(int num_points, const draco::PointAttribute *attr) {
       return nullptr;
   }
 }
+
+// Writes |N| float components of each point of |attr| to |out| with
+// |stride| bytes between points (0 for tightly packed points). Components
+// missing in |attr| are set to 0.
+template <int N>
+bool CopyPointValues(int num_points, const draco::PointAttribute *attr,
+                     float *out, int stride) {
+  const int value_size = N * static_cast<int>(sizeof(float));
+  if (stride == 0) {
+    stride = value_size;
+  }
+  // Float attributes with the same layout are copied at once.
+  if (attr->is_mapping_identity() &&
+      attr->data_type() == draco::DT_FLOAT32 && attr->num_components() == N &&
+      attr->byte_stride() == value_size && stride == value_size &&
+      attr->size() >= static_cast<size_t>(num_points)) {
+    if (num_points > 0) {
+      memcpy(out, attr->GetAddress(draco::AttributeValueIndex(0)),
+             static_cast<size_t>(num_points) * value_size);
+    }
+    return true;
+  }
+  uint8_t *dst = reinterpret_cast<uint8_t *>(out);
+  for (draco::PointIndex i(0); i < num_points; ++i) {
+    if (!attr->ConvertValue<float, N>(attr->mapped_index(i),
+                                      reinterpret_cast<float *>(dst))) {
+      return false;
+    }
+    dst += stride;
+  }
+  return true;
+}
+
+// Writes all face indices of |mesh| to |out| as IndexT values.
+template <typename IndexT>
+void CopyFaceIndices(const draco::Mesh &mesh, IndexT *out) {
+  for (draco::FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    const draco::Mesh::Face &face = mesh.face(f);
+    for (int c = 0; c < 3; ++c) {
+      out[3 * f.value() + c] = static_cast<IndexT>(face[c].value());
+    }
+  }
+}
 }  // namespace
 
 namespace draco {
@@ -270,6 +313,73 @@ bool EXPORT_API GetAttributeData(const DracoMesh *mesh,
   return true;
 }
 
+bool EXPORT_API GetMeshBuffers(const DracoMesh *mesh,
+                               const DracoUnityMeshBuffers *buffers) {
+  if (mesh == nullptr || buffers == nullptr) {
+    return false;
+  }
+  const Mesh *const m = static_cast<const Mesh *>(mesh->private_mesh);
+  const int num_points = m->num_points();
+  if (buffers->indices != nullptr) {
+    if (buffers->index_size == 4) {
+      CopyFaceIndices(*m, static_cast<uint32_t *>(buffers->indices));
+    } else if (buffers->index_size == 2 && num_points <= 0x10000) {
+      CopyFaceIndices(*m, static_cast<uint16_t *>(buffers->indices));
+    } else {
+      return false;
+    }
+  }
+  if (buffers->position != nullptr) {
+    const PointAttribute *const att =
+        m->GetNamedAttribute(GeometryAttribute::POSITION);
+    if (att == nullptr ||
+        !CopyPointValues<3>(num_points, att, buffers->position,
+                            buffers->position_stride)) {
+      return false;
+    }
+  }
+  if (buffers->normal != nullptr) {
+    const PointAttribute *const att =
+        m->GetNamedAttribute(GeometryAttribute::NORMAL);
+    if (att == nullptr ||
+        !CopyPointValues<3>(num_points, att, buffers->normal,
+                            buffers->normal_stride)) {
+      return false;
+    }
+  }
+  if (buffers->texcoord != nullptr) {
+    const PointAttribute *const att =
+        m->GetNamedAttribute(GeometryAttribute::TEX_COORD);
+    if (att == nullptr ||
+        !CopyPointValues<2>(num_points, att, buffers->texcoord,
+                            buffers->texcoord_stride)) {
+      return false;
+    }
+  }
+  if (buffers->color != nullptr) {
+    const PointAttribute *const att =
+        m->GetNamedAttribute(GeometryAttribute::COLOR);
+    if (att == nullptr ||
+        !CopyPointValues<4>(num_points, att, buffers->color,
+                            buffers->color_stride)) {
+      return false;
+    }
+    if (att->num_components() < 4) {
+      // If the alpha component wasn't set in the input data we should set it
+      // to an opaque value.
+      const int stride = buffers->color_stride == 0
+                             ? 4 * static_cast<int>(sizeof(float))
+                             : buffers->color_stride;
+      uint8_t *alpha = reinterpret_cast<uint8_t *>(buffers->color + 3);
+      for (int i = 0; i < num_points; ++i) {
+        *reinterpret_cast<float *>(alpha) = 1.f;
+        alpha += stride;
+      }
+    }
+  }
+  return true;
+}
+
 void ReleaseUnityMesh(DracoToUnityMesh **mesh_ptr) {
   DracoToUnityMesh *mesh = *mesh_ptr;
   if (!mesh) {
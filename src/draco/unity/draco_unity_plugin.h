@@ -111,6 +111,56 @@ bool EXPORT_API GetAttributeData(const DracoMesh *mesh,
                                  const DracoAttribute *attribute,
                                  DracoData **data);
 
+// Struct describing caller owned arrays filled by GetMeshBuffers(), e.g. the
+// pointers of pinned NativeArrays or of the vertex and index buffers of
+// Unity's Mesh.MeshData. The arrays are not allocated or released by the
+// plugin. Vertex arrays must hold |num_vertices| entries of the DracoMesh and
+// |indices| must hold |num_faces| * 3 entries. Entries of vertex arrays are
+// |*_stride| bytes apart so that they can be written into interleaved
+// vertex buffers. A stride of 0 means tightly packed entries. Arrays set to
+// null are not filled.
+struct EXPORT_API DracoUnityMeshBuffers {
+  DracoUnityMeshBuffers()
+      : indices(nullptr),
+        index_size(4),
+        position(nullptr),
+        position_stride(0),
+        normal(nullptr),
+        normal_stride(0),
+        texcoord(nullptr),
+        texcoord_stride(0),
+        color(nullptr),
+        color_stride(0) {}
+
+  // Triangle indices, either 16-bit (|index_size| == 2) or 32-bit
+  // (|index_size| == 4) matching Unity's IndexFormat.
+  void *indices;
+  int index_size;
+  // Three float components per vertex.
+  float *position;
+  int position_stride;
+  // Three float components per vertex.
+  float *normal;
+  int normal_stride;
+  // Two float components per vertex of the first TEX_COORD attribute.
+  float *texcoord;
+  int texcoord_stride;
+  // RGBA float components per vertex. Alpha is set to 1 for RGB colors.
+  float *color;
+  int color_stride;
+};
+
+// Writes indices and attribute values of |mesh| directly into the arrays of
+// |buffers| without any intermediate allocations. Returns false when |mesh|
+// is missing an attribute requested by a non-null array, when 16-bit indices
+// cannot address all vertices or when a value cannot be converted.
+//
+// The function only reads |mesh|. It can be called together with
+// DecodeDracoMesh() and ReleaseDracoMesh() from worker threads, e.g. from
+// Unity jobs, with each thread processing a different mesh.
+bool EXPORT_API GetMeshBuffers(const DracoMesh *mesh,
+                               const DracoUnityMeshBuffers *buffers);
+
 // DracoToUnityMesh is deprecated.
 struct EXPORT_API DracoToUnityMesh {
   DracoToUnityMesh()
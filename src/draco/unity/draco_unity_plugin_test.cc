@@ -19,8 +19,11 @@
 #include <sstream>
 #include <string>
 
+#include "draco/compression/encode.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
+#include "draco/core/vector_d.h"
+#include "draco/mesh/triangle_soup_mesh_builder.h"
 
 namespace {
 
@@ -199,6 +202,161 @@ TEST(DracoUnityPluginTest, TestAttributeUniqueId) {
   draco::ReleaseDracoMesh(&draco_mesh);
 }
 
+TEST(DracoUnityPluginTest, TestGetMeshBuffers) {
+  draco::DracoMesh *draco_mesh = DecodeToDracoMesh("cube_att_sub_o_2.drc");
+  ASSERT_NE(draco_mesh, nullptr);
+  const int num_vertices = draco_mesh->num_vertices;
+
+  // Fill tightly packed arrays.
+  std::vector<uint32_t> indices(draco_mesh->num_faces * 3);
+  std::vector<float> positions(num_vertices * 3);
+  std::vector<float> texcoords(num_vertices * 2);
+  draco::DracoUnityMeshBuffers buffers;
+  buffers.indices = indices.data();
+  buffers.position = positions.data();
+  buffers.texcoord = texcoords.data();
+  ASSERT_TRUE(draco::GetMeshBuffers(draco_mesh, &buffers));
+
+  // Compare the values with the data returned by the DracoData interface.
+  draco::DracoData *draco_indices = nullptr;
+  ASSERT_TRUE(draco::GetMeshIndices(draco_mesh, &draco_indices));
+  const int *const expected_indices = static_cast<int *>(draco_indices->data);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ASSERT_EQ(indices[i], expected_indices[i]);
+  }
+  draco::ReleaseDracoData(&draco_indices);
+
+  draco::DracoAttribute *pos_attribute = nullptr;
+  ASSERT_TRUE(draco::GetAttributeByType(
+      draco_mesh, draco::GeometryAttribute::POSITION, 0, &pos_attribute));
+  draco::DracoData *pos_data = nullptr;
+  ASSERT_TRUE(draco::GetAttributeData(draco_mesh, pos_attribute, &pos_data));
+  const float *const expected_positions = static_cast<float *>(pos_data->data);
+  for (size_t i = 0; i < positions.size(); ++i) {
+    ASSERT_EQ(positions[i], expected_positions[i]);
+  }
+
+  // Fill interleaved position and normal vertex buffer with 16-bit indices.
+  struct Vertex {
+    float position[3];
+    float normal[3];
+  };
+  std::vector<Vertex> vertices(num_vertices);
+  std::vector<uint16_t> indices16(indices.size());
+  draco::DracoUnityMeshBuffers interleaved_buffers;
+  interleaved_buffers.indices = indices16.data();
+  interleaved_buffers.index_size = 2;
+  interleaved_buffers.position = vertices[0].position;
+  interleaved_buffers.position_stride = sizeof(Vertex);
+  interleaved_buffers.normal = vertices[0].normal;
+  interleaved_buffers.normal_stride = sizeof(Vertex);
+  ASSERT_TRUE(draco::GetMeshBuffers(draco_mesh, &interleaved_buffers));
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ASSERT_EQ(indices16[i], indices[i]);
+  }
+  draco::DracoAttribute *norm_attribute = nullptr;
+  ASSERT_TRUE(draco::GetAttributeByType(
+      draco_mesh, draco::GeometryAttribute::NORMAL, 0, &norm_attribute));
+  draco::DracoData *norm_data = nullptr;
+  ASSERT_TRUE(draco::GetAttributeData(draco_mesh, norm_attribute, &norm_data));
+  const float *const expected_normals = static_cast<float *>(norm_data->data);
+  for (int i = 0; i < num_vertices; ++i) {
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_EQ(vertices[i].position[c], expected_positions[3 * i + c]);
+      ASSERT_EQ(vertices[i].normal[c], expected_normals[3 * i + c]);
+    }
+  }
+  draco::ReleaseDracoData(&norm_data);
+  draco::ReleaseDracoAttribute(&norm_attribute);
+  draco::ReleaseDracoData(&pos_data);
+  draco::ReleaseDracoAttribute(&pos_attribute);
+
+  // The mesh has no color attribute.
+  std::vector<float> colors(num_vertices * 4);
+  draco::DracoUnityMeshBuffers color_buffers;
+  color_buffers.color = colors.data();
+  ASSERT_FALSE(draco::GetMeshBuffers(draco_mesh, &color_buffers));
+  draco::ReleaseDracoMesh(&draco_mesh);
+}
+
+TEST(DracoUnityPluginTest, TestGetMeshBuffersColor) {
+  // Build a mesh with an RGB color attribute that has no alpha component.
+  draco::TriangleSoupMeshBuilder mb;
+  mb.Start(2);
+  const int pos_att_id =
+      mb.AddAttribute(draco::GeometryAttribute::POSITION, 3, draco::DT_FLOAT32);
+  const int color_att_id = mb.AddAttribute(draco::GeometryAttribute::COLOR, 3,
+                                           draco::DT_UINT8, true);
+  mb.SetAttributeValuesForFace(
+      pos_att_id, draco::FaceIndex(0), draco::Vector3f(0.f, 0.f, 0.f).data(),
+      draco::Vector3f(1.f, 0.f, 0.f).data(),
+      draco::Vector3f(0.f, 1.f, 0.f).data());
+  mb.SetAttributeValuesForFace(
+      pos_att_id, draco::FaceIndex(1), draco::Vector3f(1.f, 0.f, 0.f).data(),
+      draco::Vector3f(1.f, 1.f, 0.f).data(),
+      draco::Vector3f(0.f, 1.f, 0.f).data());
+  const uint8_t colors_0[3][3] = {{255, 0, 0}, {0, 255, 0}, {0, 0, 255}};
+  const uint8_t colors_1[3][3] = {{0, 255, 0}, {64, 128, 192}, {0, 0, 255}};
+  mb.SetAttributeValuesForFace(color_att_id, draco::FaceIndex(0), colors_0[0],
+                               colors_0[1], colors_0[2]);
+  mb.SetAttributeValuesForFace(color_att_id, draco::FaceIndex(1), colors_1[0],
+                               colors_1[1], colors_1[2]);
+  const std::unique_ptr<draco::Mesh> mesh = mb.Finalize();
+  ASSERT_NE(mesh, nullptr);
+
+  draco::EncoderBuffer encoded;
+  DRACO_ASSERT_OK(draco::Encoder().EncodeMeshToBuffer(*mesh, &encoded));
+  draco::DracoMesh *draco_mesh = nullptr;
+  ASSERT_GT(draco::DecodeDracoMesh(const_cast<char *>(encoded.data()),
+                                   encoded.size(), &draco_mesh),
+            0);
+  const int num_vertices = draco_mesh->num_vertices;
+
+  draco::DracoAttribute *color_attribute = nullptr;
+  ASSERT_TRUE(draco::GetAttributeByType(
+      draco_mesh, draco::GeometryAttribute::COLOR, 0, &color_attribute));
+  ASSERT_EQ(color_attribute->num_components, 3);
+  draco::DracoData *color_data = nullptr;
+  ASSERT_TRUE(
+      draco::GetAttributeData(draco_mesh, color_attribute, &color_data));
+  const uint8_t *const expected_colors =
+      static_cast<uint8_t *>(color_data->data);
+
+  // Tightly packed RGBA floats. Normalized 8-bit colors are converted to
+  // [0, 1] floats and the missing alpha is set to opaque.
+  std::vector<float> colors(num_vertices * 4, -1.f);
+  draco::DracoUnityMeshBuffers buffers;
+  buffers.color = colors.data();
+  ASSERT_TRUE(draco::GetMeshBuffers(draco_mesh, &buffers));
+  for (int i = 0; i < num_vertices; ++i) {
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_EQ(colors[4 * i + c], expected_colors[3 * i + c] / 255.f);
+    }
+    ASSERT_EQ(colors[4 * i + 3], 1.f);
+  }
+
+  // Colors interleaved with positions.
+  struct Vertex {
+    float position[3];
+    float color[4];
+  };
+  std::vector<Vertex> vertices(num_vertices);
+  draco::DracoUnityMeshBuffers interleaved_buffers;
+  interleaved_buffers.position = vertices[0].position;
+  interleaved_buffers.position_stride = sizeof(Vertex);
+  interleaved_buffers.color = vertices[0].color;
+  interleaved_buffers.color_stride = sizeof(Vertex);
+  ASSERT_TRUE(draco::GetMeshBuffers(draco_mesh, &interleaved_buffers));
+  for (int i = 0; i < num_vertices; ++i) {
+    for (int c = 0; c < 4; ++c) {
+      ASSERT_EQ(vertices[i].color[c], colors[4 * i + c]);
+    }
+  }
+  draco::ReleaseDracoData(&color_data);
+  draco::ReleaseDracoAttribute(&color_attribute);
+  draco::ReleaseDracoMesh(&draco_mesh);
+}
+
 class DeprecatedDracoUnityPluginTest : public ::testing::Test {
  protected:
   DeprecatedDracoUnityPluginTest() : unity_mesh_(nullptr) {}